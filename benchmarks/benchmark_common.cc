@@ -139,3 +139,65 @@ std::string ccb_decision_gen::gen_example()
   str << "}";
   return str.str();
 }
+
+ca_decision_gen::ca_decision_gen(int shared_features, int initial_seed)
+    : shared_features(shared_features), rand(initial_seed)
+{
+}
+
+std::string ca_decision_gen::gen_example()
+{
+  std::ostringstream str;
+  str << R"({"shared":)";
+  str << make_feature_vector(shared_features, shared_features * 3, rand);
+  str << "}";
+  return str.str();
+}
+
+slates_decision_gen::slates_decision_gen(
+    int shared_features, int action_features, int actions_per_slot, int slots, int total_actions, int initial_seed)
+    : shared_features(shared_features)
+    , action_features(action_features)
+    , actions_per_slot(actions_per_slot)
+    , slots(slots)
+    , rand(initial_seed)
+{
+  for (int i = 0; i < total_actions; ++i)
+  {
+    actions_set.push_back(make_feature_vector(action_features, action_features * 3, rand));
+  }
+}
+
+std::string slates_decision_gen::gen_example()
+{
+  std::ostringstream str;
+  str << "{";
+
+  str << R"("shared":)";
+  str << make_feature_vector(shared_features, shared_features * 3, rand);
+  str << ",";
+
+  // Every slot has its own actions, marked with the index of the slot
+  str << R"("_multi":[)";
+  for (int slot = 0; slot < slots; ++slot)
+  {
+    for (int i = 0; i < actions_per_slot; ++i)
+    {
+      if (slot > 0 || i > 0) { str << ","; }
+      str << R"({"action":)" << actions_set[rand.next_uint() % actions_set.size()];
+      str << R"(,"_slot_id":)" << slot << "}";
+    }
+  }
+  str << "],";
+
+  str << R"("_slots":[)";
+  for (int slot = 0; slot < slots; ++slot)
+  {
+    if (slot > 0) { str << ","; }
+    str << R"({"slot":)" << make_feature_vector(action_features, action_features * 3, rand) << "}";
+  }
+  str << "]";
+
+  str << "}";
+  return str.str();
+}
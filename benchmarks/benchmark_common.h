@@ -1,3 +1,4 @@
+#include <cstdint>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -43,3 +44,27 @@ public:
 
   std::string gen_example();
 };
+
+class ca_decision_gen
+{
+  int shared_features;
+  prng rand;
+
+public:
+  ca_decision_gen(int shared_features, int initial_seed);
+
+  std::string gen_example();
+};
+
+class slates_decision_gen
+{
+  int shared_features, action_features, actions_per_slot, slots;
+  std::vector<std::string> actions_set;
+  prng rand;
+
+public:
+  slates_decision_gen(
+      int shared_features, int action_features, int actions_per_slot, int slots, int total_actions, int initial_seed);
+
+  std::string gen_example();
+};
@@ -0,0 +1,248 @@
+#include "api_status.h"
+#include "benchmark_common.h"
+#include "constants.h"
+#include "data_buffer.h"
+#include "dedup_internals.h"
+#include "err_constants.h"
+#include "generic_event.h"
+#include "logger/async_batcher.h"
+#include "logger/event_queue.h"
+#include "serialization/payload_serializer.h"
+#include "time_helper.h"
+#include "utility/context_helper.h"
+#include "utility/watchdog.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace r = reinforcement_learning;
+namespace u = reinforcement_learning::utility;
+namespace l = reinforcement_learning::logger;
+namespace err = reinforcement_learning::error_code;
+namespace v2 = reinforcement_learning::messages::flatbuff::v2;
+
+namespace
+{
+std::vector<std::string> gen_cb_examples(int actions_per_decision, int count)
+{
+  cb_decision_gen cb_gen(20, 10, actions_per_decision, 2000, 0, false);
+  std::vector<std::string> examples;
+  std::generate_n(std::back_inserter(examples), count, [&cb_gen] { return cb_gen.gen_example(); });
+  return examples;
+}
+
+r::generic_event::payload_buffer_t cb_payload(const std::string& context, int actions_per_decision)
+{
+  std::vector<uint64_t> action_ids(actions_per_decision);
+  std::vector<float> probabilities(actions_per_decision, 1.f / static_cast<float>(actions_per_decision));
+  for (int i = 0; i < actions_per_decision; ++i) { action_ids[i] = i + 1; }
+  return l::cb_serializer::event(context, 0, v2::LearningModeType_Online, action_ids, probabilities, "model_id");
+}
+
+std::shared_ptr<r::generic_event> cb_event(const std::string& id, const std::string& context, int actions)
+{
+  return std::make_shared<r::generic_event>(id.c_str(), r::timestamp{},
+      r::generic_event::payload_type_t::PayloadType_CB, cb_payload(context, actions), r::event_content_type::IDENTITY,
+      "bench_components");
+}
+
+// Stands for the sender, so that only the batching is measured
+class null_message_sender : public l::i_message_sender
+{
+public:
+  int send(const uint16_t /*msg_type*/, const buffer& /*db*/, r::api_status* /*status*/) override
+  {
+    return err::success;
+  }
+  int init(r::api_status* /*status*/) override { return err::success; }
+};
+
+// Shared by the threads of a run, created and destroyed by thread 0 outside of the timed loop
+std::unique_ptr<r::event_queue<r::generic_event>> shared_queue;
+}  // namespace
+
+// Every thread pushes an event and pops one, all on the same queue
+static void bench_event_queue(benchmark::State& state)
+{
+  using queue_t = r::event_queue<r::generic_event>;
+  if (state.thread_index() == 0) { shared_queue.reset(new queue_t(16 * 1024 * 1024)); }
+
+  queue_t::TFunc popped;
+  for (auto _ : state)
+  {
+    auto evt = std::make_shared<r::generic_event>();
+    queue_t::TFunc func = [evt](r::generic_event& out, r::api_status*)
+    {
+      out = std::move(*evt);
+      return err::success;
+    };
+    shared_queue->push(std::move(func), 100, evt.get());
+    shared_queue->pop(&popped);
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  if (state.thread_index() == 0) { shared_queue.reset(); }
+}
+
+// Serializes a batch of CB events with async_batcher::fill_buffer, through run_iteration. Appending is not timed.
+template <class... ExtraArgs>
+static void bench_async_batcher_fill_buffer(benchmark::State& state, ExtraArgs&&... extra_args)
+{
+  int res[sizeof...(extra_args)] = {extra_args...};
+  auto actions_per_decision = res[0];
+  auto batch_size = res[1];
+
+  const auto examples = gen_cb_examples(actions_per_decision, batch_size);
+
+  u::watchdog watchdog(nullptr);
+  u::async_batcher_config config;
+  config.send_high_water_mark = 1024 * 1024 * 1024;
+  config.batch_content_encoding = r::value::CONTENT_ENCODING_IDENTITY;
+  int shared_state = 0;
+  // init() is not called, the background thread does not run and batches are only sent by run_iteration
+  l::async_batcher<r::generic_event, l::fb_collection_serializer> batcher(
+      std::unique_ptr<l::i_message_sender>(new null_message_sender()), watchdog, shared_state, nullptr, config);
+
+  r::api_status status;
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    for (int i = 0; i < batch_size; ++i)
+    {
+      auto evt = cb_event(std::to_string(i), examples[i], actions_per_decision);
+      batcher.append(
+          [evt](r::generic_event& out, r::api_status*)
+          {
+            out = std::move(*evt);
+            return err::success;
+          },
+          evt.get(), &status);
+    }
+    state.ResumeTiming();
+    batcher.run_iteration(&status);
+  }
+
+  r::logger_statistics stats;
+  batcher.get_statistics(stats);
+  state.SetItemsProcessed(state.iterations() * batch_size);
+  state.SetBytesProcessed(static_cast<int64_t>(stats.batch_bytes_sent));
+}
+
+// Adds the actions of a context to the dictionary and releases them, as the dedup logger does for each event
+template <class... ExtraArgs>
+static void bench_dedup_dict(benchmark::State& state, ExtraArgs&&... extra_args)
+{
+  int res[sizeof...(extra_args)] = {extra_args...};
+  auto actions_per_decision = res[0];
+  auto count = res[1];
+
+  const auto examples = gen_cb_examples(actions_per_decision, count);
+
+  r::dedup_dict dict;
+  r::api_status status;
+  std::string edited_payload;
+  r::generic_event::object_list_t object_ids;
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    const auto& example = examples[i++ % count];
+    edited_payload.clear();
+    object_ids.clear();
+    dict.transform_payload_and_add_objects(example, edited_payload, object_ids, &status);
+    for (auto id : object_ids) { dict.remove_object(id); }
+    benchmark::DoNotOptimize(edited_payload.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Compresses the payload of a CB event. Building the payload is not timed.
+template <class... ExtraArgs>
+static void bench_zstd_compressor(benchmark::State& state, ExtraArgs&&... extra_args)
+{
+  int res[sizeof...(extra_args)] = {extra_args...};
+  auto actions_per_decision = res[0];
+  auto level = res[1];
+
+  const auto example = gen_cb_examples(actions_per_decision, 1)[0];
+
+  r::zstd_compressor compressor(level);
+  r::api_status status;
+  int64_t bytes = 0;
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto payload = cb_payload(example, actions_per_decision);
+    bytes += static_cast<int64_t>(payload.size());
+    state.ResumeTiming();
+    compressor.compress(payload, &status);
+    benchmark::DoNotOptimize(payload.data());
+  }
+  state.SetBytesProcessed(bytes);
+}
+
+// Builds the flatbuffer payload of a CB event
+template <class... ExtraArgs>
+static void bench_payload_serializer(benchmark::State& state, ExtraArgs&&... extra_args)
+{
+  int res[sizeof...(extra_args)] = {extra_args...};
+  auto actions_per_decision = res[0];
+
+  const auto example = gen_cb_examples(actions_per_decision, 1)[0];
+  std::vector<uint64_t> action_ids(actions_per_decision);
+  std::vector<float> probabilities(actions_per_decision, 1.f / static_cast<float>(actions_per_decision));
+  for (int i = 0; i < actions_per_decision; ++i) { action_ids[i] = i + 1; }
+
+  for (auto _ : state)
+  {
+    auto payload =
+        l::cb_serializer::event(example, 0, v2::LearningModeType_Online, action_ids, probabilities, "model_id");
+    benchmark::DoNotOptimize(payload.data());
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(example.size()));
+}
+
+// Finds the actions and slots of a context
+template <class... ExtraArgs>
+static void bench_get_context_info(benchmark::State& state, ExtraArgs&&... extra_args)
+{
+  int res[sizeof...(extra_args)] = {extra_args...};
+  auto actions_per_decision = res[0];
+
+  const auto example = gen_cb_examples(actions_per_decision, 1)[0];
+
+  u::ContextInfo info;
+  for (auto _ : state)
+  {
+    info.actions.clear();
+    info.slots.clear();
+    u::get_context_info(example, info);
+    benchmark::DoNotOptimize(info.actions.data());
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(example.size()));
+}
+
+BENCHMARK(bench_event_queue)->ThreadRange(1, 16)->UseRealTime();
+
+// x actions per decision
+// x events per batch
+BENCHMARK_CAPTURE(bench_async_batcher_fill_buffer, cb_50_actions, 50, 1000)->Unit(benchmark::kMillisecond);
+
+// x actions per decision (out of 2000)
+// x number of distinct contexts
+BENCHMARK_CAPTURE(bench_dedup_dict, cb_50_actions, 50, 100)->Unit(benchmark::kMicrosecond);
+
+// x actions per decision
+// x compression level
+BENCHMARK_CAPTURE(bench_zstd_compressor, cb_50_actions_level_1, 50, 1)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(bench_zstd_compressor, cb_50_actions_level_9, 50, 9)->Unit(benchmark::kMicrosecond);
+
+// x actions per decision
+BENCHMARK_CAPTURE(bench_payload_serializer, cb_50_actions, 50)->Unit(benchmark::kMicrosecond);
+
+// x actions per decision
+BENCHMARK_CAPTURE(bench_get_context_info, cb_50_actions, 50)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(bench_get_context_info, cb_500_actions, 500)->Unit(benchmark::kMicrosecond);
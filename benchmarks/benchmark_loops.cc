@@ -0,0 +1,205 @@
+#include "api_status.h"
+#include "benchmark_common.h"
+#include "ca_loop.h"
+#include "config_utility.h"
+#include "constants.h"
+#include "continuous_action_response.h"
+#include "err_constants.h"
+#include "latency_recorder.h"
+#include "multi_slot_response.h"
+#include "multistep.h"
+#include "multistep_loop.h"
+#include "ranking_response.h"
+#include "slates_loop.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+namespace r = reinforcement_learning;
+namespace u = reinforcement_learning::utility;
+namespace err = reinforcement_learning::error_code;
+
+namespace
+{
+void set_loop_config(u::configuration& config, const char* command_line)
+{
+  config.set(r::name::APP_ID, "bench_loops");
+  config.set(r::name::PROTOCOL_VERSION, "2");
+  config.set(r::name::EH_TEST, "true");
+  config.set(r::name::MODEL_SRC, r::value::NO_MODEL_DATA);
+  config.set(r::name::MODEL_VW_INITIAL_COMMAND_LINE, command_line);
+  config.set(r::name::OBSERVATION_SENDER_IMPLEMENTATION, r::value::OBSERVATION_FILE_SENDER);
+  config.set(r::name::INTERACTION_SENDER_IMPLEMENTATION, r::value::INTERACTION_FILE_SENDER);
+  config.set(r::name::EPISODE_SENDER_IMPLEMENTATION, r::value::EPISODE_FILE_SENDER);
+  config.set(r::name::INTERACTION_FILE_NAME, r::DEV_NULL);
+  config.set(r::name::OBSERVATION_FILE_NAME, r::DEV_NULL);
+  config.set(r::name::EPISODE_FILE_NAME, r::DEV_NULL);
+  config.set(r::name::MODEL_BACKGROUND_REFRESH, "false");
+  config.set(r::name::VW_POOL_INIT_SIZE, "1");
+  config.set("queue.mode", "BLOCK");
+}
+
+void report_error(const r::api_status& status)
+{
+  std::cout << "there was an error so something went wrong during "
+               "benchmarking: "
+            << status.get_error_msg() << std::endl;
+}
+}  // namespace
+
+template <class... ExtraArgs>
+static void bench_ca(benchmark::State& state, ExtraArgs&&... extra_args)
+{
+  int res[sizeof...(extra_args)] = {extra_args...};
+  auto shared_features = res[0];
+  auto count = res[1];
+
+  ca_decision_gen ca_gen(shared_features, 0);
+  std::vector<std::string> examples;
+  std::generate_n(std::back_inserter(examples), count, [&ca_gen] { return ca_gen.gen_example(); });
+
+  u::configuration config;
+  set_loop_config(config,
+      "--cats 4 --min_value 0 --max_value 100 --bandwidth 1 --coin --loss_option 1 --json --quiet --epsilon 0.1 "
+      "--id N/A");
+
+  r::api_status status;
+  r::ca_loop model(config);
+  if (model.init(&status) != err::success) { report_error(status); }
+
+  r::continuous_action_response response;
+  latency_recorder latencies;
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    const auto event_id = std::to_string(i);
+    latencies.start();
+    if (model.request_continuous_action(event_id.c_str(), examples[i % count].c_str(), response, &status) !=
+            err::success ||
+        model.report_outcome(event_id.c_str(), 1.f, &status) != err::success)
+    {
+      report_error(status);
+    }
+    latencies.stop();
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations());
+  latencies.report(state);
+}
+
+template <class... ExtraArgs>
+static void bench_slates(benchmark::State& state, ExtraArgs&&... extra_args)
+{
+  int res[sizeof...(extra_args)] = {extra_args...};
+  auto shared_features = res[0];
+  auto action_features = res[1];
+  auto actions_per_slot = res[2];
+  auto slots = res[3];
+  auto total_actions = res[4];
+  auto count = res[5];
+
+  slates_decision_gen slates_gen(shared_features, action_features, actions_per_slot, slots, total_actions, 0);
+  std::vector<std::string> examples;
+  std::generate_n(std::back_inserter(examples), count, [&slates_gen] { return slates_gen.gen_example(); });
+
+  u::configuration config;
+  set_loop_config(config, "--slates --ccb_explore_adf --json --quiet --epsilon 0.2 --first_only --id N/A");
+
+  r::api_status status;
+  r::slates_loop model(config);
+  if (model.init(&status) != err::success) { report_error(status); }
+
+  r::multi_slot_response response;
+  latency_recorder latencies;
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    const auto event_id = std::to_string(i);
+    latencies.start();
+    if (model.request_multi_slot_decision(event_id.c_str(), examples[i % count].c_str(), response, &status) !=
+            err::success ||
+        model.report_outcome(event_id.c_str(), 1.f, &status) != err::success)
+    {
+      report_error(status);
+    }
+    latencies.stop();
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations());
+  latencies.report(state);
+}
+
+template <class... ExtraArgs>
+static void bench_multistep(benchmark::State& state, ExtraArgs&&... extra_args)
+{
+  int res[sizeof...(extra_args)] = {extra_args...};
+  auto shared_features = res[0];
+  auto action_features = res[1];
+  auto actions_per_decision = res[2];
+  auto total_actions = res[3];
+  auto count = res[4];
+  auto episode_length = res[5];
+
+  cb_decision_gen cb_gen(shared_features, action_features, actions_per_decision, total_actions, 0, false);
+  std::vector<std::string> examples;
+  std::generate_n(std::back_inserter(examples), count, [&cb_gen] { return cb_gen.gen_example(); });
+
+  u::configuration config;
+  set_loop_config(config, "--cb_explore_adf --json --quiet --epsilon 0.2 --id N/A");
+
+  r::api_status status;
+  r::multistep_loop model(config);
+  if (model.init(&status) != err::success) { report_error(status); }
+
+  // An iteration is a whole episode: its decisions and its outcome
+  r::ranking_response response;
+  latency_recorder latencies;
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    const auto episode_id = "episode_" + std::to_string(i);
+    latencies.start();
+    r::episode_state episode(episode_id.c_str());
+    std::string previous_id;
+    for (int step = 0; step < episode_length; ++step)
+    {
+      auto event_id = episode_id + "_" + std::to_string(step);
+      if (model.request_episodic_decision(event_id.c_str(), step == 0 ? nullptr : previous_id.c_str(),
+              examples[(i + step) % count].c_str(), response, episode, &status) != err::success)
+      {
+        report_error(status);
+      }
+      previous_id = std::move(event_id);
+    }
+    if (model.report_outcome(episode.get_episode_id(), 1.f, &status) != err::success) { report_error(status); }
+    latencies.stop();
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations() * episode_length);
+  latencies.report(state);
+}
+
+// Each iteration makes a decision and reports its outcome, the percentiles are per iteration
+
+// x shared features
+// x number of distinct examples
+BENCHMARK_CAPTURE(bench_ca, cats_4, 20, 100)->Unit(benchmark::kMicrosecond);
+
+// x shared features
+// x features per action
+// x actions per slot
+// x slots
+// x actions in total
+// x number of distinct examples
+BENCHMARK_CAPTURE(bench_slates, slates_4x10, 20, 10, 10, 4, 200, 100)->Unit(benchmark::kMicrosecond);
+
+// x shared features
+// x features per action
+// x actions per decision
+// x actions in total
+// x number of distinct examples
+// x decisions per episode
+BENCHMARK_CAPTURE(bench_multistep, episode_of_4, 20, 10, 10, 200, 100, 4)->Unit(benchmark::kMicrosecond);
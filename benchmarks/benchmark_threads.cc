@@ -0,0 +1,130 @@
+#include "api_status.h"
+#include "benchmark_common.h"
+#include "cb_loop.h"
+#include "config_utility.h"
+#include "constants.h"
+#include "err_constants.h"
+#include "latency_recorder.h"
+#include "ranking_response.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace r = reinforcement_learning;
+namespace u = reinforcement_learning::utility;
+namespace err = reinforcement_learning::error_code;
+namespace cfg = reinforcement_learning::utility::config;
+
+namespace
+{
+const auto JSON_CFG = R"(
+{
+  "ApplicationID": "rnc-123456-a",
+  "IsExplorationEnabled": true,
+  "InitialExplorationEpsilon": 1.0
+}
+)";
+
+// Shared by the threads of a run, created and destroyed by thread 0 outside of the timed loop
+std::unique_ptr<r::cb_loop> shared_model;
+}  // namespace
+
+template <class... ExtraArgs>
+static void bench_cb_threads(benchmark::State& state, ExtraArgs&&... extra_args)
+{
+  int res[sizeof...(extra_args)] = {extra_args...};
+  auto shared_features = res[0];
+  auto action_features = res[1];
+  auto actions_per_decision = res[2];
+  auto total_actions = res[3];
+  auto count = res[4];
+  bool compression = res[5];
+  bool dedup = res[6];
+  bool report_outcome = res[7];
+
+  if (state.thread_index() == 0)
+  {
+    u::configuration config;
+    cfg::create_from_json(JSON_CFG, config);
+    config.set(r::name::PROTOCOL_VERSION, "2");
+    config.set(r::name::EH_TEST, "true");
+    config.set(r::name::MODEL_SRC, r::value::NO_MODEL_DATA);
+    config.set(r::name::OBSERVATION_SENDER_IMPLEMENTATION, r::value::OBSERVATION_FILE_SENDER);
+    config.set(r::name::INTERACTION_SENDER_IMPLEMENTATION, r::value::INTERACTION_FILE_SENDER);
+    config.set(r::name::INTERACTION_FILE_NAME, r::DEV_NULL);
+    config.set(r::name::OBSERVATION_FILE_NAME, r::DEV_NULL);
+    config.set(r::name::MODEL_BACKGROUND_REFRESH, "false");
+    config.set(r::name::INTERACTION_USE_COMPRESSION, compression ? "true" : "false");
+    config.set(r::name::INTERACTION_USE_DEDUP, dedup ? "true" : "false");
+    config.set("queue.mode", "BLOCK");
+
+    r::api_status status;
+    shared_model.reset(new r::cb_loop(config));
+    if (shared_model->init(&status) != err::success)
+    {
+      std::cout << "there was an error so something went wrong during "
+                   "benchmarking: "
+                << status.get_error_msg() << std::endl;
+    }
+  }
+
+  // Each thread has its own examples and event ids
+  cb_decision_gen cb_gen(
+      shared_features, action_features, actions_per_decision, total_actions, state.thread_index(), false);
+  std::vector<std::string> examples;
+  std::generate_n(std::back_inserter(examples), count, [&cb_gen] { return cb_gen.gen_example(); });
+  const auto event_id_prefix = "event_id_" + std::to_string(state.thread_index()) + "_";
+
+  r::api_status status;
+  r::ranking_response response;
+  latency_recorder latencies;
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    const auto event_id = event_id_prefix + std::to_string(i);
+    latencies.start();
+    if (shared_model->choose_rank(event_id.c_str(), examples[i % count].c_str(), response, &status) != err::success ||
+        (report_outcome && shared_model->report_outcome(event_id.c_str(), 1.f, &status) != err::success))
+    {
+      std::cout << "there was an error so something went wrong during "
+                   "benchmarking: "
+                << status.get_error_msg() << std::endl;
+    }
+    latencies.stop();
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations());
+  latencies.report(state);
+
+  if (state.thread_index() == 0) { shared_model.reset(); }
+}
+
+// characteristics of the benchmark examples that will be generated are:
+
+// x shared features
+// x features per action (affects dedup-ness)
+// x actions per example
+// x actions in total (affects dedup-ness)
+// x number of distinct examples per thread
+// compression (on/off)
+// dedup (on/off)
+// report an outcome after each decision (on/off)
+//
+// items_per_second is the throughput of all the threads together, the percentiles are per call
+BENCHMARK_CAPTURE(bench_cb_threads, choose_rank, 20, 10, 50, 2000, 100, false, false, false)
+    ->ThreadRange(1, 64)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(bench_cb_threads, choose_rank_report_outcome, 20, 10, 50, 2000, 100, false, false, true)
+    ->ThreadRange(1, 64)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(bench_cb_threads, choose_rank_report_outcome_compression_dedup, 20, 10, 50, 2000, 100, true, true,
+    true)
+    ->ThreadRange(1, 64)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Times each call of a benchmark and reports the percentiles of the latencies as counters, in microseconds.
+// Use one per thread. The samples of all the threads of a run are merged before the percentiles are computed, the last
+// thread to report sets the counters.
+class latency_recorder
+{
+  // Samples of the threads of the current run that have reported
+  struct run_samples
+  {
+    std::mutex mutex;
+    std::vector<uint64_t> samples;
+    int reported_threads = 0;
+  };
+
+  static run_samples& current_run()
+  {
+    static run_samples run;
+    return run;
+  }
+
+  std::vector<uint64_t> samples;
+  std::chrono::steady_clock::time_point start_time;
+
+public:
+  void start() { start_time = std::chrono::steady_clock::now(); }
+  void stop()
+  {
+    samples.push_back(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time).count()));
+  }
+
+  void report(benchmark::State& state)
+  {
+    auto& run = current_run();
+    std::lock_guard<std::mutex> lock(run.mutex);
+    run.samples.insert(run.samples.end(), samples.begin(), samples.end());
+    if (++run.reported_threads < state.threads()) { return; }
+
+    // The next run only starts once every thread of this one has returned
+    auto& all = run.samples;
+    if (!all.empty())
+    {
+      std::sort(all.begin(), all.end());
+      const auto percentile = [&all](double p)
+      {
+        const auto index = static_cast<size_t>(p * static_cast<double>(all.size() - 1));
+        return static_cast<double>(all[index]) / 1000.;
+      };
+      // Counters are summed over the threads, only this one sets them
+      state.counters["p50_us"] = percentile(0.5);
+      state.counters["p90_us"] = percentile(0.9);
+      state.counters["p99_us"] = percentile(0.99);
+      state.counters["p999_us"] = percentile(0.999);
+      state.counters["max_us"] = percentile(1.);
+    }
+    all.clear();
+    run.reported_threads = 0;
+  }
+};
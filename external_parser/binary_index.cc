@@ -0,0 +1,362 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#include "binary_index.h"
+
+#include "flatbuffers/flatbuffers.h"
+#include "generated/v2/FileFormat_generated.h"
+#include "parse_example_binary.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace v2 = reinforcement_learning::messages::flatbuff::v2;
+
+namespace
+{
+constexpr uint64_t MESSAGE_HEADER_SIZE = 2 * sizeof(uint32_t);
+// index message offset followed by the trailer magic and 4 bytes of padding
+constexpr uint64_t INDEX_TRAILER_SIZE = sizeof(uint64_t) + 2 * sizeof(uint32_t);
+
+// the parser expects payload_size % 8 padding bytes after each payload
+uint64_t message_length(uint32_t payload_size) { return MESSAGE_HEADER_SIZE + payload_size + payload_size % 8; }
+
+int64_t to_seconds(const TimePoint& tp)
+{
+  return std::chrono::duration_cast<std::chrono::seconds>(tp.time_since_epoch()).count();
+}
+
+TimePoint from_seconds(int64_t seconds) { return TimePoint(std::chrono::seconds(seconds)); }
+
+template <typename T>
+bool read_value(std::istream& in, T& value)
+{
+  return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+template <typename T>
+void write_value(std::ostream& out, const T& value)
+{
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void write_message(std::ostream& out, uint32_t message_type, const uint8_t* payload, uint32_t payload_size)
+{
+  static const char padding[8] = {0};
+  write_value(out, message_type);
+  write_value(out, payload_size);
+  out.write(reinterpret_cast<const char*>(payload), payload_size);
+  out.write(padding, payload_size % 8);
+}
+
+class slice_reader : public VW::io::reader
+{
+public:
+  slice_reader(const std::string& file_name, const VW::external::file_slice& slice)
+      : VW::io::reader(true), _file(file_name, std::ios::binary)
+  {
+    const uint32_t magic = MSG_TYPE_FILEMAGIC;
+    const uint32_t version = BINARY_PARSER_VERSION;
+    const uint32_t eof = MSG_TYPE_EOF;
+    const uint32_t zero = 0;
+    append_memory(magic);
+    append_memory(version);
+    if (slice.checkpoint_offset != VW::external::file_slice::NO_CHECKPOINT)
+    {
+      _segments.push_back({true, slice.checkpoint_offset, slice.checkpoint_length});
+    }
+    if (slice.end > slice.begin) { _segments.push_back({true, slice.begin, slice.end - slice.begin}); }
+    append_memory(eof);
+    append_memory(zero);
+  }
+
+  ssize_t read(char* buffer, size_t num_bytes) override
+  {
+    size_t total = 0;
+    while (total < num_bytes && _current < _segments.size())
+    {
+      auto& segment = _segments[_current];
+      const uint64_t remaining = segment.length - _position;
+      if (remaining == 0)
+      {
+        ++_current;
+        _position = 0;
+        continue;
+      }
+
+      const size_t count = static_cast<size_t>(std::min<uint64_t>(remaining, num_bytes - total));
+      if (segment.from_file)
+      {
+        _file.seekg(static_cast<std::streamoff>(segment.offset + _position));
+        if (!_file.read(buffer + total, static_cast<std::streamsize>(count))) { return -1; }
+      }
+      else { std::memcpy(buffer + total, _memory.data() + segment.offset + _position, count); }
+
+      _position += count;
+      total += count;
+    }
+    return static_cast<ssize_t>(total);
+  }
+
+  void reset() override
+  {
+    _current = 0;
+    _position = 0;
+    _file.clear();
+  }
+
+private:
+  struct segment
+  {
+    bool from_file;
+    uint64_t offset;
+    uint64_t length;
+  };
+
+  template <typename T>
+  void append_memory(const T& value)
+  {
+    const auto* bytes = reinterpret_cast<const char*>(&value);
+    if (_segments.empty() || _segments.back().from_file) { _segments.push_back({false, _memory.size(), 0}); }
+    _memory.insert(_memory.end(), bytes, bytes + sizeof(T));
+    _segments.back().length += sizeof(T);
+  }
+
+  std::ifstream _file;
+  std::vector<char> _memory;
+  std::vector<segment> _segments;
+  size_t _current = 0;
+  uint64_t _position = 0;
+};
+}  // namespace
+
+namespace VW
+{
+namespace external
+{
+constexpr uint64_t file_slice::NO_CHECKPOINT;
+
+bool build_index(const std::string& file_name, std::vector<index_entry>& entries, VW::io::logger& logger)
+{
+  entries.clear();
+  std::ifstream file(file_name, std::ios::binary);
+  if (!file.is_open())
+  {
+    logger.out_error("Failed to open [{}] for indexing", file_name);
+    return false;
+  }
+
+  std::vector<char> payload;
+  uint64_t offset = 0;
+  uint32_t message_type = 0;
+  while (read_value(file, message_type))
+  {
+    if (message_type == MSG_TYPE_EOF || message_type == MSG_TYPE_INDEX) { break; }
+
+    uint32_t payload_size = 0;
+    if (!read_value(file, payload_size))
+    {
+      logger.out_error("Failed to read message size at offset [{}] of [{}]", offset, file_name);
+      return false;
+    }
+
+    if (message_type == MSG_TYPE_FILEMAGIC)
+    {
+      // inline payload
+      offset += MESSAGE_HEADER_SIZE;
+      continue;
+    }
+
+    index_entry entry{offset, message_length(payload_size), message_type, TimePoint(), TimePoint()};
+    if (message_type == MSG_TYPE_REGULAR)
+    {
+      payload.resize(payload_size);
+      if (!file.read(payload.data(), payload_size))
+      {
+        logger.out_error("Failed to read regular message at offset [{}] of [{}]", offset, file_name);
+        return false;
+      }
+
+      auto verifier = flatbuffers::Verifier(reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+      const auto* joined_payload = flatbuffers::GetRoot<v2::JoinedPayload>(payload.data());
+      if (joined_payload->Verify(verifier) && joined_payload->events() != nullptr)
+      {
+        bool first = true;
+        for (const auto* joined_event : *joined_payload->events())
+        {
+          if (joined_event->timestamp() == nullptr) { continue; }
+          const auto ts = timestamp_to_chrono(*joined_event->timestamp());
+          entry.first_event_time = first ? ts : std::min(entry.first_event_time, ts);
+          entry.last_event_time = first ? ts : std::max(entry.last_event_time, ts);
+          first = false;
+        }
+      }
+      else { logger.out_warn("Regular message at offset [{}] of [{}] failed verification", offset, file_name); }
+      file.seekg(static_cast<std::streamoff>(payload_size % 8), std::ios::cur);
+    }
+    else { file.seekg(static_cast<std::streamoff>(payload_size + payload_size % 8), std::ios::cur); }
+
+    entries.push_back(entry);
+    offset += entry.length;
+  }
+
+  return true;
+}
+
+bool append_index(const std::string& file_name, VW::io::logger& logger)
+{
+  std::vector<index_entry> entries;
+  if (read_index(file_name, entries, logger)) { return true; }
+  if (!build_index(file_name, entries, logger)) { return false; }
+
+  uint64_t index_offset = 0;
+  {
+    std::ifstream file(file_name, std::ios::binary | std::ios::ate);
+    index_offset = static_cast<uint64_t>(file.tellg());
+    if (!entries.empty()) { index_offset = entries.back().offset + entries.back().length; }
+    else if (index_offset >= MESSAGE_HEADER_SIZE) { index_offset = MESSAGE_HEADER_SIZE; }
+  }
+
+  flatbuffers::FlatBufferBuilder fbb;
+  std::vector<v2::FileIndexEntry> fb_entries;
+  fb_entries.reserve(entries.size());
+  for (const auto& entry : entries)
+  {
+    fb_entries.emplace_back(entry.offset, entry.length, to_seconds(entry.first_event_time),
+        to_seconds(entry.last_event_time), entry.message_type);
+  }
+  fbb.Finish(v2::CreateFileIndex(fbb, fbb.CreateVectorOfStructs(fb_entries)));
+
+  std::fstream file(file_name, std::ios::binary | std::ios::in | std::ios::out);
+  if (!file.is_open())
+  {
+    logger.out_error("Failed to open [{}] for writing the index", file_name);
+    return false;
+  }
+
+  // anything after the last indexed message is an EOF message which is rewritten after the index
+  file.seekp(static_cast<std::streamoff>(index_offset));
+  write_message(file, MSG_TYPE_INDEX, fbb.GetBufferPointer(), fbb.GetSize());
+  write_value(file, MSG_TYPE_EOF);
+  write_value(file, uint32_t{0});
+  write_value(file, index_offset);
+  write_value(file, INDEX_TRAILER_MAGIC);
+  write_value(file, uint32_t{0});
+
+  if (!file)
+  {
+    logger.out_error("Failed to write the index of [{}]", file_name);
+    return false;
+  }
+  return true;
+}
+
+bool read_index(const std::string& file_name, std::vector<index_entry>& entries, VW::io::logger& logger)
+{
+  entries.clear();
+  std::ifstream file(file_name, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) { return false; }
+
+  const auto file_size = static_cast<uint64_t>(file.tellg());
+  if (file_size < INDEX_TRAILER_SIZE) { return false; }
+
+  uint64_t index_offset = 0;
+  uint32_t trailer_magic = 0;
+  file.seekg(static_cast<std::streamoff>(file_size - INDEX_TRAILER_SIZE));
+  if (!read_value(file, index_offset) || !read_value(file, trailer_magic) || trailer_magic != INDEX_TRAILER_MAGIC)
+  {
+    return false;
+  }
+
+  uint32_t message_type = 0;
+  uint32_t payload_size = 0;
+  file.seekg(static_cast<std::streamoff>(index_offset));
+  if (!read_value(file, message_type) || !read_value(file, payload_size) || message_type != MSG_TYPE_INDEX ||
+      index_offset + message_length(payload_size) > file_size)
+  {
+    logger.out_warn("Index trailer of [{}] does not point to an index message", file_name);
+    return false;
+  }
+
+  std::vector<char> payload(payload_size);
+  if (!file.read(payload.data(), payload_size)) { return false; }
+
+  auto verifier = flatbuffers::Verifier(reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+  const auto* index = flatbuffers::GetRoot<v2::FileIndex>(payload.data());
+  if (!index->Verify(verifier) || index->entries() == nullptr)
+  {
+    logger.out_warn("Index of [{}] failed verification", file_name);
+    return false;
+  }
+
+  entries.reserve(index->entries()->size());
+  for (const auto* entry : *index->entries())
+  {
+    entries.push_back({entry->offset(), entry->length(), entry->message_type(),
+        from_seconds(entry->first_event_time()), from_seconds(entry->last_event_time())});
+  }
+  return true;
+}
+
+std::vector<file_slice> make_slices(
+    const std::vector<index_entry>& entries, size_t num_slices, const TimePoint& start, const TimePoint& end)
+{
+  std::vector<size_t> selected;
+  uint64_t total_bytes = 0;
+  for (size_t i = 0; i < entries.size(); ++i)
+  {
+    const auto& entry = entries[i];
+    if (entry.message_type != MSG_TYPE_REGULAR || entry.last_event_time < start || entry.first_event_time > end)
+    {
+      continue;
+    }
+    selected.push_back(i);
+    total_bytes += entry.length;
+  }
+
+  std::vector<file_slice> slices;
+  if (selected.empty() || num_slices == 0) { return slices; }
+
+  const uint64_t target_bytes = (total_bytes + num_slices - 1) / num_slices;
+  uint64_t slice_bytes = 0;
+  size_t first = selected.front();
+  for (size_t k = 0; k < selected.size(); ++k)
+  {
+    const auto& entry = entries[selected[k]];
+    slice_bytes += entry.length;
+
+    const bool last_selected = k + 1 == selected.size();
+    if (!last_selected && (slice_bytes < target_bytes || slices.size() + 1 == num_slices)) { continue; }
+
+    file_slice slice;
+    slice.begin = entries[first].offset;
+    slice.end = entry.offset + entry.length;
+    for (size_t i = first; i-- > 0;)
+    {
+      if (entries[i].message_type == MSG_TYPE_CHECKPOINT)
+      {
+        slice.checkpoint_offset = entries[i].offset;
+        slice.checkpoint_length = entries[i].length;
+        break;
+      }
+    }
+    slices.push_back(slice);
+
+    if (!last_selected)
+    {
+      first = selected[k + 1];
+      slice_bytes = 0;
+    }
+  }
+
+  return slices;
+}
+
+std::unique_ptr<VW::io::reader> open_slice(const std::string& file_name, const file_slice& slice)
+{
+  return std::unique_ptr<VW::io::reader>(new slice_reader(file_name, slice));
+}
+}  // namespace external
+}  // namespace VW
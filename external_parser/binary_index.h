@@ -0,0 +1,67 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#pragma once
+
+#include "event_processors/timestamp_helper.h"
+#include "vw/io/io_adapter.h"
+#include "vw/io/logger.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace VW
+{
+namespace external
+{
+struct index_entry
+{
+  uint64_t offset;
+  uint64_t length;
+  uint32_t message_type;
+  // only set for regular messages
+  TimePoint first_event_time;
+  TimePoint last_event_time;
+};
+
+/*
+A contiguous byte range of a file that, together with the checkpoint message
+in effect at its start, can be parsed independently of the rest of the file.
+*/
+struct file_slice
+{
+  static constexpr uint64_t NO_CHECKPOINT = std::numeric_limits<uint64_t>::max();
+
+  uint64_t checkpoint_offset = NO_CHECKPOINT;
+  uint64_t checkpoint_length = 0;
+  uint64_t begin = 0;
+  uint64_t end = 0;
+};
+
+// Scans the whole file and records the offset, length and, for regular
+// messages, the event time range of every header, checkpoint and regular message
+bool build_index(const std::string& file_name, std::vector<index_entry>& entries, VW::io::logger& logger);
+
+// Appends an index message, an EOF message and the index trailer to the file.
+// A trailing EOF message is overwritten. Does nothing if the file already has an index.
+bool append_index(const std::string& file_name, VW::io::logger& logger);
+
+// Loads the footer index, returns false if the file has no (valid) index
+bool read_index(const std::string& file_name, std::vector<index_entry>& entries, VW::io::logger& logger);
+
+// Splits the regular messages with events in [start, end] into at most
+// num_slices disjoint slices of roughly equal size, in file order.
+// Time filtering is done per message so slices can contain events that are
+// slightly outside of the requested range.
+std::vector<file_slice> make_slices(
+    const std::vector<index_entry>& entries, size_t num_slices, const TimePoint& start, const TimePoint& end);
+
+// Returns a reader producing a self-contained binary stream for the slice:
+// file magic, checkpoint, the slice bytes and an EOF message
+std::unique_ptr<VW::io::reader> open_slice(const std::string& file_name, const file_slice& slice);
+}  // namespace external
+}  // namespace VW
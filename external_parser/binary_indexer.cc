@@ -0,0 +1,30 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#include "binary_index.h"
+#include "vw/io/logger.h"
+
+#include <iostream>
+
+// Appends a footer index to each of the binary joined log files given on the command line
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "usage: " << argv[0] << " <binary log file>..." << std::endl;
+    return 1;
+  }
+
+  auto logger = VW::io::create_default_logger();
+  int result = 0;
+  for (int i = 1; i < argc; ++i)
+  {
+    if (!VW::external::append_index(argv[i], logger))
+    {
+      std::cerr << "failed to index " << argv[i] << std::endl;
+      result = 1;
+    }
+  }
+  return result;
+}
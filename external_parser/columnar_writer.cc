@@ -0,0 +1,253 @@
+#include "columnar_writer.h"
+
+#include <parquet/properties.h>
+
+#include <stdexcept>
+
+namespace log_converter
+{
+namespace
+{
+void throw_if_error(const arrow::Status& status, const std::string& what)
+{
+  if (!status.ok()) { throw std::runtime_error(what + ": " + status.ToString()); }
+}
+
+int64_t to_micros(const TimePoint& tp)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(tp.time_since_epoch()).count();
+}
+
+std::shared_ptr<arrow::DataType> timestamp_type() { return arrow::timestamp(arrow::TimeUnit::MICRO, "UTC"); }
+}  // namespace
+
+constexpr int64_t columnar_writer::ROWS_PER_BATCH;
+
+struct columnar_writer::column_builders
+{
+  explicit column_builders(arrow::MemoryPool* pool)
+      : event_id(pool)
+      , timestamp(timestamp_type(), pool)
+      , observation_timestamp_values(std::make_shared<arrow::TimestampBuilder>(timestamp_type(), pool))
+      , observation_timestamps(pool, observation_timestamp_values)
+      , payload_type(pool)
+      , model_id(pool)
+      , action_values(std::make_shared<arrow::UInt32Builder>(pool))
+      , slot_actions(std::make_shared<arrow::ListBuilder>(pool, action_values))
+      , actions(pool, slot_actions)
+      , probability_values(std::make_shared<arrow::FloatBuilder>(pool))
+      , slot_probabilities(std::make_shared<arrow::ListBuilder>(pool, probability_values))
+      , probabilities(pool, slot_probabilities)
+      , reward_values(std::make_shared<arrow::FloatBuilder>(pool))
+      , rewards(pool, reward_values)
+      , continuous_action(pool)
+      , pdf_value(pool)
+      , pdrop(pool)
+      , skip_learn(pool)
+      , context(pool)
+  {
+  }
+
+  arrow::StringBuilder event_id;
+  arrow::TimestampBuilder timestamp;
+  std::shared_ptr<arrow::TimestampBuilder> observation_timestamp_values;
+  arrow::ListBuilder observation_timestamps;
+  arrow::StringBuilder payload_type;
+  arrow::StringBuilder model_id;
+  std::shared_ptr<arrow::UInt32Builder> action_values;
+  std::shared_ptr<arrow::ListBuilder> slot_actions;
+  arrow::ListBuilder actions;
+  std::shared_ptr<arrow::FloatBuilder> probability_values;
+  std::shared_ptr<arrow::ListBuilder> slot_probabilities;
+  arrow::ListBuilder probabilities;
+  std::shared_ptr<arrow::FloatBuilder> reward_values;
+  arrow::ListBuilder rewards;
+  arrow::FloatBuilder continuous_action;
+  arrow::FloatBuilder pdf_value;
+  arrow::FloatBuilder pdrop;
+  arrow::BooleanBuilder skip_learn;
+  arrow::BinaryBuilder context;
+
+  void append_slot(const VW::parsers::json::decision_service_interaction& slot)
+  {
+    throw_if_error(slot_actions->Append(), "append actions");
+    throw_if_error(
+        action_values->AppendValues(slot.actions.data(), static_cast<int64_t>(slot.actions.size())), "append actions");
+    throw_if_error(slot_probabilities->Append(), "append probabilities");
+    throw_if_error(probability_values->AppendValues(
+                       slot.probabilities.data(), static_cast<int64_t>(slot.probabilities.size())),
+        "append probabilities");
+  }
+
+  std::vector<std::shared_ptr<arrow::Array>> finish()
+  {
+    std::vector<arrow::ArrayBuilder*> columns = {&event_id, &timestamp, &observation_timestamps, &payload_type,
+        &model_id, &actions, &probabilities, &rewards, &continuous_action, &pdf_value, &pdrop, &skip_learn, &context};
+
+    std::vector<std::shared_ptr<arrow::Array>> arrays(columns.size());
+    for (size_t i = 0; i < columns.size(); ++i) { throw_if_error(columns[i]->Finish(&arrays[i]), "finish column"); }
+    return arrays;
+  }
+};
+
+columnar_writer::columnar_writer(const std::string& outfile_name, format fmt, VW::io::logger logger)
+    : _format(fmt)
+    , _logger(std::move(logger))
+    , _schema(schema())
+    , _builders(new column_builders(arrow::default_memory_pool()))
+{
+  auto sink = arrow::io::FileOutputStream::Open(outfile_name);
+  throw_if_error(sink.status(), "open " + outfile_name);
+  _sink = *sink;
+
+  if (_format == format::parquet)
+  {
+    auto properties = parquet::WriterProperties::Builder().compression(parquet::Compression::ZSTD)->build();
+    auto writer = parquet::arrow::FileWriter::Open(*_schema, arrow::default_memory_pool(), _sink, properties);
+    throw_if_error(writer.status(), "create parquet writer for " + outfile_name);
+    _parquet_writer = std::move(*writer);
+  }
+  else
+  {
+    auto writer = arrow::ipc::MakeFileWriter(_sink, _schema);
+    throw_if_error(writer.status(), "create arrow writer for " + outfile_name);
+    _ipc_writer = *writer;
+  }
+}
+
+columnar_writer::~columnar_writer()
+{
+  try
+  {
+    finish();
+  }
+  catch (const std::exception& e)
+  {
+    _logger.out_error("closing columnar output failed: [{}].", e.what());
+  }
+  catch (...)
+  {
+    _logger.out_error("closing columnar output failed with an unknown error.");
+  }
+}
+
+std::shared_ptr<arrow::Schema> columnar_writer::schema()
+{
+  return arrow::schema({
+      arrow::field("event_id", arrow::utf8(), false),
+      arrow::field("timestamp", timestamp_type(), false),
+      arrow::field("observation_timestamps", arrow::list(timestamp_type()), false),
+      arrow::field("payload_type", arrow::utf8(), false),
+      arrow::field("model_id", arrow::utf8(), false),
+      arrow::field("actions", arrow::list(arrow::list(arrow::uint32())), false),
+      arrow::field("probabilities", arrow::list(arrow::list(arrow::float32())), false),
+      arrow::field("rewards", arrow::list(arrow::float32()), false),
+      arrow::field("continuous_action", arrow::float32()),
+      arrow::field("pdf_value", arrow::float32()),
+      arrow::field("pdrop", arrow::float32(), false),
+      arrow::field("skip_learn", arrow::boolean(), false),
+      arrow::field("context", arrow::binary(), false),
+  });
+}
+
+void columnar_writer::submit(joined_event::joined_event&& je)
+{
+  if (_finished)
+  {
+    _logger.out_error("event: [{}] submitted after the columnar output was closed.", je.interaction_metadata.event_id);
+    return;
+  }
+
+  // builders only fail to append when running out of memory, in which case the
+  // current batch can not be written anymore so the error is not recoverable
+  append(je);
+  if (++_rows >= ROWS_PER_BATCH) { write_batch(); }
+}
+
+void columnar_writer::finish()
+{
+  if (_finished) { return; }
+  _finished = true;
+
+  write_batch();
+  if (_parquet_writer) { throw_if_error(_parquet_writer->Close(), "close parquet writer"); }
+  if (_ipc_writer) { throw_if_error(_ipc_writer->Close(), "close arrow writer"); }
+  throw_if_error(_sink->Close(), "close columnar output");
+}
+
+void columnar_writer::append(const joined_event::joined_event& je)
+{
+  auto& b = *_builders;
+  const auto* data = je.get_hold_of_typed_data();
+
+  float pdrop = 0.f;
+  throw_if_error(b.actions.Append(), "append actions");
+  throw_if_error(b.probabilities.Append(), "append probabilities");
+  throw_if_error(b.rewards.Append(), "append rewards");
+
+  if (const auto* cb = dynamic_cast<const joined_event::cb_joined_event*>(data))
+  {
+    b.append_slot(cb->interaction_data);
+    throw_if_error(b.reward_values->Append(cb->reward), "append rewards");
+    pdrop = cb->interaction_data.probability_of_drop;
+  }
+  else if (const auto* ccb = dynamic_cast<const joined_event::ccb_joined_event*>(data))
+  {
+    for (const auto& slot : ccb->multi_slot_interaction.interaction_data) { b.append_slot(slot); }
+    throw_if_error(b.reward_values->AppendValues(ccb->rewards), "append rewards");
+    pdrop = ccb->multi_slot_interaction.probability_of_drop;
+  }
+  else if (const auto* slates = dynamic_cast<const joined_event::slates_joined_event*>(data))
+  {
+    for (const auto& slot : slates->multi_slot_interaction.interaction_data) { b.append_slot(slot); }
+    throw_if_error(b.reward_values->Append(slates->reward), "append rewards");
+    pdrop = slates->multi_slot_interaction.probability_of_drop;
+  }
+
+  const auto* ca = dynamic_cast<const joined_event::ca_joined_event*>(data);
+  if (ca != nullptr)
+  {
+    throw_if_error(b.continuous_action.Append(ca->interaction_data.action), "append continuous_action");
+    throw_if_error(b.pdf_value.Append(ca->interaction_data.pdf_value), "append pdf_value");
+    throw_if_error(b.reward_values->Append(ca->reward), "append rewards");
+    pdrop = ca->interaction_data.probability_of_drop;
+  }
+  else
+  {
+    throw_if_error(b.continuous_action.AppendNull(), "append continuous_action");
+    throw_if_error(b.pdf_value.AppendNull(), "append pdf_value");
+  }
+
+  throw_if_error(b.event_id.Append(je.interaction_metadata.event_id), "append event_id");
+  throw_if_error(b.timestamp.Append(to_micros(je.joined_event_timestamp)), "append timestamp");
+
+  throw_if_error(b.observation_timestamps.Append(), "append observation_timestamps");
+  for (const auto& o : je.outcome_events)
+  {
+    throw_if_error(
+        b.observation_timestamp_values->Append(to_micros(o.enqueued_time_utc)), "append observation_timestamps");
+  }
+
+  throw_if_error(b.payload_type.Append(v2::EnumNamePayloadType(je.interaction_metadata.payload_type)),
+      "append payload_type");
+  throw_if_error(b.model_id.Append(je.model_id), "append model_id");
+  throw_if_error(b.pdrop.Append(pdrop), "append pdrop");
+  throw_if_error(b.skip_learn.Append(!je.is_joined_event_learnable()), "append skip_learn");
+  throw_if_error(b.context.Append(je.context), "append context");
+}
+
+void columnar_writer::write_batch()
+{
+  if (_rows == 0) { return; }
+
+  auto batch = arrow::RecordBatch::Make(_schema, _rows, _builders->finish());
+  _rows = 0;
+
+  if (_parquet_writer)
+  {
+    auto table = arrow::Table::Make(_schema, batch->columns(), batch->num_rows());
+    throw_if_error(_parquet_writer->WriteTable(*table, ROWS_PER_BATCH), "write parquet row group");
+  }
+  else { throw_if_error(_ipc_writer->WriteRecordBatch(*batch), "write arrow record batch"); }
+}
+}  // namespace log_converter
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "log_converter.h"
+#include "vw/io/logger.h"
+
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/writer.h>
+#include <parquet/arrow/writer.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace log_converter
+{
+/*
+columnar_writer
+Writes joined events as columns to an Arrow IPC file or a Parquet file without
+going through dsjson. Rows are accumulated in Arrow builders and written out
+as one record batch (Arrow IPC) or row group (Parquet) every ROWS_PER_BATCH
+events.
+
+Per slot columns (actions, probabilities) hold a single element for CB events.
+Slates and CA events have a single reward. CA events have no actions and fill
+in the continuous_action and pdf_value columns instead.
+*/
+class columnar_writer : public joined_event_writer
+{
+public:
+  enum class format
+  {
+    arrow_ipc,
+    parquet
+  };
+
+  static constexpr int64_t ROWS_PER_BATCH = 64 * 1024;
+
+  // throws std::runtime_error if the output file can not be created
+  columnar_writer(const std::string& outfile_name, format fmt, VW::io::logger logger);
+  ~columnar_writer() override;
+
+  columnar_writer(const columnar_writer&) = delete;
+  columnar_writer& operator=(const columnar_writer&) = delete;
+
+  // throws std::runtime_error if the event can not be appended or a batch can not be written
+  void submit(joined_event::joined_event&& je) override;
+  // writes the last batch and the file footer
+  void finish() override;
+
+  static std::shared_ptr<arrow::Schema> schema();
+
+private:
+  struct column_builders;
+
+  void append(const joined_event::joined_event& je);
+  void write_batch();
+
+  format _format;
+  VW::io::logger _logger;
+  std::shared_ptr<arrow::Schema> _schema;
+  std::shared_ptr<arrow::io::FileOutputStream> _sink;
+  std::shared_ptr<arrow::ipc::RecordBatchWriter> _ipc_writer;
+  std::unique_ptr<parquet::arrow::FileWriter> _parquet_writer;
+  std::unique_ptr<column_builders> _builders;
+  int64_t _rows = 0;
+  bool _finished = false;
+};
+}  // namespace log_converter
@@ -0,0 +1,141 @@
+#include "binary_context.h"
+
+#include <cstring>
+#include <limits>
+
+namespace
+{
+const uint32_t MAGIC = 0x31544E52;  // "RNT1"
+const size_t ALIGNMENT = 8;
+const size_t TENSOR_HEADER_SIZE = 2 * sizeof(uint32_t);
+
+size_t padded_size(size_t size) { return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+
+uint32_t read_u32(const uint8_t* data)
+{
+  uint32_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+void append_base64(const uint8_t* data, size_t size, std::string& out)
+{
+  static const char* const ALPHABET = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  size_t i = 0;
+  for (; i + 3 <= size; i += 3)
+  {
+    const uint32_t triple = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2];
+    out.push_back(ALPHABET[(triple >> 18) & 0x3F]);
+    out.push_back(ALPHABET[(triple >> 12) & 0x3F]);
+    out.push_back(ALPHABET[(triple >> 6) & 0x3F]);
+    out.push_back(ALPHABET[triple & 0x3F]);
+  }
+  if (i < size)
+  {
+    const bool two_bytes = i + 1 < size;
+    const uint32_t triple = (data[i] << 16) | (two_bytes ? data[i + 1] << 8 : 0);
+    out.push_back(ALPHABET[(triple >> 18) & 0x3F]);
+    out.push_back(ALPHABET[(triple >> 12) & 0x3F]);
+    out.push_back(two_bytes ? ALPHABET[(triple >> 6) & 0x3F] : '=');
+    out.push_back('=');
+  }
+}
+
+// The tensor notation has no escape sequences
+bool is_valid_name(const uint8_t* name, size_t length)
+{
+  for (size_t i = 0; i < length; i++)
+  {
+    if (name[i] < 0x20 || name[i] == '"' || name[i] == '\\') { return false; }
+  }
+  return true;
+}
+}  // namespace
+
+bool binary_tensors_to_json(const uint8_t* data, size_t size, std::string* json, std::string& error)
+{
+  if (size < TENSOR_HEADER_SIZE || read_u32(data) != MAGIC)
+  {
+    error = "missing binary tensor header";
+    return false;
+  }
+
+  const uint32_t tensor_count = read_u32(data + sizeof(uint32_t));
+  if (json != nullptr) { *json = "{"; }
+
+  size_t offset = TENSOR_HEADER_SIZE;
+  for (uint32_t i = 0; i < tensor_count; i++)
+  {
+    if (size - offset < TENSOR_HEADER_SIZE)
+    {
+      error = "tensor " + std::to_string(i) + " is truncated";
+      return false;
+    }
+
+    const size_t name_length = read_u32(data + offset);
+    const size_t rank = read_u32(data + offset + sizeof(uint32_t));
+    offset += TENSOR_HEADER_SIZE;
+
+    const size_t name_size = padded_size(name_length + 1);
+    if (size - offset < name_size || data[offset + name_length] != '\0' || !is_valid_name(data + offset, name_length))
+    {
+      error = "invalid name for tensor " + std::to_string(i);
+      return false;
+    }
+    const uint8_t* name = data + offset;
+    offset += name_size;
+
+    if ((size - offset) / sizeof(int64_t) < rank)
+    {
+      error = "dimensions of tensor " + std::to_string(i) + " are truncated";
+      return false;
+    }
+    const uint8_t* dimensions = data + offset;
+    offset += rank * sizeof(int64_t);
+
+    // a rank 0 tensor has no values
+    size_t value_count = rank == 0 ? 0 : 1;
+    for (size_t d = 0; d < rank; d++)
+    {
+      int64_t dimension;
+      std::memcpy(&dimension, dimensions + d * sizeof(int64_t), sizeof(dimension));
+      if (dimension < 0 ||
+          (dimension > 0 &&
+              value_count > std::numeric_limits<size_t>::max() / sizeof(float) / static_cast<size_t>(dimension)))
+      {
+        error = "invalid dimension " + std::to_string(dimension) + " for tensor " + std::to_string(i);
+        return false;
+      }
+      value_count *= static_cast<size_t>(dimension);
+    }
+
+    const size_t values_size = value_count * sizeof(float);
+    if (size - offset < padded_size(values_size))
+    {
+      error = "values of tensor " + std::to_string(i) + " are truncated";
+      return false;
+    }
+
+    if (json != nullptr)
+    {
+      if (i > 0) { json->push_back(','); }
+      json->push_back('"');
+      json->append(reinterpret_cast<const char*>(name), name_length);
+      json->append("\":\"");
+      append_base64(dimensions, rank * sizeof(int64_t), *json);
+      json->push_back(';');
+      append_base64(data + offset, values_size, *json);
+      json->push_back('"');
+    }
+    offset += padded_size(values_size);
+  }
+
+  if (offset != size)
+  {
+    error = std::to_string(size - offset) + " unexpected trailing bytes";
+    return false;
+  }
+
+  if (json != nullptr) { json->push_back('}'); }
+  return true;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Renders a context logged in the binary tensor framing of structured_input (see structured_input.h in the client
+// library) in the tensor notation of the ONNX extension, {"<NAME>":"<DIMS-BASE64>;<VALUES-BASE64>",...}. That is the
+// json context the client logs for the same tensors when they are given as a string.
+// Returns false and describes the problem in error if data is not a valid framing. json can be null to only validate
+// data.
+bool binary_tensors_to_json(const uint8_t* data, size_t size, std::string* json, std::string& error);
@@ -51,11 +51,13 @@ struct typed_joined_event
   virtual void set_skip_learn(bool sl) = 0;
   virtual void set_apprentice_reward() = 0;
   virtual bool fill_in_label(VW::multi_ex& examples, VW::io::logger& logger) const = 0;
+  // columns is scratch space for the outcomes of multi slot events grouped by slot
   virtual void calc_cost(float default_reward, reward::RewardFunctionType reward_function,
       const metadata::event_metadata_info& interaction_metadata,
       // TODO outcome_events should also idealy be const here but
       // we currently need it for ccb calculation
-      std::vector<reward::outcome_event>& outcome_events, VW::io::logger& logger) = 0;
+      std::vector<reward::outcome_event>& outcome_events, reward::outcome_columns& columns,
+      VW::io::logger& logger) = 0;
 
   virtual void calculate_metrics(VW::details::dsjson_metrics*) {}
   virtual float get_sum_original_reward() const = 0;
@@ -126,11 +128,11 @@ struct cb_joined_event : public typed_joined_event
 
   void calc_cost(float default_reward, reward::RewardFunctionType reward_function,
       const metadata::event_metadata_info& interaction_metadata, std::vector<reward::outcome_event>& outcome_events,
-      VW::io::logger&) override
+      reward::outcome_columns&, VW::io::logger&) override
   {
     reward = default_reward;
     // original reward is used to record the observed reward of apprentice mode
-    original_reward = reward_function(outcome_events, default_reward);
+    original_reward = reward::calculate(reward_function, outcome_events, default_reward);
 
     if (interaction_metadata.learning_mode == v2::LearningModeType_Apprentice) { set_apprentice_reward(); }
     else { reward = original_reward; }
@@ -157,7 +159,15 @@ struct ccb_joined_event : public typed_joined_event
   std::map<std::string, int> slot_id_to_index_map;
   std::vector<float> rewards;
   std::vector<float> original_rewards;
-  std::map<int, std::vector<reward::outcome_event>> outcomes_map;
+  // outcome_events positions of the outcomes of slot i are
+  // slot_outcomes[slot_outcome_offsets[i]] to slot_outcomes[slot_outcome_offsets[i + 1] - 1]
+  std::vector<size_t> slot_outcome_offsets;
+  std::vector<size_t> slot_outcomes;
+
+  size_t num_slot_outcomes(size_t slot) const
+  {
+    return slot + 1 < slot_outcome_offsets.size() ? slot_outcome_offsets[slot + 1] - slot_outcome_offsets[slot] : 0;
+  }
 
   ~ccb_joined_event() override = default;
   bool is_skip_learn() const override { return multi_slot_interaction.skip_learn; }
@@ -224,7 +234,7 @@ struct ccb_joined_event : public typed_joined_event
 
   void calc_cost(float default_reward, reward::RewardFunctionType reward_function,
       const metadata::event_metadata_info& metadata_info, std::vector<reward::outcome_event>& outcome_events,
-      VW::io::logger& logger) override
+      reward::outcome_columns& columns, VW::io::logger& logger) override
   {
     size_t num_of_slots = multi_slot_interaction.interaction_data.size();
 
@@ -257,27 +267,38 @@ struct ccb_joined_event : public typed_joined_event
       }
     }
 
-    for (auto& o : outcome_events)
+    // group the outcomes by slot, keeping their order within a slot
+    slot_outcome_offsets.assign(num_of_slots + 1, 0);
+    for (const auto& o : outcome_events)
     {
-      if (o.index != -1)
-      {
-        if (outcomes_map.find(o.index) == outcomes_map.end()) { outcomes_map.insert({o.index, {}}); }
-
-        outcomes_map[o.index].emplace_back(o);
-      }
+      if (o.index >= 0 && static_cast<size_t>(o.index) < num_of_slots) { slot_outcome_offsets[o.index + 1]++; }
     }
+    for (size_t i = 0; i < num_of_slots; i++) { slot_outcome_offsets[i + 1] += slot_outcome_offsets[i]; }
 
-    rewards = std::vector<float>(num_of_slots, default_reward);
-    original_rewards = std::vector<float>(num_of_slots, default_reward);
+    slot_outcomes.resize(slot_outcome_offsets[num_of_slots]);
+    std::vector<size_t> next(slot_outcome_offsets.begin(), slot_outcome_offsets.end() - 1);
+    for (size_t k = 0; k < outcome_events.size(); k++)
+    {
+      const int index = outcome_events[k].index;
+      if (index >= 0 && static_cast<size_t>(index) < num_of_slots) { slot_outcomes[next[index]++] = k; }
+    }
 
-    for (int i = 0; i < static_cast<int>(num_of_slots); i++)
+    // a single reward function call computes the rewards of all slots
+    columns.clear();
+    columns.reserve(slot_outcomes.size());
+    for (size_t i = 0; i < num_of_slots; i++)
     {
-      if (outcomes_map.find(i) != outcomes_map.end())
+      for (size_t k = slot_outcome_offsets[i]; k < slot_outcome_offsets[i + 1]; k++)
       {
-        original_rewards[i] = reward_function(outcomes_map[i], default_reward);
+        columns.push_back(outcome_events[slot_outcomes[k]]);
       }
+      columns.end_group();
     }
 
+    rewards = std::vector<float>(num_of_slots, default_reward);
+    original_rewards = std::vector<float>(num_of_slots, default_reward);
+    if (num_of_slots > 0) { reward_function.columns(columns, default_reward, original_rewards.data()); }
+
     if (metadata_info.learning_mode == v2::LearningModeType_Apprentice) { set_apprentice_reward(); }
     else { rewards.assign(original_rewards.begin(), original_rewards.end()); }
   }
@@ -357,10 +378,10 @@ struct slates_joined_event : public typed_joined_event
 
   void calc_cost(float default_reward, reward::RewardFunctionType reward_function,
       const metadata::event_metadata_info& metadata_info, std::vector<reward::outcome_event>& outcome_events,
-      VW::io::logger& logger) override
+      reward::outcome_columns&, VW::io::logger& logger) override
   {
     reward = default_reward;
-    original_reward = reward_function(outcome_events, default_reward);
+    original_reward = reward::calculate(reward_function, outcome_events, default_reward);
 
     if (metadata_info.learning_mode == v2::LearningModeType_Apprentice)
     {
@@ -441,11 +462,11 @@ struct ca_joined_event : public typed_joined_event
 
   void calc_cost(float default_reward, reward::RewardFunctionType reward_function,
       const metadata::event_metadata_info& interaction_metadata, std::vector<reward::outcome_event>& outcome_events,
-      VW::io::logger& logger) override
+      reward::outcome_columns&, VW::io::logger& logger) override
   {
     reward = default_reward;
     // original reward is used to record the observed reward of apprentice mode
-    original_reward = reward_function(outcome_events, default_reward);
+    original_reward = reward::calculate(reward_function, outcome_events, default_reward);
 
     if (interaction_metadata.learning_mode == v2::LearningModeType_Apprentice)
     {
@@ -511,9 +532,10 @@ struct joined_event
     else { return false; }
   }
 
-  void calc_reward(float default_reward, reward::RewardFunctionType reward_function, VW::io::logger& logger)
+  void calc_reward(float default_reward, reward::RewardFunctionType reward_function, reward::outcome_columns& columns,
+      VW::io::logger& logger)
   {
-    typed_data->calc_cost(default_reward, reward_function, interaction_metadata, outcome_events, logger);
+    typed_data->calc_cost(default_reward, reward_function, interaction_metadata, outcome_events, columns, logger);
   }
 
   void calculate_metrics(VW::details::dsjson_metrics* metrics) { return typed_data->calculate_metrics(metrics); }
@@ -3,6 +3,11 @@
 #include "generated/v2/OutcomeEvent_generated.h"
 #include "metadata.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
 namespace reward
 {
 struct outcome_event
@@ -21,101 +26,209 @@ struct outcome_event
   bool action_taken;
 };
 
-using RewardFunctionType = float (*)(const std::vector<outcome_event>&, float default_reward);
+/*
+outcome_columns
+Struct-of-arrays copy of the fields of a set of outcome events that the reward
+functions look at. Outcomes are stored in contiguous groups, for example one
+group per ccb slot or per multistep step, and a reward function computes one
+reward per group in a single call. The example joiner uses them for the slots
+of one joined event at a time, only the multistep joiner groups a whole batch.
+*/
+struct outcome_columns
+{
+  std::vector<float> values;
+  std::vector<int> indices;
+  std::vector<TimePoint> timestamps;
+  std::vector<unsigned char> action_taken;
+  // group g holds the outcomes in [group_offsets[g], group_offsets[g + 1])
+  std::vector<size_t> group_offsets{0};
+
+  size_t size() const { return values.size(); }
+  size_t num_groups() const { return group_offsets.size() - 1; }
+  size_t group_begin(size_t g) const { return group_offsets[g]; }
+  size_t group_end(size_t g) const { return group_offsets[g + 1]; }
+  float value(size_t i) const { return values[i]; }
+  const TimePoint& timestamp(size_t i) const { return timestamps[i]; }
+  bool is_activation(size_t i) const { return action_taken[i] != 0; }
+
+  // keeps the allocated capacity so the columns can be reused
+  void clear()
+  {
+    values.clear();
+    indices.clear();
+    timestamps.clear();
+    action_taken.clear();
+    group_offsets.assign(1, 0);
+  }
+
+  void reserve(size_t num_outcomes)
+  {
+    values.reserve(num_outcomes);
+    indices.reserve(num_outcomes);
+    timestamps.reserve(num_outcomes);
+    action_taken.reserve(num_outcomes);
+  }
 
-inline float average(const std::vector<outcome_event>& outcome_events, float default_reward)
+  // adds the outcome to the current group
+  void push_back(const outcome_event& o)
+  {
+    values.push_back(o.value);
+    indices.push_back(o.index);
+    timestamps.push_back(o.enqueued_time_utc);
+    action_taken.push_back(o.action_taken ? 1 : 0);
+  }
+
+  void end_group() { group_offsets.push_back(values.size()); }
+};
+
+// The outcome events of a single joined event as one group, read in place
+struct event_outcomes
 {
-  float sum = 0.f;
-  size_t N = 0;
+  explicit event_outcomes(const std::vector<outcome_event>& outcome_events) : events(outcome_events) {}
+  const std::vector<outcome_event>& events;
+
+  size_t num_groups() const { return 1; }
+  size_t group_begin(size_t) const { return 0; }
+  size_t group_end(size_t) const { return events.size(); }
+  float value(size_t i) const { return events[i].value; }
+  const TimePoint& timestamp(size_t i) const { return events[i].enqueued_time_utc; }
+  bool is_activation(size_t i) const { return events[i].action_taken; }
+};
 
-  for (const auto& o : outcome_events)
+// Reward functions write one reward per group of outcomes to rewards. Outcomes
+// with action_taken set are activations and are ignored, groups without any
+// other outcome get the default reward.
+template <typename Outcomes>
+void average(const Outcomes& outcomes, float default_reward, float* rewards)
+{
+  for (size_t g = 0; g < outcomes.num_groups(); ++g)
   {
-    if (!o.action_taken)
+    float sum = 0.f;
+    size_t N = 0;
+    for (size_t i = outcomes.group_begin(g); i < outcomes.group_end(g); ++i)
     {
-      sum += o.value;
-      N++;
+      if (!outcomes.is_activation(i))
+      {
+        sum += outcomes.value(i);
+        N++;
+      }
     }
+    rewards[g] = N == 0 ? default_reward : sum / N;
   }
-
-  return N == 0 ? default_reward : sum / N;
 }
 
-inline float sum(const std::vector<outcome_event>& outcome_events, float default_reward)
+template <typename Outcomes>
+void sum(const Outcomes& outcomes, float default_reward, float* rewards)
 {
-  float sum = 0.f;
-  size_t N = 0;
-
-  for (const auto& o : outcome_events)
+  for (size_t g = 0; g < outcomes.num_groups(); ++g)
   {
-    if (!o.action_taken)
+    float sum = 0.f;
+    size_t N = 0;
+    for (size_t i = outcomes.group_begin(g); i < outcomes.group_end(g); ++i)
     {
-      sum += o.value;
-      N++;
+      if (!outcomes.is_activation(i))
+      {
+        sum += outcomes.value(i);
+        N++;
+      }
     }
+    rewards[g] = N == 0 ? default_reward : sum;
   }
-
-  return N == 0 ? default_reward : sum;
 }
 
-inline float min(const std::vector<outcome_event>& outcome_events, float default_reward)
+template <typename Outcomes>
+void min(const Outcomes& outcomes, float default_reward, float* rewards)
 {
-  float min_reward = std::numeric_limits<float>::max();
-
-  for (const auto& o : outcome_events)
+  for (size_t g = 0; g < outcomes.num_groups(); ++g)
   {
-    if (!o.action_taken && o.value < min_reward) { min_reward = o.value; }
+    float min_reward = std::numeric_limits<float>::max();
+    for (size_t i = outcomes.group_begin(g); i < outcomes.group_end(g); ++i)
+    {
+      if (!outcomes.is_activation(i) && outcomes.value(i) < min_reward) { min_reward = outcomes.value(i); }
+    }
+    rewards[g] = min_reward == std::numeric_limits<float>::max() ? default_reward : min_reward;
   }
-  return min_reward == std::numeric_limits<float>::max() ? default_reward : min_reward;
 }
 
-inline float max(const std::vector<outcome_event>& outcome_events, float default_reward)
+template <typename Outcomes>
+void max(const Outcomes& outcomes, float default_reward, float* rewards)
 {
-  float max_reward = std::numeric_limits<float>::min();
-
-  for (const auto& o : outcome_events)
+  for (size_t g = 0; g < outcomes.num_groups(); ++g)
   {
-    if (!o.action_taken && o.value > max_reward) { max_reward = o.value; }
+    float max_reward = std::numeric_limits<float>::min();
+    for (size_t i = outcomes.group_begin(g); i < outcomes.group_end(g); ++i)
+    {
+      if (!outcomes.is_activation(i) && outcomes.value(i) > max_reward) { max_reward = outcomes.value(i); }
+    }
+    rewards[g] = max_reward == std::numeric_limits<float>::min() ? default_reward : max_reward;
   }
-  return max_reward == std::numeric_limits<float>::min() ? default_reward : max_reward;
 }
 
-inline float median(const std::vector<outcome_event>& outcome_events, float default_reward)
+template <typename Outcomes>
+void median(const Outcomes& outcomes, float default_reward, float* rewards)
 {
   std::vector<float> values;
-  for (const auto& o : outcome_events)
+  for (size_t g = 0; g < outcomes.num_groups(); ++g)
   {
-    if (!o.action_taken) { values.push_back(o.value); }
-  }
-
-  auto outcome_events_size = values.size();
+    values.clear();
+    for (size_t i = outcomes.group_begin(g); i < outcomes.group_end(g); ++i)
+    {
+      if (!outcomes.is_activation(i)) { values.push_back(outcomes.value(i)); }
+    }
 
-  if (outcome_events_size > 0)
-  {
-    sort(values.begin(), values.end());
-    if (outcome_events_size % 2 == 0)
+    auto outcome_events_size = values.size();
+    if (outcome_events_size == 0) { rewards[g] = default_reward; }
+    else
     {
-      return (values[outcome_events_size / 2 - 1] + values[outcome_events_size / 2]) / 2;
+      sort(values.begin(), values.end());
+      if (outcome_events_size % 2 == 0)
+      {
+        rewards[g] = (values[outcome_events_size / 2 - 1] + values[outcome_events_size / 2]) / 2;
+      }
+      else { rewards[g] = values[outcome_events_size / 2]; }
     }
-    else { return values[outcome_events_size / 2]; }
   }
-
-  return default_reward;
 }
 
-inline float earliest(const std::vector<outcome_event>& outcome_events, float default_reward)
+template <typename Outcomes>
+void earliest(const Outcomes& outcomes, float default_reward, float* rewards)
 {
-  auto oldest_valid_observation = TimePoint::max();
-  float earliest_reward = default_reward;
-
-  for (const auto& o : outcome_events)
+  for (size_t g = 0; g < outcomes.num_groups(); ++g)
   {
-    if (!o.action_taken && o.enqueued_time_utc < oldest_valid_observation)
+    auto oldest_valid_observation = TimePoint::max();
+    float earliest_reward = default_reward;
+    for (size_t i = outcomes.group_begin(g); i < outcomes.group_end(g); ++i)
     {
-      oldest_valid_observation = o.enqueued_time_utc;
-      earliest_reward = o.value;
+      if (!outcomes.is_activation(i) && outcomes.timestamp(i) < oldest_valid_observation)
+      {
+        oldest_valid_observation = outcomes.timestamp(i);
+        earliest_reward = outcomes.value(i);
+      }
     }
+    rewards[g] = earliest_reward;
   }
+}
 
-  return earliest_reward;
+// A reward function, for the outcome events of a single joined event and for groups of outcomes in columns
+struct RewardFunctionType
+{
+  void (*events)(const event_outcomes& outcomes, float default_reward, float* rewards);
+  void (*columns)(const outcome_columns& outcomes, float default_reward, float* rewards);
+};
+
+const RewardFunctionType average_function = {&average<event_outcomes>, &average<outcome_columns>};
+const RewardFunctionType sum_function = {&sum<event_outcomes>, &sum<outcome_columns>};
+const RewardFunctionType min_function = {&min<event_outcomes>, &min<outcome_columns>};
+const RewardFunctionType max_function = {&max<event_outcomes>, &max<outcome_columns>};
+const RewardFunctionType median_function = {&median<event_outcomes>, &median<outcome_columns>};
+const RewardFunctionType earliest_function = {&earliest<event_outcomes>, &earliest<outcome_columns>};
+
+// Computes the reward of the outcome events of a single joined event
+inline float calculate(
+    const RewardFunctionType& reward_function, const std::vector<outcome_event>& outcome_events, float default_reward)
+{
+  float reward = default_reward;
+  reward_function.events(event_outcomes(outcome_events), default_reward, &reward);
+  return reward;
 }
 }  // namespace reward
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "binary_context.h"
 #include "generated/v2/CaEvent_generated.h"
 #include "generated/v2/CbEvent_generated.h"
 #include "generated/v2/Metadata_generated.h"
@@ -12,6 +13,37 @@ namespace v2 = reinforcement_learning::messages::flatbuff::v2;
 
 namespace typed_event
 {
+// Structured input is logged in a binary framing, it is rendered as json so that it can be read like other contexts
+inline bool is_valid_context(
+    v2::ContextFormat format, const flatbuffers::Vector<uint8_t>& context, VW::io::logger& logger)
+{
+  if (format == v2::ContextFormat_Json) { return true; }
+  if (format != v2::ContextFormat_BinaryTensors)
+  {
+    logger.out_warn("Unknown context format [{}].", static_cast<int>(format));
+    return false;
+  }
+  std::string error;
+  if (!binary_tensors_to_json(context.data(), context.size(), nullptr, error))
+  {
+    logger.out_warn("Invalid binary tensor context: {}.", error);
+    return false;
+  }
+  return true;
+}
+
+inline std::string read_context(v2::ContextFormat format, const flatbuffers::Vector<uint8_t>& context)
+{
+  if (format == v2::ContextFormat_BinaryTensors)
+  {
+    std::string json;
+    std::string error;
+    binary_tensors_to_json(context.data(), context.size(), &json, error);
+    return json;
+  }
+  return {reinterpret_cast<char const*>(context.data()), context.size()};
+}
+
 template <typename T>
 struct event_processor;
 template <>
@@ -110,15 +142,12 @@ struct event_processor<v2::CbEvent>
           EnumNameLearningModeType(loop_info.learning_mode_config), EnumNameLearningModeType(evt.learning_mode()));
       return false;
     }
-    return true;
+    return is_valid_context(evt.context_format(), *evt.context(), logger);
   }
 
   static v2::LearningModeType get_learning_mode(const v2::CbEvent& evt) { return evt.learning_mode(); }
 
-  static std::string get_context(const v2::CbEvent& evt)
-  {
-    return {reinterpret_cast<char const*>(evt.context()->data()), evt.context()->size()};
-  }
+  static std::string get_context(const v2::CbEvent& evt) { return read_context(evt.context_format(), *evt.context()); }
 
   static joined_event::joined_event fill_in_joined_event(
       const v2::CbEvent& evt, const v2::Metadata& metadata, const TimePoint& enqueued_time_utc, std::string&& line_vec)
@@ -158,15 +187,12 @@ struct event_processor<v2::CaEvent>
           EnumNameLearningModeType(loop_info.learning_mode_config), EnumNameLearningModeType(evt.learning_mode()));
       return false;
     }
-    return true;
+    return is_valid_context(evt.context_format(), *evt.context(), logger);
   }
 
   static v2::LearningModeType get_learning_mode(const v2::CaEvent& evt) { return evt.learning_mode(); }
 
-  static std::string get_context(const v2::CaEvent& evt)
-  {
-    return {reinterpret_cast<char const*>(evt.context()->data()), evt.context()->size()};
-  }
+  static std::string get_context(const v2::CaEvent& evt) { return read_context(evt.context_format(), *evt.context()); }
 
   static joined_event::joined_event fill_in_joined_event(
       const v2::CaEvent& evt, const v2::Metadata& metadata, const TimePoint& enqueued_time_utc, std::string&& line_vec)
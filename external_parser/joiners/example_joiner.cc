@@ -24,6 +24,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <stdexcept>
 
 // VW headers
 #include "vw/core/parse_example_json.h"
@@ -31,14 +32,17 @@
 #include "vw/core/scope_exit.h"
 
 example_joiner::example_joiner(VW::workspace* vw)
-    : i_joiner(vw->logger), _vw(vw), _reward_calculation(&reward::earliest), _binary_to_json(false)
+    : i_joiner(vw->logger), _vw(vw), _reward_calculation(reward::earliest_function), _binary_to_json(false)
 {
 }
 
-example_joiner::example_joiner(VW::workspace* vw, bool binary_to_json, const std::string& outfile_name)
-    : i_joiner(vw->logger), _vw(vw), _reward_calculation(&reward::earliest), _binary_to_json(binary_to_json)
+example_joiner::example_joiner(VW::workspace* vw, std::unique_ptr<log_converter::joined_event_writer>&& writer)
+    : i_joiner(vw->logger)
+    , _vw(vw)
+    , _reward_calculation(reward::earliest_function)
+    , _binary_to_json(writer != nullptr)
+    , _event_writer(std::move(writer))
 {
-  _outfile.open(outfile_name, std::ofstream::out);
 }
 
 example_joiner::~example_joiner()
@@ -46,7 +50,6 @@ example_joiner::~example_joiner()
   // cleanup examples
   _dedup_cache.clear(return_example_f, this);
   for (auto* ex : _example_pool) { VW::dealloc_examples(ex, 1); }
-  if (_binary_to_json) { _outfile.close(); }
 }
 
 VW::example* example_joiner::get_or_create_example()
@@ -149,37 +152,37 @@ bool example_joiner::joiner_ready() { return _loop_info.is_configured() && _rewa
 
 void example_joiner::set_reward_function(const v2::RewardFunctionType type, bool sticky)
 {
-  reward::RewardFunctionType reward_calculation = nullptr;
+  reward::RewardFunctionType reward_calculation = {nullptr, nullptr};
   switch (type)
   {
     case v2::RewardFunctionType_Earliest:
-      reward_calculation = &reward::earliest;
+      reward_calculation = reward::earliest_function;
       break;
     case v2::RewardFunctionType_Average:
-      reward_calculation = &reward::average;
+      reward_calculation = reward::average_function;
       break;
 
     case v2::RewardFunctionType_Sum:
-      reward_calculation = &reward::sum;
+      reward_calculation = reward::sum_function;
       break;
 
     case v2::RewardFunctionType_Min:
-      reward_calculation = &reward::min;
+      reward_calculation = reward::min_function;
       break;
 
     case v2::RewardFunctionType_Max:
-      reward_calculation = &reward::max;
+      reward_calculation = reward::max_function;
       break;
 
     case v2::RewardFunctionType_Median:
-      reward_calculation = &reward::median;
+      reward_calculation = reward::median_function;
       break;
 
     default:
       break;
   }
 
-  if (reward_calculation != nullptr) { _reward_calculation.set(reward_calculation, sticky); }
+  if (reward_calculation.events != nullptr) { _reward_calculation.set(reward_calculation, sticky); }
 }
 
 void example_joiner::clear_batch_info()
@@ -379,7 +382,7 @@ bool example_joiner::process_outcome(
   if (_batch_grouped_examples.find(metadata.id()->str()) != _batch_grouped_examples.end())
   {
     auto& joined_event = _batch_grouped_examples[metadata.id()->str()];
-    joined_event.outcome_events.push_back(o_event);
+    joined_event.outcome_events.push_back(std::move(o_event));
   }
 
   return true;
@@ -451,6 +454,7 @@ bool example_joiner::process_dedup(const v2::Event& event, const v2::Metadata& m
 bool example_joiner::process_joined(VW::multi_ex& examples)
 {
   _current_je_is_skip_learn = false;
+  throw_if_writer_failed();
 
   if (_batch_event_order.empty()) { return true; }
 
@@ -491,20 +495,24 @@ bool example_joiner::process_joined(VW::multi_ex& examples)
             {
               je->calculate_metrics(_vw->parser_runtime.example_parser->metrics.get());
               _joiner_metrics.sum_cost_original += -1.f * je->get_sum_original_reward();
+              // copied, the event is still submitted to the writer below
               if (_joiner_metrics.first_event_id.empty())
               {
-                _joiner_metrics.first_event_id = std::move(je->interaction_metadata.event_id);
-                _joiner_metrics.first_event_timestamp = std::move(je->joined_event_timestamp);
+                _joiner_metrics.first_event_id = je->interaction_metadata.event_id;
+                _joiner_metrics.first_event_timestamp = je->joined_event_timestamp;
               }
               else
               {
-                _joiner_metrics.last_event_id = std::move(je->interaction_metadata.event_id);
-                _joiner_metrics.last_event_timestamp = std::move(je->joined_event_timestamp);
+                _joiner_metrics.last_event_id = je->interaction_metadata.event_id;
+                _joiner_metrics.last_event_timestamp = je->joined_event_timestamp;
               }
             }
           }
 
-          if (_binary_to_json) { log_converter::build_json(_outfile, *je, logger); }
+          if (_binary_to_json && !log_converter::submit_noexcept(*_event_writer, std::move(*je), logger))
+          {
+            _writer_failed = true;
+          }
         }
 
         clear_event_id_batch_info(id);
@@ -534,7 +542,7 @@ bool example_joiner::process_joined(VW::multi_ex& examples)
     return false;
   }
 
-  je->calc_reward(_loop_info.default_reward, _reward_calculation.value(), logger);
+  je->calc_reward(_loop_info.default_reward, _reward_calculation.value(), _outcome_columns, logger);
 
   if (!je->is_joined_event_learnable())
   {
@@ -597,6 +605,17 @@ bool example_joiner::current_event_is_skip_learn() { return _current_je_is_skip_
 void example_joiner::on_new_batch() {}
 void example_joiner::on_batch_read() {}
 
+void example_joiner::flush()
+{
+  throw_if_writer_failed();
+  if (_event_writer) { _event_writer->finish(); }
+}
+
+void example_joiner::throw_if_writer_failed() const
+{
+  if (_writer_failed) { throw std::runtime_error("Writing the joined events failed, see the logged error."); }
+}
+
 metrics::joiner_metrics example_joiner::get_metrics() { return _joiner_metrics; }
 
 void example_joiner::apply_cli_overrides(VW::workspace*, const VW::external::parser_options&) {}
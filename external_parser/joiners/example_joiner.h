@@ -10,16 +10,22 @@
 #include "vw/core/example.h"
 #include "vw/core/v_array.h"
 
-#include <fstream>
 #include <list>
+#include <memory>
 #include <queue>
 #include <unordered_map>
 
+namespace log_converter
+{
+class joined_event_writer;
+}
+
 class example_joiner : public i_joiner
 {
 public:
   example_joiner(VW::workspace* vw);  // TODO rule of 5
-  example_joiner(VW::workspace* vw, bool binary_to_json, const std::string& outfile_name);
+  // joined events are handed to the writer instead of being turned into vw examples
+  example_joiner(VW::workspace* vw, std::unique_ptr<log_converter::joined_event_writer>&& writer);
 
   ~example_joiner() override;
 
@@ -69,6 +75,13 @@ public:
    * If metadata is malformed then don't attempt to process event
    * We can't attempt to invalidate the specific id since we don't know it (it's
    * in the metadata)
+   *
+   * --- Rewards ---
+   *
+   * Events are decoded lazily, one event id per call, so the reward of a joined
+   * event is computed when it is returned and not for the whole batch at once.
+   * CB, CA and slates rewards read the outcome events of the joined event in
+   * place, CCB rewards group the outcomes by slot in _outcome_columns.
    */
   bool process_joined(VW::multi_ex& examples) override;
 
@@ -85,6 +98,8 @@ public:
 
   void on_batch_read() override;
 
+  void flush() override;
+
   metrics::joiner_metrics get_metrics() override;
 
   void persist_metrics(VW::metric_sink& sink) override;
@@ -101,6 +116,7 @@ private:
   void clear_event_id_batch_info(const std::string& id);
   void invalidate_joined_event(const std::string& id);
   void clear_vw_examples(VW::multi_ex& examples);
+  void throw_if_writer_failed() const;
 
   VW::example* get_or_create_example();
 
@@ -124,6 +140,8 @@ private:
   flatbuffers::DetachedBuffer _detached_buffer;
 
   loop::sticky_value<reward::RewardFunctionType> _reward_calculation;
+  // reused across joined events to group the outcomes of multi slot events by slot
+  reward::outcome_columns _outcome_columns;
   loop::loop_info _loop_info;
   metrics::joiner_metrics _joiner_metrics;
 
@@ -133,5 +151,7 @@ private:
   bool _current_je_is_skip_learn;
 
   bool _binary_to_json;
-  std::ofstream _outfile;
+  std::unique_ptr<log_converter::joined_event_writer> _event_writer;
+  // set by the guards that submit to _event_writer, they can not throw
+  bool _writer_failed = false;
 };
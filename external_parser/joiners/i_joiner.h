@@ -65,6 +65,14 @@ public:
 
   virtual void on_batch_read() = 0;
 
+  // to be called once the input has no more batches, joiners that hold events
+  // back across batches make them available to process_joined
+  virtual void on_end_of_input() {}
+
+  // to be called once no more events will be processed
+  // writes out anything the joiner still has buffered
+  virtual void flush() {}
+
   virtual void persist_metrics(VW::metric_sink& sink) {}
 
   virtual metrics::joiner_metrics get_metrics() = 0;
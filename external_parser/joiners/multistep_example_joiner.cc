@@ -9,8 +9,11 @@
 #include "parse_example_external.h"
 #include "utils.h"
 
+#include <algorithm>
 #include <climits>
+#include <cstring>
 #include <ctime>
+#include <iterator>
 #include <map>
 #include <queue>
 #include <stack>
@@ -27,28 +30,36 @@
 multistep_example_joiner::multistep_example_joiner(VW::workspace* vw)
     : i_joiner(vw->logger)
     , _vw(vw)
-    , _reward_calculation(&reward::earliest)
+    , _reward_calculation(reward::earliest_function)
     , _multistep_reward_calculation(&multistep_reward_suffix_mean)
     , _binary_to_json(false)
 {
 }
 
 multistep_example_joiner::multistep_example_joiner(
-    VW::workspace* vw, bool binary_to_json, const std::string& outfile_name)
+    VW::workspace* vw, std::unique_ptr<log_converter::joined_event_writer>&& writer)
     : i_joiner(vw->logger)
     , _vw(vw)
-    , _reward_calculation(&reward::earliest)
+    , _reward_calculation(reward::earliest_function)
     , _multistep_reward_calculation(&multistep_reward_suffix_mean)
-    , _binary_to_json(binary_to_json)
+    , _binary_to_json(writer != nullptr)
+    , _event_writer(std::move(writer))
 {
-  if (_binary_to_json) { _outfile.open(outfile_name, std::ofstream::out); }
 }
 
 multistep_example_joiner::~multistep_example_joiner()
 {
   // cleanup examples
   for (auto* ex : _example_pool) { VW::dealloc_examples(ex, 1); }
-  if (_binary_to_json) { _outfile.close(); }
+}
+
+constexpr size_t multistep_example_joiner::NO_EPISODE;
+
+void multistep_example_joiner::episode::clear()
+{
+  id.clear();
+  events.clear();
+  refs.clear();
 }
 
 bool multistep_example_joiner::process_event(const v2::JoinedEvent& joined_event)
@@ -57,17 +68,26 @@ bool multistep_example_joiner::process_event(const v2::JoinedEvent& joined_event
   const v2::Metadata& meta = *event->meta();
   auto enqueued_time_utc =
       get_enqueued_time(joined_event.timestamp(), meta.client_time_utc(), _loop_info.use_client_time, logger);
+
+  if (_streaming) { add_to_episode(joined_event, *event, enqueued_time_utc); }
+  else { add_event(*event, enqueued_time_utc); }
+  return true;
+}
+
+void multistep_example_joiner::add_event(const v2::Event& event, const TimePoint& enqueued_time_utc)
+{
+  const v2::Metadata& meta = *event.meta();
   switch (meta.payload_type())
   {
     case v2::PayloadType_MultiStep:
     {
-      auto interaction = flatbuffers::GetRoot<v2::MultiStepEvent>(event->payload()->data());
+      auto interaction = flatbuffers::GetRoot<v2::MultiStepEvent>(event.payload()->data());
       _interactions[interaction->event_id()->str()].push_back({enqueued_time_utc, meta, *interaction});
       break;
     }
     case v2::PayloadType_Outcome:
     {
-      auto outcome = flatbuffers::GetRoot<v2::OutcomeEvent>(event->payload()->data());
+      auto outcome = flatbuffers::GetRoot<v2::OutcomeEvent>(event.payload()->data());
       const char* id = outcome->index_type() == v2::IndexValue_literal ? outcome->index_as_literal()->c_str() : nullptr;
       if (id == nullptr) { _episodic_outcomes.push_back(process_outcome(enqueued_time_utc, meta, *outcome)); }
       else { _outcomes[std::string(id)].push_back(process_outcome(enqueued_time_utc, meta, *outcome)); }
@@ -76,7 +96,92 @@ bool multistep_example_joiner::process_event(const v2::JoinedEvent& joined_event
     default:
       break;
   }
-  return true;
+}
+
+void multistep_example_joiner::add_to_episode(
+    const v2::JoinedEvent& joined_event, const v2::Event& event, const TimePoint& enqueued_time_utc)
+{
+  const auto* episode_id = event.meta()->id();
+  if (episode_id == nullptr) { return; }
+
+  auto it = _open_episodes.find(episode_id->str());
+  if (it == _open_episodes.end())
+  {
+    size_t slot = _episode_arena.size();
+    if (!_free_episodes.empty())
+    {
+      slot = _free_episodes.back();
+      _free_episodes.pop_back();
+    }
+    else { _episode_arena.emplace_back(); }
+
+    _episode_arena[slot].id = episode_id->str();
+    _episode_arena[slot].first_event_time = enqueued_time_utc;
+    _episode_arena[slot].last_event_time = enqueued_time_utc;
+    it = _open_episodes.emplace(episode_id->str(), slot).first;
+  }
+
+  // the batch buffer is gone once the next message is read, so the episode keeps its own copy
+  auto& ep = _episode_arena[it->second];
+  const size_t offset = (ep.events.size() + 7) & ~static_cast<size_t>(7);
+  ep.events.resize(offset + joined_event.event()->size());
+  std::memcpy(ep.events.data() + offset, joined_event.event()->data(), joined_event.event()->size());
+  ep.refs.push_back({offset, enqueued_time_utc});
+  ep.first_event_time = std::min(ep.first_event_time, enqueued_time_utc);
+  ep.last_event_time = std::max(ep.last_event_time, enqueued_time_utc);
+  _latest_event_time = std::max(_latest_event_time, enqueued_time_utc);
+}
+
+void multistep_example_joiner::close_episodes(bool close_all)
+{
+  std::vector<size_t> closed;
+  for (auto it = _open_episodes.begin(); it != _open_episodes.end();)
+  {
+    if (close_all || _episode_arena[it->second].last_event_time + _episode_timeout < _latest_event_time)
+    {
+      closed.push_back(it->second);
+      it = _open_episodes.erase(it);
+    }
+    else { ++it; }
+  }
+
+  // emit in a deterministic order
+  std::sort(closed.begin(), closed.end(),
+      [this](size_t a, size_t b)
+      {
+        const auto& lhs = _episode_arena[a];
+        const auto& rhs = _episode_arena[b];
+        return std::tie(lhs.first_event_time, lhs.id) < std::tie(rhs.first_event_time, rhs.id);
+      });
+  _closed_episodes.insert(_closed_episodes.end(), closed.begin(), closed.end());
+
+  if (_order.empty()) { load_next_episode(); }
+}
+
+void multistep_example_joiner::load_next_episode()
+{
+  // loads closed episodes until one has interactions to join
+  while (_order.empty())
+  {
+    if (_loaded_episode != NO_EPISODE)
+    {
+      _episode_arena[_loaded_episode].clear();
+      _free_episodes.push_back(_loaded_episode);
+      _loaded_episode = NO_EPISODE;
+    }
+    on_new_batch();
+    if (_closed_episodes.empty()) { return; }
+
+    _loaded_episode = _closed_episodes.front();
+    _closed_episodes.pop_front();
+    const auto& ep = _episode_arena[_loaded_episode];
+    for (const auto& ref : ep.refs)
+    {
+      add_event(*flatbuffers::GetRoot<v2::Event>(ep.events.data() + ref.offset), ref.enqueued_time_utc);
+    }
+    populate_order();
+    populate_episodic_rewards();
+  }
 }
 
 void multistep_example_joiner::set_default_reward(float default_reward, bool sticky)
@@ -103,37 +208,37 @@ bool multistep_example_joiner::joiner_ready() { return _loop_info.is_configured(
 
 void multistep_example_joiner::set_reward_function(const v2::RewardFunctionType type, bool sticky)
 {
-  reward::RewardFunctionType reward_calculation = nullptr;
+  reward::RewardFunctionType reward_calculation = {nullptr, nullptr};
   switch (type)
   {
     case v2::RewardFunctionType_Earliest:
-      reward_calculation = &reward::earliest;
+      reward_calculation = reward::earliest_function;
       break;
     case v2::RewardFunctionType_Average:
-      reward_calculation = &reward::average;
+      reward_calculation = reward::average_function;
       break;
 
     case v2::RewardFunctionType_Sum:
-      reward_calculation = &reward::sum;
+      reward_calculation = reward::sum_function;
       break;
 
     case v2::RewardFunctionType_Min:
-      reward_calculation = &reward::min;
+      reward_calculation = reward::min_function;
       break;
 
     case v2::RewardFunctionType_Max:
-      reward_calculation = &reward::max;
+      reward_calculation = reward::max_function;
       break;
 
     case v2::RewardFunctionType_Median:
-      reward_calculation = &reward::median;
+      reward_calculation = reward::median_function;
       break;
 
     default:
       break;
   }
 
-  if (reward_calculation) { _reward_calculation.set(reward_calculation, sticky); }
+  if (reward_calculation.events != nullptr) { _reward_calculation.set(reward_calculation, sticky); }
 }
 
 void multistep_example_joiner::set_multistep_reward_function(const multistep_reward_funtion_type type, bool sticky)
@@ -279,6 +384,7 @@ joined_event::joined_event multistep_example_joiner::process_interaction(
 bool multistep_example_joiner::process_joined(VW::multi_ex& examples)
 {
   _current_je_is_skip_learn = false;
+  throw_if_writer_failed();
 
   if (!_sorted)
   {
@@ -299,6 +405,7 @@ bool multistep_example_joiner::process_joined(VW::multi_ex& examples)
           VW::return_multiple_example(*_vw, examples);
           examples.push_back(VW::new_unused_example(*_vw));
         }
+        if (_streaming && _order.empty()) { load_next_episode(); }
       });
 
   if (interactions.size() != 1)
@@ -316,14 +423,20 @@ bool multistep_example_joiner::process_joined(VW::multi_ex& examples)
   auto convert_guard = VW::scope_exit(
       [&]
       {
-        if (_binary_to_json) { log_converter::build_cb_json(_outfile, joined, logger); }
+        if (_binary_to_json && !log_converter::submit_noexcept(*_event_writer, std::move(joined), logger))
+        {
+          _writer_failed = true;
+        }
       });
 
   if (_binary_to_json) { clear_examples = true; }
 
-  const auto& outcomes = _outcomes[id];
+  // the outcomes of a step are only needed once their rewards have been computed
+  auto& outcomes = _outcomes[id];
 
-  for (const auto& o : outcomes) { joined.outcome_events.push_back(o); }
+  joined.outcome_events.reserve(outcomes.size() + _episodic_outcomes.size());
+  std::move(outcomes.begin(), outcomes.end(), std::back_inserter(joined.outcome_events));
+  outcomes.clear();
   for (const auto& o : _episodic_outcomes) { joined.outcome_events.push_back(o); }
 
   if (!joined.is_joined_event_learnable())
@@ -347,6 +460,8 @@ bool multistep_example_joiner::processing_batch() { return _sorted && !_order.em
 
 void multistep_example_joiner::on_new_batch()
 {
+  // in streaming mode the batch structures hold the episode being joined,
+  // a new message is only read once it has been fully processed
   _interactions.clear();
   _outcomes.clear();
   _episodic_outcomes.clear();
@@ -356,24 +471,56 @@ void multistep_example_joiner::on_new_batch()
 
 void multistep_example_joiner::populate_episodic_rewards()
 {
+  // one group of outcomes per step, all rewards of the batch are computed in a single call
+  _outcome_columns.clear();
   for (const std::string& id : _order)
   {
-    std::vector<reward::outcome_event> outcomes = _episodic_outcomes;
-    const auto outcomes_per_step = _outcomes[id];
-    outcomes.insert(outcomes.end(), std::make_move_iterator(outcomes_per_step.begin()),
-        std::make_move_iterator(outcomes_per_step.end()));
-    _rewards.push_back(_reward_calculation.value()(outcomes, _loop_info.default_reward));
+    for (const auto& o : _episodic_outcomes) { _outcome_columns.push_back(o); }
+    const auto it = _outcomes.find(id);
+    if (it != _outcomes.end())
+    {
+      for (const auto& o : it->second) { _outcome_columns.push_back(o); }
+    }
+    _outcome_columns.end_group();
+  }
+
+  std::vector<float> rewards(_order.size(), _loop_info.default_reward);
+  if (!rewards.empty())
+  {
+    _reward_calculation.value().columns(_outcome_columns, _loop_info.default_reward, rewards.data());
   }
+  _rewards.insert(_rewards.end(), rewards.begin(), rewards.end());
   _multistep_reward_calculation.value()(_rewards);
 }
 
 void multistep_example_joiner::on_batch_read()
 {
+  if (_streaming)
+  {
+    close_episodes(false);
+    return;
+  }
   populate_order();
   _sorted = true;
   populate_episodic_rewards();
 }
 
+void multistep_example_joiner::on_end_of_input()
+{
+  if (_streaming) { close_episodes(true); }
+}
+
+void multistep_example_joiner::flush()
+{
+  throw_if_writer_failed();
+  if (_event_writer) { _event_writer->finish(); }
+}
+
+void multistep_example_joiner::throw_if_writer_failed() const
+{
+  if (_writer_failed) { throw std::runtime_error("Writing the joined events failed, see the logged error."); }
+}
+
 metrics::joiner_metrics multistep_example_joiner::get_metrics() { return _joiner_metrics; }
 
 bool multistep_example_joiner::current_event_is_skip_learn() { return _current_je_is_skip_learn; }
@@ -381,6 +528,9 @@ bool multistep_example_joiner::current_event_is_skip_learn() { return _current_j
 void multistep_example_joiner::apply_cli_overrides(
     VW::workspace* all, const VW::external::parser_options& parsed_options)
 {
+  _streaming = parsed_options.multistep_streaming;
+  _episode_timeout = std::chrono::seconds(parsed_options.multistep_episode_timeout);
+
   if (all->options->was_supplied("multistep_reward"))
   {
     multistep_reward_funtion_type multistep_reward_func;
@@ -2,6 +2,7 @@
 
 #include "event_processors/joined_event.h"
 #include "event_processors/loop.h"
+#include "generated/v2/Event_generated.h"
 #include "generated/v2/FileFormat_generated.h"
 #include "generated/v2/Metadata_generated.h"
 #include "generated/v2/MultiStepEvent_generated.h"
@@ -12,11 +13,15 @@
 #include "vw/core/example.h"
 #include "vw/core/v_array.h"
 
+#include <chrono>
 #include <deque>
-#include <fstream>
+#include <limits>
 #include <list>
+#include <memory>
 #include <queue>
+#include <string>
 #include <unordered_map>
+#include <vector>
 // VW headers
 // vw.h has to come before json_utils.h
 // clang-format off
@@ -25,6 +30,11 @@
 
 namespace v2 = reinforcement_learning::messages::flatbuff::v2;
 
+namespace log_converter
+{
+class joined_event_writer;
+}
+
 enum multistep_reward_funtion_type
 {
   Identity = 0,
@@ -57,7 +67,8 @@ class multistep_example_joiner : public i_joiner
 {
 public:
   multistep_example_joiner(VW::workspace* vw);  // TODO rule of 5
-  multistep_example_joiner(VW::workspace* vw, bool binary_to_json, const std::string& outfile_name);
+  // joined events are handed to the writer instead of being turned into vw examples
+  multistep_example_joiner(VW::workspace* vw, std::unique_ptr<log_converter::joined_event_writer>&& writer);
 
   ~multistep_example_joiner() override;
 
@@ -77,6 +88,8 @@ public:
 
   void on_new_batch() override;
   void on_batch_read() override;
+  void on_end_of_input() override;
+  void flush() override;
   metrics::joiner_metrics get_metrics() override;
 
 private:
@@ -89,6 +102,37 @@ private:
   };
   void set_multistep_reward_function(const multistep_reward_funtion_type type, bool sticky);
 
+  /*
+  Streaming mode keeps the events of each open episode in a slot of
+  _episode_arena instead of joining whole batches. An episode is closed once an
+  event enqueued more than _episode_timeout after its last event is read, or
+  when the input ends. Closed episodes are then joined one at a time like a
+  batch, so memory is bounded by the open episodes rather than the batch size.
+  */
+  struct episode
+  {
+    struct event_ref
+    {
+      size_t offset;
+      TimePoint enqueued_time_utc;
+    };
+
+    std::string id;
+    // copies of the serialized v2::Event buffers, each starting 8 byte aligned
+    std::vector<uint8_t> events;
+    std::vector<event_ref> refs;
+    TimePoint first_event_time;
+    TimePoint last_event_time;
+
+    void clear();
+  };
+  static constexpr size_t NO_EPISODE = std::numeric_limits<size_t>::max();
+
+  void add_event(const v2::Event& event, const TimePoint& enqueued_time_utc);
+  void add_to_episode(const v2::JoinedEvent& joined_event, const v2::Event& event, const TimePoint& enqueued_time_utc);
+  void close_episodes(bool close_all);
+  void load_next_episode();
+
 private:
   bool populate_order();
   reward::outcome_event process_outcome(
@@ -96,6 +140,7 @@ private:
   joined_event::joined_event process_interaction(
       const Parsed<v2::MultiStepEvent>& event_meta, VW::multi_ex& examples, float reward);
   void populate_episodic_rewards();
+  void throw_if_writer_failed() const;
 
 private:
   std::vector<VW::example*> _example_pool;
@@ -110,16 +155,29 @@ private:
   std::unordered_map<std::string, std::vector<Parsed<v2::MultiStepEvent>>> _interactions;
   std::unordered_map<std::string, std::vector<reward::outcome_event>> _outcomes;
   std::vector<reward::outcome_event> _episodic_outcomes;
+  reward::outcome_columns _outcome_columns;
 
   std::deque<std::string> _order;
   std::deque<float> _rewards;
 
   bool _sorted = false;
 
+  bool _streaming = false;
+  std::chrono::seconds _episode_timeout{0};
+  std::vector<episode> _episode_arena;
+  std::vector<size_t> _free_episodes;
+  std::unordered_map<std::string, size_t> _open_episodes;
+  std::deque<size_t> _closed_episodes;
+  // arena slot of the episode that is being joined, its events are referenced by _interactions
+  size_t _loaded_episode = NO_EPISODE;
+  TimePoint _latest_event_time;
+
   metrics::joiner_metrics _joiner_metrics;
 
   bool _current_je_is_skip_learn;
 
   bool _binary_to_json = false;
-  std::ofstream _outfile;
+  std::unique_ptr<log_converter::joined_event_writer> _event_writer;
+  // set by the guards that submit to _event_writer, they can not throw
+  bool _writer_failed = false;
 };
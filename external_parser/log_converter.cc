@@ -10,28 +10,28 @@ namespace log_converter
 {
 namespace rj = rapidjson;
 
-void build_json(std::ofstream& outfile, joined_event::joined_event& je, VW::io::logger& logger)
+void build_json(std::string& out, joined_event::joined_event& je, VW::io::logger& logger)
 {
   switch (je.interaction_metadata.payload_type)
   {
     case v2::PayloadType_CB:
-      build_cb_json(outfile, je, logger);
+      build_cb_json(out, je, logger);
       break;
     case v2::PayloadType_CCB:
-      build_ccb_json(outfile, je, logger);
+      build_ccb_json(out, je, logger);
       break;
     case v2::PayloadType_CA:
-      build_ca_json(outfile, je, logger);
+      build_ca_json(out, je, logger);
       break;
     case v2::PayloadType_Slates:
-      build_slates_json(outfile, je, logger);
+      build_slates_json(out, je, logger);
       break;
     default:
       break;
   }
 }
 
-void build_cb_json(std::ofstream& outfile, joined_event::joined_event& je, VW::io::logger& logger)
+void build_cb_json(std::string& out, joined_event::joined_event& je, VW::io::logger& logger)
 {
   auto cb_je = reinterpret_cast<const joined_event::cb_joined_event*>(je.get_hold_of_typed_data());
   float cost = -1.f * cb_je->reward;
@@ -134,7 +134,8 @@ void build_cb_json(std::ofstream& outfile, joined_event::joined_event& je, VW::i
 
     writer.EndObject();
 
-    outfile << out_buffer.GetString() << std::endl;
+    out.append(out_buffer.GetString(), out_buffer.GetSize());
+    out.push_back('\n');
   }
   catch (const std::exception& e)
   {
@@ -143,13 +144,14 @@ void build_cb_json(std::ofstream& outfile, joined_event::joined_event& je, VW::i
   }
 }
 
-void build_ccb_json(std::ofstream& outfile, joined_event::joined_event& je, VW::io::logger& logger)
+void build_ccb_json(std::string& out, joined_event::joined_event& je, VW::io::logger& logger)
 {
   const std::string& event_id = je.interaction_metadata.event_id;
 
   auto ccb_joined_event = reinterpret_cast<const joined_event::ccb_joined_event*>(je.get_hold_of_typed_data());
   const auto& interaction_data = ccb_joined_event->multi_slot_interaction.interaction_data;
-  const auto& outcomes_map = ccb_joined_event->outcomes_map;
+  const auto& slot_outcome_offsets = ccb_joined_event->slot_outcome_offsets;
+  const auto& slot_outcomes = ccb_joined_event->slot_outcomes;
   const auto& rewards = ccb_joined_event->rewards;
   const auto& original_rewards = ccb_joined_event->original_rewards;
   const auto& baseline_actions = ccb_joined_event->multi_slot_interaction.baseline_actions;
@@ -210,13 +212,14 @@ void build_ccb_json(std::ofstream& outfile, joined_event::joined_event& je, VW::
       for (auto& p : interaction_data[i].probabilities) { writer.Double(p); }
       writer.EndArray();
 
-      if (outcomes_map.find(i) != outcomes_map.end())
+      if (ccb_joined_event->num_slot_outcomes(i) > 0)
       {
         writer.Key("_o");
         writer.StartArray();
 
-        for (auto& o : outcomes_map.at(i))
+        for (size_t k = slot_outcome_offsets[i]; k < slot_outcome_offsets[i + 1]; k++)
         {
+          const auto& o = je.outcome_events[slot_outcomes[k]];
           writer.StartObject();
 
           if (!o.action_taken)
@@ -277,7 +280,8 @@ void build_ccb_json(std::ofstream& outfile, joined_event::joined_event& je, VW::
     }
 
     writer.EndObject();
-    outfile << out_buffer.GetString() << std::endl;
+    out.append(out_buffer.GetString(), out_buffer.GetSize());
+    out.push_back('\n');
   }
   catch (const std::exception& e)
   {
@@ -285,7 +289,7 @@ void build_ccb_json(std::ofstream& outfile, joined_event::joined_event& je, VW::
   }
 }
 
-void build_ca_json(std::ofstream& outfile, joined_event::joined_event& je, VW::io::logger& logger)
+void build_ca_json(std::string& out, joined_event::joined_event& je, VW::io::logger& logger)
 {
   auto ca_je = reinterpret_cast<const joined_event::ca_joined_event*>(je.get_hold_of_typed_data());
   float cost = -1.f * ca_je->reward;
@@ -345,7 +349,8 @@ void build_ca_json(std::ofstream& outfile, joined_event::joined_event& je, VW::i
 
     writer.EndObject();
 
-    outfile << out_buffer.GetString() << std::endl;
+    out.append(out_buffer.GetString(), out_buffer.GetSize());
+    out.push_back('\n');
   }
   catch (const std::exception& e)
   {
@@ -354,7 +359,7 @@ void build_ca_json(std::ofstream& outfile, joined_event::joined_event& je, VW::i
   }
 }
 
-void build_slates_json(std::ofstream& outfile, joined_event::joined_event& je, VW::io::logger& logger)
+void build_slates_json(std::string& out, joined_event::joined_event& je, VW::io::logger& logger)
 {
   const std::string& event_id = je.interaction_metadata.event_id;
 
@@ -454,11 +459,187 @@ void build_slates_json(std::ofstream& outfile, joined_event::joined_event& je, V
     }
 
     writer.EndObject();
-    outfile << out_buffer.GetString() << std::endl;
+    out.append(out_buffer.GetString(), out_buffer.GetSize());
+    out.push_back('\n');
   }
   catch (const std::exception& e)
   {
     logger.out_error("convert event: [{}] from binary to json format failed: [{}].", event_id, e.what());
   }
 }
+
+bool submit_noexcept(joined_event_writer& writer, joined_event::joined_event&& je, VW::io::logger& logger) noexcept
+{
+  try
+  {
+    writer.submit(std::move(je));
+    return true;
+  }
+  catch (const std::exception& e)
+  {
+    try
+    {
+      logger.out_error("writing a joined event failed: [{}].", e.what());
+    }
+    catch (...)
+    {
+    }
+  }
+  catch (...)
+  {
+    try
+    {
+      logger.out_error("writing a joined event failed with an unknown error.");
+    }
+    catch (...)
+    {
+    }
+  }
+  return false;
+}
+
+constexpr size_t dsjson_writer::EVENTS_PER_CHUNK;
+constexpr size_t dsjson_writer::CHUNKS_IN_FLIGHT_PER_WORKER;
+constexpr size_t dsjson_writer::WRITE_BLOCK_SIZE;
+
+dsjson_writer::dsjson_writer(
+    const std::string& outfile_name, size_t num_workers, VW::io::logger logger, render_fn render)
+    : _logger(std::move(logger)), _render(render), _max_in_flight(num_workers * CHUNKS_IN_FLIGHT_PER_WORKER)
+{
+  _outfile.open(outfile_name, std::ofstream::out | std::ofstream::binary);
+
+  if (num_workers == 0)
+  {
+    _inline_buffer.reserve(WRITE_BLOCK_SIZE);
+    return;
+  }
+
+  _pending.reserve(EVENTS_PER_CHUNK);
+  for (size_t i = 0; i < num_workers; ++i) { _workers.emplace_back(&dsjson_writer::worker_loop, this); }
+  _writer = std::thread(&dsjson_writer::writer_loop, this);
+}
+
+dsjson_writer::~dsjson_writer()
+{
+  flush();
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _shutdown = true;
+  }
+  _work_cv.notify_all();
+  _ready_cv.notify_all();
+  for (auto& worker : _workers) { worker.join(); }
+  if (_writer.joinable()) { _writer.join(); }
+  _outfile.close();
+}
+
+void dsjson_writer::submit(joined_event::joined_event&& je)
+{
+  if (_workers.empty())
+  {
+    _render(_inline_buffer, je, _logger);
+    if (_inline_buffer.size() >= WRITE_BLOCK_SIZE)
+    {
+      _outfile.write(_inline_buffer.data(), _inline_buffer.size());
+      _inline_buffer.clear();
+    }
+    return;
+  }
+
+  _pending.push_back(std::move(je));
+  if (_pending.size() >= EVENTS_PER_CHUNK) { dispatch_pending(); }
+}
+
+void dsjson_writer::flush()
+{
+  if (_workers.empty())
+  {
+    _outfile.write(_inline_buffer.data(), _inline_buffer.size());
+    _inline_buffer.clear();
+    _outfile.flush();
+    return;
+  }
+
+  dispatch_pending();
+  std::unique_lock<std::mutex> lock(_mutex);
+  _written_cv.wait(lock, [this] { return _next_to_write == _next_sequence; });
+  // the writer thread is idle until the next chunk is dispatched
+  _outfile.flush();
+}
+
+void dsjson_writer::dispatch_pending()
+{
+  if (_pending.empty()) { return; }
+
+  std::unique_ptr<chunk> next;
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _written_cv.wait(lock, [this] { return _next_sequence - _next_to_write < _max_in_flight; });
+
+    if (_free_chunks.empty()) { next.reset(new chunk()); }
+    else
+    {
+      next = std::move(_free_chunks.back());
+      _free_chunks.pop_back();
+    }
+
+    // hand the pending events over and keep the (empty) recycled vector for the next chunk
+    next->events.swap(_pending);
+    next->sequence = _next_sequence++;
+    _work.push_back(std::move(next));
+  }
+  _work_cv.notify_one();
+}
+
+void dsjson_writer::worker_loop()
+{
+  while (true)
+  {
+    std::unique_ptr<chunk> current;
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _work_cv.wait(lock, [this] { return _shutdown || !_work.empty(); });
+      if (_work.empty()) { return; }
+      current = std::move(_work.front());
+      _work.pop_front();
+    }
+
+    for (auto& je : current->events) { _render(current->output, je, _logger); }
+    current->events.clear();
+
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      const auto sequence = current->sequence;
+      _ready.emplace(sequence, std::move(current));
+    }
+    _ready_cv.notify_one();
+  }
+}
+
+void dsjson_writer::writer_loop()
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (true)
+  {
+    _ready_cv.wait(lock, [this] { return _shutdown || _ready.find(_next_to_write) != _ready.end(); });
+    auto it = _ready.find(_next_to_write);
+    if (it == _ready.end())
+    {
+      // shutdown is only requested once everything was flushed
+      return;
+    }
+
+    auto current = std::move(it->second);
+    _ready.erase(it);
+
+    lock.unlock();
+    _outfile.write(current->output.data(), current->output.size());
+    current->output.clear();
+    lock.lock();
+
+    _free_chunks.push_back(std::move(current));
+    ++_next_to_write;
+    _written_cv.notify_all();
+  }
+}
 }  // namespace log_converter
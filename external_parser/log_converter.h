@@ -7,17 +7,110 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace v2 = reinforcement_learning::messages::flatbuff::v2;
 
 namespace log_converter
 {
-void build_json(std::ofstream& outfile, joined_event::joined_event& je, VW::io::logger& logger);
-void build_cb_json(std::ofstream& outfile, joined_event::joined_event& je, VW::io::logger& logger);
-void build_ccb_json(std::ofstream& outfile, joined_event::joined_event& je, VW::io::logger& logger);
-void build_ca_json(std::ofstream& outfile, joined_event::joined_event& je, VW::io::logger& logger);
-void build_slates_json(std::ofstream& outfile, joined_event::joined_event& je, VW::io::logger& logger);
-;
+// Each builder appends a single newline terminated dsjson line to out
+void build_json(std::string& out, joined_event::joined_event& je, VW::io::logger& logger);
+void build_cb_json(std::string& out, joined_event::joined_event& je, VW::io::logger& logger);
+void build_ccb_json(std::string& out, joined_event::joined_event& je, VW::io::logger& logger);
+void build_ca_json(std::string& out, joined_event::joined_event& je, VW::io::logger& logger);
+void build_slates_json(std::string& out, joined_event::joined_event& je, VW::io::logger& logger);
+
+// Receives joined events in the order in which the joiner produced them
+class joined_event_writer
+{
+public:
+  virtual ~joined_event_writer() = default;
+  // takes ownership of the joined event
+  virtual void submit(joined_event::joined_event&& je) = 0;
+  // writes out everything still buffered, nothing is submitted afterwards
+  virtual void finish() = 0;
+};
+
+// Submits je from a destructor, e.g. a scope_exit guard, where an exception would terminate the process. Returns
+// false once the error is logged if the writer threw, the caller has to report it outside of the destructor.
+bool submit_noexcept(joined_event_writer& writer, joined_event::joined_event&& je, VW::io::logger& logger) noexcept;
+
+/*
+dsjson_writer
+Converts joined events to dsjson lines and writes them to the output file in
+the order in which they were submitted.
+
+With num_workers == 0 events are converted on the calling thread.
+Otherwise submitted events are grouped into chunks that are rendered in
+parallel by num_workers threads, each chunk into its own buffer. A separate
+writer thread emits the rendered chunks in submission order using one block
+write per chunk.
+*/
+class dsjson_writer : public joined_event_writer
+{
+public:
+  using render_fn = void (*)(std::string&, joined_event::joined_event&, VW::io::logger&);
+
+  static constexpr size_t EVENTS_PER_CHUNK = 256;
+  static constexpr size_t CHUNKS_IN_FLIGHT_PER_WORKER = 4;
+  static constexpr size_t WRITE_BLOCK_SIZE = 1 << 20;
+
+  dsjson_writer(
+      const std::string& outfile_name, size_t num_workers, VW::io::logger logger, render_fn render = &build_json);
+  ~dsjson_writer() override;
+
+  dsjson_writer(const dsjson_writer&) = delete;
+  dsjson_writer& operator=(const dsjson_writer&) = delete;
+
+  // blocks while too many chunks are in flight
+  void submit(joined_event::joined_event&& je) override;
+  void finish() override { flush(); }
+  // blocks until everything submitted so far has been written to the output file
+  void flush();
+
+private:
+  struct chunk
+  {
+    uint64_t sequence = 0;
+    std::vector<joined_event::joined_event> events;
+    std::string output;
+  };
+
+  void dispatch_pending();
+  void worker_loop();
+  void writer_loop();
+
+  std::ofstream _outfile;
+  VW::io::logger _logger;
+  render_fn _render;
+  size_t _max_in_flight;
+
+  // only touched by the submitting thread
+  std::vector<joined_event::joined_event> _pending;
+  std::string _inline_buffer;
+
+  std::mutex _mutex;
+  std::condition_variable _work_cv;
+  std::condition_variable _ready_cv;
+  std::condition_variable _written_cv;
+  std::deque<std::unique_ptr<chunk>> _work;
+  std::map<uint64_t, std::unique_ptr<chunk>> _ready;
+  std::vector<std::unique_ptr<chunk>> _free_chunks;
+  uint64_t _next_sequence = 0;
+  uint64_t _next_to_write = 0;
+  bool _shutdown = false;
+
+  std::vector<std::thread> _workers;
+  std::thread _writer;
+};
 }  // namespace log_converter
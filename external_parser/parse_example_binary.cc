@@ -333,9 +333,12 @@ bool binary_parser::advance_to_next_payload_type(io_buf& input, unsigned int& pa
 
 void binary_parser::persist_metrics(metric_sink& sink) { _example_joiner->persist_metrics(sink); }
 
+void binary_parser::flush() { _example_joiner->flush(); }
+
 bool binary_parser::parse_examples(VW::workspace*, io_buf& io_buf, VW::multi_ex& examples)
 {
   if (process_next_in_batch(examples)) { return true; }
+  if (_end_of_input) { return false; }
 
   unsigned int payload_type;
   while (advance_to_next_payload_type(io_buf, payload_type))
@@ -366,9 +369,15 @@ bool binary_parser::parse_examples(VW::workspace*, io_buf& io_buf, VW::multi_ex&
         }
         break;
       }
+      case MSG_TYPE_INDEX:
+      {
+        // the footer index is only used to seek, see binary_index.h
+        if (!skip_over_unknown_payload(io_buf)) { return false; }
+        break;
+      }
       case MSG_TYPE_EOF:
       {
-        return false;
+        return process_end_of_input(examples);
       }
 
       default:
@@ -383,7 +392,14 @@ bool binary_parser::parse_examples(VW::workspace*, io_buf& io_buf, VW::multi_ex&
     }
   }
 
-  return false;
+  return process_end_of_input(examples);
+}
+
+bool binary_parser::process_end_of_input(VW::multi_ex& examples)
+{
+  _end_of_input = true;
+  _example_joiner->on_end_of_input();
+  return process_next_in_batch(examples);
 }
 }  // namespace external
 }  // namespace VW
@@ -14,6 +14,8 @@ constexpr unsigned int MSG_TYPE_HEADER = 0x55555555;
 constexpr unsigned int MSG_TYPE_REGULAR = 0xFFFFFFFF;
 constexpr unsigned int MSG_TYPE_CHECKPOINT = 0x11111111;
 constexpr unsigned int MSG_TYPE_EOF = 0xAAAAAAAA;
+constexpr unsigned int MSG_TYPE_INDEX = 0x22222222;
+constexpr unsigned int INDEX_TRAILER_MAGIC = 0x49465756;  //'VWFI'
 
 namespace VW
 {
@@ -32,13 +34,18 @@ public:
   bool skip_over_unknown_payload(io_buf& input);
   bool advance_to_next_payload_type(io_buf& input, unsigned int& payload_type);
   void persist_metrics(metric_sink& metrics) override;
+  // write out anything the joiner has still buffered, call once parsing is done
+  void flush();
 
 private:
   bool process_next_in_batch(VW::multi_ex& examples);
+  // lets the joiner release events held back across batches once the input is exhausted
+  bool process_end_of_input(VW::multi_ex& examples);
   std::unique_ptr<i_joiner> _example_joiner;
   char* _payload;
   uint32_t _payload_size;
   uint64_t _total_size_read;
+  bool _end_of_input = false;
 };
 }  // namespace external
 }  // namespace VW
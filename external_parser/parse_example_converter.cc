@@ -24,6 +24,8 @@ bool binary_json_converter::parse_examples(VW::workspace* all, io_buf& io_buf, V
   {
     // do nothing
   }
+  // make sure all converted events are on disk before reporting the end of the input
+  _parser.flush();
   // vw will not learn, just exit
   return false;
 }
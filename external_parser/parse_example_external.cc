@@ -2,8 +2,11 @@
 // individual contributors. All rights reserved. Released under a BSD (revised)
 // license as described in the file LICENSE.
 
+#include "binary_index.h"
+#include "date.h"
 #include "joiners/example_joiner.h"
 #include "joiners/multistep_example_joiner.h"
+#include "log_converter.h"
 #include "parse_example_binary.h"
 #include "parse_example_converter.h"
 #include "utils.h"
@@ -13,6 +16,11 @@
 
 #include <cstdio>
 #include <memory>
+#include <sstream>
+
+#ifdef RL_BUILD_ARROW_EXPORT
+#  include "columnar_writer.h"
+#endif
 
 namespace VW
 {
@@ -42,6 +50,72 @@ std::map<const char*, v2::LearningModeType> const learning_modes = {{
 
 bool parser_options::is_enabled() { return binary; }
 
+std::unique_ptr<log_converter::joined_event_writer> make_columnar_writer(
+    const std::string& infile_name, const parser_options& parsed_options, VW::io::logger logger)
+{
+#ifdef RL_BUILD_ARROW_EXPORT
+  if (parsed_options.binary_to_parquet)
+  {
+    return VW::make_unique<log_converter::columnar_writer>(
+        infile_name + ".parquet", log_converter::columnar_writer::format::parquet, std::move(logger));
+  }
+  return VW::make_unique<log_converter::columnar_writer>(
+      infile_name + ".arrow", log_converter::columnar_writer::format::arrow_ipc, std::move(logger));
+#else
+  static_cast<void>(infile_name);
+  static_cast<void>(parsed_options);
+  static_cast<void>(logger);
+  throw std::runtime_error(
+      "--binary_to_parquet and --binary_to_arrow require the parser to be built with RL_BUILD_ARROW_EXPORT");
+#endif
+}
+
+TimePoint parse_time_option(const std::string& value, const char* option_name)
+{
+  TimePoint tp;
+  std::istringstream in(value);
+  in >> date::parse("%FT%TZ", tp);
+  if (in.fail()) { throw std::runtime_error(std::string("Invalid argument to --") + option_name + " " + value); }
+  return tp;
+}
+
+// Replaces the data file with the slice of it selected by --binary_time_start,
+// --binary_time_end, --binary_slice and --binary_num_slices using its footer index
+void select_binary_slice(VW::workspace* all, const parser_options& parsed_options)
+{
+  const bool time_range = all->options->was_supplied("binary_time_start") ||
+      all->options->was_supplied("binary_time_end");
+  if (!time_range && !all->options->was_supplied("binary_num_slices")) { return; }
+
+  if (parsed_options.binary_num_slices == 0 || parsed_options.binary_slice >= parsed_options.binary_num_slices)
+  {
+    throw std::runtime_error("--binary_slice must be smaller than --binary_num_slices");
+  }
+
+  const auto& infile_path = all->parser_runtime.data_filename;
+  std::vector<index_entry> entries;
+  if (!read_index(infile_path, entries, all->logger))
+  {
+    throw std::runtime_error("input file " + infile_path + " has no index, it can be added with rl_binary_indexer");
+  }
+
+  const auto start = all->options->was_supplied("binary_time_start")
+      ? parse_time_option(parsed_options.binary_time_start, "binary_time_start")
+      : TimePoint::min();
+  const auto end = all->options->was_supplied("binary_time_end")
+      ? parse_time_option(parsed_options.binary_time_end, "binary_time_end")
+      : TimePoint::max();
+
+  auto slices = make_slices(entries, parsed_options.binary_num_slices, start, end);
+  // fewer slices than requested when the range only covers a few messages, the remaining ones are empty
+  file_slice slice;
+  if (parsed_options.binary_slice < slices.size()) { slice = slices[parsed_options.binary_slice]; }
+
+  auto& input = all->parser_runtime.example_parser->input;
+  input.close_files();
+  input.add_file(open_slice(infile_path, slice));
+}
+
 void apply_cli_overrides(std::unique_ptr<i_joiner>& joiner, VW::workspace* all, const parser_options& parsed_options)
 {
   if (all->options->was_supplied("default_reward")) { joiner->set_default_reward(parsed_options.default_reward, true); }
@@ -85,8 +159,14 @@ std::unique_ptr<parser> parser::get_external_parser(VW::workspace* all, const pa
   if (parsed_options.binary)
   {
     bool binary_to_json = parsed_options.binary_to_json;
+    bool binary_to_columnar = parsed_options.binary_to_parquet || parsed_options.binary_to_arrow;
+    if ((binary_to_json && binary_to_columnar) || (parsed_options.binary_to_parquet && parsed_options.binary_to_arrow))
+    {
+      throw std::runtime_error(
+          "only one of --binary_to_json, --binary_to_parquet and --binary_to_arrow can be supplied");
+    }
     std::unique_ptr<i_joiner> joiner(nullptr);
-    if (binary_to_json)
+    if (binary_to_json || binary_to_columnar)
     {
       const auto& infile_path = all->parser_runtime.data_filename;
       const auto& infile_name = infile_path.substr(0, infile_path.find_last_of('.'));
@@ -95,18 +175,22 @@ std::unique_ptr<parser> parser::get_external_parser(VW::workspace* all, const pa
       if (infile_extension == "dsjson")
       {
         throw std::runtime_error(
-            "input file for --binary_to_json option should"
+            "input file for --binary_to_json, --binary_to_parquet and --binary_to_arrow options should"
             " be binary format, file provided: " +
             infile_path);
       }
 
-      std::string outfile_name = infile_name + ".dsjson";
-
-      if (parsed_options.multistep)
+      std::unique_ptr<log_converter::joined_event_writer> writer;
+      if (binary_to_columnar) { writer = make_columnar_writer(infile_name, parsed_options, all->logger); }
+      else
       {
-        joiner = VW::make_unique<multistep_example_joiner>(all, binary_to_json, outfile_name);
+        writer = VW::make_unique<log_converter::dsjson_writer>(infile_name + ".dsjson",
+            parsed_options.binary_to_json_threads, all->logger,
+            parsed_options.multistep ? &log_converter::build_cb_json : &log_converter::build_json);
       }
-      else { joiner = VW::make_unique<example_joiner>(all, binary_to_json, outfile_name); }
+
+      if (parsed_options.multistep) { joiner = VW::make_unique<multistep_example_joiner>(all, std::move(writer)); }
+      else { joiner = VW::make_unique<example_joiner>(all, std::move(writer)); }
       apply_cli_overrides(joiner, all, parsed_options);
 
       return VW::make_unique<binary_json_converter>(std::move(joiner), all->logger);
@@ -135,7 +219,22 @@ void parser::set_parse_args(VW::config::option_group_definition& in_options, par
                    std::to_string(BINARY_PARSER_VERSION)))
       .add(VW::config::make_option("binary_to_json", parsed_options.binary_to_json)
                .help("convert binary joined log into dsjson format"))
+      .add(VW::config::make_option("binary_to_json_threads", parsed_options.binary_to_json_threads)
+               .default_value(0)
+               .help("number of threads rendering dsjson in parallel for --binary_to_json, output order is "
+                     "preserved. 0 converts on the parser thread"))
+      .add(VW::config::make_option("binary_to_parquet", parsed_options.binary_to_parquet)
+               .help("convert binary joined log into a columnar parquet file"))
+      .add(VW::config::make_option("binary_to_arrow", parsed_options.binary_to_arrow)
+               .help("convert binary joined log into a columnar arrow ipc file"))
       .add(VW::config::make_option("multistep", parsed_options.multistep).help("multistep binary joiner"))
+      .add(VW::config::make_option("multistep_streaming", parsed_options.multistep_streaming)
+               .help("join multistep episodes as soon as they are closed instead of per JoinedPayload, memory is "
+                     "bounded by the number of open episodes"))
+      .add(VW::config::make_option("multistep_episode_timeout", parsed_options.multistep_episode_timeout)
+               .default_value(300)
+               .help("with --multistep_streaming, an episode is closed once an event enqueued this many seconds "
+                     "after its last event is read"))
       .add(VW::config::make_option("multistep_reward", parsed_options.multistep_reward)
                .help("Override multistep reward function to be used, valid values: suffix_mean (default), suffix_sum, "
                      "identity"))
@@ -149,7 +248,20 @@ void parser::set_parse_args(VW::config::option_group_definition& in_options, par
       .add(VW::config::make_option("reward_function", parsed_options.reward_function)
                .help("Override the reward function to be used, valid values: earliest, average, median, sum, min, max"))
       .add(VW::config::make_option("learning_mode", parsed_options.learning_mode)
-               .help("Override the learning mode from the file, valid values: Online, Apprentice, LoggingOnly"));
+               .help("Override the learning mode from the file, valid values: Online, Apprentice, LoggingOnly"))
+      .add(VW::config::make_option("binary_time_start", parsed_options.binary_time_start)
+               .help("only read messages with events at or after this time, format: YYYY-MM-DDTHH:MM:SSZ. Requires "
+                     "an indexed binary file"))
+      .add(VW::config::make_option("binary_time_end", parsed_options.binary_time_end)
+               .help("only read messages with events at or before this time, format: YYYY-MM-DDTHH:MM:SSZ. Requires "
+                     "an indexed binary file"))
+      .add(VW::config::make_option("binary_num_slices", parsed_options.binary_num_slices)
+               .default_value(1)
+               .help("split the selected messages of an indexed binary file into this many slices of similar size "
+                     "that can be processed independently"))
+      .add(VW::config::make_option("binary_slice", parsed_options.binary_slice)
+               .default_value(0)
+               .help("zero based slice of the indexed binary file to read, see --binary_num_slices"));
 }
 
 void parser::persist_metrics(metric_sink& metric_sink) { metric_sink.set_uint("external_parser", 1); }
@@ -173,6 +285,7 @@ std::unique_ptr<VW::workspace> initialize_with_binary_parser(std::unique_ptr<con
   // Do binary parser specific setup if the binary parser is enabled.
   if (parsed_options.is_enabled())
   {
+    select_binary_slice(all.get(), parsed_options);
     auto external_parser = VW::external::parser::get_external_parser(all.get(), parsed_options);
     auto* external_parser_ptr = external_parser.get();
     // The metric hook will only get called if the workspace is still alive,
@@ -18,13 +18,22 @@ struct parser_options
   bool is_enabled();
   bool binary;
   bool binary_to_json;
+  uint32_t binary_to_json_threads;
+  bool binary_to_parquet;
+  bool binary_to_arrow;
   bool multistep;
   float default_reward;
   std::string multistep_reward;
+  bool multistep_streaming;
+  uint32_t multistep_episode_timeout;
   std::string problem_type;
   std::string reward_function;
   std::string learning_mode;
   bool use_client_time;
+  std::string binary_time_start;
+  std::string binary_time_end;
+  uint32_t binary_slice;
+  uint32_t binary_num_slices;
 };
 
 int parse_examples(VW::workspace* all, io_buf& io_buf, VW::multi_ex& examples);
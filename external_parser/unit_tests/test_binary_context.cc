@@ -0,0 +1,100 @@
+#include <boost/test/unit_test.hpp>
+
+#include "event_processors/binary_context.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Same layout as structured_input::add_tensor in the client library
+class framing
+{
+public:
+  framing()
+  {
+    append_u32(0x31544E52);
+    append_u32(0);
+  }
+
+  void add_tensor(const std::string& name, const std::vector<int64_t>& dimensions, const std::vector<float>& values)
+  {
+    append_u32(static_cast<uint32_t>(name.size()));
+    append_u32(static_cast<uint32_t>(dimensions.size()));
+    append(name.data(), name.size());
+    pad(1);
+    append(dimensions.data(), dimensions.size() * sizeof(int64_t));
+    append(values.data(), values.size() * sizeof(float));
+    pad(0);
+    const uint32_t count = ++_count;
+    std::memcpy(&bytes[sizeof(uint32_t)], &count, sizeof(count));
+  }
+
+  std::vector<uint8_t> bytes;
+
+private:
+  void append(const void* data, size_t size)
+  {
+    const auto* begin = static_cast<const uint8_t*>(data);
+    bytes.insert(bytes.end(), begin, begin + size);
+  }
+  void append_u32(uint32_t value) { append(&value, sizeof(value)); }
+  // at least min_size zero bytes, up to a multiple of 8
+  void pad(size_t min_size) { bytes.resize((bytes.size() + min_size + 7) & ~size_t(7), 0); }
+
+  uint32_t _count = 0;
+};
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(binary_context_to_tensor_notation)
+{
+  framing input;
+  input.add_tensor("a", {2}, {0.5f, 1.5f});
+  input.add_tensor("features", {1, 3}, {1.f, 2.f, 3.f});
+  input.add_tensor("scalar", {}, {});
+
+  std::string json;
+  std::string error;
+  BOOST_REQUIRE(binary_tensors_to_json(input.bytes.data(), input.bytes.size(), &json, error));
+  BOOST_CHECK_EQUAL(json,
+      R"({"a":"AgAAAAAAAAA=;AAAAPwAAwD8=","features":"AQAAAAAAAAADAAAAAAAAAA==;AACAPwAAAEAAAEBA","scalar":";"})");
+
+  // validation only
+  BOOST_CHECK(binary_tensors_to_json(input.bytes.data(), input.bytes.size(), nullptr, error));
+}
+
+BOOST_AUTO_TEST_CASE(binary_context_empty)
+{
+  framing input;
+  std::string json;
+  std::string error;
+  BOOST_REQUIRE(binary_tensors_to_json(input.bytes.data(), input.bytes.size(), &json, error));
+  BOOST_CHECK_EQUAL(json, "{}");
+}
+
+BOOST_AUTO_TEST_CASE(binary_context_malformed)
+{
+  framing input;
+  input.add_tensor("features", {1, 3}, {1.f, 2.f, 3.f});
+  std::string error;
+
+  // json context
+  const std::string text = R"({"features":"AQAAAAAAAAADAAAAAAAAAA==;AACAPwAAAEAAAEBA"})";
+  BOOST_CHECK(!binary_tensors_to_json(reinterpret_cast<const uint8_t*>(text.data()), text.size(), nullptr, error));
+
+  // truncated values
+  BOOST_CHECK(!binary_tensors_to_json(input.bytes.data(), input.bytes.size() - 8, nullptr, error));
+  BOOST_CHECK_EQUAL(error, "values of tensor 0 are truncated");
+
+  // trailing bytes
+  auto trailing = input.bytes;
+  trailing.resize(trailing.size() + 8, 0);
+  BOOST_CHECK(!binary_tensors_to_json(trailing.data(), trailing.size(), nullptr, error));
+
+  // a name that can not be written in the tensor notation
+  framing quoted;
+  quoted.add_tensor("a\"b", {1}, {1.f});
+  BOOST_CHECK(!binary_tensors_to_json(quoted.bytes.data(), quoted.bytes.size(), nullptr, error));
+  BOOST_CHECK_EQUAL(error, "invalid name for tensor 0");
+}
@@ -0,0 +1,138 @@
+#include <boost/test/unit_test.hpp>
+
+#include "binary_index.h"
+#include "parse_example_binary.h"
+#include "parse_example_external.h"
+#include "test_common.h"
+#include "vw/config/options_cli.h"
+#include "vw/core/parse_primitives.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+namespace
+{
+std::string make_indexed_copy(const std::string& infile_path, const std::string& outfile_path)
+{
+  std::string outfile_name = get_test_files_location() + outfile_path;
+  {
+    std::ifstream in(get_test_files_location() + infile_path, std::ios::binary);
+    std::ofstream out(outfile_name, std::ios::binary | std::ios::trunc);
+    out << in.rdbuf();
+  }
+  auto logger = VW::io::create_null_logger();
+  BOOST_REQUIRE(VW::external::append_index(outfile_name, logger));
+  return outfile_name;
+}
+
+size_t count_examples(const std::string& infile_name, const std::string& extra_args = "")
+{
+  std::string command = "--quiet --binary_parser --cb_explore_adf -d " + infile_name + extra_args;
+  auto options = VW::make_unique<VW::config::options_cli>(VW::split_command_line(command));
+  auto vw = VW::external::initialize_with_binary_parser(std::move(options));
+
+  size_t count = 0;
+  VW::multi_ex examples;
+  examples.push_back(VW::new_unused_example(*vw));
+  while (vw->parser_runtime.example_parser->reader(vw.get(), vw->parser_runtime.example_parser->input, examples) > 0)
+  {
+    ++count;
+    clear_examples(examples, vw.get());
+    examples.push_back(VW::new_unused_example(*vw));
+  }
+  clear_examples(examples, vw.get());
+  VW::finish(*vw, false);
+  return count;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(binary_index_tests)
+BOOST_AUTO_TEST_CASE(indexed_file_parses_like_the_original)
+{
+  const std::string original = "valid_joined_logs/average_reward_100_interactions.fb";
+  const auto indexed = make_indexed_copy(original, "test_outputs/average_reward_100_interactions_indexed.fb");
+
+  auto logger = VW::io::create_null_logger();
+  std::vector<VW::external::index_entry> entries;
+  BOOST_REQUIRE(VW::external::read_index(indexed, entries, logger));
+  BOOST_REQUIRE(!entries.empty());
+  BOOST_CHECK_EQUAL(entries.front().message_type, MSG_TYPE_HEADER);
+
+  // indexing an already indexed file is a no-op
+  BOOST_REQUIRE(VW::external::append_index(indexed, logger));
+  std::vector<VW::external::index_entry> entries_again;
+  BOOST_REQUIRE(VW::external::read_index(indexed, entries_again, logger));
+  BOOST_CHECK_EQUAL(entries.size(), entries_again.size());
+
+  BOOST_CHECK_EQUAL(count_examples(get_test_files_location() + original), count_examples(indexed));
+}
+
+BOOST_AUTO_TEST_CASE(unindexed_file_has_no_index)
+{
+  auto logger = VW::io::create_null_logger();
+  std::vector<VW::external::index_entry> entries;
+  BOOST_CHECK(!VW::external::read_index(
+      get_test_files_location() + "valid_joined_logs/average_reward_100_interactions.fb", entries, logger));
+  BOOST_CHECK_THROW(count_examples(get_test_files_location() + "valid_joined_logs/average_reward_100_interactions.fb",
+                        " --binary_num_slices 2"),
+      std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(slices_cover_the_whole_file)
+{
+  // two checkpoints with a regular message each
+  const auto indexed = make_indexed_copy(
+      "valid_joined_logs/average_reward_100_interactions.fb", "test_outputs/average_reward_slices_indexed.fb");
+  const size_t total = count_examples(indexed);
+
+  for (size_t num_slices : {1, 2, 3})
+  {
+    size_t sliced_total = 0;
+    for (size_t i = 0; i < num_slices; ++i)
+    {
+      sliced_total += count_examples(indexed,
+          " --binary_num_slices " + std::to_string(num_slices) + " --binary_slice " + std::to_string(i));
+    }
+    BOOST_CHECK_EQUAL(sliced_total, total);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(slices_start_with_a_checkpoint)
+{
+  const auto indexed = make_indexed_copy(
+      "valid_joined_logs/average_reward_100_interactions.fb", "test_outputs/average_reward_checkpoint_indexed.fb");
+  auto logger = VW::io::create_null_logger();
+  std::vector<VW::external::index_entry> entries;
+  BOOST_REQUIRE(VW::external::read_index(indexed, entries, logger));
+
+  auto slices = VW::external::make_slices(entries, 4, TimePoint::min(), TimePoint::max());
+  BOOST_REQUIRE_EQUAL(slices.size(), 2);
+  for (size_t i = 0; i < slices.size(); ++i)
+  {
+    BOOST_CHECK(slices[i].checkpoint_offset != VW::external::file_slice::NO_CHECKPOINT);
+    BOOST_CHECK_LT(slices[i].begin, slices[i].end);
+    if (i > 0) { BOOST_CHECK_LE(slices[i - 1].end, slices[i].checkpoint_offset); }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(time_range_selects_messages)
+{
+  const auto indexed = make_indexed_copy(
+      "valid_joined_logs/average_reward_100_interactions.fb", "test_outputs/average_reward_time_range_indexed.fb");
+  auto logger = VW::io::create_null_logger();
+  std::vector<VW::external::index_entry> entries;
+  BOOST_REQUIRE(VW::external::read_index(indexed, entries, logger));
+
+  auto earliest = TimePoint::max();
+  for (const auto& entry : entries)
+  {
+    if (entry.message_type == MSG_TYPE_REGULAR) { earliest = std::min(earliest, entry.first_event_time); }
+  }
+  BOOST_CHECK(VW::external::make_slices(entries, 1, TimePoint::min(), earliest - std::chrono::hours(1)).empty());
+  BOOST_CHECK_EQUAL(VW::external::make_slices(entries, 1, earliest, earliest).size(), 1);
+
+  BOOST_CHECK_EQUAL(
+      count_examples(indexed, " --binary_time_start 1970-01-01T00:00:00Z"), count_examples(indexed));
+}
+BOOST_AUTO_TEST_SUITE_END()
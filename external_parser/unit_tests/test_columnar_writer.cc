@@ -0,0 +1,107 @@
+#include <boost/test/unit_test.hpp>
+
+#include "columnar_writer.h"
+#include "parse_example_external.h"
+#include "test_common.h"
+#include "vw/config/options_cli.h"
+#include "vw/core/parse_primitives.h"
+
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
+#include <parquet/arrow/reader.h>
+
+#include <stdio.h>
+
+namespace
+{
+void convert(const std::string& infile_name, const std::string& extra_args)
+{
+  std::string command = "--quiet --binary_parser --cb_explore_adf -d " + infile_name + extra_args;
+  auto options = VW::make_unique<VW::config::options_cli>(VW::split_command_line(command));
+  auto vw = VW::external::initialize_with_binary_parser(std::move(options));
+
+  VW::multi_ex examples;
+  examples.push_back(VW::new_unused_example(*vw));
+  while (vw->parser_runtime.example_parser->reader(vw.get(), vw->parser_runtime.example_parser->input, examples) > 0)
+  {
+    examples.push_back(VW::new_unused_example(*vw));
+  }
+  clear_examples(examples, vw.get());
+  VW::finish(*vw, false);
+}
+
+void check_cb_simple_table(const arrow::Table& table)
+{
+  BOOST_REQUIRE_EQUAL(table.num_rows(), 1);
+
+  auto event_ids = std::static_pointer_cast<arrow::StringArray>(table.GetColumnByName("event_id")->chunk(0));
+  BOOST_CHECK_EQUAL(event_ids->GetString(0), "91f71c8");
+
+  auto actions = std::static_pointer_cast<arrow::ListArray>(table.GetColumnByName("actions")->chunk(0));
+  auto slots = std::static_pointer_cast<arrow::ListArray>(actions->values());
+  auto action_ids = std::static_pointer_cast<arrow::UInt32Array>(slots->values());
+  BOOST_REQUIRE_EQUAL(slots->length(), 1);
+  BOOST_REQUIRE_EQUAL(action_ids->length(), 2);
+  BOOST_CHECK_EQUAL(action_ids->Value(0), 1);
+  BOOST_CHECK_EQUAL(action_ids->Value(1), 2);
+
+  auto rewards = std::static_pointer_cast<arrow::ListArray>(table.GetColumnByName("rewards")->chunk(0));
+  auto reward_values = std::static_pointer_cast<arrow::FloatArray>(rewards->values());
+  BOOST_REQUIRE_EQUAL(reward_values->length(), 1);
+  BOOST_CHECK_CLOSE(reward_values->Value(0), 1.5f, FLOAT_TOL);
+
+  auto pdf_values = table.GetColumnByName("pdf_value")->chunk(0);
+  BOOST_CHECK(pdf_values->IsNull(0));
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(columnar_writer_tests)
+BOOST_AUTO_TEST_CASE(cb_to_arrow_ipc)
+{
+  std::string infile_name = get_test_files_location() + "valid_joined_logs/cb_simple.log";
+  std::string outfile_name = get_test_files_location() + "valid_joined_logs/cb_simple.arrow";
+  convert(infile_name, " --binary_to_arrow");
+
+  auto input = arrow::io::ReadableFile::Open(outfile_name);
+  BOOST_REQUIRE(input.ok());
+  auto reader = arrow::ipc::RecordBatchFileReader::Open(*input);
+  BOOST_REQUIRE(reader.ok());
+
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  for (int i = 0; i < (*reader)->num_record_batches(); ++i) { batches.push_back(*(*reader)->ReadRecordBatch(i)); }
+  auto table = arrow::Table::FromRecordBatches(log_converter::columnar_writer::schema(), batches);
+  BOOST_REQUIRE(table.ok());
+  BOOST_CHECK((*table)->schema()->Equals(*log_converter::columnar_writer::schema()));
+  check_cb_simple_table(**table);
+
+  remove(outfile_name.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(cb_to_parquet)
+{
+  std::string infile_name = get_test_files_location() + "valid_joined_logs/cb_simple.log";
+  std::string outfile_name = get_test_files_location() + "valid_joined_logs/cb_simple.parquet";
+  convert(infile_name, " --binary_to_parquet");
+
+  auto input = arrow::io::ReadableFile::Open(outfile_name);
+  BOOST_REQUIRE(input.ok());
+  std::unique_ptr<parquet::arrow::FileReader> reader;
+  BOOST_REQUIRE(parquet::arrow::OpenFile(*input, arrow::default_memory_pool(), &reader).ok());
+
+  std::shared_ptr<arrow::Table> table;
+  BOOST_REQUIRE(reader->ReadTable(&table).ok());
+  auto combined = table->CombineChunks();
+  BOOST_REQUIRE(combined.ok());
+  check_cb_simple_table(**combined);
+
+  remove(outfile_name.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(conversion_outputs_are_exclusive)
+{
+  std::string infile_name = get_test_files_location() + "valid_joined_logs/cb_simple.log";
+  BOOST_CHECK_THROW(convert(infile_name, " --binary_to_json --binary_to_arrow"), std::runtime_error);
+  BOOST_CHECK_THROW(convert(infile_name, " --binary_to_json --binary_to_parquet"), std::runtime_error);
+  BOOST_CHECK_THROW(convert(infile_name, " --binary_to_parquet --binary_to_arrow"), std::runtime_error);
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,14 +1,18 @@
 #include <boost/test/unit_test.hpp>
 
+#include "log_converter.h"
 #include "parse_example_external.h"
 #include "test_common.h"
 #include "vw/config/options_cli.h"
 #include "vw/core/parse_primitives.h"
 
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
 #include <stdio.h>
 
-std::string get_json_event(
-    std::string infile_path, std::string outfile_path, v2::ProblemType problem_type = v2::ProblemType_CB)
+std::string get_json_event(std::string infile_path, std::string outfile_path,
+    v2::ProblemType problem_type = v2::ProblemType_CB, const std::string& extra_args = "")
 {
   std::string infile_name = get_test_files_location() + infile_path;
   std::string command;
@@ -38,6 +42,8 @@ std::string get_json_event(
       break;
   }
 
+  command += extra_args;
+
   auto options = VW::make_unique<VW::config::options_cli>(VW::split_command_line(command));
   auto vw = VW::external::initialize_with_binary_parser(std::move(options));
 
@@ -403,3 +409,97 @@ BOOST_AUTO_TEST_CASE(convert_binary_to_dsjson_multistep_unordered)
   BOOST_CHECK_EQUAL(converted_json, expected_joined_json);
 }
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(log_converter_parallel)
+BOOST_AUTO_TEST_CASE(parallel_cb_conversion_matches_sequential)
+{
+  std::string infile_path = "valid_joined_logs/average_reward_100_interactions.fb";
+  std::string outfile_path = "valid_joined_logs/average_reward_100_interactions.dsjson";
+
+  std::string sequential_json = get_json_event(infile_path, outfile_path);
+  for (const auto* threads : {" --binary_to_json_threads 1", " --binary_to_json_threads 4"})
+  {
+    std::string parallel_json = get_json_event(infile_path, outfile_path, v2::ProblemType_CB, threads);
+    BOOST_CHECK(!parallel_json.empty());
+    BOOST_CHECK_EQUAL(parallel_json, sequential_json);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(parallel_ccb_conversion_matches_sequential)
+{
+  std::string infile_path = "valid_joined_logs/ccb_sum_reward_100_interactions.fb";
+  std::string outfile_path = "valid_joined_logs/ccb_sum_reward_100_interactions.dsjson";
+
+  std::string sequential_json = get_json_event(infile_path, outfile_path, v2::ProblemType_CCB);
+  std::string parallel_json =
+      get_json_event(infile_path, outfile_path, v2::ProblemType_CCB, " --binary_to_json_threads 3");
+  BOOST_CHECK(!parallel_json.empty());
+  BOOST_CHECK_EQUAL(parallel_json, sequential_json);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_multistep_conversion_matches_sequential)
+{
+  std::string infile_path = "valid_joined_logs/multistep_unordered_episodes.fb";
+  std::string outfile_path = "valid_joined_logs/multistep_unordered_episodes.dsjson";
+
+  std::string sequential_json = get_json_event(infile_path, outfile_path, v2::ProblemType_MULTISTEP);
+  std::string parallel_json =
+      get_json_event(infile_path, outfile_path, v2::ProblemType_MULTISTEP, " --binary_to_json_threads 2");
+  BOOST_CHECK(!parallel_json.empty());
+  BOOST_CHECK_EQUAL(parallel_json, sequential_json);
+}
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(log_converter_multistep_streaming)
+namespace
+{
+std::vector<std::string> sorted_lines(const std::string& text)
+{
+  std::vector<std::string> lines;
+  std::istringstream in(text);
+  std::string line;
+  while (std::getline(in, line)) { lines.push_back(line); }
+  std::sort(lines.begin(), lines.end());
+  return lines;
+}
+
+// streaming emits whole episodes in the order in which they are closed,
+// so only the set of joined steps is compared
+void check_streaming_matches_batch(const std::string& file_name)
+{
+  std::string infile_path = "valid_joined_logs/" + file_name + ".fb";
+  std::string outfile_path = "valid_joined_logs/" + file_name + ".dsjson";
+
+  auto batch = sorted_lines(get_json_event(infile_path, outfile_path, v2::ProblemType_MULTISTEP));
+  auto streaming =
+      sorted_lines(get_json_event(infile_path, outfile_path, v2::ProblemType_MULTISTEP, " --multistep_streaming"));
+  BOOST_CHECK(!streaming.empty());
+  BOOST_CHECK_EQUAL_COLLECTIONS(streaming.begin(), streaming.end(), batch.begin(), batch.end());
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(streaming_2_episodes) { check_streaming_matches_batch("multistep_2_episodes"); }
+
+BOOST_AUTO_TEST_CASE(streaming_3_deferred_episodes) { check_streaming_matches_batch("multistep_3_deferred_episodes"); }
+
+BOOST_AUTO_TEST_CASE(streaming_unordered_episodes) { check_streaming_matches_batch("multistep_unordered_episodes"); }
+BOOST_AUTO_TEST_SUITE_END()
+
+namespace
+{
+class failing_writer : public log_converter::joined_event_writer
+{
+public:
+  void submit(joined_event::joined_event&&) override { throw std::runtime_error("disk full"); }
+  void finish() override {}
+};
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(submit_noexcept_reports_writer_errors)
+{
+  // Submitting from a scope_exit guard must not let the exception escape its destructor
+  failing_writer writer;
+  auto logger = VW::io::create_null_logger();
+  joined_event::joined_event je;
+  BOOST_CHECK(!log_converter::submit_noexcept(writer, std::move(je), logger));
+}
@@ -467,3 +467,80 @@ BOOST_AUTO_TEST_CASE(sum)
   BOOST_CHECK_EQUAL(rewards.at(0), 2 + 2 + 5 + 2);
 }
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(reward_function_kernels)
+namespace
+{
+reward::outcome_event make_outcome(float value, int seconds, bool action_taken = false)
+{
+  reward::outcome_event o;
+  o.value = value;
+  o.enqueued_time_utc = TimePoint(std::chrono::seconds(seconds));
+  o.action_taken = action_taken;
+  return o;
+}
+
+reward::outcome_columns make_groups()
+{
+  reward::outcome_columns columns;
+  columns.push_back(make_outcome(3.f, 2));
+  columns.push_back(make_outcome(1.f, 3));
+  columns.push_back(make_outcome(100.f, 1, true));
+  columns.push_back(make_outcome(2.f, 4));
+  columns.end_group();
+  // only an activation
+  columns.push_back(make_outcome(0.f, 1, true));
+  columns.end_group();
+  // empty group
+  columns.end_group();
+  columns.push_back(make_outcome(-4.f, 7));
+  columns.push_back(make_outcome(6.f, 5));
+  columns.end_group();
+  return columns;
+}
+
+std::vector<float> run(const reward::RewardFunctionType& reward_function)
+{
+  const auto columns = make_groups();
+  std::vector<float> rewards(columns.num_groups());
+  reward_function.columns(columns, DEFAULT_REWARD, rewards.data());
+  return rewards;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(one_reward_per_group)
+{
+  const std::vector<float> expected_average = {2.f, DEFAULT_REWARD, DEFAULT_REWARD, 1.f};
+  const std::vector<float> expected_sum = {6.f, DEFAULT_REWARD, DEFAULT_REWARD, 2.f};
+  const std::vector<float> expected_min = {1.f, DEFAULT_REWARD, DEFAULT_REWARD, -4.f};
+  const std::vector<float> expected_median = {2.f, DEFAULT_REWARD, DEFAULT_REWARD, 1.f};
+  const std::vector<float> expected_earliest = {3.f, DEFAULT_REWARD, DEFAULT_REWARD, 6.f};
+
+  auto rewards = run(reward::average_function);
+  BOOST_CHECK_EQUAL_COLLECTIONS(rewards.begin(), rewards.end(), expected_average.begin(), expected_average.end());
+  rewards = run(reward::sum_function);
+  BOOST_CHECK_EQUAL_COLLECTIONS(rewards.begin(), rewards.end(), expected_sum.begin(), expected_sum.end());
+  rewards = run(reward::min_function);
+  BOOST_CHECK_EQUAL_COLLECTIONS(rewards.begin(), rewards.end(), expected_min.begin(), expected_min.end());
+  rewards = run(reward::median_function);
+  BOOST_CHECK_EQUAL_COLLECTIONS(rewards.begin(), rewards.end(), expected_median.begin(), expected_median.end());
+  rewards = run(reward::earliest_function);
+  BOOST_CHECK_EQUAL_COLLECTIONS(rewards.begin(), rewards.end(), expected_earliest.begin(), expected_earliest.end());
+
+  rewards = run(reward::max_function);
+  BOOST_CHECK_EQUAL(rewards[0], 3.f);
+  BOOST_CHECK_EQUAL(rewards[3], 6.f);
+}
+
+BOOST_AUTO_TEST_CASE(single_event_matches_groups)
+{
+  std::vector<reward::outcome_event> outcomes = {
+      make_outcome(3.f, 2), make_outcome(1.f, 3), make_outcome(100.f, 1, true), make_outcome(2.f, 4)};
+  for (const auto& reward_function : {reward::average_function, reward::sum_function, reward::min_function,
+           reward::max_function, reward::median_function, reward::earliest_function})
+  {
+    BOOST_CHECK_EQUAL(reward::calculate(reward_function, outcomes, DEFAULT_REWARD), run(reward_function)[0]);
+  }
+  BOOST_CHECK_EQUAL(reward::calculate(reward::sum_function, {}, DEFAULT_REWARD), DEFAULT_REWARD);
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -21,8 +21,18 @@ const char* const MODEL_BACKGROUND_REFRESH = "model.backgroundrefresh";
 const char* const MODEL_VW_INITIAL_COMMAND_LINE = "model.vw.initial_command_line";
 const char* const VW_CMDLINE = "vw.commandline";
 const char* const VW_POOL_INIT_SIZE = "vw.pool.init.size";
+// Predict linear --cb_explore_adf models with epsilon-greedy exploration without the VW learner stack
+const char* const MODEL_VW_LIGHTWEIGHT_CB_ADF = "model.vw.lightweight_cb_adf";
+// Number of CB rankings cached by context, 0 disables the cache. Not used with audit.
+const char* const MODEL_VW_PREDICTION_CACHE_SIZE = "model.vw.prediction_cache.size";
+// File with one context per line. Each pooled model object predicts them before a new model is published.
+const char* const MODEL_WARMUP_CONTEXTS_FILE = "model.warmup.contexts_file";
 const char* const INITIAL_EPSILON = "initial_exploration.epsilon";
 const char* const LEARNING_MODE = "rank.learning.mode";
+// CB decisions over more actions than this rank only a shortlist of this many, picked by the linear terms of the model.
+// 0 ranks all the actions. Needs model.vw.lightweight_cb_adf, online learning mode and protocol version 2: the full
+// context is logged and the shortlist goes in a field of the event.
+const char* const RANK_SHORTLIST_SIZE = "rank.shortlist.size";
 const char* const PROTOCOL_VERSION = "protocol.version";
 const char* const HTTP_API_KEY = "http.api.key";
 const char* const HTTP_API_HEADER_KEY_NAME = "http.api.header.key.name";
@@ -98,6 +108,10 @@ const char* const SENDER_IMPLEMENTATION = "sender.implementation";
 const char* const EH_TEST = "eventhub.mock";
 const char* const TRACE_LOG_IMPLEMENTATION = "trace.logger.implementation";
 const char* const TRACE_LOG_LEVEL = "trace.logger.level";
+// File of FILE_TRACE_LOGGER, appended to
+const char* const TRACE_LOG_FILE_NAME = "trace.logger.file.name";
+// Records each thread can log to FILE_TRACE_LOGGER between two writes of the background thread, more are dropped
+const char* const TRACE_LOG_RING_SIZE = "trace.logger.ring_size";
 const char* const EPISODE_FILE_NAME = "episode.file.name";
 const char* const INTERACTION_FILE_NAME = "interaction.file.name";
 const char* const OBSERVATION_FILE_NAME = "observation.file.name";
@@ -106,6 +120,10 @@ const char* const HTTP_CLIENT_DISABLE_CERT_VALIDATION = "http.certvalidation.dis
 const char* const HTTP_CLIENT_TIMEOUT = "http.timeout";  // Timeout is in seconds, default is 30.
 const char* const MODEL_FILE_NAME = "model_file_loader.file_name";
 const char* const MODEL_FILE_MUST_EXIST = "model_file_loader.file_must_exist";
+// Map the model file instead of reading it. Replace the file (rename) rather than rewriting it in place.
+const char* const MODEL_FILE_USE_MMAP = "model_file_loader.use_mmap";
+// Detect changes with inotify (Linux) instead of polling the file, true by default
+const char* const MODEL_FILE_USE_INOTIFY = "model_file_loader.use_inotify";
 
 const char* const ZSTD_COMPRESSION_LEVEL = "zstd.compression_level";
 }  // namespace name
@@ -136,6 +154,7 @@ const char* const OBSERVATION_HTTP_API_SENDER_OAUTH = "OBSERVATION_HTTP_API_SEND
 const char* const INTERACTION_HTTP_API_SENDER_OAUTH = "INTERACTION_HTTP_API_SENDER_OAUTH";
 const char* const NULL_TRACE_LOGGER = "NULL_TRACE_LOGGER";
 const char* const CONSOLE_TRACE_LOGGER = "CONSOLE_TRACE_LOGGER";
+const char* const FILE_TRACE_LOGGER = "FILE_TRACE_LOGGER";
 const char* const NULL_TIME_PROVIDER = "NULL_TIME_PROVIDER";
 const char* const CLOCK_TIME_PROVIDER = "CLOCK_TIME_PROVIDER";
 const char* const LEARNING_MODE_ONLINE = "ONLINE";
@@ -146,6 +165,8 @@ const char* const CONTENT_ENCODING_DEDUP = "DEDUP";
 const char* const HTTP_API_DEFAULT_HEADER_KEY_NAME = "Ocp-Apim-Subscription-Key";
 const char* const HTTP_API_DEFAULT_OAUTH_TOKEN_TYPE = "Bearer";
 const char* const TRACE_LOG_LEVEL_DEFAULT = "info";
+const char* const TRACE_LOG_FILE_NAME_DEFAULT = "rl_trace.log";
+const int TRACE_LOG_RING_SIZE_DEFAULT = 1024;
 
 const char* const QUEUE_MODE_DROP = "DROP";
 const char* const QUEUE_MODE_BLOCK = "BLOCK";
@@ -22,14 +22,20 @@ public:
   float get_probability() const;
 
 private:
+  friend class decision_response;
+
   //! slot_id
-  const std::string slot_id;
+  std::string slot_id;
   //! action id
   uint32_t action_id;
   //! probability associated with the action id
   float probability;
 };
 
+/**
+ * @brief decision_response keeps its slots and their ids across clear(), so that a response reused from one request
+ * to the next is filled without allocating once it has grown to the size of the largest decision.
+ */
 class decision_response
 {
 private:
@@ -37,6 +43,8 @@ private:
 
   std::string _model_id;
   coll_t _decision;
+  //! Number of slots in use, the slots of _decision past it are kept for reuse
+  size_t _size = 0;
 
 public:
   using iterator_t = container_iterator<slot_response, coll_t>;
@@ -12,6 +12,8 @@
 #include "err_constants.h"
 #include "factory_resolver.h"
 #include "future_compat.h"
+#include "logger_statistics.h"
+#include "metrics_snapshot.h"
 #include "multi_slot_response.h"
 #include "multi_slot_response_detailed.h"
 #include "multistep.h"
@@ -428,6 +430,24 @@ public:
    */
   int refresh_model(api_status* status = nullptr);
 
+  /**
+   * @brief Snapshot of the latency histograms and counters of the API stages.
+   * Metrics are process wide: they include the calls of every live_model of the process.
+   * @param snapshot Snapshot to fill, its previous values are overwritten
+   * @param status  Optional field with detailed string description if there is an error
+   * @return int Return error code, not_supported if the library was built with RL_USE_METRICS=OFF
+   */
+  int get_metrics(metrics_snapshot& snapshot, api_status* status = nullptr);
+
+  /**
+   * @brief Statistics of the queues, batches and senders of the event loggers, to monitor logging backpressure.
+   * Reading them takes no lock shared with the decision and outcome calls.
+   * @param stats Statistics to fill
+   * @param status  Optional field with detailed string description if there is an error
+   * @return int Return error code.  This will also be returned in the api_status object
+   */
+  int get_logging_statistics(logging_statistics& stats, api_status* status = nullptr);
+
   /**
    * @brief Error callback function.
    * When live_model is constructed, a background error callback and a
@@ -0,0 +1,64 @@
+/**
+ * @brief logger_statistics definition. logger_statistics hold the health of the queue, batching and sender of the
+ * event loggers, to monitor the backpressure of logging.
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace reinforcement_learning
+{
+/**
+ * @brief Statistics of an event logger since it was created.
+ * Queue sizes are current values, everything else is cumulative.
+ */
+struct logger_statistics
+{
+  //! Events in the queue
+  uint64_t queue_count = 0;
+  //! Estimated size of the events in the queue, in bytes
+  uint64_t queue_bytes = 0;
+  //! Largest number of events the queue held
+  uint64_t queue_count_high_water_mark = 0;
+  //! Largest estimated size of the events the queue held, in bytes
+  uint64_t queue_bytes_high_water_mark = 0;
+
+  //! Time producers spent blocked on a full queue in BLOCK queue mode, in nanoseconds
+  uint64_t blocked_time_ns = 0;
+  //! Number of times a producer blocked on a full queue
+  uint64_t blocked_count = 0;
+
+  //! Events dropped by subsampling
+  uint64_t events_dropped_subsampling = 0;
+  //! Events dropped because the queue was full, in DROP queue mode
+  uint64_t events_dropped_queue_full = 0;
+
+  //! Batches handed to the sender
+  uint64_t batches_sent = 0;
+  //! Size of the batches handed to the sender, in bytes
+  uint64_t batch_bytes_sent = 0;
+  //! Batches the sender failed to send
+  uint64_t send_failures = 0;
+
+  //! Size of the compressed event payloads before compression, in bytes
+  uint64_t bytes_before_compression = 0;
+  //! Size of the compressed event payloads after compression, in bytes
+  uint64_t bytes_after_compression = 0;
+
+  //! Requests of the sender started and not completed yet, 0 if the sender does not report them
+  uint64_t requests_in_flight = 0;
+};
+
+/**
+ * @brief Statistics of the event loggers of a live_model.
+ */
+struct logging_statistics
+{
+  //! Logger of the decisions
+  logger_statistics interactions;
+  //! Logger of the outcomes
+  logger_statistics observations;
+  //! Logger of the episodes, zero when the model does not use episodes
+  logger_statistics episodes;
+};
+}  // namespace reinforcement_learning
@@ -15,6 +15,7 @@
 #include "multi_slot_response.h"
 #include "multi_slot_response_detailed.h"
 #include "sender.h"
+#include "structured_input.h"
 
 #include <functional>
 #include <memory>
@@ -86,6 +87,63 @@ public:
   int request_continuous_action(
       str_view context_json, continuous_action_response& response, api_status* status = nullptr);
 
+  /**
+   * @brief Choose an action from a continuous range, given the context as named float tensors. The model gets the
+   * tensors without any text encoding and the context is logged in the compact binary form of structured_input.
+   * The model has to accept structured input for continuous actions. Requires protocol.version 2, and can not be
+   * combined with dedup.
+   * @param event_id  The unique identifier for this interaction.  The same event_id should be used when
+   *                  reporting the outcome for this action.
+   * @param input Context tensors
+   * @param flags Action flags (see action_flags.h)
+   * @param response Continuous action response contains the chosen action and the probability density value of the
+   * chosen action location from the continuous range.
+   * @param status  Optional field with detailed string description if there is an error
+   * @return int Return error code.  This will also be returned in the api_status object
+   */
+  int request_continuous_action(str_view event_id, const structured_input& input, unsigned int flags,
+      continuous_action_response& response, api_status* status = nullptr);
+
+  /**
+   * @brief Choose an action from a continuous range, given the context as named float tensors. See above.
+   * @param event_id  The unique identifier for this interaction.  The same event_id should be used when
+   *                  reporting the outcome for this action.
+   * @param input Context tensors
+   * @param response Continuous action response contains the chosen action and the probability density value of the
+   * chosen action location from the continuous range.
+   * @param status  Optional field with detailed string description if there is an error
+   * @return int Return error code.  This will also be returned in the api_status object
+   */
+  int request_continuous_action(str_view event_id, const structured_input& input,
+      continuous_action_response& response, api_status* status = nullptr);
+
+  /**
+   * @brief Choose an action from a continuous range, given the context as named float tensors. A unique event_id will
+   * be generated and returned in the continuous_action_response. The same event_id should be used when reporting the
+   * outcome for this action.
+   * @param input Context tensors
+   * @param flags Action flags (see action_flags.h)
+   * @param response Continuous action response contains the chosen action and the probability density value of the
+   * chosen action location from the continuous range.
+   * @param status  Optional field with detailed string description if there is an error
+   * @return int Return error code.  This will also be returned in the api_status object
+   */
+  int request_continuous_action(const structured_input& input, unsigned int flags,
+      continuous_action_response& response, api_status* status = nullptr);
+
+  /**
+   * @brief Choose an action from a continuous range, given the context as named float tensors. A unique event_id will
+   * be generated and returned in the continuous_action_response. The same event_id should be used when reporting the
+   * outcome for this action.
+   * @param input Context tensors
+   * @param response Continuous action response contains the chosen action and the probability density value of the
+   * chosen action location from the continuous range.
+   * @param status  Optional field with detailed string description if there is an error
+   * @return int Return error code.  This will also be returned in the api_status object
+   */
+  int request_continuous_action(
+      const structured_input& input, continuous_action_response& response, api_status* status = nullptr);
+
   /**
    * @brief Report the outcome for the top action.
    *
@@ -13,6 +13,7 @@
 #include "future_compat.h"
 #include "ranking_response.h"
 #include "sender.h"
+#include "structured_input.h"
 
 #include <functional>
 #include <memory>
@@ -84,6 +85,61 @@ public:
   int choose_rank(str_view context_json, unsigned int flags, ranking_response& resp,
       api_status* status = nullptr);  // event_id is auto-generated
 
+  /**
+   * @brief Choose an action, given the context as named float tensors. The model gets the tensors without any
+   * text encoding and the context is logged in the compact binary form of structured_input.
+   * Use a model that accepts structured input (e.g. ONNXRUNTIME with onnx.use_unstructured_input = false).
+   * Requires protocol.version 2, and can not be combined with dedup or rank.shortlist.size.
+   * @param event_id  The unique identifier for this interaction.  The same event_id should be used when
+   *                  reporting the outcome for this action.
+   * @param input Context tensors
+   * @param flags Action flags (see action_flags.h)
+   * @param resp Ranking response contains the chosen action, probability distribution used for sampling actions and
+   * ranked actions
+   * @param status  Optional field with detailed string description if there is an error
+   * @return int Return error code.  This will also be returned in the api_status object
+   */
+  int choose_rank(str_view event_id, const structured_input& input, unsigned int flags, ranking_response& resp,
+      api_status* status = nullptr);
+
+  /**
+   * @brief Choose an action, given the context as named float tensors. See above.
+   * @param event_id  The unique identifier for this interaction.  The same event_id should be used when
+   *                  reporting the outcome for this action.
+   * @param input Context tensors
+   * @param resp Ranking response contains the chosen action, probability distribution used for sampling actions and
+   * ranked actions
+   * @param status  Optional field with detailed string description if there is an error
+   * @return int Return error code.  This will also be returned in the api_status object
+   */
+  int choose_rank(
+      str_view event_id, const structured_input& input, ranking_response& resp, api_status* status = nullptr);
+
+  /**
+   * @brief Choose an action, given the context as named float tensors. A unique event_id will be generated and
+   * returned in the ranking_response. The same event_id should be used when reporting the outcome for this action.
+   * @param input Context tensors
+   * @param flags Action flags (see action_flags.h)
+   * @param resp Ranking response contains the chosen action, probability distribution used for sampling actions and
+   * ranked actions
+   * @param status  Optional field with detailed string description if there is an error
+   * @return int Return error code.  This will also be returned in the api_status object
+   */
+  int choose_rank(const structured_input& input, unsigned int flags, ranking_response& resp,
+      api_status* status = nullptr);  // event_id is auto-generated
+
+  /**
+   * @brief Choose an action, given the context as named float tensors. A unique event_id will be generated and
+   * returned in the ranking_response. The same event_id should be used when reporting the outcome for this action.
+   * @param input Context tensors
+   * @param resp Ranking response contains the chosen action, probability distribution used for sampling actions and
+   * ranked actions
+   * @param status  Optional field with detailed string description if there is an error
+   * @return int Return error code.  This will also be returned in the api_status object
+   */
+  int choose_rank(const structured_input& input, ranking_response& resp,
+      api_status* status = nullptr);  // event_id is auto-generated
+
   /**
    * @brief Report the outcome for the top action.
    *
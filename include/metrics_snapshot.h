@@ -0,0 +1,101 @@
+/**
+ * @brief metrics_snapshot definition. A metrics_snapshot holds the latency histograms and counters of the stages of the
+ * API, as collected by the library.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace reinforcement_learning
+{
+/**
+ * @brief Stages of the API whose latency is recorded.
+ */
+enum class api_stage
+{
+  context_parse,   //!< Parsing of a JSON context by the model
+  pool_checkout,   //!< Wait for an object of the model pool
+  model_predict,   //!< Model call of a decision, context parsing included
+  sampling,        //!< Sampling of the pdf and population of the response
+  serialization,   //!< Serialization of an event into a batch
+  queue_enqueue,   //!< Append of an event to a logger queue, including the wait when the queue blocks
+  queue_wait,      //!< Time spent by an event in a logger queue
+  batch_fill,      //!< Filling of a batch from a logger queue, serialization included
+  compression,     //!< Compression of an event or a batch
+  send,            //!< Send of a batch by a sender
+  model_fetch,     //!< Download of a new model by the model transport
+  model_verify,    //!< Verification of a new model by the model transport
+  model_load,      //!< Parsing, warm-up and publication of a new model
+  count            //!< Number of stages, not a stage
+};
+
+/**
+ * @brief Events counted by the library.
+ */
+enum class api_counter
+{
+  events_enqueued,  //!< Events appended to a logger queue
+  events_dropped,   //!< Events dropped by subsampling or because a logger queue was full
+  batches_sent,     //!< Batches handed to a sender
+  send_failures,    //!< Batches a sender failed to send
+  send_retries,     //!< Retried send requests
+  count             //!< Number of counters, not a counter
+};
+
+const char* to_string(api_stage stage);
+const char* to_string(api_counter counter);
+
+/**
+ * @brief Latency histogram of a stage, in nanoseconds. Values are bucketed with a relative precision of 1/8.
+ */
+struct latency_histogram
+{
+  //! Number of values
+  uint64_t count = 0;
+  //! Sum of the values
+  uint64_t sum = 0;
+  //! (inclusive upper bound, number of values) of the non empty buckets, by increasing bound
+  std::vector<std::pair<uint64_t, uint64_t>> buckets;
+
+  /**
+   * @brief Bound under which the fraction q of the values fall.
+   *
+   * @param q Fraction in [0, 1]
+   * @return uint64_t Upper bound of the bucket holding the quantile, 0 if the histogram is empty
+   */
+  uint64_t quantile(double q) const;
+};
+
+/**
+ * @brief Latency histograms and counters of all the stages at the time of the snapshot.
+ *
+ * Metrics are collected for the whole process since it started, whatever live_model object recorded them.
+ */
+class metrics_snapshot
+{
+public:
+  metrics_snapshot();
+
+  const latency_histogram& get(api_stage stage) const;
+  uint64_t get(api_counter counter) const;
+
+  latency_histogram& get(api_stage stage);
+  uint64_t& get(api_counter counter);
+
+  /**
+   * @brief Prometheus text exposition format of the snapshot.
+   * Stage histograms are named rl_stage_latency_seconds with a stage label, counters rl_<counter>_total.
+   *
+   * @return std::string
+   */
+  std::string to_prometheus() const;
+
+private:
+  std::vector<latency_histogram> _histograms;
+  std::vector<uint64_t> _counters;
+};
+}  // namespace reinforcement_learning
@@ -1,10 +1,12 @@
 #pragma once
 #include "err_constants.h"
+#include "multi_slot_ranking.h"
 #include "multistep.h"
 
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -39,6 +41,11 @@ public:
   // Set data
   int set_data(const char* vw_model, size_t len);
 
+  // Use len bytes of memory owned by data (e.g. a file mapping) instead of a copy. Copies of this object share the
+  // memory and keep it alive. alloc(), free() and set_data() switch back to owned memory.
+  void set_shared_data(std::shared_ptr<char> data, size_t len);
+  bool is_shared() const;
+
   model_data() = default;
   ~model_data() = default;
 
@@ -49,6 +56,8 @@ public:
 
 private:
   std::vector<char> _data;
+  std::shared_ptr<char> _shared_data;
+  size_t _shared_data_sz = 0;
   uint32_t _refresh_count = 0;
 };
 
@@ -57,6 +66,8 @@ class i_data_transport
 {
 public:
   virtual int get_data(model_data& data, api_status* status = nullptr) = 0;
+  //! Checks the integrity of new data returned by get_data (e.g. against a checksum sent with it) before it is used.
+  virtual int verify_data(const model_data& data, api_status* status = nullptr) { return error_code::success; }
   virtual ~i_data_transport() = default;
 };
 
@@ -81,14 +92,24 @@ public:
   virtual int update(const model_data& data, bool& model_ready, api_status* status = nullptr) = 0;
   virtual int choose_rank(const char* event_id, uint64_t rnd_seed, string_view features, std::vector<int>& action_ids,
       std::vector<float>& action_pdf, std::string& model_version, api_status* status = nullptr) = 0;
+  //! Two-stage choose_rank() for large action sets: a cheap first stage shortlists at most shortlist_size actions and
+  //! only those are ranked. shortlist receives their indices in increasing order, action_ids holds the same indices.
+  //! shortlist is left empty when every action was ranked, which is what models without a first stage do.
+  virtual int choose_rank_shortlist(const char* event_id, uint64_t rnd_seed, string_view features,
+      size_t shortlist_size, std::vector<int>& action_ids, std::vector<float>& action_pdf, std::vector<int>& shortlist,
+      std::string& model_version, api_status* status = nullptr)
+  {
+    shortlist.clear();
+    return choose_rank(event_id, rnd_seed, features, action_ids, action_pdf, model_version, status);
+  }
   virtual int choose_continuous_action(string_view features, float& action, float& pdf_value,
       std::string& model_version, api_status* status = nullptr) = 0;
   virtual int request_decision(const std::vector<const char*>& event_ids, string_view features,
       std::vector<std::vector<uint32_t>>& actions_ids, std::vector<std::vector<float>>& action_pdfs,
       std::string& model_version, api_status* status = nullptr) = 0;
   virtual int request_multi_slot_decision(const char* event_id, const std::vector<std::string>& slot_ids,
-      string_view features, std::vector<std::vector<uint32_t>>& actions_ids,
-      std::vector<std::vector<float>>& action_pdfs, std::string& model_version, api_status* status = nullptr) = 0;
+      string_view features, multi_slot_ranking& ranking, std::string& model_version,
+      api_status* status = nullptr) = 0;
   virtual int choose_rank_multistep(const char* event_id, uint64_t rnd_seed, string_view features,
       const episode_history& history, std::vector<int>& action_ids, std::vector<float>& action_pdf,
       std::string& model_version, api_status* status = nullptr) = 0;
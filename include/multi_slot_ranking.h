@@ -0,0 +1,65 @@
+/**
+ * @brief multi_slot_ranking definition. multi_slot_ranking holds the ranked actions and probabilities of every slot of
+ * a multi slot decision in flat arrays.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace reinforcement_learning
+{
+/**
+ * @brief Ranked action ids and probabilities of all the slots of a multi slot (CCB or slates) decision.
+ *
+ * The entries of all slots are stored contiguously, slot after slot, and offsets() delimits them: the entries of slot i
+ * are [offsets()[i], offsets()[i + 1]) of action_ids() and probabilities(). A decision of any size therefore lives in
+ * three arrays, and clear() keeps their memory so that the object can be reused without allocating.
+ */
+class multi_slot_ranking
+{
+public:
+  multi_slot_ranking();
+
+  /**
+   * @brief Removes all slots. The memory is kept.
+   */
+  void clear();
+
+  /**
+   * @brief Reserves memory for slot_count slots holding entry_count entries overall.
+   */
+  void reserve(size_t slot_count, size_t entry_count);
+
+  /**
+   * @brief Appends an empty slot. The entries pushed from then on belong to it.
+   */
+  void add_slot();
+
+  /**
+   * @brief Appends an entry to the last slot. There must be at least one slot.
+   */
+  void push_back(uint32_t action_id, float probability);
+
+  size_t slot_count() const;
+  size_t slot_size(size_t slot) const;
+  //! Total number of entries over all the slots
+  size_t size() const;
+
+  //! slot_size(slot) action ids of the slot
+  const uint32_t* slot_action_ids(size_t slot) const;
+  //! slot_size(slot) probabilities of the slot
+  const float* slot_probabilities(size_t slot) const;
+
+  //! slot_count() + 1 offsets, the last one is size()
+  const std::vector<size_t>& offsets() const;
+  const std::vector<uint32_t>& action_ids() const;
+  const std::vector<float>& probabilities() const;
+
+private:
+  std::vector<size_t> _offsets;
+  std::vector<uint32_t> _action_ids;
+  std::vector<float> _probabilities;
+};
+}  // namespace reinforcement_learning
@@ -27,6 +27,8 @@ public:
   void set_probability(float prob);
 
 private:
+  friend class multi_slot_response;
+
   //! slot entry id
   std::string _id;
   //! action id
@@ -37,6 +39,9 @@ private:
 
 /**
  * @brief request_multi_slot_decision returns the per-slot action choice using multi_slot_response.
+ *
+ * The slot entries and the ids are kept across clear(), so that a response reused from one request to the next is
+ * filled without allocating once it has grown to the size of the largest decision.
  */
 class multi_slot_response
 {
@@ -46,6 +51,8 @@ private:
   std::string _event_id;
   std::string _model_id;
   coll_t _decision;
+  //! Number of slots in use, the entries of _decision past it are kept for reuse
+  size_t _size = 0;
 
 public:
   using iterator_t = container_iterator<slot_entry, coll_t>;
@@ -12,6 +12,12 @@ namespace reinforcement_learning
 {
 class api_status;
 
+/**
+ * @brief request_multi_slot_decision returns the ranking of every slot using multi_slot_response_detailed.
+ *
+ * The slot rankings and the ids are kept across clear() and resize(), so that a response reused from one request to
+ * the next is filled without allocating once it has grown to the size of the largest decision.
+ */
 class multi_slot_response_detailed
 {
 private:
@@ -20,6 +26,8 @@ private:
   std::string _event_id;
   std::string _model_id;
   coll_t _decision;
+  //! Number of slots in use, the (cleared) slots of _decision past it are kept for reuse
+  size_t _size = 0;
 
 public:
   using iterator_t = container_iterator<slot_ranking, coll_t>;
@@ -40,6 +48,7 @@ public:
   void set_model_id(std::string&& model_id);
   const char* get_model_id() const;
 
+  // The content of slot is copied into the slot at index, which keeps its buffers
   int set_slot_at_index(const unsigned int index, slot_ranking&& slot, api_status* status = nullptr);
 
   void clear();
@@ -1,6 +1,7 @@
 #pragma once
 #include "configuration.h"
 #include "data_buffer.h"
+#include "logger_statistics.h"
 
 #include <memory>
 namespace reinforcement_learning
@@ -22,6 +23,9 @@ public:
     return v_send(data, status);
   }
 
+  // Senders that track their requests set requests_in_flight of stats
+  virtual void get_statistics(logger_statistics& /*stats*/) const {}
+
   virtual ~i_sender() = default;
 
 protected:
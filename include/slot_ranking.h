@@ -105,6 +105,14 @@ public:
    */
   void push_back(const size_t action_id, const float prob);
 
+  /**
+   * @brief Reserve memory for count (action id, probability) pairs, so that as many push_back() calls do not allocate
+   * (This is set internally by the API)
+   *
+   * @param count
+   */
+  void reserve(size_t count);
+
   /**
    * @brief Size of the action collection.
    *
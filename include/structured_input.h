@@ -0,0 +1,77 @@
+/**
+ * @brief structured_input definition. structured_input holds named float tensors passed to a model without
+ * encoding them as text.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace reinforcement_learning
+{
+class api_status;
+
+/**
+ * @brief Named float tensors, given by pointer and shape, used as the context of a decision.
+ *
+ * The tensors are copied into a compact binary framing. The same bytes are handed to the model and logged as the
+ * context of the interaction, tagged as binary tensors, so there is no text encoding on the client. The log reader
+ * renders them in the tensor notation of the ONNX extension.
+ *
+ * All integers are little-endian and every section starts at a multiple of 8 bytes from the start of the buffer:
+ *
+ * <INPUT>  := <MAGIC:uint32> <TENSOR-COUNT:uint32> <TENSOR>*
+ * <TENSOR> := <NAME-LENGTH:uint32> <RANK:uint32> <NAME> <DIMS:int64[RANK]> <VALUES> <PADDING>
+ * <NAME>   := NAME-LENGTH characters, followed by '\0' padding up to a multiple of 8 (at least one '\0')
+ * <VALUES> := float[product(DIMS)]
+ * <PADDING>:= zero bytes up to the next multiple of 8
+ *
+ * A tensor of rank 0 has no values. The buffer itself is 8 byte aligned.
+ */
+class structured_input
+{
+public:
+  static const uint32_t MAGIC = 0x31544E52;  // "RNT1"
+  static const size_t ALIGNMENT = 8;
+
+  static size_t padded_size(size_t size) { return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+
+  structured_input();
+
+  /**
+   * @brief Appends a tensor. The values are copied.
+   *
+   * @param name Name of the tensor, e.g. the name of a model input
+   * @param dimensions Shape of the tensor, rank entries
+   * @param rank Number of dimensions
+   * @param values product(dimensions) values in row-major order
+   * @param status  Optional field with detailed string description if there is an error
+   * @return int Return error code.  This will also be returned in the api_status object
+   */
+  int add_tensor(const char* name, const int64_t* dimensions, size_t rank, const float* values,
+      api_status* status = nullptr);
+
+  int add_tensor(const std::string& name, const std::vector<int64_t>& dimensions, const float* values,
+      api_status* status = nullptr);
+
+  /**
+   * @brief Removes all tensors. The memory is kept so that the object can be reused without allocating.
+   */
+  void clear();
+
+  size_t tensor_count() const;
+
+  const char* data() const;
+  size_t size() const;
+
+private:
+  char* bytes();
+  void grow(size_t size);
+
+  std::vector<uint64_t> _buffer;
+  size_t _size = 0;
+  uint32_t _tensor_count = 0;
+};
+}  // namespace reinforcement_learning
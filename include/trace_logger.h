@@ -1,7 +1,10 @@
 #pragma once
 #include "api_status.h"
 
+#include <cstdint>
+#include <initializer_list>
 #include <string>
+#include <type_traits>
 
 namespace reinforcement_learning
 {
@@ -22,9 +25,10 @@ int get_log_level_from_string(const std::string& level, int& level_value, api_st
 }  // namespace details
 }  // namespace reinforcement_learning
 
-#define TRACE_LOG(logger, level, msg)                   \
-  do {                                                  \
-    if (logger != nullptr) { logger->log(level, msg); } \
+// msg is only evaluated when the logger is enabled for the level
+#define TRACE_LOG(logger, level, msg)                                                \
+  do {                                                                               \
+    if (logger != nullptr && logger->is_enabled(level)) { logger->log(level, msg); } \
   } while (0)
 
 #define TRACE_DEBUG(logger, msg) TRACE_LOG(logger, reinforcement_learning::LEVEL_DEBUG, msg)
@@ -32,13 +36,64 @@ int get_log_level_from_string(const std::string& level, int& level_value, api_st
 #define TRACE_WARN(logger, msg) TRACE_LOG(logger, reinforcement_learning::LEVEL_WARN, msg)
 #define TRACE_ERROR(logger, msg) TRACE_LOG(logger, reinforcement_learning::LEVEL_ERROR, msg)
 
+// Structured record, the fields are trace_field values: TRACE_EVENT(logger, LEVEL_INFO, "model_loaded", {"size", n})
+#define TRACE_EVENT(logger, level, event, ...)                                                              \
+  do {                                                                                                      \
+    if (logger != nullptr && logger->is_enabled(level)) { logger->log_event(level, event, {__VA_ARGS__}); } \
+  } while (0)
+
 namespace reinforcement_learning
 {
+// Named value of a structured trace record. The name is not copied, it must be a string literal.
+struct trace_field
+{
+  enum class type_t
+  {
+    int64,
+    uint64,
+    float64,
+    string
+  };
+
+  template <typename T,
+      typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, int>::type = 0>
+  trace_field(const char* name, T value) : name(name), type(type_t::int64), int_value(value)
+  {
+  }
+  template <typename T,
+      typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value, int>::type = 0>
+  trace_field(const char* name, T value) : name(name), type(type_t::uint64), uint_value(value)
+  {
+  }
+  trace_field(const char* name, double value) : name(name), type(type_t::float64), float_value(value) {}
+  trace_field(const char* name, const char* value) : name(name), type(type_t::string), string_value(value) {}
+  trace_field(const char* name, std::string value)
+      : name(name), type(type_t::string), string_value(std::move(value))
+  {
+  }
+  trace_field() = default;
+
+  // Appends " name=value" to out
+  void format(std::string& out) const;
+
+  const char* name = "";
+  type_t type = type_t::int64;
+  int64_t int_value = 0;
+  uint64_t uint_value = 0;
+  double float_value = 0;
+  std::string string_value;
+};
+
 class i_trace
 {
 public:
   virtual void log(int log_level, const std::string& msg) = 0;
   virtual void set_level(int log_level) = 0;
+  // Checked by the TRACE_* macros before the message is built
+  virtual bool is_enabled(int /*log_level*/) const { return true; }
+  // Structured record: an event id (a string literal, not copied) and its fields. Tracers may format it later, off the
+  // calling thread. By default it is formatted as "event name=value ..." and passed to log().
+  virtual void log_event(int log_level, const char* event, std::initializer_list<trace_field> fields);
   virtual ~i_trace(){};
 };
 }  // namespace reinforcement_learning
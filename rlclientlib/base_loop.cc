@@ -65,4 +65,16 @@ int base_loop::refresh_model(api_status* status)
   return _pimpl->refresh_model(status);
 }
 
+int base_loop::get_metrics(metrics_snapshot& snapshot, api_status* status)
+{
+  INIT_CHECK();
+  return _pimpl->get_metrics(snapshot, status);
+}
+
+int base_loop::get_logging_statistics(logging_statistics& stats, api_status* status)
+{
+  INIT_CHECK();
+  return _pimpl->get_logging_statistics(stats, status);
+}
+
 }  // namespace reinforcement_learning
@@ -34,6 +34,34 @@ int ca_loop::request_continuous_action(str_view context_json, continuous_action_
       string_view(context_json.str, context_json.size), action_flags::DEFAULT, response, status);
 }
 
+int ca_loop::request_continuous_action(str_view event_id, const structured_input& input, unsigned int flags,
+    continuous_action_response& response, api_status* status)
+{
+  INIT_CHECK();
+  return _pimpl->request_continuous_action(event_id.str, input, flags, response, status);
+}
+
+int ca_loop::request_continuous_action(
+    str_view event_id, const structured_input& input, continuous_action_response& response, api_status* status)
+{
+  INIT_CHECK();
+  return _pimpl->request_continuous_action(event_id.str, input, action_flags::DEFAULT, response, status);
+}
+
+int ca_loop::request_continuous_action(
+    const structured_input& input, unsigned int flags, continuous_action_response& response, api_status* status)
+{
+  INIT_CHECK();
+  return _pimpl->request_continuous_action(input, flags, response, status);
+}
+
+int ca_loop::request_continuous_action(
+    const structured_input& input, continuous_action_response& response, api_status* status)
+{
+  INIT_CHECK();
+  return _pimpl->request_continuous_action(input, action_flags::DEFAULT, response, status);
+}
+
 int ca_loop::report_outcome(str_view event_id, str_view outcome, api_status* status)
 {
   INIT_CHECK();
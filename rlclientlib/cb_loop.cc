@@ -29,6 +29,33 @@ int cb_loop::choose_rank(str_view context_json, unsigned int flags, ranking_resp
   return _pimpl->choose_rank(string_view(context_json.str, context_json.size), flags, response, status);
 }
 
+int cb_loop::choose_rank(str_view event_id, const structured_input& input, unsigned int flags,
+    ranking_response& response, api_status* status)
+{
+  INIT_CHECK();
+  return _pimpl->choose_rank(event_id.str, input, flags, response, status);
+}
+
+int cb_loop::choose_rank(
+    str_view event_id, const structured_input& input, ranking_response& response, api_status* status)
+{
+  INIT_CHECK();
+  return choose_rank(event_id, input, action_flags::DEFAULT, response, status);
+}
+
+int cb_loop::choose_rank(
+    const structured_input& input, unsigned int flags, ranking_response& response, api_status* status)
+{
+  INIT_CHECK();
+  return _pimpl->choose_rank(input, flags, response, status);
+}
+
+int cb_loop::choose_rank(const structured_input& input, ranking_response& response, api_status* status)
+{
+  INIT_CHECK();
+  return choose_rank(input, action_flags::DEFAULT, response, status);
+}
+
 int cb_loop::report_outcome(str_view event_id, str_view outcome, api_status* status)
 {
   INIT_CHECK();
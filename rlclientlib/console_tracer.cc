@@ -8,9 +8,11 @@ namespace reinforcement_learning
 {
 void console_tracer::log(int log_level, const std::string& msg)
 {
-  if (log_level < _log_level) { return; }
+  if (!is_enabled(log_level)) { return; }
   std::cout << details::get_log_level_string(log_level) << ": " << msg << std::endl;
 }
 
 void console_tracer::set_level(int log_level) { _log_level = log_level; }
+
+bool console_tracer::is_enabled(int log_level) const { return log_level >= _log_level; }
 }  // namespace reinforcement_learning
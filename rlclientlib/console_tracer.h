@@ -9,8 +9,9 @@ public:
   // Inherited via i_trace
   void log(int log_level, const std::string& msg) override;
   void set_level(int log_level) override;
+  bool is_enabled(int log_level) const override;
 
 private:
-  int _log_level;
+  int _log_level = LEVEL_INFO;
 };
 }  // namespace reinforcement_learning
@@ -18,10 +18,18 @@ float slot_response::get_probability() const { return probability; }
 
 void decision_response::push_back(const char* event_id, uint32_t action_id, float prob)
 {
-  _decision.emplace_back(event_id, action_id, prob);
+  if (_size < _decision.size())
+  {
+    auto& slot = _decision[_size];
+    slot.slot_id = event_id;
+    slot.action_id = action_id;
+    slot.probability = prob;
+  }
+  else { _decision.emplace_back(event_id, action_id, prob); }
+  ++_size;
 }
 
-size_t decision_response::size() const { return _decision.size(); }
+size_t decision_response::size() const { return _size; }
 
 void decision_response::set_model_id(const char* model_id) { _model_id = model_id; }
 void decision_response::set_model_id(std::string&& model_id) { _model_id.assign(std::move(model_id)); }
@@ -29,7 +37,8 @@ const char* decision_response::get_model_id() const { return _model_id.c_str();
 
 void decision_response::clear()
 {
-  _decision.clear();
+  // The slots are kept so that the next request reuses their ids
+  _size = 0;
   _model_id.clear();
 }
 
@@ -37,19 +46,21 @@ decision_response::const_iterator_t decision_response::begin() const { return {_
 
 decision_response::iterator_t decision_response::begin() { return {_decision}; }
 
-decision_response::const_iterator_t decision_response::end() const { return {_decision, _decision.size()}; }
+decision_response::const_iterator_t decision_response::end() const { return {_decision, _size}; }
 
-decision_response::iterator_t decision_response::end() { return {_decision, _decision.size()}; }
+decision_response::iterator_t decision_response::end() { return {_decision, _size}; }
 
 decision_response::decision_response(decision_response&& other) noexcept
-    : _decision(std::move(other._decision)), _model_id(std::move(other._model_id))
+    : _model_id(std::move(other._model_id)), _decision(std::move(other._decision)), _size(other._size)
 {
+  other._size = 0;
 }
 
 decision_response& decision_response::operator=(decision_response&& other) noexcept
 {
   std::swap(_model_id, other._model_id);
   std::swap(_decision, other._decision);
+  std::swap(_size, other._size);
   return *this;
 }
 }  // namespace reinforcement_learning
@@ -4,6 +4,7 @@
 #include "serialization/payload_serializer.h"
 #include "utility/config_helper.h"
 #include "utility/context_helper.h"
+#include "utility/metrics_registry.h"
 #include "vw/common/hash.h"
 #include "zstd.h"
 
@@ -60,7 +61,12 @@ int dedup_dict::transform_payload_and_add_objects(
 {
   u::ContextInfo context_info;
   RETURN_IF_FAIL(u::get_context_info(payload, context_info, nullptr, status));
+  return transform_payload_and_add_objects(payload, context_info, edited_payload, object_ids, status);
+}
 
+int dedup_dict::transform_payload_and_add_objects(string_view payload, const u::ContextInfo& context_info,
+    std::string& edited_payload, generic_event::object_list_t& object_ids, api_status* status)
+{
   edited_payload = std::string(payload);
   object_ids.clear();
   object_ids.reserve(context_info.actions.size());
@@ -88,6 +94,7 @@ zstd_compressor::zstd_compressor(int level) : _level(level) {}
 
 int zstd_compressor::compress(generic_event::payload_buffer_t& input, api_status* status) const
 {
+  utility::stage_timer timer(api_stage::compression);
   size_t buff_size = ZSTD_compressBound(input.size());
 
   std::unique_ptr<uint8_t[]> data(fb::DefaultAllocator().allocate(buff_size));
@@ -151,14 +158,30 @@ int dedup_state::compress(
   if (_use_compression)
   {
     content_type = event_content_type::ZSTD;
-    return _compressor.compress(input, status);
+    const size_t old_size = input.size();
+    RETURN_IF_FAIL(_compressor.compress(input, status));
+    _bytes_before_compression.fetch_add(old_size, std::memory_order_relaxed);
+    _bytes_after_compression.fetch_add(input.size(), std::memory_order_relaxed);
+    return error_code::success;
   }
   content_type = event_content_type::IDENTITY;
   return error_code::success;
 }
 
+void dedup_state::get_compression_statistics(logger_statistics& stats) const
+{
+  stats.bytes_before_compression = _bytes_before_compression.load(std::memory_order_relaxed);
+  stats.bytes_after_compression = _bytes_after_compression.load(std::memory_order_relaxed);
+}
+
 int dedup_state::transform_payload_and_add_objects(
     string_view payload, std::string& edited_payload, generic_event::object_list_t& object_ids, api_status* status)
+{
+  return transform_payload_and_add_objects(payload, nullptr, edited_payload, object_ids, status);
+}
+
+int dedup_state::transform_payload_and_add_objects(string_view payload, const u::ContextInfo* context_info,
+    std::string& edited_payload, generic_event::object_list_t& object_ids, api_status* status)
 {
   if (!_use_dedup)
   {
@@ -166,8 +189,16 @@ int dedup_state::transform_payload_and_add_objects(
     return error_code::success;
   }
 
+  // analyze the context outside of the lock if it was not done while serving the request
+  u::ContextInfo local_info;
+  if (context_info == nullptr)
+  {
+    RETURN_IF_FAIL(u::get_context_info(payload, local_info, nullptr, status));
+    context_info = &local_info;
+  }
+
   std::unique_lock<std::mutex> mlock(_mutex);
-  return _dict.transform_payload_and_add_objects(payload, edited_payload, object_ids, status);
+  return _dict.transform_payload_and_add_objects(payload, *context_info, edited_payload, object_ids, status);
 }
 
 action_dict_builder::action_dict_builder(dedup_state& state) : _size_estimate(0), _state(state) {}
@@ -295,10 +326,10 @@ public:
   bool is_object_extraction_enabled() const override { return _use_dedup; }
   bool is_serialization_transform_enabled() const override { return _use_compression; }
 
-  int transform_payload_and_extract_objects(string_view context, std::string& edited_payload,
-      generic_event::object_list_t& objects, api_status* status) override
+  int transform_payload_and_extract_objects(string_view context, const utility::ContextInfo* context_info,
+      std::string& edited_payload, generic_event::object_list_t& objects, api_status* status) override
   {
-    return _dedup_state.transform_payload_and_add_objects(context, edited_payload, objects, status);
+    return _dedup_state.transform_payload_and_add_objects(context, context_info, edited_payload, objects, status);
   }
 
   int transform_serialized_payload(
@@ -307,6 +338,8 @@ public:
     return _dedup_state.compress(input, content_type, status);
   }
 
+  void get_statistics(logger_statistics& stats) const override { _dedup_state.get_compression_statistics(stats); }
+
 private:
   dedup_state _dedup_state;
   int _dummy_state = 0;
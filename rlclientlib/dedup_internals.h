@@ -1,9 +1,12 @@
 #pragma once
 #include "api_status.h"
 #include "dedup.h"
+#include "logger_statistics.h"
 #include "rl_string_view.h"
+#include "utility/context_helper.h"
 #include "zstd.h"
 
+#include <atomic>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
@@ -32,6 +35,9 @@ public:
   size_t size() const;
   int transform_payload_and_add_objects(
       string_view payload, std::string& edited_payload, generic_event::object_list_t& object_ids, api_status* status);
+  //! Same as above, with the spans of the actions already found by utility::get_context_info
+  int transform_payload_and_add_objects(string_view payload, const utility::ContextInfo& context_info,
+      std::string& edited_payload, generic_event::object_list_t& object_ids, api_status* status);
 
 private:
   struct dict_entry
@@ -90,8 +96,13 @@ public:
 
   void update_ewma(float value);
   int compress(generic_event::payload_buffer_t& input, event_content_type& content_type, api_status* status) const;
+  // Sets the sizes before and after compression of the payloads compressed so far
+  void get_compression_statistics(logger_statistics& stats) const;
   int transform_payload_and_add_objects(
       string_view payload, std::string& edited_payload, generic_event::object_list_t& object_ids, api_status* status);
+  // context_info may be nullptr, the payload is analyzed then
+  int transform_payload_and_add_objects(string_view payload, const utility::ContextInfo* context_info,
+      std::string& edited_payload, generic_event::object_list_t& object_ids, api_status* status);
 
   i_time_provider* get_time_provider() { return _time_provider.get(); }
 
@@ -107,6 +118,8 @@ private:
   std::unique_ptr<i_time_provider> _time_provider;
   bool _use_compression;
   bool _use_dedup;
+  mutable std::atomic<uint64_t> _bytes_before_compression{0};
+  mutable std::atomic<uint64_t> _bytes_after_compression{0};
 };
 
 static const char* DEDUP_DICT_EVENT_ID = "3defd95a-0122-4aac-9068-0b9ac30b66d8";
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "structured_input.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace reinforcement_learning
+{
+namespace onnx
+{
+// Binary tensor framing of structured_input (see structured_input.h). It is
+// what the model reads for structured input, and for unstructured input when
+// onnx.input_format = BINARY, as an alternative to the base64 tensor notation.
+//
+// When the buffer passed to choose_rank starts at an 8 byte aligned address,
+// the tensors are handed to the ONNX Runtime in place, without any copy.
+// The context is logged as-is, so binary input should be combined with the
+// binary (flatbuffer) interaction logging.
+namespace binary_tensor
+{
+const uint32_t MAGIC = structured_input::MAGIC;
+const size_t ALIGNMENT = structured_input::ALIGNMENT;
+
+inline size_t padded_size(size_t size) { return structured_input::padded_size(size); }
+
+// Builds a buffer in the binary tensor framing. The buffer is 8 byte aligned.
+using writer = structured_input;
+}  // namespace binary_tensor
+}  // namespace onnx
+}  // namespace reinforcement_learning
@@ -15,8 +15,24 @@ namespace reinforcement_learning
 namespace name
 {
 // TODO: Explore and expose useful configuration settings here
+// false: contexts are structured_input tensors (cb_loop/ca_loop structured APIs), true: contexts are strings in
+// onnx.input_format
 const char* const ONNX_USE_UNSTRUCTURED_INPUT = "onnx.use_unstructured_input";
 const char* const ONNX_OUTPUT_NAME = "onnx.output_name";
+// Encoding of unstructured input: TENSOR_NOTATION (default) or BINARY, see onnx_binary_tensor.h
+const char* const ONNX_INPUT_FORMAT = "onnx.input_format";
+// Micro-batching of concurrent requests, for models with a dynamic batch dimension. A max size of 1 disables it.
+const char* const ONNX_BATCH_MAX_SIZE = "onnx.batch.max_size";
+const char* const ONNX_BATCH_MAX_DELAY_US = "onnx.batch.max_delay_us";
+// Session threading. 0 threads leaves the choice to the ONNX Runtime. The global thread pool is shared by all models of
+// the process and only takes effect if the ONNX Runtime environment does not exist yet.
+const char* const ONNX_INTRA_OP_THREADS = "onnx.intra_op_threads";
+const char* const ONNX_INTER_OP_THREADS = "onnx.inter_op_threads";
+const char* const ONNX_USE_GLOBAL_THREAD_POOL = "onnx.use_global_thread_pool";
+// DISABLE_ALL, BASIC, EXTENDED (default) or ALL
+const char* const ONNX_GRAPH_OPTIMIZATION_LEVEL = "onnx.graph_optimization_level";
+// Bind inputs and outputs once per session instead of on every run
+const char* const ONNX_USE_IO_BINDING = "onnx.use_io_binding";
 }  // namespace name
 }  // namespace reinforcement_learning
 
@@ -25,5 +41,11 @@ namespace reinforcement_learning
 namespace value
 {
 const char* const ONNXRUNTIME_MODEL = "ONNXRUNTIME";
-}
+const char* const ONNX_INPUT_FORMAT_TENSOR_NOTATION = "TENSOR_NOTATION";
+const char* const ONNX_INPUT_FORMAT_BINARY = "BINARY";
+const char* const ONNX_GRAPH_OPTIMIZATION_DISABLE_ALL = "DISABLE_ALL";
+const char* const ONNX_GRAPH_OPTIMIZATION_BASIC = "BASIC";
+const char* const ONNX_GRAPH_OPTIMIZATION_EXTENDED = "EXTENDED";
+const char* const ONNX_GRAPH_OPTIMIZATION_ALL = "ALL";
+}  // namespace value
 }  // namespace reinforcement_learning
\ No newline at end of file
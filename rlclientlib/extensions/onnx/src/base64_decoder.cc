@@ -0,0 +1,286 @@
+#include "base64_decoder.h"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#  define RL_BASE64_X86
+#  include <immintrin.h>
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>
+#    define RL_BASE64_TARGET(isa)
+#  else
+#    define RL_BASE64_TARGET(isa) __attribute__((target(isa)))
+#  endif
+#endif
+
+namespace reinforcement_learning
+{
+namespace onnx
+{
+namespace base64
+{
+namespace
+{
+// Any value with the high bit set marks an invalid character
+constexpr uint8_t INVALID = 0xFF;
+
+std::array<uint8_t, 256> make_decode_table()
+{
+  std::array<uint8_t, 256> table;
+  table.fill(INVALID);
+
+  for (int c = 'A'; c <= 'Z'; ++c) { table[c] = static_cast<uint8_t>(c - 'A'); }
+  for (int c = 'a'; c <= 'z'; ++c) { table[c] = static_cast<uint8_t>(c - 'a' + 26); }
+  for (int c = '0'; c <= '9'; ++c) { table[c] = static_cast<uint8_t>(c - '0' + 52); }
+  table['+'] = 62;
+  table['/'] = 63;
+
+  return table;
+}
+
+const std::array<uint8_t, 256>& decode_table()
+{
+  static const std::array<uint8_t, 256> table = make_decode_table();
+  return table;
+}
+
+inline uint8_t lookup(const std::array<uint8_t, 256>& table, char c) { return table[static_cast<uint8_t>(c)]; }
+
+// Decodes groups of 4 characters in [i, end), returns the position of the first
+// invalid character or end
+size_t decode_quads_scalar(const char* input, size_t i, size_t end, uint8_t*& out)
+{
+  const auto& table = decode_table();
+
+  for (; i < end; i += 4)
+  {
+    const uint32_t a = lookup(table, input[i]);
+    const uint32_t b = lookup(table, input[i + 1]);
+    const uint32_t c = lookup(table, input[i + 2]);
+    const uint32_t d = lookup(table, input[i + 3]);
+
+    if (((a | b | c | d) & 0x80) != 0)
+    {
+      while ((lookup(table, input[i]) & 0x80) == 0) { ++i; }
+      return i;
+    }
+
+    const uint32_t bits = (a << 18) | (b << 12) | (c << 6) | d;
+    out[0] = static_cast<uint8_t>(bits >> 16);
+    out[1] = static_cast<uint8_t>(bits >> 8);
+    out[2] = static_cast<uint8_t>(bits);
+    out += 3;
+  }
+
+  return end;
+}
+
+#ifdef RL_BASE64_X86
+// The vector decoders translate characters to 6 bit values with nibble lookups
+// (W. Mula, D. Lemire, "Faster Base64 Encoding and Decoding Using AVX2
+// Instructions"). Characters are validated by looking up the set of valid high
+// nibbles for each low nibble. Each block is 16 (or 32) characters, decoded into
+// 12 (or 24) bytes using a full vector store, so blocks are only decoded while
+// the output has room for the whole store. Decoding stops at the first block
+// containing an invalid character (including padding), the scalar decoder
+// continues from there.
+
+RL_BASE64_TARGET("sse4.1")
+size_t decode_blocks_sse41(const char* input, size_t i, size_t end, uint8_t*& out, const uint8_t* out_end)
+{
+  const __m128i shift_lut = _mm_setr_epi8(0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i valid_hi_lut = _mm_setr_epi8(static_cast<char>(0xA8), static_cast<char>(0xF8),
+      static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8),
+      static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8),
+      static_cast<char>(0xF0), 0x54, 0x50, 0x50, 0x50, 0x54);
+  const __m128i hi_bit_lut =
+      _mm_setr_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, static_cast<char>(0x80), 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+  const __m128i slash = _mm_set1_epi8('/');
+  const __m128i slash_shift = _mm_set1_epi8(16);
+  const __m128i merge_pairs = _mm_set1_epi32(0x01400140);
+  const __m128i merge_quads = _mm_set1_epi32(0x00011000);
+  const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+  for (; i + 16 <= end && out + 16 <= out_end; i += 16, out += 12)
+  {
+    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    const __m128i hi = _mm_and_si128(_mm_srli_epi32(in, 4), nibble_mask);
+    const __m128i lo = _mm_and_si128(in, nibble_mask);
+
+    const __m128i valid = _mm_and_si128(_mm_shuffle_epi8(valid_hi_lut, lo), _mm_shuffle_epi8(hi_bit_lut, hi));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(valid, _mm_setzero_si128())) != 0) { break; }
+
+    const __m128i shift = _mm_blendv_epi8(_mm_shuffle_epi8(shift_lut, hi), slash_shift, _mm_cmpeq_epi8(in, slash));
+    const __m128i values = _mm_add_epi8(in, shift);
+    const __m128i merged = _mm_madd_epi16(_mm_maddubs_epi16(values, merge_pairs), merge_quads);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(merged, pack));
+  }
+
+  return i;
+}
+
+RL_BASE64_TARGET("avx2")
+size_t decode_blocks_avx2(const char* input, size_t i, size_t end, uint8_t*& out, const uint8_t* out_end)
+{
+  const __m256i shift_lut = _mm256_setr_epi8(0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 19, 4,
+      -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m256i valid_hi_lut = _mm256_setr_epi8(static_cast<char>(0xA8), static_cast<char>(0xF8),
+      static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8),
+      static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8),
+      static_cast<char>(0xF0), 0x54, 0x50, 0x50, 0x50, 0x54, static_cast<char>(0xA8), static_cast<char>(0xF8),
+      static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8),
+      static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8),
+      static_cast<char>(0xF0), 0x54, 0x50, 0x50, 0x50, 0x54);
+  const __m256i hi_bit_lut = _mm256_setr_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, static_cast<char>(0x80), 0, 0,
+      0, 0, 0, 0, 0, 0, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, static_cast<char>(0x80), 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+  const __m256i slash = _mm256_set1_epi8('/');
+  const __m256i slash_shift = _mm256_set1_epi8(16);
+  const __m256i merge_pairs = _mm256_set1_epi32(0x01400140);
+  const __m256i merge_quads = _mm256_set1_epi32(0x00011000);
+  const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5, 4, 10,
+      9, 8, 14, 13, 12, -1, -1, -1, -1);
+  // moves the 12 bytes of the upper lane next to the 12 bytes of the lower lane
+  const __m256i join_lanes = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+
+  for (; i + 32 <= end && out + 32 <= out_end; i += 32, out += 24)
+  {
+    const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+    const __m256i hi = _mm256_and_si256(_mm256_srli_epi32(in, 4), nibble_mask);
+    const __m256i lo = _mm256_and_si256(in, nibble_mask);
+
+    const __m256i valid =
+        _mm256_and_si256(_mm256_shuffle_epi8(valid_hi_lut, lo), _mm256_shuffle_epi8(hi_bit_lut, hi));
+    if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(valid, _mm256_setzero_si256())) != 0) { break; }
+
+    const __m256i shift =
+        _mm256_blendv_epi8(_mm256_shuffle_epi8(shift_lut, hi), slash_shift, _mm256_cmpeq_epi8(in, slash));
+    const __m256i values = _mm256_add_epi8(in, shift);
+    const __m256i merged = _mm256_madd_epi16(_mm256_maddubs_epi16(values, merge_pairs), merge_quads);
+    const __m256i packed = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(merged, pack), join_lanes);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), packed);
+  }
+
+  return i;
+}
+
+decoder_isa detect_isa()
+{
+#  if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  const int max_leaf = info[0];
+
+  __cpuid(info, 1);
+  const bool sse41 = (info[2] & (1 << 19)) != 0;
+  const bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+
+  bool avx2 = false;
+  if (max_leaf >= 7 && os_saves_ymm)
+  {
+    __cpuidex(info, 7, 0);
+    avx2 = (info[1] & (1 << 5)) != 0;
+  }
+#  else
+  __builtin_cpu_init();
+  const bool sse41 = __builtin_cpu_supports("sse4.1") != 0;
+  const bool avx2 = __builtin_cpu_supports("avx2") != 0;
+#  endif
+
+  if (avx2) { return decoder_isa::avx2; }
+  if (sse41) { return decoder_isa::sse41; }
+  return decoder_isa::scalar;
+}
+#else
+decoder_isa detect_isa() { return decoder_isa::scalar; }
+#endif
+
+size_t data_length(const char* input, size_t length)
+{
+  const auto* padding = static_cast<const char*>(std::memchr(input, '=', length));
+  return padding == nullptr ? length : static_cast<size_t>(padding - input);
+}
+
+bool fail(decode_error& error, decode_error::kind kind, size_t position, char character, size_t count)
+{
+  error.error = kind;
+  error.position = position;
+  error.character = character;
+  error.count = count;
+  return false;
+}
+}  // namespace
+
+decoder_isa supported_isa()
+{
+  static const decoder_isa isa = detect_isa();
+  return isa;
+}
+
+size_t decoded_size(const char* input, size_t length)
+{
+  const size_t data = data_length(input, length);
+  switch (length - data)
+  {
+    case 1:
+      return (data / 4) * 3 + 2;
+    case 2:
+      return (data / 4) * 3 + 1;
+    default:
+      return (data / 4) * 3;
+  }
+}
+
+bool decode(const char* input, size_t length, uint8_t* output, decode_error& error)
+{
+  return decode(supported_isa(), input, length, output, error);
+}
+
+bool decode(decoder_isa isa, const char* input, size_t length, uint8_t* output, decode_error& error)
+{
+  error = decode_error{};
+
+  const size_t data = data_length(input, length);
+  const size_t quads_end = data - data % 4;
+  const size_t padding_count = length - data;
+
+  uint8_t* out = output;
+  size_t i = 0;
+
+#ifdef RL_BASE64_X86
+  if (static_cast<int>(isa) > static_cast<int>(supported_isa())) { isa = supported_isa(); }
+
+  const uint8_t* out_end = output + decoded_size(input, length);
+  if (isa == decoder_isa::avx2) { i = decode_blocks_avx2(input, i, quads_end, out, out_end); }
+  if (isa != decoder_isa::scalar) { i = decode_blocks_sse41(input, i, quads_end, out, out_end); }
+#else
+  static_cast<void>(isa);
+#endif
+
+  i = decode_quads_scalar(input, i, quads_end, out);
+  if (i != quads_end) { return fail(error, decode_error::kind::invalid_character, i, input[i], 0); }
+
+  // characters of the last, padded, group
+  const auto& table = decode_table();
+  uint32_t bits = 0;
+  for (; i < data; ++i)
+  {
+    const uint8_t value = lookup(table, input[i]);
+    if ((value & 0x80) != 0) { return fail(error, decode_error::kind::invalid_character, i, input[i], 0); }
+    bits = (bits << 6) | value;
+  }
+
+  if (length % 4 != 0) { return fail(error, decode_error::kind::invalid_length, length, '\0', length); }
+  if (padding_count > 2) { return fail(error, decode_error::kind::invalid_padding, length, '\0', padding_count); }
+
+  bits <<= 6 * padding_count;
+  if (padding_count > 0) { *out++ = static_cast<uint8_t>(bits >> 16); }
+  if (padding_count == 1) { *out++ = static_cast<uint8_t>(bits >> 8); }
+
+  return true;
+}
+}  // namespace base64
+}  // namespace onnx
+}  // namespace reinforcement_learning
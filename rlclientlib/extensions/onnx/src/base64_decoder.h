@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace reinforcement_learning
+{
+namespace onnx
+{
+// Bulk base64 decoder used by the tensor notation parser.
+//
+// The input is validated and decoded in a single pass, straight into a caller
+// provided buffer sized with decoded_size(). Full blocks are decoded with
+// AVX2 or SSE4.1 when the CPU supports it (detected once at runtime), the rest
+// of the input and any block containing padding or an invalid character goes
+// through the scalar table decoder, which also determines the exact error.
+//
+// Padding follows the historical tensor notation rules: everything after the
+// first '=' counts as padding, at most two padding characters are allowed and
+// the total number of characters must be a multiple of 4.
+namespace base64
+{
+enum class decoder_isa
+{
+  scalar,
+  sse41,
+  avx2
+};
+
+struct decode_error
+{
+  enum class kind
+  {
+    none,
+    invalid_character,  // character and position are set
+    invalid_length,     // count is the number of characters
+    invalid_padding     // count is the number of padding characters
+  };
+
+  kind error = kind::none;
+  size_t position = 0;
+  char character = '\0';
+  size_t count = 0;
+};
+
+// Number of bytes the input decodes to, assuming it is valid
+size_t decoded_size(const char* input, size_t length);
+
+// Decodes length characters into output, which must have room for
+// decoded_size(input, length) bytes. Returns false and fills in error if the
+// input is not valid base64, the content of output is unspecified in that case.
+bool decode(const char* input, size_t length, uint8_t* output, decode_error& error);
+
+// Same as decode, forcing a specific implementation. Requesting an instruction
+// set the CPU does not support falls back to the best supported one.
+bool decode(decoder_isa isa, const char* input, size_t length, uint8_t* output, decode_error& error);
+
+// Best instruction set supported by this CPU and build
+decoder_isa supported_isa();
+}  // namespace base64
+}  // namespace onnx
+}  // namespace reinforcement_learning
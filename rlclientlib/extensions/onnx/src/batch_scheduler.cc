@@ -0,0 +1,216 @@
+#include "batch_scheduler.h"
+
+#include "err_constants.h"
+#include "trace_logger.h"
+#include "vw/core/scope_exit.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace reinforcement_learning
+{
+namespace onnx
+{
+static const OrtApi& OnnxRuntimeCApi = Ort::GetApi();
+
+int run_session(Ort::Session& session, const char* const* input_names, const Ort::Value* inputs, size_t input_count,
+    const char* output_name, std::vector<float>& output, i_trace* trace_logger, api_status* status)
+{
+  // Use the C API to avoid an unneeded throw in the error case
+  OrtValue* onnx_output = nullptr;
+
+  // This cast-chain is taken from the OnnxRuntime code implementation of the C++ API of Ort::Session::Run().
+  auto ort_input_values = reinterpret_cast<const OrtValue* const*>(inputs);
+
+  OrtStatus* run_status = OnnxRuntimeCApi.Run(
+      session.operator OrtSession*(),  // Unwrap the underlying C reference to pass to the C API
+      Ort::RunOptions{nullptr}, input_names, ort_input_values,
+      input_count,                     // Inputs: Names, Values, Count
+      &output_name, 1, &onnx_output);  // Outputs: Names, Count, Values; note the inconsistency
+
+  if (run_status)
+  {
+    auto release_guard = VW::scope_exit([&run_status] { OnnxRuntimeCApi.ReleaseStatus(run_status); });
+    RETURN_ERROR_LS(trace_logger, status, extension_error) << OnnxRuntimeCApi.GetErrorMessage(run_status);
+  }
+
+  // Re-wrap in Ort::Value to ensure proper destruction (no point in using VW::scope_exit, since we allocate either way)
+  Ort::Value target_output = Ort::Value(onnx_output);
+
+  size_t num_elements = target_output.GetTensorTypeAndShapeInfo().GetElementCount();
+  const float* floatarr = target_output.GetTensorData<float>();
+  output.assign(floatarr, floatarr + num_elements);
+
+  return error_code::success;
+}
+
+size_t batch_rows(const std::vector<Ort::Value>& inputs)
+{
+  size_t rows = 0;
+  for (const auto& input : inputs)
+  {
+    const auto shape = input.GetTensorTypeAndShapeInfo().GetShape();
+    if (shape.empty() || shape[0] <= 0) { return 0; }
+    if (rows != 0 && rows != static_cast<size_t>(shape[0])) { return 0; }
+    rows = static_cast<size_t>(shape[0]);
+  }
+  return rows;
+}
+
+batch_scheduler::batch_scheduler(const batching_options& options, i_trace* trace_logger)
+    : _options(options)
+    , _trace_logger(trace_logger)
+    , _memory_info(Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault))
+{
+}
+
+int batch_scheduler::run(const std::shared_ptr<Ort::Session>& session, const std::vector<const char*>& input_names,
+    const std::vector<Ort::Value>& inputs, const char* output_name, std::vector<float>& output, api_status* status)
+{
+  const size_t rows = batch_rows(inputs);
+  if (rows == 0 || rows >= _options.max_size)
+  {
+    return run_session(
+        *session, input_names.data(), inputs.data(), inputs.size(), output_name, output, _trace_logger, status);
+  }
+
+  std::unique_lock<std::mutex> lock(_mutex);
+
+  std::shared_ptr<batch> current = _open;
+  const bool leader = !current || !accepts(*current, session, input_names, inputs, output_name, rows);
+  if (leader)
+  {
+    // An open batch that does not accept this request is left to its leader, which runs it once its delay expires
+    current = std::make_shared<batch>();
+    current->session = session;
+    current->input_names.assign(input_names.begin(), input_names.end());
+    current->output_name = output_name;
+    for (const auto& input : inputs) { current->shapes.push_back(input.GetTensorTypeAndShapeInfo().GetShape()); }
+    _open = current;
+  }
+
+  current->requests.push_back({&inputs, &output, rows});
+  current->rows += rows;
+  if (current->rows >= _options.max_size)
+  {
+    current->closed = true;
+    if (_open == current) { _open.reset(); }
+    current->cv.notify_all();
+  }
+
+  if (leader)
+  {
+    current->cv.wait_for(lock, _options.max_delay, [&current] { return current->closed; });
+    current->closed = true;
+    if (_open == current) { _open.reset(); }
+
+    lock.unlock();
+    execute(*current);
+    lock.lock();
+
+    current->done = true;
+    current->cv.notify_all();
+  }
+  else { current->cv.wait(lock, [&current] { return current->done; }); }
+
+  if (current->result != error_code::success)
+  {
+    api_status::try_update(status, current->result, current->error.c_str());
+    return current->result;
+  }
+
+  return error_code::success;
+}
+
+bool batch_scheduler::accepts(const batch& b, const std::shared_ptr<Ort::Session>& session,
+    const std::vector<const char*>& input_names, const std::vector<Ort::Value>& inputs, const char* output_name,
+    size_t rows) const
+{
+  if (b.closed || b.session != session || b.rows + rows > _options.max_size) { return false; }
+  if (b.output_name != output_name || b.input_names.size() != input_names.size()) { return false; }
+
+  for (size_t i = 0; i < inputs.size(); i++)
+  {
+    if (b.input_names[i] != input_names[i]) { return false; }
+
+    const auto shape = inputs[i].GetTensorTypeAndShapeInfo().GetShape();
+    const auto& batch_shape = b.shapes[i];
+    if (shape.size() != batch_shape.size() || !std::equal(shape.begin() + 1, shape.end(), batch_shape.begin() + 1))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void batch_scheduler::execute(batch& b)
+{
+  api_status status;
+  std::vector<const char*> input_names;
+  for (const auto& name : b.input_names) { input_names.push_back(name.c_str()); }
+
+  if (b.requests.size() == 1)
+  {
+    const auto& r = b.requests.front();
+    b.result = run_session(*b.session, input_names.data(), r.inputs->data(), r.inputs->size(), b.output_name.c_str(),
+        *r.output, _trace_logger, &status);
+    b.error = status.get_error_msg();
+    return;
+  }
+
+  // Concatenate the inputs of all requests along the batch dimension
+  std::vector<std::vector<float>> buffers(input_names.size());
+  std::vector<Ort::Value> inputs;
+  inputs.reserve(input_names.size());
+
+  for (size_t i = 0; i < input_names.size(); i++)
+  {
+    std::vector<int64_t> shape = b.shapes[i];
+    size_t row_size = 1;
+    for (size_t d = 1; d < shape.size(); d++) { row_size *= static_cast<size_t>(shape[d]); }
+    shape[0] = static_cast<int64_t>(b.rows);
+
+    auto& buffer = buffers[i];
+    buffer.resize(b.rows * row_size);
+    float* target = buffer.data();
+    for (const auto& r : b.requests)
+    {
+      const size_t count = r.rows * row_size;
+      if (count > 0) { std::memcpy(target, (*r.inputs)[i].GetTensorData<float>(), count * sizeof(float)); }
+      target += count;
+    }
+
+    inputs.push_back(
+        Ort::Value::CreateTensor<float>(_memory_info, buffer.data(), buffer.size(), shape.data(), shape.size()));
+  }
+
+  std::vector<float> output;
+  b.result = run_session(*b.session, input_names.data(), inputs.data(), inputs.size(), b.output_name.c_str(), output,
+      _trace_logger, &status);
+  if (b.result != error_code::success)
+  {
+    b.error = status.get_error_msg();
+    return;
+  }
+
+  // Hand out the output rows
+  if (output.size() % b.rows != 0)
+  {
+    b.result = error_code::extension_error;
+    b.error = "Batched output does not have the batch dimension of the input. Disable batching for this model.";
+    TRACE_ERROR(_trace_logger, b.error);
+    return;
+  }
+
+  const size_t output_row_size = output.size() / b.rows;
+  auto source = output.cbegin();
+  for (const auto& r : b.requests)
+  {
+    const auto count = static_cast<std::ptrdiff_t>(r.rows * output_row_size);
+    r.output->assign(source, source + count);
+    source += count;
+  }
+}
+}  // namespace onnx
+}  // namespace reinforcement_learning
@@ -0,0 +1,110 @@
+#pragma once
+#include "api_status.h"
+
+#include <onnxruntime_cxx_api.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace reinforcement_learning
+{
+class i_trace;
+}
+
+namespace reinforcement_learning
+{
+namespace onnx
+{
+/**
+ * Runs the session on the given inputs and copies the (float) output tensor
+ * with the given name to output.
+ */
+int run_session(Ort::Session& session, const char* const* input_names, const Ort::Value* inputs, size_t input_count,
+    const char* output_name, std::vector<float>& output, i_trace* trace_logger, api_status* status = nullptr);
+
+struct batching_options
+{
+  // Maximum number of rows (summed over requests) in a batched run, 1 disables batching
+  size_t max_size = 1;
+  // Maximum time the first request of a batch waits for more requests
+  std::chrono::microseconds max_delay{200};
+};
+
+/**
+ * Coalesces concurrent inference requests into a single run of the session.
+ *
+ * Requests are batched along the first dimension of their inputs, so the
+ * model has to accept a dynamic batch dimension on all inputs and produce an
+ * output with the same batch dimension. Only requests for the same session,
+ * with the same input names and the same shape apart from the batch dimension
+ * are batched together.
+ *
+ * There is no scheduling thread: the first request of a batch becomes its
+ * leader, waits until the batch is full or max_delay has elapsed, runs it
+ * and hands every request its slice of the output. Requests arriving while a
+ * batch is running start the next batch.
+ */
+class batch_scheduler
+{
+public:
+  batch_scheduler(const batching_options& options, i_trace* trace_logger);
+
+  batch_scheduler(const batch_scheduler&) = delete;
+  batch_scheduler& operator=(const batch_scheduler&) = delete;
+
+  // Blocks until the batch containing this request ran. output receives this request's rows.
+  int run(const std::shared_ptr<Ort::Session>& session, const std::vector<const char*>& input_names,
+      const std::vector<Ort::Value>& inputs, const char* output_name, std::vector<float>& output,
+      api_status* status = nullptr);
+
+  const batching_options& options() const { return _options; }
+
+private:
+  struct request
+  {
+    const std::vector<Ort::Value>* inputs;
+    std::vector<float>* output;
+    size_t rows;
+  };
+
+  struct batch
+  {
+    std::shared_ptr<Ort::Session> session;
+    std::vector<std::string> input_names;
+    std::string output_name;
+    // shapes of the first request, the batch dimension is ignored when matching
+    std::vector<std::vector<int64_t>> shapes;
+
+    std::vector<request> requests;
+    size_t rows = 0;
+
+    bool closed = false;
+    bool done = false;
+    int result = 0;
+    std::string error;
+    std::condition_variable cv;
+  };
+
+  bool accepts(const batch& b, const std::shared_ptr<Ort::Session>& session,
+      const std::vector<const char*>& input_names, const std::vector<Ort::Value>& inputs, const char* output_name,
+      size_t rows) const;
+  void execute(batch& b);
+
+  const batching_options _options;
+  i_trace* _trace_logger;
+  Ort::MemoryInfo _memory_info;
+
+  std::mutex _mutex;
+  // batch currently accepting requests
+  std::shared_ptr<batch> _open;
+};
+
+// Number of rows (leading dimension shared by all inputs), 0 if the inputs can not be batched
+size_t batch_rows(const std::vector<Ort::Value>& inputs);
+}  // namespace onnx
+}  // namespace reinforcement_learning
@@ -0,0 +1,117 @@
+#include "binary_tensor_reader.h"
+
+#include "err_constants.h"
+#include "onnx_binary_tensor.h"
+#include "trace_logger.h"
+
+#include <cstring>
+#include <limits>
+
+namespace reinforcement_learning
+{
+namespace onnx
+{
+namespace
+{
+inline uint32_t read_u32(const char* data)
+{
+  uint32_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+}  // namespace
+
+int read_binary_tensors(string_view input, const Ort::MemoryInfo& memory_info, std::vector<const char*>& input_names,
+    std::vector<Ort::Value>& inputs, std::vector<uint64_t>& aligned_storage, i_trace* trace_logger, api_status* status)
+{
+  const size_t size = input.size();
+  const char* data = input.data();
+
+  if (size < 2 * sizeof(uint32_t) || read_u32(data) != binary_tensor::MAGIC)
+  {
+    RETURN_ERROR_LS(trace_logger, status, extension_error)
+        << "OnnxExtension: Failed to deserialize binary input: missing binary tensor header.";
+  }
+
+  if (reinterpret_cast<uintptr_t>(data) % binary_tensor::ALIGNMENT != 0)
+  {
+    aligned_storage.resize(binary_tensor::padded_size(size) / sizeof(uint64_t));
+    std::memcpy(aligned_storage.data(), data, size);
+    data = reinterpret_cast<const char*>(aligned_storage.data());
+  }
+
+  const uint32_t tensor_count = read_u32(data + sizeof(uint32_t));
+  input_names.reserve(tensor_count);
+  inputs.reserve(tensor_count);
+
+  size_t offset = 2 * sizeof(uint32_t);
+  for (uint32_t i = 0; i < tensor_count; i++)
+  {
+    if (size - offset < 2 * sizeof(uint32_t))
+    {
+      RETURN_ERROR_LS(trace_logger, status, extension_error)
+          << "OnnxExtension: Failed to deserialize binary input: tensor " << i << " is truncated.";
+    }
+
+    const size_t name_length = read_u32(data + offset);
+    const size_t rank = read_u32(data + offset + sizeof(uint32_t));
+    offset += 2 * sizeof(uint32_t);
+
+    const size_t name_size = binary_tensor::padded_size(name_length + 1);
+    if (size - offset < name_size || data[offset + name_length] != '\0')
+    {
+      RETURN_ERROR_LS(trace_logger, status, extension_error)
+          << "OnnxExtension: Failed to deserialize binary input: invalid name for tensor " << i << ".";
+    }
+    const char* name = data + offset;
+    offset += name_size;
+
+    if ((size - offset) / sizeof(int64_t) < rank)
+    {
+      RETURN_ERROR_LS(trace_logger, status, extension_error)
+          << "OnnxExtension: Failed to deserialize binary input: dimensions of input '" << name << "' are truncated.";
+    }
+    const auto* dimensions = reinterpret_cast<const int64_t*>(data + offset);
+    offset += rank * sizeof(int64_t);
+
+    // Same convention as the tensor notation: a rank 0 tensor has no values
+    size_t value_count = rank == 0 ? 0 : 1;
+    for (size_t d = 0; d < rank; d++)
+    {
+      if (dimensions[d] < 0 ||
+          (dimensions[d] > 0 &&
+              value_count > std::numeric_limits<size_t>::max() / sizeof(float) / static_cast<size_t>(dimensions[d])))
+      {
+        RETURN_ERROR_LS(trace_logger, status, extension_error)
+            << "OnnxExtension: Failed to deserialize binary input: invalid dimension " << dimensions[d]
+            << " for input '" << name << "'.";
+      }
+      value_count *= static_cast<size_t>(dimensions[d]);
+    }
+
+    const size_t values_size = binary_tensor::padded_size(value_count * sizeof(float));
+    if (size - offset < values_size)
+    {
+      RETURN_ERROR_LS(trace_logger, status, extension_error)
+          << "OnnxExtension: Failed to deserialize binary input: values of input '" << name
+          << "' are truncated. Expecting " << value_count << " elements.";
+    }
+
+    // The ONNX Runtime does not write to input tensors
+    auto* values = reinterpret_cast<float*>(const_cast<char*>(data + offset));
+    offset += values_size;
+
+    input_names.push_back(name);
+    inputs.push_back(Ort::Value::CreateTensor<float>(memory_info, values, value_count, dimensions, rank));
+  }
+
+  if (offset != size)
+  {
+    RETURN_ERROR_LS(trace_logger, status, extension_error)
+        << "OnnxExtension: Failed to deserialize binary input: " << (size - offset) << " unexpected trailing bytes.";
+  }
+
+  return error_code::success;
+}
+}  // namespace onnx
+}  // namespace reinforcement_learning
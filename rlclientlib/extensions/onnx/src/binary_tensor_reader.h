@@ -0,0 +1,30 @@
+#pragma once
+#include "api_status.h"
+#include "rl_string_view.h"
+
+#include <onnxruntime_cxx_api.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace reinforcement_learning
+{
+class i_trace;
+}
+
+namespace reinforcement_learning
+{
+namespace onnx
+{
+/**
+ * Reads input in the binary tensor framing (see onnx_binary_tensor.h).
+ *
+ * Input names and tensors point into the input buffer, which has to outlive
+ * them. If the buffer is not 8 byte aligned it is first copied to
+ * aligned_storage, which then has to outlive them instead.
+ */
+int read_binary_tensors(string_view input, const Ort::MemoryInfo& memory_info, std::vector<const char*>& input_names,
+    std::vector<Ort::Value>& inputs, std::vector<uint64_t>& aligned_storage, i_trace* trace_logger,
+    api_status* status = nullptr);
+}  // namespace onnx
+}  // namespace reinforcement_learning
@@ -8,6 +8,9 @@
 #include "model_mgmt.h"
 #include "onnx_model.h"
 
+#include <chrono>
+#include <cstring>
+
 namespace m = reinforcement_learning::model_management;
 namespace u = reinforcement_learning::utility;
 
@@ -28,7 +31,64 @@ int create_onnx_model(
 
   bool use_unstructured_input = config.get_bool(name::ONNX_USE_UNSTRUCTURED_INPUT, false);
 
-  retval.reset(new onnx_model(trace_logger, app_id, output_name, use_unstructured_input));
+  onnx_model_options options;
+  const char* format_name = config.get(name::ONNX_INPUT_FORMAT, value::ONNX_INPUT_FORMAT_TENSOR_NOTATION);
+  if (std::strcmp(format_name, value::ONNX_INPUT_FORMAT_BINARY) == 0) { options.format = input_format::binary; }
+  else if (std::strcmp(format_name, value::ONNX_INPUT_FORMAT_TENSOR_NOTATION) != 0)
+  {
+    RETURN_ERROR_LS(trace_logger, status, inference_configuration_error)
+        << "Unknown input format '" << format_name << "'. Expected " << value::ONNX_INPUT_FORMAT_TENSOR_NOTATION
+        << " or " << value::ONNX_INPUT_FORMAT_BINARY << ".";
+  }
+
+  const int batch_max_size = config.get_int(name::ONNX_BATCH_MAX_SIZE, 1);
+  const int batch_max_delay = config.get_int(name::ONNX_BATCH_MAX_DELAY_US, 200);
+  if (batch_max_size < 1 || batch_max_delay < 0)
+  {
+    RETURN_ERROR_LS(trace_logger, status, inference_configuration_error)
+        << name::ONNX_BATCH_MAX_SIZE << " must be at least 1 and " << name::ONNX_BATCH_MAX_DELAY_US
+        << " must not be negative.";
+  }
+  options.batching.max_size = static_cast<size_t>(batch_max_size);
+  options.batching.max_delay = std::chrono::microseconds(batch_max_delay);
+
+  options.intra_op_threads = config.get_int(name::ONNX_INTRA_OP_THREADS, 0);
+  options.inter_op_threads = config.get_int(name::ONNX_INTER_OP_THREADS, 0);
+  if (options.intra_op_threads < 0 || options.inter_op_threads < 0)
+  {
+    RETURN_ERROR_LS(trace_logger, status, inference_configuration_error)
+        << name::ONNX_INTRA_OP_THREADS << " and " << name::ONNX_INTER_OP_THREADS << " must not be negative.";
+  }
+  options.use_global_thread_pool = config.get_bool(name::ONNX_USE_GLOBAL_THREAD_POOL, false);
+
+  const char* level_name = config.get(name::ONNX_GRAPH_OPTIMIZATION_LEVEL, value::ONNX_GRAPH_OPTIMIZATION_EXTENDED);
+  if (std::strcmp(level_name, value::ONNX_GRAPH_OPTIMIZATION_DISABLE_ALL) == 0)
+  {
+    options.optimization_level = GraphOptimizationLevel::ORT_DISABLE_ALL;
+  }
+  else if (std::strcmp(level_name, value::ONNX_GRAPH_OPTIMIZATION_BASIC) == 0)
+  {
+    options.optimization_level = GraphOptimizationLevel::ORT_ENABLE_BASIC;
+  }
+  else if (std::strcmp(level_name, value::ONNX_GRAPH_OPTIMIZATION_EXTENDED) == 0)
+  {
+    options.optimization_level = GraphOptimizationLevel::ORT_ENABLE_EXTENDED;
+  }
+  else if (std::strcmp(level_name, value::ONNX_GRAPH_OPTIMIZATION_ALL) == 0)
+  {
+    options.optimization_level = GraphOptimizationLevel::ORT_ENABLE_ALL;
+  }
+  else
+  {
+    RETURN_ERROR_LS(trace_logger, status, inference_configuration_error)
+        << "Unknown graph optimization level '" << level_name << "'. Expected "
+        << value::ONNX_GRAPH_OPTIMIZATION_DISABLE_ALL << ", " << value::ONNX_GRAPH_OPTIMIZATION_BASIC << ", "
+        << value::ONNX_GRAPH_OPTIMIZATION_EXTENDED << " or " << value::ONNX_GRAPH_OPTIMIZATION_ALL << ".";
+  }
+
+  options.use_io_binding = config.get_bool(name::ONNX_USE_IO_BINDING, false);
+
+  retval.reset(new onnx_model(trace_logger, app_id, output_name, use_unstructured_input, options));
 
   return error_code::success;
 };
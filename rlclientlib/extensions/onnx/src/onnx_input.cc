@@ -17,7 +17,7 @@ std::vector<const char*> onnx_input_builder::input_names() const
   std::vector<const char*> result;
   result.reserve(input_count());
 
-  std::for_each(_input_names.cbegin(), _input_names.cend(),
+  std::for_each(_input_names.cbegin(), _input_names.cbegin() + _count,
       [&result, &count](const std::string& str) { result.push_back(str.c_str()); });
 
   return result;
@@ -32,10 +32,11 @@ int onnx_input_builder::allocate_inputs(
 
   bool failed = false;
 
-  for (const tensor_data_t& tensor : _inputs)
+  for (size_t i = 0; i < _count; i++)
   {
+    const tensor_data_t& tensor = _inputs[i];
     const bytes_t& dimensions_bytes = tensor.first;
-    const bytes_t& values_bytes = tensor.second;
+    const values_t& values = tensor.second;
 
     // Unpack the dimensions
     size_t rank;
@@ -51,18 +52,18 @@ int onnx_input_builder::allocate_inputs(
     size_t expected_values_count =
         rank == 0 ? 0 : std::accumulate(dimensions, dimensions + rank, 1, std::multiplies<size_t>());
 
-    // Unpack the data
-    size_t values_count = 0;
-    if (!check_array_size<value_t>(values_bytes, expected_values_count, values_count))
+    // The parser already checked that the values are a whole number of elements
+    const size_t values_count = values.size();
+    if (values_count != expected_values_count)
     {
       RETURN_ERROR_LS(_trace_logger, status, extension_error)
-          << "Invalid tensor value packing/data for input '" << _input_names[result.size()]
-          << "'. Expecting multiple of " << sizeof(int64_t) << ". Got " << values_bytes.size() << ". Expecting "
+          << "Invalid tensor value data for input '" << _input_names[result.size()] << "'. Expecting "
           << expected_values_count << " elements. Got " << values_count << ".";
     }
 
-    value_t* values = (value_t*)values_bytes.data();
-    result.push_back(std::move(Ort::Value::CreateTensor<value_t>(memory_info, values, values_count, dimensions, rank)));
+    value_t* values_data = (value_t*)values.data();
+    result.push_back(
+        std::move(Ort::Value::CreateTensor<value_t>(memory_info, values_data, values_count, dimensions, rank)));
   }
 
   return error_code::success;
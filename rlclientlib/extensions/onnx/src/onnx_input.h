@@ -14,7 +14,14 @@ namespace onnx
 {
 using byte_t = unsigned char;
 using bytes_t = std::vector<byte_t>;
-using tensor_data_t = std::pair<bytes_t, bytes_t>;
+
+// TODO: Support reading type information for the tensor (and later map/sequence)
+using value_t = float;
+using values_t = std::vector<value_t>;
+
+// The dimensions bytes and the values of a tensor. The values are decoded straight into a float buffer, so that the
+// tensor can be created over it without a copy.
+using tensor_data_t = std::pair<bytes_t, values_t>;
 
 /**
  * Check whether the provided bytes map exactly to a whole number of elements
@@ -40,9 +47,6 @@ inline bool check_array_size(const bytes_t& bytes, size_t expected_element_count
   return check_array_packing<element_t>(bytes, element_count) && (element_count == expected_element_count);
 }
 
-// TODO: Support reading type information for the tensor (and later map/sequence)
-using value_t = float;
-
 class onnx_input_builder
 {
 public:
@@ -55,18 +59,38 @@ public:
 
   inline size_t input_count() const { return count(); }
 
-  inline size_t count() const { return _inputs.size(); }
+  inline size_t count() const { return _count; }
 
 public:
   inline void push_input(const std::string& input_name, const tensor_data_t& input)
   {
-    _input_names.push_back(input_name);
-    _inputs.push_back(input);
+    append_input(input_name) = input;
+  }
+
+  // Adds an input and returns its (empty) data. The buffers of inputs removed
+  // by clear() are reused, so filling them does not allocate once warmed up.
+  inline tensor_data_t& append_input(std::string input_name)
+  {
+    if (_count == _inputs.size())
+    {
+      _input_names.emplace_back();
+      _inputs.emplace_back();
+    }
+
+    _input_names[_count] = std::move(input_name);
+    tensor_data_t& input = _inputs[_count++];
+    input.first.clear();
+    input.second.clear();
+    return input;
   }
 
+  // Removes all inputs, keeping their buffers for reuse
+  inline void clear() { _count = 0; }
+
 private:
   std::vector<std::string> _input_names{};
   std::vector<tensor_data_t> _inputs{};
+  size_t _count = 0;
 
   i_trace* _trace_logger;
 };
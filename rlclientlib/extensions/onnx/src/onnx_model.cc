@@ -1,6 +1,7 @@
 #include "onnx_model.h"
 
 #include "api_status.h"
+#include "binary_tensor_reader.h"
 #include "err_constants.h"
 #include "factory_resolver.h"
 #include "onnx_input.h"
@@ -8,6 +9,7 @@
 #include "trace_logger.h"
 #include "vw/core/scope_exit.h"
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 
@@ -18,12 +20,9 @@ namespace onnx
 // This is used for statically introspecting the model. It will be used regardless of whether the actual
 // inference is done on CPU/GPU/Accelerator.
 static Ort::AllocatorWithDefaultOptions DefaultOnnxAllocator;
-static const OrtApi& OnnxRuntimeCApi = Ort::GetApi();
 
-inline void OrtLogCallback(void* param, OrtLoggingLevel severity, const char* category, const char* logid,
-    const char* code_location, const char* message)
+inline void trace_ort_message(i_trace* trace_logger, OrtLoggingLevel severity, const char* logid, const char* message)
 {
-  i_trace* trace_logger = static_cast<i_trace*>(param);
   if ((trace_logger) == nullptr) { return; }
 
   int loglevel = LEVEL_ERROR;
@@ -53,21 +52,94 @@ inline void OrtLogCallback(void* param, OrtLoggingLevel severity, const char* ca
   TRACE_LOG(trace_logger, loglevel, buf.str());
 }
 
-onnx_model::onnx_model(i_trace* trace_logger, const char* app_id, const char* output_name, bool use_unstructured_input)
+std::shared_ptr<shared_env> shared_env::acquire(
+    const char* app_id, const onnx_model_options& options, i_trace* trace_logger)
+{
+  static std::mutex instance_mutex;
+  static std::weak_ptr<shared_env> instance;
+
+  std::lock_guard<std::mutex> lock(instance_mutex);
+  std::shared_ptr<shared_env> env = instance.lock();
+  if (env)
+  {
+    std::lock_guard<std::mutex> trace_loggers_lock(env->_trace_loggers_mutex);
+    if (trace_logger != nullptr) { env->_trace_loggers.push_back(trace_logger); }
+    return env;
+  }
+
+  env.reset(new shared_env());
+  if (trace_logger != nullptr) { env->_trace_loggers.push_back(trace_logger); }
+  env->_global_thread_pool = options.use_global_thread_pool;
+  if (!options.use_global_thread_pool)
+  {
+    env->_env.reset(new Ort::Env(ORT_LOGGING_LEVEL_VERBOSE, app_id, &shared_env::log, env.get()));
+  }
+  else
+  {
+    Ort::ThreadingOptions threading_options;
+    threading_options.SetGlobalIntraOpNumThreads(options.intra_op_threads);
+    threading_options.SetGlobalInterOpNumThreads(options.inter_op_threads);
+    env->_env.reset(
+        new Ort::Env(threading_options, &shared_env::log, env.get(), ORT_LOGGING_LEVEL_VERBOSE, app_id));
+  }
+
+  instance = env;
+  return env;
+}
+
+void shared_env::release_trace_logger(i_trace* trace_logger)
+{
+  std::lock_guard<std::mutex> lock(_trace_loggers_mutex);
+  const auto it = std::find(_trace_loggers.begin(), _trace_loggers.end(), trace_logger);
+  if (it != _trace_loggers.end()) { _trace_loggers.erase(it); }
+}
+
+void shared_env::log(void* param, OrtLoggingLevel severity, const char* /*category*/, const char* logid,
+    const char* /*code_location*/, const char* message)
+{
+  auto* env = static_cast<shared_env*>(param);
+  std::lock_guard<std::mutex> lock(env->_trace_loggers_mutex);
+  if (!env->_trace_loggers.empty()) { trace_ort_message(env->_trace_loggers.front(), severity, logid, message); }
+}
+
+onnx_model::onnx_model(i_trace* trace_logger, const char* app_id, const char* output_name, bool use_unstructured_input,
+    const onnx_model_options& options)
     : _trace_logger(trace_logger)
     , _output_name(output_name)
     , _use_unstructured_input(use_unstructured_input)
-    , _env(Ort::Env(ORT_LOGGING_LEVEL_VERBOSE, app_id, OrtLogCallback, trace_logger))
+    , _input_format(options.format)
+    , _use_io_binding(options.use_io_binding)
+    , _env(shared_env::acquire(app_id, options, trace_logger))
+    // TODO: Support GPU scoring - it is unfortunate that we cannot simply grab the appropriate allocator
+    // based on what version of onnxruntime we are loading.
+    , _memory_info(Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault))
 {
-  //_session_options.SetThreadPoolSize(thread_pool_size);
+  if (options.batching.max_size > 1) { _batch_scheduler.reset(new batch_scheduler(options.batching, trace_logger)); }
+
+  if (options.use_global_thread_pool && _env->has_global_thread_pool()) { _session_options.DisablePerSessionThreads(); }
+  else
+  {
+    if (options.use_global_thread_pool)
+    {
+      TRACE_WARN(_trace_logger,
+          "The ONNX Runtime environment was created by a model without global thread pools. Threads are not shared.");
+    }
+    if (options.intra_op_threads > 0) { _session_options.SetIntraOpNumThreads(options.intra_op_threads); }
+    if (options.inter_op_threads > 0) { _session_options.SetInterOpNumThreads(options.inter_op_threads); }
+  }
+
+  // The inter-op pool is only used to run independent nodes in parallel
+  if (options.inter_op_threads > 1) { _session_options.SetExecutionMode(ExecutionMode::ORT_PARALLEL); }
 
   // ORT_DISABLE_ALL -> To disable all optimizations
   // ORT_ENABLE_BASIC -> To enable basic optimizations (Such as redundant node removals)
   // ORT_ENABLE_EXTENDED -> To enable extended optimizations (Includes level 1 + more complex optimizations like node
   // fusions) ORT_ENABLE_ALL -> To Enable All possible opitmizations
-  _session_options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_EXTENDED);  // Make it FAST
+  _session_options.SetGraphOptimizationLevel(options.optimization_level);
 }
 
+onnx_model::~onnx_model() { _env->release_trace_logger(_trace_logger); }
+
 int onnx_model::update(const model_management::model_data& data, bool& model_ready, api_status* status)
 {
   try
@@ -77,13 +149,20 @@ int onnx_model::update(const model_management::model_data& data, bool& model_rea
     if (data.data_sz() <= 0) { RETURN_ERROR_LS(_trace_logger, status, model_update_error) << "Empty model data."; }
 
     std::shared_ptr<Ort::Session> new_session =
-        std::make_shared<Ort::Session>(_env, data.data(), data.data_sz(), _session_options);
+        std::make_shared<Ort::Session>(_env->env(), data.data(), data.data_sz(), _session_options);
 
     // Validate that the model makes sense
     // Rules:
     // 1. There are N inputs, which are all tensors of floats
     // 2. There is an output with the provided name, which is a tensor of floats
 
+    // Batching needs a dynamic leading dimension on every input and on the output
+    bool batchable = true;
+    auto has_batch_dimension = [](const Ort::TypeInfo& type_info) {
+      const auto shape = type_info.GetTensorTypeAndShapeInfo().GetShape();
+      return !shape.empty() && shape[0] < 0;
+    };
+
     size_t input_count = new_session->GetInputCount();
     for (size_t i = 0; i < input_count; i++)
     {
@@ -94,6 +173,8 @@ int onnx_model::update(const model_management::model_data& data, bool& model_rea
       {
         RETURN_ERROR_LS(_trace_logger, status, model_update_error) << "Invalid input type. Expected: tensor<float>.";
       }
+
+      batchable = batchable && has_batch_dimension(input_type_info);
     }
 
     bool found_output = false;
@@ -120,10 +201,24 @@ int onnx_model::update(const model_management::model_data& data, bool& model_rea
       RETURN_ERROR_LS(_trace_logger, status, model_update_error) << "Invalid output type. Expected: tensor<float>.";
     }
 
-    // TODO: Should we add additional checks to make sure the next two sets are atomic?
-    _output_index = output_index;
+    batchable = batchable && has_batch_dimension(output_type_info);
+    if (_batch_scheduler && !batchable)
+    {
+      TRACE_WARN(_trace_logger,
+          "Model inputs or output have no dynamic batch dimension. Requests for this model are not batched.");
+    }
+
+    std::shared_ptr<const loaded_session> loaded(new loaded_session{std::move(new_session), output_index, batchable});
+    std::atomic_store(&_master_session, std::move(loaded));
 
-    _master_session = std::move(new_session);
+    // Idle states must not keep the previous model alive
+    std::lock_guard<std::mutex> lock(_states_mutex);
+    for (auto& state : _free_states)
+    {
+      state->binding.reset();
+      state->preallocated_output = Ort::Value(nullptr);
+      state->session.reset();
+    }
   }
   catch (const std::exception& e)
   {
@@ -141,68 +236,145 @@ int onnx_model::update(const model_management::model_data& data, bool& model_rea
 int onnx_model::choose_rank(const char* event_id, uint64_t rnd_seed, string_view features, std::vector<int>& action_ids,
     std::vector<float>& action_pdf, std::string& model_version, api_status* status)
 {
-  std::shared_ptr<Ort::Session> local_session = _master_session;
-  if (!local_session)
+  const std::shared_ptr<const loaded_session> loaded = std::atomic_load(&_master_session);
+  if (!loaded)
   {
     // Model is not ready
     RETURN_ERROR_LS(_trace_logger, status, model_rank_error) << "No model loaded.";
   }
 
-  // TODO: Support GPU scoring - it is unfortunate that we cannot simply grab the appropriate allocator
-  // based on what version of onnxruntime we are loading.
-  Ort::MemoryInfo memory_info =
-      Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
+  std::unique_ptr<inference_state> state = acquire_state();
+  auto release_guard = VW::scope_exit([this, &state] { release_state(std::move(state)); });
 
-  onnx_input_builder input_context(_trace_logger);
-  if (_use_unstructured_input) { RETURN_IF_FAIL(read_tensor_notation(features, input_context, status)); }
+  std::vector<const char*>& input_names = state->input_names;
+  std::vector<Ort::Value>& inputs = state->inputs;
+  std::vector<float>& output = state->output;
+
+  if (!_use_unstructured_input || _input_format == input_format::binary)
+  {
+    // Structured input (see structured_input.h) uses the binary framing. Tensors are created over the memory of
+    // features, no copies
+    RETURN_IF_FAIL(
+        read_binary_tensors(features, _memory_info, input_names, inputs, state->aligned_input, _trace_logger, status));
+  }
   else
   {
-    // TODO: This is a placeholder for implementing ExampleBuilder APIs. We put this here to ensure that we can make a
-    // non-breaking-change in the future that makes structured input the default.
-    RETURN_ERROR_LS(_trace_logger, status, model_rank_error)
-        << "Structured input is not yet implemented. See onnx_model.cc.";
+    onnx_input_builder& input_context = state->input_builder;
+    RETURN_IF_FAIL(read_tensor_notation(features, input_context, status));
+
+    input_names = input_context.input_names();
+    RETURN_IF_FAIL(input_context.allocate_inputs(inputs, _memory_info, status));
   }
 
-  Ort::RunOptions run_options{nullptr};
+  if (_batch_scheduler && loaded->batchable)
+  {
+    RETURN_IF_FAIL(_batch_scheduler->run(loaded->session, input_names, inputs, _output_name.c_str(), output, status));
+  }
+  else if (_use_io_binding) { RETURN_IF_FAIL(run_with_binding(*state, *loaded, status)); }
+  else
+  {
+    RETURN_IF_FAIL(run_session(*loaded->session, input_names.data(), inputs.data(), inputs.size(), _output_name.c_str(),
+        output, _trace_logger, status));
+  }
 
-  std::vector<const char*> input_names = input_context.input_names();
-  std::vector<Ort::Value> inputs;
+  const size_t num_elements = output.size();
+  action_ids.reserve(num_elements);
+  action_pdf.reserve(num_elements);
 
-  RETURN_IF_FAIL(input_context.allocate_inputs(inputs, memory_info, status));
+  for (size_t i = 0; i < num_elements; i++)
+  {
+    action_ids.push_back(i);
+    action_pdf.push_back(output[i]);
+  }
 
-  // Use the C API to avoid an unneeded throw in the error case
-  OrtValue* onnx_output = nullptr;
+  return error_code::success;
+}
 
-  // This cast-chain is taken from the OnnxRuntime code implementation of the C++ API of Ort::Session::Run().
-  auto ort_input_values = reinterpret_cast<const OrtValue**>(const_cast<Ort::Value*>(inputs.data()));
+std::unique_ptr<onnx_model::inference_state> onnx_model::acquire_state()
+{
+  std::unique_ptr<inference_state> state;
+  {
+    std::lock_guard<std::mutex> lock(_states_mutex);
+    if (!_free_states.empty())
+    {
+      state = std::move(_free_states.back());
+      _free_states.pop_back();
+    }
+  }
+
+  if (!state) { state.reset(new inference_state(_trace_logger)); }
 
-  std::vector<const char*> output_node_names;
-  output_node_names.push_back(_output_name.c_str());
+  state->input_builder.clear();
+  state->input_names.clear();
+  state->inputs.clear();
+  state->output.clear();
+  return state;
+}
 
-  OrtStatus* run_status = OnnxRuntimeCApi.Run(
-      local_session->operator OrtSession*(),  // Unwrap the underlying C reference to pass to the C API
-      Ort::RunOptions{nullptr}, input_names.data(), ort_input_values,
-      input_context.input_count(),                 // Inputs: Names, Values, Count
-      output_node_names.data(), 1, &onnx_output);  // Outputs: Names, Count, Values; note the inconsistency
+void onnx_model::release_state(std::unique_ptr<inference_state> state)
+{
+  // Drop the input tensors, they point into the caller's memory
+  state->inputs.clear();
 
-  if (run_status)
+  // The model was updated while this call ran
+  const std::shared_ptr<const loaded_session> loaded = std::atomic_load(&_master_session);
+  if (state->session && (!loaded || state->session != loaded->session))
   {
-    auto release_guard = VW::scope_exit([&run_status] { OnnxRuntimeCApi.ReleaseStatus(run_status); });
-    RETURN_ERROR_LS(_trace_logger, status, extension_error) << OnnxRuntimeCApi.GetErrorMessage(run_status);
+    state->binding.reset();
+    state->preallocated_output = Ort::Value(nullptr);
+    state->session.reset();
   }
 
-  // Re-wrap in Ort::Value to ensure proper destruction (no point in using VW::scope_exit, since we allocate either way)
-  Ort::Value target_output = Ort::Value(onnx_output);
+  std::lock_guard<std::mutex> lock(_states_mutex);
+  _free_states.push_back(std::move(state));
+}
 
-  size_t num_elements = target_output.GetTensorTypeAndShapeInfo().GetElementCount();
+int onnx_model::run_with_binding(inference_state& state, const loaded_session& loaded, api_status* status)
+{
+  const std::shared_ptr<Ort::Session>& session = loaded.session;
+  try
+  {
+    if (state.session != session)
+    {
+      state.preallocated_output = Ort::Value(nullptr);
+      state.binding.reset(new Ort::IoBinding(*session));
+      state.session = session;
+
+      // Models with a fixed output shape write straight into a buffer that is reused across calls
+      const auto output_shape = session->GetOutputTypeInfo(loaded.output_index).GetTensorTypeAndShapeInfo().GetShape();
+      const bool fixed_shape = std::all_of(output_shape.cbegin(), output_shape.cend(), [](int64_t d) { return d > 0; });
+      if (fixed_shape)
+      {
+        size_t count = 1;
+        for (int64_t d : output_shape) { count *= static_cast<size_t>(d); }
 
-  // TODO: Once we update to OnnxRuntime v1.5.1, we can change this to grab immutable data via GetTensorData<float>()
-  float* floatarr = target_output.GetTensorMutableData<float>();
+        state.output_buffer.resize(count);
+        state.preallocated_output = Ort::Value::CreateTensor<float>(
+            _memory_info, state.output_buffer.data(), count, output_shape.data(), output_shape.size());
+        state.binding->BindOutput(_output_name.c_str(), state.preallocated_output);
+      }
+      else { state.binding->BindOutput(_output_name.c_str(), _memory_info); }
+    }
 
-  for (size_t i = 0; i < num_elements; i++)
+    state.binding->ClearBoundInputs();
+    for (size_t i = 0; i < state.inputs.size(); i++)
+    {
+      state.binding->BindInput(state.input_names[i], state.inputs[i]);
+    }
+
+    session->Run(Ort::RunOptions{nullptr}, *state.binding);
+
+    if (state.preallocated_output) { state.output.assign(state.output_buffer.cbegin(), state.output_buffer.cend()); }
+    else
+    {
+      std::vector<Ort::Value> outputs = state.binding->GetOutputValues();
+      const float* values = outputs.front().GetTensorData<float>();
+      state.output.assign(values, values + outputs.front().GetTensorTypeAndShapeInfo().GetElementCount());
+    }
+  }
+  catch (const std::exception& e)
   {
-    action_ids.push_back(i);
-    action_pdf.push_back(floatarr[i]);
+    RETURN_ERROR_LS(_trace_logger, status, extension_error) << e.what();
   }
 
   return error_code::success;
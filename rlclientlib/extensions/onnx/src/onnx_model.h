@@ -1,10 +1,15 @@
 #pragma once
+#include "batch_scheduler.h"
 #include "err_constants.h"
 #include "model_mgmt.h"
+#include "onnx_input.h"
 
 #include <onnxruntime_cxx_api.h>
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace reinforcement_learning
 {
@@ -15,10 +20,69 @@ namespace reinforcement_learning
 {
 namespace onnx
 {
+// Encoding of unstructured input, see tensor_parser.h and onnx_binary_tensor.h
+enum class input_format
+{
+  tensor_notation,
+  binary
+};
+
+struct onnx_model_options
+{
+  input_format format = input_format::tensor_notation;
+  batching_options batching;
+
+  // 0 leaves the choice to the ONNX Runtime
+  int intra_op_threads = 0;
+  int inter_op_threads = 0;
+  // Share one intra-op and one inter-op thread pool between all sessions. The
+  // pools are owned by the ONNX Runtime environment, which is shared by all the
+  // models of the process (see shared_env), so they are only created if no other
+  // model exists yet.
+  bool use_global_thread_pool = false;
+  GraphOptimizationLevel optimization_level = GraphOptimizationLevel::ORT_ENABLE_EXTENDED;
+
+  // Run through a reused IO binding, writing into a preallocated output tensor
+  // when the output shape of the model is fixed
+  bool use_io_binding = false;
+};
+
+/*
+The ONNX Runtime environment of the process. The ONNX Runtime expects a single
+environment per process: it is created by the first model and shared by all the
+models alive at the same time. Its log messages go to the trace logger of the
+oldest of these models, and its global thread pools, if any, are configured by
+the options of the model that created it.
+*/
+class shared_env
+{
+public:
+  // Adds trace_logger to the loggers of the environment, until release_trace_logger is called
+  static std::shared_ptr<shared_env> acquire(
+      const char* app_id, const onnx_model_options& options, i_trace* trace_logger);
+  void release_trace_logger(i_trace* trace_logger);
+
+  Ort::Env& env() { return *_env; }
+  bool has_global_thread_pool() const { return _global_thread_pool; }
+
+private:
+  shared_env() = default;
+  static void log(void* param, OrtLoggingLevel severity, const char* category, const char* logid,
+      const char* code_location, const char* message);
+
+  std::mutex _trace_loggers_mutex;
+  std::vector<i_trace*> _trace_loggers;
+  bool _global_thread_pool = false;
+  // last, so that it is destroyed while the trace loggers can still be used
+  std::unique_ptr<Ort::Env> _env;
+};
+
 class onnx_model : public model_management::i_model
 {
 public:
-  onnx_model(i_trace* trace_logger, const char* app_id, const char* output_name, bool use_unstructured_input);
+  onnx_model(i_trace* trace_logger, const char* app_id, const char* output_name, bool use_unstructured_input,
+      const onnx_model_options& options = {});
+  ~onnx_model() override;
   int update(const model_management::model_data& data, bool& model_ready, api_status* status = nullptr) override;
   int choose_rank(const char* event_id, uint64_t rnd_seed, string_view features, std::vector<int>& action_ids,
       std::vector<float>& action_pdf, std::string& model_version, api_status* status = nullptr) override;
@@ -37,8 +101,7 @@ public:
   }
 
   int request_multi_slot_decision(const char* event_id, const std::vector<std::string>& slot_ids, string_view features,
-      std::vector<std::vector<uint32_t>>& actions_ids, std::vector<std::vector<float>>& action_pdfs,
-      std::string& model_version, api_status* status = nullptr) override
+      multi_slot_ranking& ranking, std::string& model_version, api_status* status = nullptr) override
   {
     return error_code::not_supported;
   }
@@ -53,15 +116,59 @@ public:
   model_management::model_type_t model_type() const { return model_management::model_type_t::CB; }
 
 private:
+  /*
+  Everything a single choose_rank call needs. States are pooled so that input
+  buffers, the IO binding and the preallocated output are reused across calls,
+  each concurrent call using its own state.
+  */
+  struct inference_state
+  {
+    explicit inference_state(i_trace* trace_logger) : input_builder(trace_logger) {}
+
+    onnx_input_builder input_builder;
+    std::vector<const char*> input_names;
+    std::vector<Ort::Value> inputs;
+    // backing memory for binary input that is not suitably aligned to be used in place
+    std::vector<uint64_t> aligned_input;
+    std::vector<float> output;
+
+    // only used with IO binding, bound to session
+    std::shared_ptr<Ort::Session> session;
+    std::unique_ptr<Ort::IoBinding> binding;
+    std::vector<float> output_buffer;
+    Ort::Value preallocated_output{nullptr};
+  };
+
+  // A session and what update found out about its model
+  struct loaded_session
+  {
+    std::shared_ptr<Ort::Session> session;
+    size_t output_index;
+    // whether all inputs and the output of the model have a dynamic batch dimension
+    bool batchable;
+  };
+
+  std::unique_ptr<inference_state> acquire_state();
+  void release_state(std::unique_ptr<inference_state> state);
+  int run_with_binding(inference_state& state, const loaded_session& loaded, api_status* status);
+
   i_trace* _trace_logger;
   std::string _output_name;
-  size_t _output_index;
   const bool _use_unstructured_input;
+  const input_format _input_format;
+  const bool _use_io_binding;
 
-  Ort::Env _env;
+  std::shared_ptr<shared_env> _env;
   Ort::SessionOptions _session_options;
+  Ort::MemoryInfo _memory_info;
+
+  // swapped by update while choose_rank runs, only accessed with std::atomic_load and std::atomic_store
+  std::shared_ptr<const loaded_session> _master_session;
+  // only set if batching is enabled
+  std::unique_ptr<batch_scheduler> _batch_scheduler;
 
-  std::shared_ptr<Ort::Session> _master_session;
+  std::mutex _states_mutex;
+  std::vector<std::unique_ptr<inference_state>> _free_states;
 };
 }  // namespace onnx
 }  // namespace reinforcement_learning
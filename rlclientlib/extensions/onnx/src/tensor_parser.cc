@@ -1,6 +1,9 @@
 #include "tensor_parser.h"
 
+#include "base64_decoder.h"
+
 #include <algorithm>
+#include <cstring>
 #include <sstream>
 
 namespace reinforcement_learning
@@ -141,109 +144,63 @@ inline static bool consume_exact(const char*& reading_head)
 
 namespace base64
 {
-struct parse_context
+// Decodes the base64 characters up to the terminator into target and moves the
+// reading head past the terminator. The target is sized once and decoded into in
+// bulk, see base64_decoder.h. input_end is the end of the line being parsed. The
+// decoded bytes have to be a whole number of elements of the target.
+template <char terminator, typename element_t>
+inline bool consume(const char*& reading_head, const char* input_end, std::vector<element_t>& target,
+    errors::error_context& error_context)
 {
-private:
-  size_t _count;
-  uint32_t _running;
-  size_t _padding_count;
-  std::vector<uint8_t>& _bytes;
-  errors::error_context& _error_context;
+  if (reading_head == nullptr) { return false; }
 
-public:
-  inline parse_context(std::vector<uint8_t>& target, errors::error_context& errors_target)
-      : _bytes(target), _error_context(errors_target), _count(0), _running(0), _padding_count(0)
-  {
-  }
+  const size_t remaining = static_cast<size_t>(input_end - reading_head);
+  const auto* end = static_cast<const char*>(std::memchr(reading_head, terminator, remaining));
+  const size_t length = end == nullptr ? remaining : static_cast<size_t>(end - reading_head);
 
-  inline bool invoke(const char c)
-  {
-    _running = _running << 6;
-    _count++;
+  // rounded up, so that invalid base64 is reported before the packing
+  const size_t byte_count = onnx::base64::decoded_size(reading_head, length);
+  target.resize((byte_count + sizeof(element_t) - 1) / sizeof(element_t));
 
-    if (_padding_count || c == '=') { _padding_count++; }
-    else if (!_padding_count)
-    {
-      if (c >= 'A' /* 65 */ && c <= 'Z' /* 90 */)
-      {
-        _running = _running | (c - 'A' + 0);  // 0 - 25
-      }
-      else if (c >= 'a' /* 97 */ && c <= 'z' /* 122 */)
-      {
-        _running = _running | (c - 'a' + 26);  // 26 - 51
-      }
-      else if (c >= '0' /* 48 */ && c <= '9' /* 57 */)
-      {
-        _running = _running | (c - '0' + 52);  // 52 - 61
-      }
-      else if (c == '+') { _running = _running | 62; }
-      else if (c == '/') { _running = _running | 63; }
-      else
-      {
-        // TODO: Bad character
-        std::stringstream error_detail_builder;
-        error_detail_builder << "Invalid base64 character: '" << c << "'.";
-
-        return _error_context.append_error(std::string(error_detail_builder.str()));
-      }
-
-      if (_count % 4 == 0)
-      {
-        _bytes.push_back((_running >> 16) & 0xFF);
-        _bytes.push_back((_running >> 8) & 0xFF);
-        _bytes.push_back(_running & 0xFF);
-
-        _running = 0;
-      }
-    }
-
-    return true;
-  }
-
-  inline bool end()
+  onnx::base64::decode_error error;
+  if (onnx::base64::decode(reading_head, length, reinterpret_cast<uint8_t*>(target.data()), error))
   {
-    if (_count % 4 != 0)
+    if (end == nullptr)
     {
-      std::stringstream error_detail_builder;
-      error_detail_builder << "Invalid number of base64 characters: '" << _count << "'.";
-
-      return _error_context.append_error(std::string(error_detail_builder.str()));
+      reading_head += length;
+      return false;
     }
 
-    switch (_padding_count)
-    {
-      case 0:
-        break;
-      case 1:
-        _bytes.push_back((_running >> 16) & 0xFF);
-        _bytes.push_back((_running >> 8) & 0xFF);
-        break;
-      case 2:
-        _bytes.push_back((_running >> 16) & 0xFF);
-        break;
-      default:
-        std::stringstream error_detail_builder;
-        error_detail_builder << "Invalid number of base64 padding characters: '" << _padding_count << "'.";
-
-        return _error_context.append_error(std::string(error_detail_builder.str()));
-    }
+    reading_head = end + 1;
+    if (byte_count % sizeof(element_t) == 0) { return true; }
 
-    return true;
+    std::stringstream error_detail_builder;
+    error_detail_builder << "Invalid number of bytes: '" << byte_count << "'. Expecting a multiple of "
+                         << sizeof(element_t) << ".";
+    return error_context.append_error(error_detail_builder.str());
   }
-};
-
-using parse_action = primitives::routing_action<parse_context>;
-
-template <typename until_t>
-using frame = primitives::parse_frame<parse_context, until_t, parse_action>;
 
-template <char ch>
-using until = primitives::until<parse_context, ch>;
+  std::stringstream error_detail_builder;
+  switch (error.error)
+  {
+    case onnx::base64::decode_error::kind::invalid_character:
+      reading_head += error.position;
+      error_detail_builder << "Invalid base64 character: '" << error.character << "'.";
+      break;
+    case onnx::base64::decode_error::kind::invalid_length:
+      // lengths are only validated once the terminator is reached
+      if (end == nullptr) { return false; }
+      reading_head = end + 1;
+      error_detail_builder << "Invalid number of base64 characters: '" << error.count << "'.";
+      break;
+    default:
+      if (end == nullptr) { return false; }
+      reading_head = end + 1;
+      error_detail_builder << "Invalid number of base64 padding characters: '" << error.count << "'.";
+      break;
+  }
 
-template <bool inclusive, typename until_t>
-inline bool consume(const char*& c, parse_context& context)
-{
-  return primitives::consume<inclusive, frame<until_t>, parse_context>(c, context);
+  return error_context.append_error(error_detail_builder.str());
 }
 }  // namespace base64
 
@@ -295,30 +252,26 @@ using primitives::until;
 
 using escaped = escaped_string<BACKSLASH>;
 
-bool parse_tensor_value(const char*& reading_head, std::vector<byte_t>& dims, std::vector<byte_t>& data,
+bool parse_tensor_value(const char*& reading_head, const char* input_end, bytes_t& dims, values_t& values,
     errors::error_context& error_target)
 {
   errors::error_context error_context = error_target.with_prefix("while parsing tensor value");
 
-  auto dims_context = base64::parse_context(dims, error_context);
-  auto data_context = base64::parse_context(data, error_context);
-
   // " <base64 dimensions> ; <base64 data> "
   return consume_exact<DOUBLE_QUOTE>(reading_head) &&
-      base64::consume<INCLUSIVE, base64::until<SEMICOLON>>(reading_head, dims_context) &&
-      base64::consume<INCLUSIVE, base64::until<DOUBLE_QUOTE>>(reading_head, data_context);
+      base64::consume<SEMICOLON>(reading_head, input_end, dims, error_context) &&
+      base64::consume<DOUBLE_QUOTE>(reading_head, input_end, values, error_context);
 }
 
-bool parse_tensor_name_value(const char*& reading_head, std::string& name, bytes_t& shape_bytes, bytes_t& value_bytes,
-    errors::error_context& error_target)
+bool parse_tensor_name(const char*& reading_head, std::string& name, errors::error_context& error_target)
 {
   auto name_context = escaped::parse_context(name);
 
-  // " <escaped_name> " : <tensor_value>
+  // " <escaped_name> " :
   return consume_exact<DOUBLE_QUOTE>(reading_head) &&
       (escaped::consume<INCLUSIVE, escaped::until<DOUBLE_QUOTE>>(reading_head, name_context) ||  // on error:
           error_target.with_prefix("while parsing tensor name").append_error("Expected '\"'.")) &&
-      consume_exact<COLON>(reading_head) && parse_tensor_value(reading_head, shape_bytes, value_bytes, error_target);
+      consume_exact<COLON>(reading_head);
 }
 
 bool parse(parser_context& context)
@@ -331,6 +284,7 @@ bool parse(parser_context& context)
   if (context.line().empty()) { return true; }
 
   const char*& reading_head = context._reading_head;
+  const char* const input_end = context._line.c_str() + context._line.size();
 
   // '{' <tensor_name_value> [ ',' <tensor_name_value> ]*
   if (!consume_exact<OPEN_BRACE>(reading_head)) { return false; }
@@ -342,16 +296,11 @@ bool parse(parser_context& context)
 
   do {
     std::string name;
-    bytes_t tensor_shape_bytes;
-    bytes_t tensor_data_bytes;
-
-    if (!parse_tensor_name_value(reading_head, name, tensor_shape_bytes, tensor_data_bytes, error_context))
-    {
-      return false;
-    }
+    if (!parse_tensor_name(reading_head, name, error_context)) { return false; }
 
-    context._input_builder.push_input(
-        std::move(name), std::move(std::make_pair(tensor_shape_bytes, tensor_data_bytes)));
+    // <tensor_value> is decoded straight into the (reused) buffers of the input
+    tensor_data_t& tensor = context._input_builder.append_input(std::move(name));
+    if (!parse_tensor_value(reading_head, input_end, tensor.first, tensor.second, error_context)) { return false; }
 
   } while (
       consume_exact<COMMA>(reading_head));  // consume's API is to move reading_head until after success or before first
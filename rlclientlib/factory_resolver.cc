@@ -15,6 +15,7 @@
 
 #include "console_tracer.h"
 #include "error_callback_fn.h"
+#include "file_tracer.h"
 #include "logger/file/file_logger.h"
 #include "model_mgmt/file_model_loader.h"
 
@@ -91,6 +92,8 @@ int null_tracer_create(
     std::unique_ptr<i_trace>& retval, const u::configuration& /*cfg*/, i_trace* trace_logger, api_status* status);
 int console_tracer_create(
     std::unique_ptr<i_trace>& retval, const u::configuration& /*cfg*/, i_trace* trace_logger, api_status* status);
+int file_tracer_create(
+    std::unique_ptr<i_trace>& retval, const u::configuration& cfg, i_trace* trace_logger, api_status* status);
 
 int file_sender_create(std::unique_ptr<i_sender>& retval, const u::configuration& cfg, const char* file_name,
     error_callback_fn* error_cb, i_trace* trace_logger, api_status* status)
@@ -113,7 +116,10 @@ int file_model_loader_create(std::unique_ptr<m::i_data_transport>& retval, const
   TRACE_INFO(trace_logger, "File model loader created.");
   const char* file_name = config.get(name::MODEL_FILE_NAME, "current");
   const bool file_must_exist = config.get_bool(name::MODEL_FILE_MUST_EXIST, false);
-  auto file_loader = VW::make_unique<model_management::file_model_loader>(file_name, file_must_exist, trace_logger);
+  const bool use_mmap = config.get_bool(name::MODEL_FILE_USE_MMAP, false);
+  const bool use_inotify = config.get_bool(name::MODEL_FILE_USE_INOTIFY, true);
+  auto file_loader = VW::make_unique<model_management::file_model_loader>(
+      file_name, file_must_exist, trace_logger, use_mmap, use_inotify);
 
   const auto success = file_loader->init(status);
   if (success != error_code::success) { return success; }
@@ -152,6 +158,7 @@ void factory_initializer::register_default_factories()
 
   trace_logger_factory.register_type(value::NULL_TRACE_LOGGER, null_tracer_create);
   trace_logger_factory.register_type(value::CONSOLE_TRACE_LOGGER, console_tracer_create);
+  trace_logger_factory.register_type(value::FILE_TRACE_LOGGER, file_tracer_create);
 
   time_provider_factory.register_type(value::NULL_TIME_PROVIDER, null_time_provider_create);
   time_provider_factory.register_type(value::CLOCK_TIME_PROVIDER, clock_time_provider_create);
@@ -193,4 +200,19 @@ int console_tracer_create(
   retval.reset(new console_tracer());
   return error_code::success;
 }
+
+int file_tracer_create(
+    std::unique_ptr<i_trace>& retval, const u::configuration& cfg, i_trace* trace_logger, api_status* status)
+{
+  const auto* file_name = cfg.get(name::TRACE_LOG_FILE_NAME, value::TRACE_LOG_FILE_NAME_DEFAULT);
+  const auto ring_size = cfg.get_int(name::TRACE_LOG_RING_SIZE, value::TRACE_LOG_RING_SIZE_DEFAULT);
+  if (ring_size <= 0)
+  {
+    RETURN_ERROR_ARG(trace_logger, status, invalid_argument, name::TRACE_LOG_RING_SIZE, " must be positive");
+  }
+  std::unique_ptr<file_tracer> tracer(new file_tracer(file_name, static_cast<size_t>(ring_size)));
+  RETURN_IF_FAIL(tracer->init(status));
+  retval = std::move(tracer);
+  return error_code::success;
+}
 }  // namespace reinforcement_learning
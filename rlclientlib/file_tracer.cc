@@ -0,0 +1,225 @@
+#include "file_tracer.h"
+
+#include "api_status.h"
+#include "date.h"
+#include "err_constants.h"
+#include "str_util.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace reinforcement_learning
+{
+namespace
+{
+const std::chrono::milliseconds FLUSH_INTERVAL(10);
+
+std::atomic<uint64_t> next_tracer_id{1};
+
+size_t round_up_to_power_of_two(size_t value)
+{
+  size_t result = 1;
+  while (result < value) { result <<= 1; }
+  return result;
+}
+}  // namespace
+
+file_tracer::ring::ring(size_t size, uint64_t owner, uint32_t thread)
+    : records(round_up_to_power_of_two(size)), owner(owner), thread(thread)
+{
+}
+
+file_tracer::file_tracer(std::string file_name, size_t ring_size)
+    : _file_name(std::move(file_name)), _ring_size((std::max)(ring_size, size_t{1})), _id(next_tracer_id.fetch_add(1))
+{
+}
+
+file_tracer::~file_tracer()
+{
+  if (_thread.joinable())
+  {
+    _sleeper.interrupt();
+    _thread.join();
+  }
+  flush();
+
+  std::lock_guard<std::mutex> lock(_rings_mutex);
+  for (const auto& r : _rings) { r->consumer_exited.store(true, std::memory_order_release); }
+}
+
+int file_tracer::init(api_status* status)
+{
+  _file.open(_file_name, std::ios::app);
+  if (!_file.is_open()) { RETURN_ERROR_LS(nullptr, status, file_open_error) << " File:" << _file_name; }
+  _thread = std::thread(&file_tracer::run, this);
+  return error_code::success;
+}
+
+void file_tracer::log(int log_level, const std::string& msg)
+{
+  if (!is_enabled(log_level)) { return; }
+
+  auto& r = thread_ring();
+  auto* slot = reserve(r, log_level);
+  if (slot == nullptr) { return; }
+  slot->message.assign(msg);
+  slot->event = nullptr;
+  commit(r);
+}
+
+void file_tracer::log_event(int log_level, const char* event, std::initializer_list<trace_field> fields)
+{
+  if (!is_enabled(log_level)) { return; }
+
+  auto& r = thread_ring();
+  auto* slot = reserve(r, log_level);
+  if (slot == nullptr) { return; }
+  slot->event = event;
+  // copied over the fields of previous records, whose strings keep their capacity
+  if (slot->fields.size() < fields.size()) { slot->fields.resize(fields.size()); }
+  std::copy(fields.begin(), fields.end(), slot->fields.begin());
+  slot->field_count = fields.size();
+  commit(r);
+}
+
+file_tracer::record* file_tracer::reserve(ring& r, int log_level)
+{
+  const auto tail = r.tail.load(std::memory_order_relaxed);
+  if (tail - r.head.load(std::memory_order_acquire) == r.records.size())
+  {
+    r.dropped.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  auto& slot = r.records[tail & (r.records.size() - 1)];
+  slot.level = log_level;
+  slot.time = std::chrono::system_clock::now();
+  slot.thread = r.thread;
+  return &slot;
+}
+
+void file_tracer::commit(ring& r)
+{
+  r.tail.store(r.tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void file_tracer::set_level(int log_level) { _log_level.store(log_level, std::memory_order_relaxed); }
+
+bool file_tracer::is_enabled(int log_level) const { return log_level >= _log_level.load(std::memory_order_relaxed); }
+
+file_tracer::thread_rings::~thread_rings()
+{
+  for (const auto& r : rings) { r->producer_exited.store(true, std::memory_order_release); }
+}
+
+file_tracer::ring& file_tracer::thread_ring()
+{
+  // A ring outlives its thread until the tracer drained it
+  thread_local thread_rings local;
+  for (const auto& r : local.rings)
+  {
+    if (r->owner == _id) { return *r; }
+  }
+
+  std::shared_ptr<ring> r;
+  {
+    std::lock_guard<std::mutex> lock(_rings_mutex);
+    r = std::make_shared<ring>(_ring_size, _id, _next_thread++);
+    _rings.push_back(r);
+  }
+
+  local.rings.erase(std::remove_if(local.rings.begin(), local.rings.end(),
+                        [](const std::shared_ptr<ring>& old)
+                        { return old->consumer_exited.load(std::memory_order_acquire); }),
+      local.rings.end());
+  local.rings.push_back(r);
+  return *r;
+}
+
+void file_tracer::record::swap(record& other)
+{
+  std::swap(level, other.level);
+  std::swap(time, other.time);
+  std::swap(thread, other.thread);
+  message.swap(other.message);
+  std::swap(event, other.event);
+  fields.swap(other.fields);
+  std::swap(field_count, other.field_count);
+}
+
+file_tracer::record& file_tracer::next_pending()
+{
+  if (_pending_count == _pending.size()) { _pending.emplace_back(); }
+  return _pending[_pending_count++];
+}
+
+void file_tracer::flush()
+{
+  std::lock_guard<std::mutex> flush_lock(_flush_mutex);
+  {
+    std::lock_guard<std::mutex> lock(_rings_mutex);
+    _draining = _rings;
+  }
+
+  for (const auto& r : _draining)
+  {
+    const auto head = r->head.load(std::memory_order_relaxed);
+    const auto tail = r->tail.load(std::memory_order_acquire);
+    // The ring slot gets the buffers of a written record in exchange
+    for (auto i = head; i != tail; ++i) { next_pending().swap(r->records[i & (r->records.size() - 1)]); }
+    r->head.store(tail, std::memory_order_release);
+
+    const auto dropped = r->dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0)
+    {
+      auto& drops = next_pending();
+      drops.level = LEVEL_WARN;
+      drops.time = std::chrono::system_clock::now();
+      drops.thread = r->thread;
+      drops.message = utility::concat(dropped, " trace records dropped, the ring of the thread was full");
+      drops.event = nullptr;
+    }
+  }
+  _draining.clear();
+
+  {
+    // The exit flag is read first: the thread set it after publishing its last record, so an empty ring stays empty
+    std::lock_guard<std::mutex> lock(_rings_mutex);
+    _rings.erase(std::remove_if(_rings.begin(), _rings.end(),
+                     [](const std::shared_ptr<ring>& r)
+                     {
+                       return r->producer_exited.load(std::memory_order_acquire) &&
+                           r->head.load(std::memory_order_relaxed) == r->tail.load(std::memory_order_acquire);
+                     }),
+        _rings.end());
+  }
+
+  if (_pending_count == 0) { return; }
+
+  _order.resize(_pending_count);
+  std::iota(_order.begin(), _order.end(), size_t{0});
+  std::stable_sort(
+      _order.begin(), _order.end(), [this](size_t a, size_t b) { return _pending[a].time < _pending[b].time; });
+  for (const auto i : _order)
+  {
+    const auto& r = _pending[i];
+    _file << date::format("%FT%TZ", std::chrono::time_point_cast<std::chrono::microseconds>(r.time)) << " [" << r.thread
+          << "] " << details::get_log_level_string(r.level) << ": ";
+    if (r.event == nullptr) { _file << r.message << "\n"; }
+    else
+    {
+      _line.assign(r.event);
+      for (size_t f = 0; f < r.field_count; ++f) { r.fields[f].format(_line); }
+      _file << _line << "\n";
+    }
+  }
+  _file.flush();
+  // The records keep their buffers for the next flush
+  _pending_count = 0;
+}
+
+void file_tracer::run()
+{
+  while (_sleeper.sleep(FLUSH_INTERVAL)) { flush(); }
+}
+}  // namespace reinforcement_learning
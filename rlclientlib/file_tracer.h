@@ -0,0 +1,127 @@
+#pragma once
+#include "trace_logger.h"
+#include "utility/interruptable_sleeper.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace reinforcement_learning
+{
+/*
+Tracer writing to a file from a background thread.
+
+log() only stores the message with its level, time and thread in a ring of
+the calling thread: the ring is written by that thread alone and read by
+the background thread, without locks. log_event() stores the event id and
+the fields the same way, they are only formatted by the background thread.
+The background thread formats the records of all the rings every few
+milliseconds, in time order, and writes them to the file. Records that find
+their ring full are dropped and the number of drops is written to the file
+instead.
+
+The strings of the records are swapped between the rings and the buffer of
+the background thread rather than moved out, so both keep their capacity
+and steady logging does not allocate. A ring is dropped once its thread
+exited and it was drained.
+*/
+class file_tracer : public i_trace
+{
+public:
+  file_tracer(std::string file_name, size_t ring_size);
+  ~file_tracer() override;
+
+  file_tracer(const file_tracer&) = delete;
+  file_tracer& operator=(const file_tracer&) = delete;
+
+  // Opens the file and starts the background thread
+  int init(api_status* status);
+
+  // Inherited via i_trace
+  void log(int log_level, const std::string& msg) override;
+  void set_level(int log_level) override;
+  bool is_enabled(int log_level) const override;
+  void log_event(int log_level, const char* event, std::initializer_list<trace_field> fields) override;
+
+  // Writes the records logged so far, from the calling thread. Used by tests.
+  void flush();
+
+private:
+  struct record
+  {
+    int level = 0;
+    std::chrono::system_clock::time_point time;
+    uint32_t thread = 0;
+    // message when event is null, otherwise the event id and the first field_count fields
+    std::string message;
+    const char* event = nullptr;
+    std::vector<trace_field> fields;
+    size_t field_count = 0;
+
+    // Exchanges the buffers too
+    void swap(record& other);
+  };
+
+  // Single producer single consumer ring of records
+  struct ring
+  {
+    ring(size_t size, uint64_t owner, uint32_t thread);
+
+    std::vector<record> records;
+    const uint64_t owner;
+    const uint32_t thread;
+    std::atomic<size_t> head{0};
+    std::atomic<size_t> tail{0};
+    std::atomic<uint64_t> dropped{0};
+    // Set by the thread when it exits, after its last record
+    std::atomic<bool> producer_exited{false};
+    // Set by the tracer when it is destroyed, the thread no longer looks the ring up
+    std::atomic<bool> consumer_exited{false};
+  };
+
+  // Rings of a thread for every tracer it logged to, flagged when the thread exits
+  struct thread_rings
+  {
+    ~thread_rings();
+    std::vector<std::shared_ptr<ring>> rings;
+  };
+
+  ring& thread_ring();
+  // Slot of the next record of r, null when r is full. The record is published by commit().
+  static record* reserve(ring& r, int log_level);
+  static void commit(ring& r);
+  // Slot of _pending for the next record
+  record& next_pending();
+  void run();
+
+  const std::string _file_name;
+  const size_t _ring_size;
+  // Unique among the tracers of the process, the rings of a thread are found by it
+  const uint64_t _id;
+  std::atomic<int> _log_level{LEVEL_INFO};
+
+  std::mutex _rings_mutex;
+  std::vector<std::shared_ptr<ring>> _rings;
+  uint32_t _next_thread = 0;
+  // Copy of _rings drained by flush()
+  std::vector<std::shared_ptr<ring>> _draining;
+
+  std::mutex _flush_mutex;
+  std::ofstream _file;
+  // The first _pending_count are the records to write, the others keep their buffers for the next flush
+  std::vector<record> _pending;
+  size_t _pending_count = 0;
+  std::vector<size_t> _order;
+  std::string _line;
+
+  utility::interruptable_sleeper _sleeper;
+  std::thread _thread;
+};
+}  // namespace reinforcement_learning
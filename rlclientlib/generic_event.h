@@ -3,9 +3,11 @@
 #include "generated/v2/Event_generated.h"
 #include "logger/logger_extensions.h"
 #include "time_helper.h"
+#include "utility/context_helper.h"
 
 #include <flatbuffers/flatbuffers.h>
 
+#include <memory>
 #include <string>
 
 namespace reinforcement_learning
@@ -33,6 +35,9 @@ public:
 
   generic_event() = default;
   generic_event(const char* id, const timestamp& ts, payload_type_t type, string_view context, const char* app_id);
+  // context_info is the analysis of the context, it spares object extraction from parsing the context again
+  generic_event(const char* id, const timestamp& ts, payload_type_t type, string_view context,
+      const utility::ContextInfo& context_info, const char* app_id);
   generic_event(const char* id, const timestamp& ts, payload_type_t type, payload_buffer_t&& payload,
       event_content_type content_type, object_list_t&& objects, const char* app_id, float pass_prob = 1.f);
   generic_event(const char* id, const timestamp& ts, payload_type_t type, payload_buffer_t&& payload,
@@ -78,7 +83,8 @@ public:
     else
     {
       std::string tmp;
-      RETURN_IF_FAIL(ext->transform_payload_and_extract_objects(_context_string.c_str(), tmp, _objects, status));
+      RETURN_IF_FAIL(ext->transform_payload_and_extract_objects(
+          _context_string.c_str(), _context_info.get(), tmp, _objects, status));
       _payload = serializer.event(tmp.c_str(), args...);
     }
     if (ext->is_serialization_transform_enabled())
@@ -87,6 +93,7 @@ public:
     }
     else { _content_type = event_content_type::IDENTITY; }
     _context_string.clear();
+    _context_info.reset();
     return 0;
   }
 
@@ -104,5 +111,6 @@ protected:
   std::string _app_id;
   uint64_t _event_index;
   std::string _context_string;
+  std::unique_ptr<utility::ContextInfo> _context_info;
 };
 }  // namespace reinforcement_learning
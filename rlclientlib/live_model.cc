@@ -258,6 +258,18 @@ int live_model::refresh_model(api_status* status)
   return _pimpl->refresh_model(status);
 }
 
+int live_model::get_metrics(metrics_snapshot& snapshot, api_status* status)
+{
+  INIT_CHECK();
+  return _pimpl->get_metrics(snapshot, status);
+}
+
+int live_model::get_logging_statistics(logging_statistics& stats, api_status* status)
+{
+  INIT_CHECK();
+  return _pimpl->get_logging_statistics(stats, status);
+}
+
 int live_model::request_episodic_decision(const char* event_id, const char* previous_id, string_view context_json,
     ranking_response& resp, episode_state& episode, api_status* status)
 {
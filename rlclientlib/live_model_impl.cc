@@ -11,12 +11,15 @@
 #include "ranking_response.h"
 #include "sampling.h"
 #include "sender.h"
+#include "str_util.h"
 #include "trace_logger.h"
 #include "utility/context_helper.h"
+#include "utility/metrics_registry.h"
 #include "vw/common/hash.h"
 #include "vw/explore/explore.h"
 #include "vw_model/safe_vw.h"
 
+#include <algorithm>
 #include <boost/uuid/random_generator.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <cmath>
@@ -68,6 +71,28 @@ int live_model_impl::init(api_status* status)
   }
 
   _initial_epsilon = _configuration.get_float(name::INITIAL_EPSILON, 0.2f);
+  const auto shortlist_size = _configuration.get_int(name::RANK_SHORTLIST_SIZE, 0);
+  if (shortlist_size > 0 && _learning_mode == ONLINE)
+  {
+    // The shortlist is logged in a field of v2 events
+    if (_protocol_version != 2)
+    {
+      RETURN_ERROR_LS(_trace_logger.get(), status, protocol_not_supported)
+          << name::RANK_SHORTLIST_SIZE << " requires " << name::PROTOCOL_VERSION << " 2.";
+    }
+    if (!_configuration.get_bool(name::MODEL_VW_LIGHTWEIGHT_CB_ADF, false))
+    {
+      TRACE_WARN(_trace_logger,
+          utility::concat(name::RANK_SHORTLIST_SIZE, " needs ", name::MODEL_VW_LIGHTWEIGHT_CB_ADF,
+              ", CB decisions rank all the actions."));
+    }
+    _shortlist_size = static_cast<size_t>(shortlist_size);
+  }
+  else if (shortlist_size > 0)
+  {
+    TRACE_WARN(_trace_logger,
+        utility::concat(name::RANK_SHORTLIST_SIZE, " only applies in online learning mode, it is ignored."));
+  }
   const char* app_id = _configuration.get(name::APP_ID, "");
   _seed_shift = VW::uniform_hash(app_id, strlen(app_id), 0);
 
@@ -76,6 +101,13 @@ int live_model_impl::init(api_status* status)
 
 int live_model_impl::choose_rank(
     const char* event_id, string_view context, unsigned int flags, ranking_response& response, api_status* status)
+{
+  return choose_rank_impl(event_id, context, messages::flatbuff::v2::ContextFormat_Json, flags, response, status);
+}
+
+int live_model_impl::choose_rank_impl(const char* event_id, string_view context,
+    messages::flatbuff::v2::ContextFormat context_format, unsigned int flags, ranking_response& response,
+    api_status* status)
 {
   response.clear();
   // clear previous errors if any
@@ -89,12 +121,20 @@ int live_model_impl::choose_rank(
 
   std::vector<int> action_ids;
   std::vector<float> action_pdf;
+  std::vector<int> shortlist;
   std::string model_version;
 
-  _model->choose_rank(event_id, seed, context, action_ids, action_pdf, model_version, status);
+  const auto predict_start = utility::metrics_registry::now();
+  if (_shortlist_size > 0)
+  {
+    RETURN_IF_FAIL(_model->choose_rank_shortlist(
+        event_id, seed, context, _shortlist_size, action_ids, action_pdf, shortlist, model_version, status));
+  }
+  else { _model->choose_rank(event_id, seed, context, action_ids, action_pdf, model_version, status); }
+  utility::metrics_registry::record_since(api_stage::model_predict, predict_start);
 
   RETURN_IF_FAIL(sample_and_populate_response(
-      seed, action_ids, action_pdf, std::move(model_version), response, _trace_logger.get(), status));
+      seed, action_ids, action_pdf, model_version, response, _trace_logger.get(), status));
 
   response.set_event_id(event_id);
 
@@ -104,7 +144,9 @@ int live_model_impl::choose_rank(
     RETURN_IF_FAIL(reset_action_order(response));
   }
 
-  RETURN_IF_FAIL(_interaction_logger->log(context, flags, response, status, _learning_mode));
+  // A shortlist is logged with the full context, so that training can tell which of its actions were ranked
+  RETURN_IF_FAIL(
+      _interaction_logger->log(context, flags, response, status, _learning_mode, context_format, shortlist));
 
   if (_learning_mode == APPRENTICE)
   {
@@ -131,21 +173,30 @@ int live_model_impl::choose_rank(
 
 int live_model_impl::request_continuous_action(const char* event_id, string_view context, unsigned int flags,
     continuous_action_response& response, api_status* status)
+{
+  return request_continuous_action_impl(
+      event_id, context, messages::flatbuff::v2::ContextFormat_Json, flags, response, status);
+}
+
+int live_model_impl::request_continuous_action_impl(const char* event_id, string_view context,
+    messages::flatbuff::v2::ContextFormat context_format, unsigned int flags, continuous_action_response& response,
+    api_status* status)
 {
   response.clear();
   // clear previous errors if any
   api_status::try_clear(status);
 
-  RETURN_IF_FAIL(check_null_or_empty(event_id, context.data(), _trace_logger.get(), status));
+  RETURN_IF_FAIL(check_null_or_empty(event_id, context, _trace_logger.get(), status));
 
   float action = NAN;
   float pdf_value = NAN;
   std::string model_version;
 
+  const auto predict_start = utility::metrics_registry::now();
   RETURN_IF_FAIL(_model->choose_continuous_action(context, action, pdf_value, model_version, status));
-  RETURN_IF_FAIL(populate_response(
-      action, pdf_value, std::string(event_id), std::string(model_version), response, _trace_logger.get(), status));
-  RETURN_IF_FAIL(_interaction_logger->log_continuous_action(context.data(), flags, response, status));
+  utility::metrics_registry::record_since(api_stage::model_predict, predict_start);
+  RETURN_IF_FAIL(populate_response(action, pdf_value, event_id, model_version, response, _trace_logger.get(), status));
+  RETURN_IF_FAIL(_interaction_logger->log_continuous_action(context, flags, response, status, context_format));
 
   if (_watchdog.has_background_error_been_reported())
   {
@@ -162,6 +213,63 @@ int live_model_impl::request_continuous_action(
   return request_continuous_action(uuid.c_str(), context, flags, response, status);
 }
 
+int live_model_impl::choose_rank(const char* event_id, const structured_input& input, unsigned int flags,
+    ranking_response& response, api_status* status)
+{
+  RETURN_IF_FAIL(check_structured_input(input, status));
+  // The shortlist is made of the actions of a json context
+  if (_shortlist_size > 0)
+  {
+    RETURN_ERROR_LS(_trace_logger.get(), status, invalid_argument)
+        << "Structured input can not be combined with " << name::RANK_SHORTLIST_SIZE << ".";
+  }
+  return choose_rank_impl(event_id, string_view(input.data(), input.size()),
+      messages::flatbuff::v2::ContextFormat_BinaryTensors, flags, response, status);
+}
+
+int live_model_impl::choose_rank(
+    const structured_input& input, unsigned int flags, ranking_response& response, api_status* status)
+{
+  const auto uuid = boost::uuids::to_string(boost::uuids::random_generator()());
+  return choose_rank(uuid.c_str(), input, flags, response, status);
+}
+
+int live_model_impl::request_continuous_action(const char* event_id, const structured_input& input,
+    unsigned int flags, continuous_action_response& response, api_status* status)
+{
+  RETURN_IF_FAIL(check_structured_input(input, status));
+  return request_continuous_action_impl(event_id, string_view(input.data(), input.size()),
+      messages::flatbuff::v2::ContextFormat_BinaryTensors, flags, response, status);
+}
+
+int live_model_impl::request_continuous_action(
+    const structured_input& input, unsigned int flags, continuous_action_response& response, api_status* status)
+{
+  const auto uuid = boost::uuids::to_string(boost::uuids::random_generator()());
+  return request_continuous_action(uuid.c_str(), input, flags, response, status);
+}
+
+int live_model_impl::check_structured_input(const structured_input& input, api_status* status)
+{
+  // The binary context is logged as-is and tagged with its format, which only v2 events carry
+  if (_protocol_version != 2)
+  {
+    RETURN_ERROR_LS(_trace_logger.get(), status, protocol_not_supported)
+        << "Structured input requires " << name::PROTOCOL_VERSION << " 2.";
+  }
+  // dedup only understands json contexts
+  if (_logger_extensions->is_object_extraction_enabled())
+  {
+    RETURN_ERROR_LS(_trace_logger.get(), status, content_encoding_error)
+        << " Structured input can not be combined with dedup.";
+  }
+  if (input.tensor_count() == 0)
+  {
+    RETURN_ERROR_LS(_trace_logger.get(), status, invalid_argument) << "Structured input has no tensors.";
+  }
+  return error_code::success;
+}
+
 int live_model_impl::request_decision(
     string_view context_json, unsigned int flags, decision_response& resp, api_status* status)
 {
@@ -197,18 +305,17 @@ int live_model_impl::request_decision(
 
   std::vector<std::string> event_ids_str(num_decisions);
   std::vector<const char*> event_ids(num_decisions, nullptr);
-  std::map<size_t, std::string> found_ids;
-  RETURN_IF_FAIL(utility::get_event_ids(context_json, found_ids, _trace_logger.get(), status));
-
-  autogenerate_missing_uuids(found_ids, event_ids_str, _seed_shift);
+  autogenerate_missing_uuids(context_info.slot_ids, event_ids_str, _seed_shift);
 
   for (int i = 0; i < event_ids.size(); i++) { event_ids[i] = event_ids_str[i].c_str(); }
 
   // This will behave correctly both before a model is loaded and after. Prior to a model being loaded it operates in
   // explore only mode.
+  const auto predict_start = utility::metrics_registry::now();
   RETURN_IF_FAIL(_model->request_decision(event_ids, context_json, actions_ids, actions_pdfs, model_version, status));
+  utility::metrics_registry::record_since(api_stage::model_predict, predict_start);
   RETURN_IF_FAIL(populate_response(
-      actions_ids, actions_pdfs, event_ids, std::string(model_version), resp, _trace_logger.get(), status));
+      actions_ids, actions_pdfs, event_ids, model_version, resp, _trace_logger.get(), status));
   RETURN_IF_FAIL(_interaction_logger->log_decisions(
       event_ids, context_json, flags, actions_ids, actions_pdfs, model_version, status));
 
@@ -222,8 +329,8 @@ int live_model_impl::request_decision(
 }
 
 int live_model_impl::request_multi_slot_decision_impl(const char* event_id, string_view context_json,
-    std::vector<std::string>& slot_ids, std::vector<std::vector<uint32_t>>& action_ids,
-    std::vector<std::vector<float>>& action_pdfs, std::string& model_version, api_status* status)
+    utility::ContextInfo& context_info, std::vector<std::string>& slot_ids, multi_slot_ranking& ranking,
+    std::string& model_version, api_status* status)
 {
   // clear previous errors if any
   api_status::try_clear(status);
@@ -232,7 +339,6 @@ int live_model_impl::request_multi_slot_decision_impl(const char* event_id, stri
   RETURN_IF_FAIL(check_null_or_empty(event_id, _trace_logger.get(), status));
   RETURN_IF_FAIL(check_null_or_empty(context_json, _trace_logger.get(), status));
 
-  utility::ContextInfo context_info;
   RETURN_IF_FAIL(utility::get_context_info(context_json, context_info, _trace_logger.get(), status));
 
   // Ensure multi comes before slots, this is a current limitation of the parser.
@@ -244,12 +350,12 @@ int live_model_impl::request_multi_slot_decision_impl(const char* event_id, stri
   }
 
   slot_ids.resize(context_info.slots.size());
-  std::map<size_t, std::string> found_ids;
-  RETURN_IF_FAIL(utility::get_slot_ids(context_json, context_info.slots, found_ids, _trace_logger.get(), status));
-  autogenerate_missing_uuids(found_ids, slot_ids, _seed_shift);
+  autogenerate_missing_uuids(context_info.slot_ids, slot_ids, _seed_shift);
 
-  RETURN_IF_FAIL(_model->request_multi_slot_decision(
-      event_id, slot_ids, context_json, action_ids, action_pdfs, model_version, status));
+  const auto predict_start = utility::metrics_registry::now();
+  RETURN_IF_FAIL(
+      _model->request_multi_slot_decision(event_id, slot_ids, context_json, ranking, model_version, status));
+  utility::metrics_registry::record_since(api_stage::model_predict, predict_start);
   return error_code::success;
 }
 
@@ -267,16 +373,16 @@ int live_model_impl::request_multi_slot_decision(const char* event_id, string_vi
 
   if (_learning_mode == APPRENTICE && baseline_actions.empty()) { return error_code::baseline_actions_not_defined; }
 
+  utility::ContextInfo context_info;
   std::vector<std::string> slot_ids;
-  std::vector<std::vector<uint32_t>> action_ids;
-  std::vector<std::vector<float>> action_pdfs;
+  multi_slot_ranking ranking;
   std::string model_version;
 
   RETURN_IF_FAIL(live_model_impl::request_multi_slot_decision_impl(
-      event_id, context_json, slot_ids, action_ids, action_pdfs, model_version, status));
-  RETURN_IF_FAIL(populate_multi_slot_response(action_ids, action_pdfs, std::string(event_id),
-      std::string(model_version), slot_ids, resp, _trace_logger.get(), status));
-  RETURN_IF_FAIL(_interaction_logger->log_decision(event_id, context_json, flags, action_ids, action_pdfs,
+      event_id, context_json, context_info, slot_ids, ranking, model_version, status));
+  RETURN_IF_FAIL(populate_multi_slot_response(
+      ranking, event_id, model_version, slot_ids, resp, _trace_logger.get(), status));
+  RETURN_IF_FAIL(_interaction_logger->log_decision(event_id, context_json, context_info, flags, ranking,
       model_version, slot_ids, status, baseline_actions, _learning_mode));
 
   if (_learning_mode == APPRENTICE || _learning_mode == LOGGINGONLY)
@@ -309,20 +415,20 @@ int live_model_impl::request_multi_slot_decision(const char* event_id, string_vi
 
   if (_learning_mode == APPRENTICE && baseline_actions.empty()) { return error_code::baseline_actions_not_defined; }
 
+  utility::ContextInfo context_info;
   std::vector<std::string> slot_ids;
-  std::vector<std::vector<uint32_t>> action_ids;
-  std::vector<std::vector<float>> action_pdfs;
+  multi_slot_ranking ranking;
   std::string model_version;
 
   RETURN_IF_FAIL(live_model_impl::request_multi_slot_decision_impl(
-      event_id, context_json, slot_ids, action_ids, action_pdfs, model_version, status));
+      event_id, context_json, context_info, slot_ids, ranking, model_version, status));
 
   // set the size of buffer in response to match the number of slots
   resp.resize(slot_ids.size());
 
-  RETURN_IF_FAIL(populate_multi_slot_response_detailed(action_ids, action_pdfs, std::string(event_id),
-      std::string(model_version), slot_ids, resp, _trace_logger.get(), status));
-  RETURN_IF_FAIL(_interaction_logger->log_decision(event_id, context_json, flags, action_ids, action_pdfs,
+  RETURN_IF_FAIL(populate_multi_slot_response_detailed(
+      ranking, event_id, model_version, slot_ids, resp, _trace_logger.get(), status));
+  RETURN_IF_FAIL(_interaction_logger->log_decision(event_id, context_json, context_info, flags, ranking,
       model_version, slot_ids, status, baseline_actions, _learning_mode));
 
   if (_learning_mode == APPRENTICE || _learning_mode == LOGGINGONLY)
@@ -412,6 +518,7 @@ int live_model_impl::refresh_model(api_status* status)
 
   model_management::model_data md;
   RETURN_IF_FAIL(_transport->get_data(md, status));
+  if (md.refresh_count() > 0 && md.data_sz() > 0) { RETURN_IF_FAIL(_transport->verify_data(md, status)); }
 
   bool model_ready = false;
   RETURN_IF_FAIL(_model->update(md, model_ready, status));
@@ -421,6 +528,25 @@ int live_model_impl::refresh_model(api_status* status)
   return error_code::success;
 }
 
+int live_model_impl::get_metrics(metrics_snapshot& snapshot, api_status* status)
+{
+#ifdef RL_DISABLE_METRICS
+  RETURN_ERROR_LS(_trace_logger.get(), status, not_supported) << "The library was built with RL_USE_METRICS=OFF";
+#else
+  utility::metrics_registry::snapshot(snapshot);
+  return error_code::success;
+#endif
+}
+
+int live_model_impl::get_logging_statistics(logging_statistics& stats, api_status* status)
+{
+  stats = logging_statistics();
+  _interaction_logger->get_statistics(stats.interactions);
+  _outcome_logger->get_statistics(stats.observations);
+  if (_episode_logger) { _episode_logger->get_statistics(stats.episodes); }
+  return error_code::success;
+}
+
 live_model_impl::live_model_impl(const utility::configuration& config, const error_fn fn, void* err_context,
     trace_logger_factory_t* trace_factory, data_transport_factory_t* t_factory, model_factory_t* m_factory,
     sender_factory_t* sender_factory, time_provider_factory_t* time_provider_factory)
@@ -653,10 +779,12 @@ int live_model_impl::request_episodic_decision(const char* event_id, const char*
   const auto history = episode.get_history();
   const std::string context_patched = history.get_context(previous_id, context_json);
 
+  const auto predict_start = utility::metrics_registry::now();
   RETURN_IF_FAIL(_model->choose_rank_multistep(
       event_id, seed, context_patched.c_str(), history, action_ids, action_pdf, model_version, status));
+  utility::metrics_registry::record_since(api_stage::model_predict, predict_start);
   RETURN_IF_FAIL(sample_and_populate_response(
-      seed, action_ids, action_pdf, std::move(model_version), resp, _trace_logger.get(), status));
+      seed, action_ids, action_pdf, model_version, resp, _trace_logger.get(), status));
 
   resp.set_event_id(event_id);
 
@@ -2,11 +2,14 @@
 #include "factory_resolver.h"
 #include "learning_mode.h"
 #include "logger/logger_facade.h"
+#include "metrics_snapshot.h"
 #include "model_mgmt.h"
 #include "model_mgmt/data_callback_fn.h"
 #include "model_mgmt/model_downloader.h"
 #include "multi_slot_response_detailed.h"
 #include "multistep.h"
+#include "structured_input.h"
+#include "utility/context_helper.h"
 #include "utility/periodic_background_proc.h"
 #include "utility/watchdog.h"
 
@@ -37,6 +40,15 @@ public:
   // here the event_id is auto-generated
   int request_continuous_action(
       string_view context, unsigned int flags, continuous_action_response& response, api_status* status);
+  int choose_rank(const char* event_id, const structured_input& input, unsigned int flags, ranking_response& response,
+      api_status* status);
+  // here the event_id is auto-generated
+  int choose_rank(const structured_input& input, unsigned int flags, ranking_response& response, api_status* status);
+  int request_continuous_action(const char* event_id, const structured_input& input, unsigned int flags,
+      continuous_action_response& response, api_status* status);
+  // here the event_id is auto-generated
+  int request_continuous_action(
+      const structured_input& input, unsigned int flags, continuous_action_response& response, api_status* status);
   int request_decision(string_view context_json, unsigned int flags, decision_response& resp, api_status* status);
   int request_multi_slot_decision(const char* event_id, string_view context_json, unsigned int flags,
       multi_slot_response& resp, const std::vector<int>& baseline_actions, api_status* status = nullptr);
@@ -63,6 +75,10 @@ public:
 
   int refresh_model(api_status* status);
 
+  int get_metrics(metrics_snapshot& snapshot, api_status* status);
+
+  int get_logging_statistics(logging_statistics& stats, api_status* status);
+
   explicit live_model_impl(const utility::configuration& config, error_fn fn, void* err_context,
       trace_logger_factory_t* trace_factory, data_transport_factory_t* t_factory, model_factory_t* m_factory,
       sender_factory_t* sender_factory, time_provider_factory_t* time_provider_factory);
@@ -88,9 +104,17 @@ private:
   int report_outcome_internal(const char* event_id, D outcome, api_status* status);
   template <typename D, typename I>
   int report_outcome_internal(const char* primary_id, I secondary_id, D outcome, api_status* status);
+  // context_format tells the logger how context is encoded
+  int choose_rank_impl(const char* event_id, string_view context, messages::flatbuff::v2::ContextFormat context_format,
+      unsigned int flags, ranking_response& response, api_status* status);
+  int request_continuous_action_impl(const char* event_id, string_view context,
+      messages::flatbuff::v2::ContextFormat context_format, unsigned int flags, continuous_action_response& response,
+      api_status* status);
+  int check_structured_input(const structured_input& input, api_status* status);
+  // context_info receives the analysis of the context, which is passed on to the logger with it
   int request_multi_slot_decision_impl(const char* event_id, string_view context_json,
-      std::vector<std::string>& slot_ids, std::vector<std::vector<uint32_t>>& action_ids,
-      std::vector<std::vector<float>>& action_pdfs, std::string& model_version, api_status* status);
+      utility::ContextInfo& context_info, std::vector<std::string>& slot_ids, multi_slot_ranking& ranking,
+      std::string& model_version, api_status* status);
 
 private:
   // ensure trace logger exists during shutdown
@@ -98,6 +122,8 @@ private:
   // Internal implementation state
   std::atomic_bool _model_ready{false};
   float _initial_epsilon = 0.2f;
+  // 0 when CB decisions rank all the actions
+  size_t _shortlist_size = 0;
   utility::configuration _configuration;
   error_callback_fn _error_cb;
   model_management::data_callback_fn _data_cb;
@@ -6,11 +6,13 @@
 #include "err_constants.h"
 #include "error_callback_fn.h"
 #include "event_queue.h"
+#include "logger_statistics.h"
 #include "message_sender.h"
 #include "rl_string_view.h"
 #include "serialization/fb_serializer.h"
 #include "serialization/json_serializer.h"
 #include "utility/config_helper.h"
+#include "utility/metrics_registry.h"
 #include "utility/object_pool.h"
 #include "utility/periodic_background_proc.h"
 #include "vw/common/hash.h"
@@ -19,6 +21,7 @@
 // float comparisons
 #include "vw/core/vw_math.h"
 
+#include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <memory>
@@ -46,6 +49,9 @@ public:
   virtual int append(TFunc& func, TEvent* event, api_status* status = nullptr) = 0;
 
   virtual int run_iteration(api_status* status) = 0;
+
+  // Statistics of the queue, the batches and the sender. Takes no lock shared with append().
+  virtual void get_statistics(logger_statistics& stats) const = 0;
 };
 
 // This class takes uses a queue and a background thread to accumulate events, and send them by batch asynchronously.
@@ -68,6 +74,8 @@ public:
 
   int run_iteration(api_status* status) override;
 
+  void get_statistics(logger_statistics& stats) const override;
+
 private:
   int fill_buffer(std::shared_ptr<utility::data_buffer>& retbuffer, size_t& remaining, api_status* status);
 
@@ -96,6 +104,13 @@ private:
   float _subsample_rate;
   events_counter_status _events_counter_status;
   uint64_t _buffer_end_event_index = 0;
+
+  std::atomic<uint64_t> _stat_blocked_time_ns{0};
+  std::atomic<uint64_t> _stat_blocked_count{0};
+  std::atomic<uint64_t> _stat_dropped_subsampling{0};
+  std::atomic<uint64_t> _stat_batches_sent{0};
+  std::atomic<uint64_t> _stat_batch_bytes_sent{0};
+  std::atomic<uint64_t> _stat_send_failures{0};
 };
 
 template <typename TEvent, template <typename> class TSerializer>
@@ -121,10 +136,13 @@ int async_batcher<TEvent, TSerializer>::append(TFunc&& func, TEvent* event, api_
     if (event->try_drop(_subsample_rate, constants::SUBSAMPLE_RATE_DROP_PASS))
     {
       // If the event is dropped, just get out of here
+      utility::metrics_registry::increment(api_counter::events_dropped);
+      _stat_dropped_subsampling.fetch_add(1, std::memory_order_relaxed);
       return error_code::success;
     }
   }
 
+  utility::stage_timer timer(api_stage::queue_enqueue);
   _queue.push(std::move(func), TSerializer<TEvent>::serializer_t::size_estimate(*event), event);
 
   // block or drop events if the queue if full
@@ -132,8 +150,13 @@ int async_batcher<TEvent, TSerializer>::append(TFunc&& func, TEvent* event, api_
   {
     if (queue_mode_enum::BLOCK == _queue_mode)
     {
+      const auto blocked_start = utility::metrics_registry::now();
       std::unique_lock<std::mutex> lk(_m);
       _cv.wait(lk, [this] { return !_queue.is_full(); });
+      lk.unlock();
+      const auto blocked_end = utility::metrics_registry::now();
+      _stat_blocked_time_ns.fetch_add(blocked_end - blocked_start, std::memory_order_relaxed);
+      _stat_blocked_count.fetch_add(1, std::memory_order_relaxed);
     }
     else if (queue_mode_enum::DROP == _queue_mode) { _queue.prune(_pass_prob); }
   }
@@ -154,10 +177,24 @@ int async_batcher<TEvent, TSerializer>::run_iteration(api_status* status)
   return error_code::success;
 }
 
+template <typename TEvent, template <typename> class TSerializer>
+void async_batcher<TEvent, TSerializer>::get_statistics(logger_statistics& stats) const
+{
+  _queue.get_statistics(stats);
+  stats.events_dropped_subsampling += _stat_dropped_subsampling.load(std::memory_order_relaxed);
+  stats.blocked_time_ns = _stat_blocked_time_ns.load(std::memory_order_relaxed);
+  stats.blocked_count = _stat_blocked_count.load(std::memory_order_relaxed);
+  stats.batches_sent = _stat_batches_sent.load(std::memory_order_relaxed);
+  stats.batch_bytes_sent = _stat_batch_bytes_sent.load(std::memory_order_relaxed);
+  stats.send_failures = _stat_send_failures.load(std::memory_order_relaxed);
+  _sender->get_statistics(stats);
+}
+
 template <typename TEvent, template <typename> class TSerializer>
 int async_batcher<TEvent, TSerializer>::fill_buffer(
     std::shared_ptr<utility::data_buffer>& buffer, size_t& remaining, api_status* status)
 {
+  utility::stage_timer timer(api_stage::batch_fill);
   TFunc f_evt;
   TEvent evt;
   TSerializer<TEvent> collection_serializer(*buffer.get(), _batch_content_encoding, _shared_state);
@@ -168,7 +205,9 @@ int async_batcher<TEvent, TSerializer>::fill_buffer(
     {
       if (queue_mode_enum::BLOCK == _queue_mode) { _cv.notify_one(); }
       RETURN_IF_FAIL(f_evt(evt, status));
+      const auto serialization_start = utility::metrics_registry::now();
       RETURN_IF_FAIL(collection_serializer.add(evt, status));
+      utility::metrics_registry::record_since(api_stage::serialization, serialization_start);
       --remaining;
     }
   }
@@ -200,8 +239,16 @@ void async_batcher<TEvent, TSerializer>::flush()
 
     auto buffer = _buffer_pool->acquire();
     if (fill_buffer(buffer, remaining, &status) != error_code::success) { ERROR_CALLBACK(_perror_cb, status); }
-    if (_sender->send(TSerializer<TEvent>::message_id(), buffer, &status) != error_code::success)
+    utility::metrics_registry::increment(api_counter::batches_sent);
+    _stat_batches_sent.fetch_add(1, std::memory_order_relaxed);
+    _stat_batch_bytes_sent.fetch_add(buffer->body_filled_size(), std::memory_order_relaxed);
+    const auto send_start = utility::metrics_registry::now();
+    const auto send_result = _sender->send(TSerializer<TEvent>::message_id(), buffer, &status);
+    utility::metrics_registry::record_since(api_stage::send, send_start);
+    if (send_result != error_code::success)
     {
+      utility::metrics_registry::increment(api_counter::send_failures);
+      _stat_send_failures.fetch_add(1, std::memory_order_relaxed);
       ERROR_CALLBACK(_perror_cb, status);
     }
   }
@@ -49,14 +49,12 @@ int ccb_logger::log_decisions(std::vector<const char*>& event_ids, string_view c
 }
 
 int multi_slot_logger::log_decision(const std::string& event_id, string_view context, unsigned int flags,
-    const std::vector<std::vector<uint32_t>>& action_ids, const std::vector<std::vector<float>>& pdfs,
-    const std::string& model_version, api_status* status)
+    const multi_slot_ranking& ranking, const std::string& model_version, api_status* status)
 {
   const auto now = _time_provider != nullptr ? _time_provider->gmt_now() : timestamp();
 
   auto evt_sp = std::make_shared<multi_slot_decision_event>();
-  auto evt_copy =
-      multi_slot_decision_event::request_decision(event_id, context, flags, action_ids, pdfs, model_version, now);
+  auto evt_copy = multi_slot_decision_event::request_decision(event_id, context, flags, ranking, model_version, now);
   *evt_sp = std::move(evt_copy);
 
   auto evt_fn = [evt_sp](multi_slot_decision_event& out_evt, api_status* status) -> int
@@ -42,6 +42,8 @@ public:
 
   int init(api_status* status);
 
+  void get_statistics(logger_statistics& stats) const { _batcher->get_statistics(stats); }
+
 protected:
   int append(TFunc&& func, TEvent* event, api_status* status);
   int append(TFunc& func, TEvent* event, api_status* status);
@@ -134,8 +136,7 @@ public:
   }
 
   int log_decision(const std::string& event_id, string_view context, unsigned int flags,
-      const std::vector<std::vector<uint32_t>>& action_ids, const std::vector<std::vector<float>>& pdfs,
-      const std::string& model_version, api_status* status);
+      const multi_slot_ranking& ranking, const std::string& model_version, api_status* status);
 };
 
 class observation_logger : public event_logger<outcome_event>
@@ -183,11 +184,38 @@ public:
     // using shared_ptr because we can't move a unique_ptr in C++11
     // We should replace them in C++14
     auto evt_sp = std::make_shared<generic_event>(event_id, now, type, context, _app_id);
+    return append_transformed(evt_sp, ext, serializer, status, args...);
+  }
+
+  // Same as above for a context already analyzed by utility::get_context_info
+  template <typename TSerializer, typename... Args>
+  int log(const char* event_id, string_view context, const utility::ContextInfo& context_info,
+      generic_event::payload_type_t type, i_logger_extensions* ext, TSerializer& serializer, api_status* status,
+      const Args&... args)
+  {
+    const auto now = _time_provider != nullptr ? _time_provider->gmt_now() : timestamp();
+    auto evt_sp = std::make_shared<generic_event>(event_id, now, type, context, context_info, _app_id);
+    return append_transformed(evt_sp, ext, serializer, status, args...);
+  }
+
+  // TODO: used for observations for now.. may want to change that later
+  // These functions will take in fully transformed generic_event objects, and should only be used
+  // when the creation of those types are very cheap
+  int log(const char* event_id, generic_event::payload_buffer_t&& payload, generic_event::payload_type_t type,
+      event_content_type content_type, api_status* status);
+  int log(const char* event_id, generic_event::payload_buffer_t&& payload, generic_event::payload_type_t type,
+      event_content_type content_type, generic_event::object_list_t&& objects, api_status* status);
+
+private:
+  template <typename TSerializer, typename... Args>
+  int append_transformed(const std::shared_ptr<generic_event>& evt_sp, i_logger_extensions* ext,
+      TSerializer& serializer, api_status* status, const Args&... args)
+  {
     // there's no guarantee that the parameter pack Args will stay in scope, so we need to capture them
     // as a copy the ensure their lifetime.
     // TODO: See if there's a way to do this without the copy, since the pack can contain some pretty
     //       expensive objects
-    auto evt_fn = [evt_sp, type, ext, serializer, args...](generic_event& out_evt, api_status* status) -> int
+    auto evt_fn = [evt_sp, ext, serializer, args...](generic_event& out_evt, api_status* status) -> int
     {
       RETURN_IF_FAIL(evt_sp->transform(ext, serializer, status, args...));
       out_evt = std::move(*evt_sp);
@@ -195,14 +223,6 @@ public:
     };
     return append(std::move(evt_fn), evt_sp.get(), status);
   }
-
-  // TODO: used for observations for now.. may want to change that later
-  // These functions will take in fully transformed generic_event objects, and should only be used
-  // when the creation of those types are very cheap
-  int log(const char* event_id, generic_event::payload_buffer_t&& payload, generic_event::payload_type_t type,
-      event_content_type content_type, api_status* status);
-  int log(const char* event_id, generic_event::payload_buffer_t&& payload, generic_event::payload_type_t type,
-      event_content_type content_type, generic_event::object_list_t&& objects, api_status* status);
 };
 }  // namespace logger
 }  // namespace reinforcement_learning
@@ -1,9 +1,12 @@
 #pragma once
 
 #include "constants.h"
+#include "logger_statistics.h"
 #include "ranking_event.h"
 #include "utility/config_helper.h"
+#include "utility/metrics_registry.h"
 
+#include <atomic>
 #include <list>
 #include <mutex>
 #include <queue>
@@ -19,8 +22,8 @@ public:
   using TFunc = std::function<int(T&, api_status*)>;
 
 private:
-  // T's lifetime is tied to TFunc
-  using queue_t = std::list<std::tuple<TFunc, size_t, T*>>;
+  // T's lifetime is tied to TFunc. The last element is the time of the push, for the queue_wait metric.
+  using queue_t = std::list<std::tuple<TFunc, size_t, T*, uint64_t>>;
   using iterator_t = typename queue_t::iterator;
 
   queue_t _queue;
@@ -32,6 +35,14 @@ private:
   events_counter_status _event_counter_status{events_counter_status::DISABLE};
   float _subsample_rate{1.0f};
 
+  // Written under _mutex, read without it by get_statistics()
+  std::atomic<uint64_t> _stat_count{0};
+  std::atomic<uint64_t> _stat_bytes{0};
+  std::atomic<uint64_t> _stat_count_high_water_mark{0};
+  std::atomic<uint64_t> _stat_bytes_high_water_mark{0};
+  std::atomic<uint64_t> _stat_dropped_subsampling{0};
+  std::atomic<uint64_t> _stat_dropped_queue_full{0};
+
 public:
   event_queue(size_t max_capacity, events_counter_status event_counter_status = events_counter_status::DISABLE,
       float subsample_rate = 1.0f)
@@ -48,6 +59,9 @@ public:
       *item = std::move(std::get<0>(entry));
       _capacity = (std::max)(0, static_cast<int>(_capacity) - static_cast<int>(std::get<1>(entry)));
       _queue.pop_front();
+      update_size_statistics();
+      mlock.unlock();
+      utility::metrics_registry::record_since(api_stage::queue_wait, std::get<3>(entry));
       return true;
     }
     return false;
@@ -69,11 +83,16 @@ public:
       if (event->try_drop(_subsample_rate, constants::SUBSAMPLE_RATE_DROP_PASS))
       {
         // If the event is dropped, just get out of here
+        utility::metrics_registry::increment(api_counter::events_dropped);
+        _stat_dropped_subsampling.store(_stat_dropped_subsampling.load(std::memory_order_relaxed) + 1,
+            std::memory_order_relaxed);
         return false;
       }
     }
     _capacity += item_size;
-    _queue.emplace_back(std::forward<TFunc>(item), item_size, event);
+    _queue.emplace_back(std::forward<TFunc>(item), item_size, event, utility::metrics_registry::now());
+    update_size_statistics();
+    utility::metrics_registry::increment(api_counter::events_enqueued);
     return true;
   }
 
@@ -81,11 +100,17 @@ public:
   {
     std::unique_lock<std::mutex> mlock(_mutex);
     if (!is_full()) return;
+    const auto size_before = _queue.size();
     for (auto it = _queue.begin(); it != _queue.end();)
     {
       it = std::get<2>(*it)->try_drop(pass_prob, _drop_pass) ? erase(it) : (++it);
     }
     ++_drop_pass;
+    utility::metrics_registry::increment(api_counter::events_dropped, size_before - _queue.size());
+    _stat_dropped_queue_full.store(
+        _stat_dropped_queue_full.load(std::memory_order_relaxed) + size_before - _queue.size(),
+        std::memory_order_relaxed);
+    update_size_statistics();
   }
 
   // approximate size
@@ -99,7 +124,35 @@ public:
 
   size_t capacity() const { return _capacity; }
 
+  // Takes no lock, the values may be slightly behind the queue
+  void get_statistics(logger_statistics& stats) const
+  {
+    stats.queue_count = _stat_count.load(std::memory_order_relaxed);
+    stats.queue_bytes = _stat_bytes.load(std::memory_order_relaxed);
+    stats.queue_count_high_water_mark = _stat_count_high_water_mark.load(std::memory_order_relaxed);
+    stats.queue_bytes_high_water_mark = _stat_bytes_high_water_mark.load(std::memory_order_relaxed);
+    stats.events_dropped_subsampling = _stat_dropped_subsampling.load(std::memory_order_relaxed);
+    stats.events_dropped_queue_full = _stat_dropped_queue_full.load(std::memory_order_relaxed);
+  }
+
 private:
+  // thread-unsafe
+  void update_size_statistics()
+  {
+    const uint64_t count = _queue.size();
+    const uint64_t bytes = _capacity;
+    _stat_count.store(count, std::memory_order_relaxed);
+    _stat_bytes.store(bytes, std::memory_order_relaxed);
+    if (count > _stat_count_high_water_mark.load(std::memory_order_relaxed))
+    {
+      _stat_count_high_water_mark.store(count, std::memory_order_relaxed);
+    }
+    if (bytes > _stat_bytes_high_water_mark.load(std::memory_order_relaxed))
+    {
+      _stat_bytes_high_water_mark.store(bytes, std::memory_order_relaxed);
+    }
+  }
+
   // thread-unsafe
   iterator_t erase(iterator_t it)
   {
@@ -11,11 +11,13 @@
 #include "utility/eventhub_http_authorization.h"
 #include "utility/header_authorization.h"
 #include "utility/http_client.h"
+#include "utility/metrics_registry.h"
 #include "utility/stl_container_adapter.h"
 
 #include <cpprest/http_headers.h>
 #include <pplx/pplxtasks.h>
 
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <sstream>
@@ -39,6 +41,8 @@ class http_transport_client : public i_sender
 public:
   virtual int init(const utility::configuration& config, api_status* status) override;
 
+  void get_statistics(logger_statistics& stats) const override;
+
   // Takes the ownership of the i_http_client and delete it at the end of lifetime
   template <typename... Args>
   http_transport_client(i_http_client* client, size_t tasks_count, size_t MAX_RETRIES,
@@ -59,7 +63,8 @@ private:
         std::chrono::milliseconds max_retry_duration = std::chrono::milliseconds(
             360000),  // retries will halt before max_retries attempts if this time elapses
                       // first
-        error_callback_fn* error_callback = nullptr, i_trace* trace = nullptr);
+        error_callback_fn* error_callback = nullptr, i_trace* trace = nullptr,
+        std::atomic<size_t>* requests_in_flight = nullptr);
 
     // The constructor kicks off an async request which captures the this variable. If this object is moved then the
     // this pointer is invalidated and causes tricky bugs.
@@ -92,6 +97,8 @@ private:
 
     error_callback_fn* _error_callback;
     i_trace* _trace;
+    // Counts the request from its start to its final response, retries included
+    std::atomic<size_t>* _requests_in_flight;
   };
 
 private:
@@ -114,12 +121,13 @@ private:
   const std::chrono::milliseconds _max_retry_duration;
   i_trace* _trace;
   error_callback_fn* _error_callback;
+  std::atomic<size_t> _requests_in_flight{0};
 };
 
 template <typename TAuthorization>
 http_transport_client<TAuthorization>::http_request_task::http_request_task(i_http_client* client, http_headers headers,
     const buffer& post_data, size_t max_retries, std::chrono::milliseconds max_retry_duration,
-    error_callback_fn* error_callback, i_trace* trace)
+    error_callback_fn* error_callback, i_trace* trace, std::atomic<size_t>* requests_in_flight)
     : _client(client)
     , _headers(headers)
     , _post_data(post_data)
@@ -128,7 +136,9 @@ http_transport_client<TAuthorization>::http_request_task::http_request_task(i_ht
     , _max_retry_duration(max_retry_duration)
     , _error_callback(error_callback)
     , _trace(trace)
+    , _requests_in_flight(requests_in_flight)
 {
+  if (_requests_in_flight != nullptr) { _requests_in_flight->fetch_add(1, std::memory_order_relaxed); }
   _task = send_request();
 }
 
@@ -150,6 +160,7 @@ pplx::task<web::http::status_code> http_transport_client<TAuthorization>::http_r
               TRACE_ERROR(_trace, e.what());
             }
 
+            if (_requests_in_flight != nullptr) { _requests_in_flight->fetch_sub(1, std::memory_order_relaxed); }
             return code;
           });
 }
@@ -210,6 +221,7 @@ pplx::task<http_response> http_transport_client<TAuthorization>::http_request_ta
     std::this_thread::sleep_for(RETRY_DELAY);
 
     // return a new task which will resubmit the original request
+    utility::metrics_registry::increment(api_counter::send_retries);
     return send_request_with_retries(try_count + 1);
   };
 
@@ -233,6 +245,12 @@ int http_transport_client<TAuthorization>::init(const utility::configuration& co
   return error_code::success;
 }
 
+template <typename TAuthorization>
+void http_transport_client<TAuthorization>::get_statistics(logger_statistics& stats) const
+{
+  stats.requests_in_flight = _requests_in_flight.load(std::memory_order_relaxed);
+}
+
 template <typename TAuthorization>
 int http_transport_client<TAuthorization>::pop_task(api_status* status)
 {
@@ -268,8 +286,8 @@ int http_transport_client<TAuthorization>::v_send(const buffer& post_data, api_s
     // Before creating the task, ensure that it is allowed to be created.
     if (_tasks.size() >= _max_tasks_count) { RETURN_IF_FAIL(pop_task(status)); }
 
-    std::unique_ptr<http_request_task> request_task(new http_request_task(
-        _client.get(), headers, post_data, _max_retry_count, _max_retry_duration, _error_callback, _trace));
+    std::unique_ptr<http_request_task> request_task(new http_request_task(_client.get(), headers, post_data,
+        _max_retry_count, _max_retry_duration, _error_callback, _trace, &_requests_in_flight));
     _tasks.push(std::move(request_task));
   }
   catch (const std::exception& e)
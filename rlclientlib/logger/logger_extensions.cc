@@ -27,8 +27,8 @@ public:
   bool is_object_extraction_enabled() const override { return false; }
   bool is_serialization_transform_enabled() const override { return false; }
 
-  int transform_payload_and_extract_objects(string_view context, std::string& edited_payload,
-      generic_event::object_list_t& objects, api_status* status) override
+  int transform_payload_and_extract_objects(string_view context, const utility::ContextInfo* context_info,
+      std::string& edited_payload, generic_event::object_list_t& objects, api_status* status) override
   {
     return error_code::success;
   }
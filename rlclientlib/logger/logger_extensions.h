@@ -17,10 +17,12 @@ enum class event_content_type;
 namespace utility
 {
 class watchdog;
-}
+struct ContextInfo;
+}  // namespace utility
 class generic_event;
 class api_status;
 class i_time_provider;
+struct logger_statistics;
 namespace logger
 {
 template <typename TEvent>
@@ -59,10 +61,13 @@ public:
 
   virtual std::unique_ptr<i_async_batcher<generic_event>> create_batcher(std::unique_ptr<i_message_sender> sender,
       utility::watchdog& watchdog, error_callback_fn* perror_cb, const char* section) = 0;
-  virtual int transform_payload_and_extract_objects(
-      string_view context, std::string& edited_payload, object_list_t& objects, api_status* status) = 0;
+  // context_info is the analysis of the context done when the request was served, nullptr if there was none
+  virtual int transform_payload_and_extract_objects(string_view context, const utility::ContextInfo* context_info,
+      std::string& edited_payload, object_list_t& objects, api_status* status) = 0;
   virtual int transform_serialized_payload(
       payload_buffer_t& input, event_content_type& content_type, api_status* status) const = 0;
+  // Adds the statistics of the transforms, the compression sizes
+  virtual void get_statistics(logger_statistics& /*stats*/) const {}
 
   static std::unique_ptr<i_logger_extensions> get_extensions(
       const utility::configuration& config, std::unique_ptr<i_time_provider> time_provider);
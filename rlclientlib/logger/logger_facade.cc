@@ -80,11 +80,14 @@ int interaction_logger_facade::init(api_status* status)
 }
 
 int interaction_logger_facade::log(string_view context, unsigned int flags, const ranking_response& response,
-    api_status* status, learning_mode learning_mode)
+    api_status* status, learning_mode learning_mode, v2::ContextFormat context_format,
+    const std::vector<int>& shortlist)
 {
   switch (_version)
   {
     case 1:
+      // v1 events have no way to tell a binary context from a json one, or to carry a shortlist
+      if (context_format != v2::ContextFormat_Json || !shortlist.empty()) { return protocol_not_supported(status); }
       return _v1_cb->log(response.get_event_id(), context, flags, response, status, learning_mode);
     case 2:
     {
@@ -100,9 +103,13 @@ int interaction_logger_facade::log(string_view context, unsigned int flags, cons
         action_ids.push_back(r.action_id + 1);
         probabilities.push_back(r.probability);
       }
+      // logged from 1 like the action ids
+      std::vector<uint64_t> shortlist_ids;
+      shortlist_ids.reserve(shortlist.size());
+      for (const auto action : shortlist) { shortlist_ids.push_back(static_cast<uint64_t>(action) + 1); }
 
       return _v2->log(response.get_event_id(), context, _serializer_cb.type, &_logger_extensions, _serializer_cb,
-          status, flags, lmt, action_ids, probabilities, model_id);
+          status, flags, lmt, action_ids, probabilities, model_id, context_format, shortlist_ids);
     }
     default:
       return protocol_not_supported(status);
@@ -170,8 +177,8 @@ int multi_slot_model_type_to_payload_type(
   return error_code::success;
 }
 
-int interaction_logger_facade::log_decision(const std::string& event_id, string_view context, unsigned int flags,
-    const std::vector<std::vector<uint32_t>>& action_ids, const std::vector<std::vector<float>>& pdfs,
+int interaction_logger_facade::log_decision(const std::string& event_id, string_view context,
+    const utility::ContextInfo& context_info, unsigned int flags, const multi_slot_ranking& ranking,
     const std::string& model_version, const std::vector<std::string>& slot_ids, api_status* status,
     const std::vector<int>& baseline_actions, learning_mode learning_mode)
 {
@@ -182,7 +189,7 @@ int interaction_logger_facade::log_decision(const std::string& event_id, string_
       switch (_model_type)
       {
         case model_type_t::SLATES:
-          return _v1_multislot->log_decision(event_id, context, flags, action_ids, pdfs, model_version, status);
+          return _v1_multislot->log_decision(event_id, context, flags, ranking, model_version, status);
         default:
           RETURN_ERROR_ARG(
               nullptr, status, protocol_not_supported, "multi_slot logger under v1 protocol can only log slates.");
@@ -196,16 +203,16 @@ int interaction_logger_facade::log_decision(const std::string& event_id, string_
       generic_event::payload_type_t payload_type;
       RETURN_IF_FAIL(multi_slot_model_type_to_payload_type(_model_type, payload_type, status));
 
-      return _v2->log(event_id.c_str(), context, payload_type, &_logger_extensions, _serializer_multislot, status,
-          flags, action_ids, pdfs, model_version, slot_ids, baseline_actions, lmt);
+      return _v2->log(event_id.c_str(), context, context_info, payload_type, &_logger_extensions,
+          _serializer_multislot, status, flags, ranking, model_version, slot_ids, baseline_actions, lmt);
     }
     default:
       return protocol_not_supported(status);
   }
 }
 
-int interaction_logger_facade::log_continuous_action(
-    string_view context, unsigned int flags, const continuous_action_response& response, api_status* status)
+int interaction_logger_facade::log_continuous_action(string_view context, unsigned int flags,
+    const continuous_action_response& response, api_status* status, v2::ContextFormat context_format)
 {
   switch (_version)
   {
@@ -215,13 +222,26 @@ int interaction_logger_facade::log_continuous_action(
       // so that it can be copied by value and persist after char* goes out of scope
       auto model_id = std::string(response.get_model_id());
       return _v2->log(response.get_event_id(), context, _serializer_ca.type, &_logger_extensions, _serializer_ca,
-          status, flags, response.get_chosen_action(), response.get_chosen_action_pdf_value(), model_id);
+          status, flags, response.get_chosen_action(), response.get_chosen_action_pdf_value(), model_id,
+          context_format);
     }
     default:
       return protocol_not_supported(status);
   }
 }
 
+void interaction_logger_facade::get_statistics(logger_statistics& stats) const
+{
+  if (_v1_cb) { _v1_cb->get_statistics(stats); }
+  else if (_v1_ccb) { _v1_ccb->get_statistics(stats); }
+  else if (_v1_multislot) { _v1_multislot->get_statistics(stats); }
+  else if (_v2)
+  {
+    _v2->get_statistics(stats);
+    _logger_extensions.get_statistics(stats);
+  }
+}
+
 observation_logger_facade::observation_logger_facade(const utility::configuration& c,
     std::unique_ptr<i_message_sender> sender, utility::watchdog& watchdog,
     std::unique_ptr<i_time_provider> time_provider, error_callback_fn* perror_cb)
@@ -359,6 +379,12 @@ int observation_logger_facade::report_action_taken(const char* primary_id, const
   }
 }
 
+void observation_logger_facade::get_statistics(logger_statistics& stats) const
+{
+  if (_v1) { _v1->get_statistics(stats); }
+  else if (_v2) { _v2->get_statistics(stats); }
+}
+
 // TODO: Do we need an EPISODE_SECTION for the config? Just use OBSERVATION_SECTION for now
 episode_logger_facade::episode_logger_facade(const utility::configuration& c, std::unique_ptr<i_message_sender> sender,
     utility::watchdog& watchdog, std::unique_ptr<i_time_provider> time_provider, error_callback_fn* perror_cb)
@@ -394,5 +420,10 @@ int episode_logger_facade::log(const char* episode_id, api_status* status)
       return protocol_not_supported(status);
   }
 }
+
+void episode_logger_facade::get_statistics(logger_statistics& stats) const
+{
+  if (_v2) { _v2->get_statistics(stats); }
+}
 }  // namespace logger
 }  // namespace reinforcement_learning
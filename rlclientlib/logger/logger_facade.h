@@ -7,11 +7,13 @@
 #include "event_logger.h"
 #include "learning_mode.h"
 #include "logger/logger_extensions.h"
+#include "logger_statistics.h"
 #include "message_sender.h"
 #include "model_mgmt.h"
 #include "ranking_response.h"
 #include "serialization/payload_serializer.h"
 #include "time_helper.h"
+#include "utility/context_helper.h"
 #include "utility/watchdog.h"
 
 #include <functional>
@@ -38,28 +40,32 @@ public:
 
   int init(api_status* status);
 
-  // CB v1/v2
+  // CB v1/v2, only v2 logs contexts that are not json and shortlists (the indices of the actions of context that were
+  // ranked)
   int log(string_view context, unsigned int flags, const ranking_response& response, api_status* status,
-      learning_mode learning_mode = ONLINE);
+      learning_mode learning_mode = ONLINE, v2::ContextFormat context_format = v2::ContextFormat_Json,
+      const std::vector<int>& shortlist = {});
 
   int log_decisions(std::vector<const char*>& event_ids, string_view context, unsigned int flags,
       const std::vector<std::vector<uint32_t>>& action_ids, const std::vector<std::vector<float>>& pdfs,
       const std::string& model_version, api_status* status);
 
-  // Multislot (Slates v1/v2 + CCB v2)
-  int log_decision(const std::string& event_id, string_view context, unsigned int flags,
-      const std::vector<std::vector<uint32_t>>& action_ids, const std::vector<std::vector<float>>& pdfs,
-      const std::string& model_version, const std::vector<std::string>& slot_ids, api_status* status,
-      const std::vector<int>& baseline_actions, learning_mode learning_mode = ONLINE);
+  // Multislot (Slates v1/v2 + CCB v2), context_info is the analysis of the context done while serving the request
+  int log_decision(const std::string& event_id, string_view context, const utility::ContextInfo& context_info,
+      unsigned int flags, const multi_slot_ranking& ranking, const std::string& model_version,
+      const std::vector<std::string>& slot_ids, api_status* status, const std::vector<int>& baseline_actions,
+      learning_mode learning_mode = ONLINE);
 
   // Continuous
-  int log_continuous_action(
-      string_view context, unsigned int flags, const continuous_action_response& response, api_status* status);
+  int log_continuous_action(string_view context, unsigned int flags, const continuous_action_response& response,
+      api_status* status, v2::ContextFormat context_format = v2::ContextFormat_Json);
 
   // Multistep
   int log(const char* episode_id, const char* previous_id, string_view context, unsigned int flags,
       const ranking_response& response, api_status* status);
 
+  void get_statistics(logger_statistics& stats) const;
+
 private:
   const reinforcement_learning::model_management::model_type_t _model_type;
   const int _version;
@@ -106,6 +112,8 @@ public:
   int report_action_taken(const char* event_id, api_status* status);
   int report_action_taken(const char* primary_id, const char* secondary_id, api_status* status);
 
+  void get_statistics(logger_statistics& stats) const;
+
 private:
   const int _version;
   int _serializer_shared_state;
@@ -132,6 +140,8 @@ public:
 
   int log(const char* episode_id, api_status* status);
 
+  void get_statistics(logger_statistics& stats) const;
+
 private:
   const int _version;
   int _serializer_shared_state;
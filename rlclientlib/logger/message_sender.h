@@ -5,6 +5,7 @@
 namespace reinforcement_learning
 {
 class api_status;
+struct logger_statistics;
 
 namespace utility
 {
@@ -20,6 +21,8 @@ public:
   virtual ~i_message_sender() = default;
   virtual int send(const uint16_t msg_type, const buffer& db, api_status* status = nullptr) = 0;
   virtual int init(api_status* status = nullptr) = 0;
+  // Adds the statistics the sender keeps, if any
+  virtual void get_statistics(logger_statistics& /*stats*/) const {}
 };
 }  // namespace logger
 }  // namespace reinforcement_learning
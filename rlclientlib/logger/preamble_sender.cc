@@ -26,5 +26,7 @@ int preamble_message_sender::send(const uint16_t msg_type, const buffer& db, api
 }
 
 int preamble_message_sender::init(api_status* status) { return error_code::success; }
+
+void preamble_message_sender::get_statistics(logger_statistics& stats) const { _sender->get_statistics(stats); }
 }  // namespace logger
 }  // namespace reinforcement_learning
@@ -12,6 +12,7 @@ public:
   explicit preamble_message_sender(std::unique_ptr<i_sender>);
   int send(const uint16_t msg_type, const buffer& db, api_status* status) override;
   int init(api_status* status) override;
+  void get_statistics(logger_statistics& stats) const override;
 
 private:
   std::unique_ptr<i_sender> _sender;
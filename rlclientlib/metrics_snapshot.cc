@@ -0,0 +1,90 @@
+#include "metrics_snapshot.h"
+
+#include <sstream>
+
+namespace reinforcement_learning
+{
+namespace
+{
+const char* const STAGE_NAMES[] = {"context_parse", "pool_checkout", "model_predict", "sampling", "serialization",
+    "queue_enqueue", "queue_wait", "batch_fill", "compression", "send", "model_fetch", "model_verify", "model_load"};
+const char* const COUNTER_NAMES[] = {
+    "events_enqueued", "events_dropped", "batches_sent", "send_failures", "send_retries"};
+
+static_assert(sizeof(STAGE_NAMES) / sizeof(STAGE_NAMES[0]) == static_cast<size_t>(api_stage::count),
+    "Every stage needs a name");
+static_assert(sizeof(COUNTER_NAMES) / sizeof(COUNTER_NAMES[0]) == static_cast<size_t>(api_counter::count),
+    "Every counter needs a name");
+
+// Prometheus buckets, in seconds. The histograms are much finer, they are summed into these.
+const double PROMETHEUS_BOUNDS[] = {1e-6, 2.5e-6, 5e-6, 1e-5, 2.5e-5, 5e-5, 1e-4, 2.5e-4, 5e-4, 1e-3, 2.5e-3, 5e-3,
+    1e-2, 2.5e-2, 5e-2, 0.1, 0.25, 0.5, 1., 2.5, 5., 10.};
+}  // namespace
+
+const char* to_string(api_stage stage) { return STAGE_NAMES[static_cast<size_t>(stage)]; }
+
+const char* to_string(api_counter counter) { return COUNTER_NAMES[static_cast<size_t>(counter)]; }
+
+uint64_t latency_histogram::quantile(double q) const
+{
+  if (count == 0) { return 0; }
+  const auto rank = static_cast<uint64_t>(q * static_cast<double>(count));
+  uint64_t seen = 0;
+  for (const auto& bucket : buckets)
+  {
+    seen += bucket.second;
+    if (seen > rank) { return bucket.first; }
+  }
+  return buckets.back().first;
+}
+
+metrics_snapshot::metrics_snapshot()
+    : _histograms(static_cast<size_t>(api_stage::count)), _counters(static_cast<size_t>(api_counter::count), 0)
+{
+}
+
+const latency_histogram& metrics_snapshot::get(api_stage stage) const
+{
+  return _histograms[static_cast<size_t>(stage)];
+}
+
+uint64_t metrics_snapshot::get(api_counter counter) const { return _counters[static_cast<size_t>(counter)]; }
+
+latency_histogram& metrics_snapshot::get(api_stage stage) { return _histograms[static_cast<size_t>(stage)]; }
+
+uint64_t& metrics_snapshot::get(api_counter counter) { return _counters[static_cast<size_t>(counter)]; }
+
+std::string metrics_snapshot::to_prometheus() const
+{
+  std::ostringstream out;
+  out << "# HELP rl_stage_latency_seconds Latency of the stages of the reinforcement learning client API.\n";
+  out << "# TYPE rl_stage_latency_seconds histogram\n";
+  for (size_t stage = 0; stage < _histograms.size(); ++stage)
+  {
+    const auto& histogram = _histograms[stage];
+    const char* name = STAGE_NAMES[stage];
+
+    // The bound of a bucket is inclusive, a bucket falls under a Prometheus bound if its own bound does
+    uint64_t cumulative = 0;
+    auto bucket = histogram.buckets.begin();
+    for (const double bound : PROMETHEUS_BOUNDS)
+    {
+      const auto bound_ns = static_cast<uint64_t>(bound * 1e9 + 0.5);
+      for (; bucket != histogram.buckets.end() && bucket->first <= bound_ns; ++bucket) { cumulative += bucket->second; }
+      out << "rl_stage_latency_seconds_bucket{stage=\"" << name << "\",le=\"" << bound << "\"} " << cumulative << "\n";
+    }
+    out << "rl_stage_latency_seconds_bucket{stage=\"" << name << "\",le=\"+Inf\"} " << histogram.count << "\n";
+    out << "rl_stage_latency_seconds_sum{stage=\"" << name << "\"} " << static_cast<double>(histogram.sum) / 1e9
+        << "\n";
+    out << "rl_stage_latency_seconds_count{stage=\"" << name << "\"} " << histogram.count << "\n";
+  }
+
+  for (size_t counter = 0; counter < _counters.size(); ++counter)
+  {
+    const char* name = COUNTER_NAMES[counter];
+    out << "# TYPE rl_" << name << "_total counter\n";
+    out << "rl_" << name << "_total " << _counters[counter] << "\n";
+  }
+  return out.str();
+}
+}  // namespace reinforcement_learning
@@ -2,15 +2,24 @@
 
 #include "api_status.h"
 #include "err_constants.h"
+#include "str_util.h"
+#include "trace_logger.h"
 
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include <cerrno>
+#include <ctime>
 #include <fstream>
 #include <utility>
 #ifndef _WIN32
+#  include <fcntl.h>
+#  include <sys/mman.h>
 #  include <unistd.h>
 #endif
+#ifdef __linux__
+#  include <sys/inotify.h>
+#endif
 
 #ifdef _WIN32
 #  define stat _stat
@@ -20,6 +29,22 @@ namespace reinforcement_learning
 {
 namespace model_management
 {
+namespace
+{
+// 64 bit FNV-1a
+uint64_t content_hash(const model_data& data)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+  for (size_t i = 0; i < data.data_sz(); ++i)
+  {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+}  // namespace
+
 int file_model_loader::get_file_modified_time(time_t& file_time, api_status* status) const
 {
   struct stat result
@@ -33,11 +58,18 @@ int file_model_loader::get_file_modified_time(time_t& file_time, api_status* sta
   RETURN_ERROR_LS(_trace, status, file_stats_error) << " file_name = " << _file_name;
 }
 
-file_model_loader::file_model_loader(std::string file_name, bool file_must_exist, i_trace* trace_logger)
-    : _file_name{std::move(file_name)}, _file_must_exist{file_must_exist}, _trace{trace_logger}
+file_model_loader::file_model_loader(
+    std::string file_name, bool file_must_exist, i_trace* trace_logger, bool use_mmap, bool use_inotify)
+    : _file_name{std::move(file_name)}
+    , _file_must_exist{file_must_exist}
+    , _trace{trace_logger}
+    , _use_mmap{use_mmap}
+    , _use_inotify{use_inotify}
 {
 }
 
+file_model_loader::~file_model_loader() { stop_watching(); }
+
 int file_model_loader::init(api_status* status)
 {
   if (_file_must_exist)
@@ -45,43 +77,197 @@ int file_model_loader::init(api_status* status)
     std::ifstream in_strm(_file_name.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
     if (!in_strm.good()) { RETURN_ERROR_LS(_trace, status, file_open_error) << " file_name = " << _file_name; }
   }
+  if (_use_inotify) { start_watching(); }
   return error_code::success;
 }
 
 int file_model_loader::get_data(model_data& data, api_status* status)
 {
+  // Nothing happened to the file since it was last loaded
+  if (!has_pending_change()) { return error_code::success; }
+
   std::ifstream in_strm(_file_name.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
 
   if (in_strm.good())
   {
     // File exists read from it
     const auto curr_file_size = in_strm.tellg();
+    in_strm.close();
 
     time_t curr_last_modified = 0;
     RETURN_IF_FAIL(get_file_modified_time(curr_last_modified, status));
 
-    // If file has the same size and same timestamp, no need to reload
-    if (curr_last_modified == _last_modified && (size_t)curr_file_size == _datasz) { return error_code::success; }
-
-    in_strm.seekg(0, std::ios::beg);
-    auto* const buff = data.alloc(curr_file_size);
-    if (!in_strm.read(buff, curr_file_size))
+    // If file has the same size and same timestamp, no need to reload. The timestamp has a resolution of a second
+    // though: a file modified in the second it was loaded can change again without either changing. Such a file is
+    // read again and compared by content, until a load happens after it was last modified.
+    const bool same_stamp = curr_last_modified == _last_modified && (size_t)curr_file_size == _datasz;
+    if (same_stamp && _last_modified < _loaded_at)
     {
-      RETURN_ERROR_LS(_trace, status, file_read_error) << " file_name = " << _file_name;
+      _pending_change = false;
+      return error_code::success;
     }
-    data.data_sz(curr_file_size);
-    data.increment_refresh_count();
-    in_strm.close();
+
+    const time_t load_time = std::time(nullptr);
+    if (_use_mmap) { RETURN_IF_FAIL(map_file(data, curr_file_size, status)); }
+    else { RETURN_IF_FAIL(read_file(data, curr_file_size, status)); }
+
+    const bool is_racy = curr_last_modified >= load_time;
+    const uint64_t hash = same_stamp || is_racy ? content_hash(data) : 0;
+    // An unchanged model is not handed out again
+    if (!same_stamp || hash != _content_hash) { data.increment_refresh_count(); }
     _last_modified = curr_last_modified;
-    _datasz = (size_t)curr_file_size;
+    _datasz = data.data_sz();
+    _loaded_at = load_time;
+    _content_hash = hash;
+    // Check again on the next refresh, even if nothing else happens to the file
+    _pending_change = is_racy;
+    return error_code::success;
   }
   else
   {
     // File does not exist or cannot open
     if (_file_must_exist) { RETURN_ERROR_LS(_trace, status, file_open_error) << " file_name = " << _file_name; }
   }
+  _pending_change = false;
+  return error_code::success;
+}
+
+int file_model_loader::read_file(model_data& data, size_t file_size, api_status* status) const
+{
+  std::ifstream in_strm(_file_name.c_str(), std::ios::in | std::ios::binary);
+  auto* const buff = data.alloc(file_size);
+  if (!in_strm.read(buff, file_size))
+  {
+    RETURN_ERROR_LS(_trace, status, file_read_error) << " file_name = " << _file_name;
+  }
+  data.data_sz(file_size);
   return error_code::success;
 }
 
+int file_model_loader::map_file(model_data& data, size_t file_size, api_status* status)
+{
+#ifdef _WIN32
+  // Not mapped on Windows
+  return read_file(data, file_size, status);
+#else
+  const int fd = ::open(_file_name.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) { RETURN_ERROR_LS(_trace, status, file_open_error) << " file_name = " << _file_name; }
+
+  // The file may have changed since it was checked, map what is there now
+  struct stat result
+  {
+  };
+  if (::fstat(fd, &result) != 0)
+  {
+    ::close(fd);
+    RETURN_ERROR_LS(_trace, status, file_stats_error) << " file_name = " << _file_name;
+  }
+  file_size = static_cast<size_t>(result.st_size);
+
+  // The mapped file was written to instead of being replaced, the model still using it already sees the new bytes.
+  // The new model is read, so that it does not depend on a file that is rewritten in place.
+  const auto device = static_cast<uint64_t>(result.st_dev);
+  const auto inode = static_cast<uint64_t>(result.st_ino);
+  if (!_mapping.expired() && device == _mapped_device && inode == _mapped_inode)
+  {
+    ::close(fd);
+    TRACE_WARN(_trace,
+        utility::concat("Model file ", _file_name, " was rewritten in place while mapped, which is not supported. ",
+            "Replace it by renaming a new file over it."));
+    return read_file(data, file_size, status);
+  }
+
+  // An empty file can not be mapped
+  if (file_size == 0)
+  {
+    ::close(fd);
+    data.alloc(0);
+    return error_code::success;
+  }
+
+  // Private mapping, so that writes through data() stay local. Pages that are not written still show the file, which
+  // is why it has to be replaced rather than rewritten in place.
+  void* const mapping = ::mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  const int map_error = errno;
+  // The mapping outlives the descriptor
+  ::close(fd);
+  if (mapping == MAP_FAILED)
+  {
+    RETURN_ERROR_LS(_trace, status, file_read_error)
+        << " file_name = " << _file_name << ", mmap failed with errno " << map_error;
+  }
+
+  std::shared_ptr<char> shared(static_cast<char*>(mapping), [file_size](char* p) { ::munmap(p, file_size); });
+  _mapping = shared;
+  _mapped_device = device;
+  _mapped_inode = inode;
+  data.set_shared_data(std::move(shared), file_size);
+  return error_code::success;
+#endif
+}
+
+void file_model_loader::start_watching()
+{
+#ifdef __linux__
+  // Watch the directory rather than the file, models are usually replaced by renaming a new file over the old one
+  const auto separator = _file_name.find_last_of('/');
+  const std::string directory = separator == std::string::npos ? "." : _file_name.substr(0, separator + 1);
+  _watched_name = separator == std::string::npos ? _file_name : _file_name.substr(separator + 1);
+
+  _watch_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (_watch_fd < 0)
+  {
+    TRACE_WARN(_trace, "inotify is not available, polling the model file for changes.");
+    return;
+  }
+
+  if (::inotify_add_watch(
+          _watch_fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_ATTRIB) < 0)
+  {
+    TRACE_WARN(_trace, "Unable to watch the directory of the model file, polling it for changes.");
+    stop_watching();
+  }
+#endif
+}
+
+void file_model_loader::stop_watching()
+{
+#ifdef __linux__
+  if (_watch_fd >= 0) { ::close(_watch_fd); }
+#endif
+  _watch_fd = -1;
+}
+
+bool file_model_loader::has_pending_change()
+{
+#ifdef __linux__
+  if (_watch_fd < 0) { return true; }
+
+  alignas(inotify_event) char buffer[4096];
+  ssize_t length = 0;
+  while ((length = ::read(_watch_fd, buffer, sizeof(buffer))) > 0)
+  {
+    for (const char* p = buffer; p < buffer + length;)
+    {
+      const auto* event = reinterpret_cast<const inotify_event*>(p);
+      if ((event->mask & IN_Q_OVERFLOW) != 0 || (event->len > 0 && _watched_name == event->name))
+      {
+        _pending_change = true;
+      }
+      if ((event->mask & IN_IGNORED) != 0)
+      {
+        // The directory is gone, fall back to polling
+        stop_watching();
+        return true;
+      }
+      p += sizeof(inotify_event) + event->len;
+    }
+  }
+  return _pending_change;
+#else
+  return true;
+#endif
+}
+
 }  // namespace model_management
 }  // namespace reinforcement_learning
@@ -9,22 +9,68 @@ namespace reinforcement_learning
 {
 namespace model_management
 {
+/*
+Loads the model from a file whenever the file changes.
+
+With use_mmap the file is mapped (copy-on-write) instead of read, and the
+mapping is shared by every copy of the model_data handed out, so the model is
+never copied. The model keeps the mapping for as long as it is loaded, and
+pages it did not write still show the file: models must then be updated by
+writing a new file and renaming it over the old one. Rewriting the file in
+place is not supported, the loaded model sees the new bytes and truncating
+the file makes reads of the mapping raise SIGBUS. A file that is rewritten
+in place while still mapped is detected by its inode, traced, and read
+rather than mapped again.
+
+On Linux, changes are detected with inotify on the directory of the file,
+so an unchanged file costs a single non-blocking read per refresh. Elsewhere,
+or if inotify is not available, the size and modification time are polled.
+A file modified in the second it was loaded is read again on the next
+refresh, since a second write in that second can leave both unchanged.
+*/
 class file_model_loader : public i_data_transport
 {
 public:
-  file_model_loader(std::string file_name, bool file_must_exist, i_trace* trace_logger);
+  file_model_loader(std::string file_name, bool file_must_exist, i_trace* trace_logger, bool use_mmap = false,
+      bool use_inotify = true);
+  ~file_model_loader() override;
+
+  file_model_loader(const file_model_loader&) = delete;
+  file_model_loader& operator=(const file_model_loader&) = delete;
+
   int init(api_status* status = nullptr);
   int get_data(model_data& data, api_status* status = nullptr) override;
 
 private:
   int get_file_modified_time(time_t& file_time, api_status* status) const;
+  int read_file(model_data& data, size_t file_size, api_status* status) const;
+  int map_file(model_data& data, size_t file_size, api_status* status);
+  void start_watching();
+  void stop_watching();
+  bool has_pending_change();
 
 private:
   std::string _file_name;
   bool _file_must_exist;
   i_trace* _trace;
+  const bool _use_mmap;
+  const bool _use_inotify;
   time_t _last_modified = 0;
   size_t _datasz{};
+  // Time of the last load, taken before the file was read
+  time_t _loaded_at = 0;
+  // Content hash of the last load, only computed when the file was modified in the second it was loaded
+  uint64_t _content_hash = 0;
+
+  // The last mapping handed out and the file it maps
+  std::weak_ptr<char> _mapping;
+  uint64_t _mapped_device = 0;
+  uint64_t _mapped_inode = 0;
+
+  // inotify descriptor, -1 when polling
+  int _watch_fd = -1;
+  std::string _watched_name;
+  bool _pending_change = true;
 };
 
 }  // namespace model_management
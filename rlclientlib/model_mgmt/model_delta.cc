@@ -0,0 +1,177 @@
+#include "model_delta.h"
+
+#include "api_status.h"
+#include "err_constants.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace reinforcement_learning
+{
+namespace model_management
+{
+namespace
+{
+const size_t ENTRY_SIZE = sizeof(uint64_t) + sizeof(float);
+
+class delta_reader
+{
+public:
+  delta_reader(const char* data, size_t len) : _data(data), _remaining(len) {}
+
+  template <typename T>
+  bool read(T& value)
+  {
+    if (_remaining < sizeof(T)) { return false; }
+    std::memcpy(&value, _data, sizeof(T));
+    skip(sizeof(T));
+    return true;
+  }
+
+  bool read(std::string& value)
+  {
+    uint32_t length = 0;
+    if (!read(length) || _remaining < length) { return false; }
+    value.assign(_data, length);
+    skip(length);
+    return true;
+  }
+
+  const char* position() const { return _data; }
+  size_t remaining() const { return _remaining; }
+
+private:
+  void skip(size_t len)
+  {
+    _data += len;
+    _remaining -= len;
+  }
+
+  const char* _data;
+  size_t _remaining;
+};
+
+template <typename T>
+char* write(char* target, const T& value)
+{
+  std::memcpy(target, &value, sizeof(T));
+  return target + sizeof(T);
+}
+
+char* write(char* target, const std::string& value)
+{
+  target = write(target, static_cast<uint32_t>(value.size()));
+  std::memcpy(target, value.data(), value.size());
+  return target + value.size();
+}
+
+bool index_less(const model_delta::entry& left, const model_delta::entry& right) { return left.first < right.first; }
+}  // namespace
+
+const uint32_t model_delta::MAGIC;
+
+bool model_delta::is_delta(const model_data& data)
+{
+  uint32_t magic = 0;
+  if (data.data() == nullptr || data.data_sz() < sizeof(magic)) { return false; }
+  std::memcpy(&magic, data.data(), sizeof(magic));
+  return magic == MAGIC;
+}
+
+int model_delta::parse(const char* data, size_t len, api_status* status)
+{
+  delta_reader reader(data, len);
+
+  uint32_t magic = 0;
+  uint64_t count = 0;
+  if (!reader.read(magic) || magic != MAGIC)
+  {
+    RETURN_ERROR_LS(nullptr, status, model_update_error) << "Model delta does not start with the expected magic.";
+  }
+  if (!reader.read(_base_id) || !reader.read(_model_id) || !reader.read(count) ||
+      count != reader.remaining() / ENTRY_SIZE || reader.remaining() % ENTRY_SIZE != 0)
+  {
+    RETURN_ERROR_LS(nullptr, status, model_update_error) << "Model delta is truncated or malformed.";
+  }
+
+  _weights.resize(static_cast<size_t>(count));
+  const char* position = reader.position();
+  for (auto& weight : _weights)
+  {
+    std::memcpy(&weight.first, position, sizeof(uint64_t));
+    std::memcpy(&weight.second, position + sizeof(uint64_t), sizeof(float));
+    position += ENTRY_SIZE;
+  }
+
+  // keep the last entry for each index
+  std::stable_sort(_weights.begin(), _weights.end(), index_less);
+  auto last = _weights.begin();
+  for (auto it = _weights.begin(); it != _weights.end(); ++it)
+  {
+    if (last->first == it->first) { *last = *it; }
+    else { *(++last) = *it; }
+  }
+  if (!_weights.empty()) { _weights.erase(last + 1, _weights.end()); }
+
+  return error_code::success;
+}
+
+void model_delta::serialize(model_data& data) const
+{
+  const size_t size = sizeof(MAGIC) + 2 * sizeof(uint32_t) + _base_id.size() + _model_id.size() + sizeof(uint64_t) +
+      _weights.size() * ENTRY_SIZE;
+
+  char* target = data.alloc(size);
+  target = write(target, MAGIC);
+  target = write(target, _base_id);
+  target = write(target, _model_id);
+  target = write(target, static_cast<uint64_t>(_weights.size()));
+  for (const auto& weight : _weights)
+  {
+    target = write(target, weight.first);
+    target = write(target, weight.second);
+  }
+}
+
+void model_delta::set_ids(std::string base_id, std::string model_id)
+{
+  _base_id = std::move(base_id);
+  _model_id = std::move(model_id);
+}
+
+void model_delta::set_weight(uint64_t index, float weight)
+{
+  const entry value(index, weight);
+  const auto it = std::lower_bound(_weights.begin(), _weights.end(), value, index_less);
+  if (it != _weights.end() && it->first == index) { it->second = weight; }
+  else { _weights.insert(it, value); }
+}
+
+void model_delta::merge(const model_delta& newer)
+{
+  std::vector<entry> merged;
+  merged.reserve(_weights.size() + newer._weights.size());
+
+  auto older_it = _weights.cbegin();
+  auto newer_it = newer._weights.cbegin();
+  while (older_it != _weights.cend() && newer_it != newer._weights.cend())
+  {
+    if (older_it->first < newer_it->first) { merged.push_back(*older_it++); }
+    else
+    {
+      if (older_it->first == newer_it->first) { ++older_it; }
+      merged.push_back(*newer_it++);
+    }
+  }
+  merged.insert(merged.end(), older_it, _weights.cend());
+  merged.insert(merged.end(), newer_it, newer._weights.cend());
+
+  _weights.swap(merged);
+  _model_id = newer._model_id;
+}
+
+const std::string& model_delta::base_id() const { return _base_id; }
+const std::string& model_delta::model_id() const { return _model_id; }
+const std::vector<model_delta::entry>& model_delta::weights() const { return _weights; }
+}  // namespace model_management
+}  // namespace reinforcement_learning
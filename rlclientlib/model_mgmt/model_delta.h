@@ -0,0 +1,67 @@
+#pragma once
+#include "model_mgmt.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace reinforcement_learning
+{
+class api_status;
+}
+
+namespace reinforcement_learning
+{
+namespace model_management
+{
+/*
+Sparse update of the weights of a model, published instead of the full model
+when only a few weights changed. A delta names the model it applies to and
+the model it produces, the latter becomes the model version reported for
+decisions.
+
+A delta only saves transferring the model. vw_model still parses the full
+base model it kept for every object it builds, then applies the delta, so
+applying a delta costs as much as loading the full model.
+
+All integers are little-endian:
+
+<DELTA>  := <MAGIC:uint32> <BASE-ID-LENGTH:uint32> <BASE-ID> <MODEL-ID-LENGTH:uint32> <MODEL-ID> <COUNT:uint64> <ENTRY>*
+<ENTRY>  := <INDEX:uint64> <WEIGHT:float>
+
+INDEX is the position in the weight array of the model, as produced by
+hashing (i.e. already multiplied by the stride). A later entry for the same
+index overrides an earlier one.
+*/
+class model_delta
+{
+public:
+  using entry = std::pair<uint64_t, float>;
+
+  static const uint32_t MAGIC = 0x31444C52;  // "RLD1"
+
+  static bool is_delta(const model_data& data);
+
+  int parse(const char* data, size_t len, api_status* status = nullptr);
+  void serialize(model_data& data) const;
+
+  void set_ids(std::string base_id, std::string model_id);
+  void set_weight(uint64_t index, float weight);
+
+  // Applies newer on top of this delta: weights of newer win, the model id is taken from newer
+  void merge(const model_delta& newer);
+
+  const std::string& base_id() const;
+  const std::string& model_id() const;
+  // sorted by index, unique
+  const std::vector<entry>& weights() const;
+
+private:
+  std::string _base_id;
+  std::string _model_id;
+  std::vector<entry> _weights;
+};
+}  // namespace model_management
+}  // namespace reinforcement_learning
@@ -1,6 +1,11 @@
 #include "model_downloader.h"
 
 #include "api_status.h"
+#include "str_util.h"
+#include "trace_logger.h"
+#include "utility/metrics_registry.h"
+
+#include <chrono>
 
 namespace reinforcement_learning
 {
@@ -37,10 +42,40 @@ model_downloader& model_downloader::operator=(model_downloader&& temp) noexcept
 
 int model_downloader::run_iteration(api_status* status) const
 {
+  using clock = std::chrono::steady_clock;
+  const auto elapsed = [](clock::time_point start)
+  { return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start); };
+
+  auto start = clock::now();
   model_data md;
   RETURN_IF_FAIL(_ptrans->get_data(md, status));
+  const auto fetch = elapsed(start);
+
+  const bool is_new_model = md.refresh_count() > 0 && md.data_sz() > 0;
+  std::chrono::nanoseconds verify{0};
+  if (is_new_model)
+  {
+    start = clock::now();
+    RETURN_IF_FAIL(_ptrans->verify_data(md, status));
+    verify = elapsed(start);
+  }
 
+  start = clock::now();
   const auto scode = _pdata_cb->report_data(md, _trace, status);
+  const auto load = elapsed(start);
+
+  // Refreshes that found no new model are not recorded, they would hide the cost of the updates
+  if (is_new_model && scode == error_code::success)
+  {
+    utility::metrics_registry::record(api_stage::model_fetch, fetch.count());
+    utility::metrics_registry::record(api_stage::model_verify, verify.count());
+    utility::metrics_registry::record(api_stage::model_load, load.count());
+    using std::chrono::microseconds;
+    TRACE_INFO(_trace,
+        utility::concat("New model data processed. Fetch: ", std::chrono::duration_cast<microseconds>(fetch).count(),
+            "us, verify: ", std::chrono::duration_cast<microseconds>(verify).count(),
+            "us, load: ", std::chrono::duration_cast<microseconds>(load).count(), "us"));
+  }
   return scode;
 }
 }  // namespace model_management
@@ -9,6 +9,14 @@ namespace reinforcement_learning
 {
 namespace model_management
 {
+/*
+Refreshes the model in stages: the data is fetched from the transport into a
+staging buffer, verified by the transport (e.g. against a checksum) and only
+then handed to the data callback, which parses, warms up and publishes it.
+Data that fails verification never reaches the callback. The duration of
+each stage of a refresh that brings a new model is recorded in the metrics
+(model_fetch, model_verify and model_load).
+*/
 class model_downloader
 {
 public:
@@ -1,29 +1,58 @@
 #include "model_mgmt.h"
 
+#include <algorithm>
+
 namespace reinforcement_learning
 {
 namespace model_management
 {
 
-char* model_data::data() { return _data.data(); }
-const char* model_data::data() const { return _data.data(); }
+char* model_data::data() { return _shared_data ? _shared_data.get() : _data.data(); }
+const char* model_data::data() const { return _shared_data ? _shared_data.get() : _data.data(); }
 
 void model_data::increment_refresh_count() { ++_refresh_count; }
 
-size_t model_data::data_sz() const { return _data.size(); }
+size_t model_data::data_sz() const { return _shared_data ? _shared_data_sz : _data.size(); }
 
 uint32_t model_data::refresh_count() const { return _refresh_count; }
 
-void model_data::data_sz(const size_t fillsz) { _data.resize(fillsz); }
+void model_data::data_sz(const size_t fillsz)
+{
+  if (_shared_data)
+  {
+    // Shared memory can not grow, take a copy
+    _data.assign(_shared_data.get(), _shared_data.get() + std::min(fillsz, _shared_data_sz));
+    _shared_data.reset();
+    _shared_data_sz = 0;
+  }
+  _data.resize(fillsz);
+}
 
 char* model_data::alloc(const size_t desired)
 {
+  _shared_data.reset();
+  _shared_data_sz = 0;
   _data.clear();
   _data.resize(desired);
   return _data.data();
 }
 
-void model_data::free() { _data.clear(); }
+void model_data::free()
+{
+  _shared_data.reset();
+  _shared_data_sz = 0;
+  _data.clear();
+}
+
+void model_data::set_shared_data(std::shared_ptr<char> data, size_t len)
+{
+  // Release the owned copy, that is the point of sharing
+  std::vector<char>().swap(_data);
+  _shared_data = std::move(data);
+  _shared_data_sz = _shared_data ? len : 0;
+}
+
+bool model_data::is_shared() const { return _shared_data != nullptr; }
 
 int model_data::set_data(const char* vw_model, size_t len)
 {
@@ -4,6 +4,7 @@
 #include "factory_resolver.h"
 #include "trace_logger.h"
 #include "utility/header_authorization.h"
+#include "utility/http_helper.h"
 
 #include <cpprest/asyncrt_utils.h>
 #include <cpprest/http_client.h>
@@ -155,6 +156,9 @@ int restapi_data_transport::get_data(model_data& ret, api_status* status)
                       _httpcli->get_url());
                 }
 
+                const auto md5 = response.headers().find(U("Content-MD5"));
+                _content_md5 = md5 == response.headers().end() ? ::utility::string_t() : md5->second;
+
                 curr_datasz = response.headers().content_length();
                 if (curr_datasz > 0)
                 {
@@ -193,5 +197,10 @@ int restapi_data_transport::get_data(model_data& ret, api_status* status)
 
   return request_task.get();
 }
+
+int restapi_data_transport::verify_data(const model_data& data, api_status* status)
+{
+  return utility::check_content_md5(data.data(), data.data_sz(), _content_md5, _trace, status);
+}
 }  // namespace model_management
 }  // namespace reinforcement_learning
@@ -22,6 +22,7 @@ public:
       std::unique_ptr<i_http_client>&& httpcli, utility::configuration cfg, model_source model_source, i_trace* trace);
 
   int get_data(model_data& ret, api_status* status) override;
+  int verify_data(const model_data& data, api_status* status) override;
 
 private:
   using time_t = std::chrono::time_point<std::chrono::system_clock>;
@@ -30,6 +31,8 @@ private:
   std::unique_ptr<i_http_client> _httpcli;
   ::utility::datetime _last_modified;
   uint64_t _datasz;
+  // Content-MD5 of the last download, empty if not sent
+  ::utility::string_t _content_md5;
   i_trace* _trace;
   const utility::configuration _cfg;
   model_source _model_source = model_source::AZURE;
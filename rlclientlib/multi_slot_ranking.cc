@@ -0,0 +1,51 @@
+#include "multi_slot_ranking.h"
+
+#include <cassert>
+
+namespace reinforcement_learning
+{
+multi_slot_ranking::multi_slot_ranking() { clear(); }
+
+void multi_slot_ranking::clear()
+{
+  _offsets.assign(1, 0);
+  _action_ids.clear();
+  _probabilities.clear();
+}
+
+void multi_slot_ranking::reserve(size_t slot_count, size_t entry_count)
+{
+  _offsets.reserve(slot_count + 1);
+  _action_ids.reserve(entry_count);
+  _probabilities.reserve(entry_count);
+}
+
+void multi_slot_ranking::add_slot() { _offsets.push_back(_action_ids.size()); }
+
+void multi_slot_ranking::push_back(uint32_t action_id, float probability)
+{
+  assert(slot_count() > 0);
+  _action_ids.push_back(action_id);
+  _probabilities.push_back(probability);
+  _offsets.back() = _action_ids.size();
+}
+
+size_t multi_slot_ranking::slot_count() const { return _offsets.size() - 1; }
+
+size_t multi_slot_ranking::slot_size(size_t slot) const { return _offsets[slot + 1] - _offsets[slot]; }
+
+size_t multi_slot_ranking::size() const { return _action_ids.size(); }
+
+const uint32_t* multi_slot_ranking::slot_action_ids(size_t slot) const { return _action_ids.data() + _offsets[slot]; }
+
+const float* multi_slot_ranking::slot_probabilities(size_t slot) const
+{
+  return _probabilities.data() + _offsets[slot];
+}
+
+const std::vector<size_t>& multi_slot_ranking::offsets() const { return _offsets; }
+
+const std::vector<uint32_t>& multi_slot_ranking::action_ids() const { return _action_ids; }
+
+const std::vector<float>& multi_slot_ranking::probabilities() const { return _probabilities; }
+}  // namespace reinforcement_learning
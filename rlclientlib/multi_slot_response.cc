@@ -36,23 +36,32 @@ const char* multi_slot_response::get_model_id() const { return _model_id.c_str()
 
 void multi_slot_response::clear()
 {
-  _decision.clear();
+  // The entries are kept so that the next request reuses their ids
+  _size = 0;
   _model_id.clear();
   _event_id.clear();
 }
 
 void multi_slot_response::push_back(const std::string& id, uint32_t action_id, float prob)
 {
-  _decision.emplace_back(id, action_id, prob);
+  if (_size < _decision.size())
+  {
+    auto& entry = _decision[_size];
+    entry._id = id;
+    entry._action_id = action_id;
+    entry._probability = prob;
+  }
+  else { _decision.emplace_back(id, action_id, prob); }
+  ++_size;
 }
 
-size_t multi_slot_response::size() const { return _decision.size(); }
+size_t multi_slot_response::size() const { return _size; }
 
 multi_slot_response::const_iterator_t multi_slot_response::begin() const { return {_decision}; }
 
 multi_slot_response::iterator_t multi_slot_response::begin() { return {_decision}; }
 
-multi_slot_response::const_iterator_t multi_slot_response::end() const { return {_decision, _decision.size()}; }
+multi_slot_response::const_iterator_t multi_slot_response::end() const { return {_decision, _size}; }
 
-multi_slot_response::iterator_t multi_slot_response::end() { return {_decision, _decision.size()}; }
+multi_slot_response::iterator_t multi_slot_response::end() { return {_decision, _size}; }
 }  // namespace reinforcement_learning
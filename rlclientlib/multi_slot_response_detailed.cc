@@ -22,11 +22,22 @@ const char* multi_slot_response_detailed::get_model_id() const { return _model_i
 
 int multi_slot_response_detailed::set_slot_at_index(const unsigned int index, slot_ranking&& slot, api_status* status)
 {
-  if (index >= _decision.size())
+  if (index >= _size)
   {
     RETURN_ERROR_ARG(nullptr, status, slot_index_out_of_bounds_error, "Slot index out of bounds");
   }
-  _decision[index] = std::move(slot);
+  // Copied into the slot rather than moved over it, so that the slot keeps its buffers for the next request
+  slot_ranking& target = _decision[index];
+  target.clear();
+  target.set_id(slot.get_id());
+  target.reserve(slot.size());
+  for (const auto& action : slot) { target.push_back(action.action_id, action.probability); }
+
+  size_t chosen_action_id = 0;
+  if (slot.get_chosen_action_id(chosen_action_id) == error_code::success)
+  {
+    target.set_chosen_action_id_unchecked(chosen_action_id);
+  }
   return error_code::success;
 }
 
@@ -34,21 +45,24 @@ void multi_slot_response_detailed::clear()
 {
   _model_id.clear();
   _event_id.clear();
-  _decision.clear();
+  resize(0);
 }
 
-size_t multi_slot_response_detailed::size() const { return _decision.size(); }
+size_t multi_slot_response_detailed::size() const { return _size; }
 
 multi_slot_response_detailed::const_iterator_t multi_slot_response_detailed::begin() const { return {_decision}; }
 
 multi_slot_response_detailed::iterator_t multi_slot_response_detailed::begin() { return {_decision}; }
 
-multi_slot_response_detailed::const_iterator_t multi_slot_response_detailed::end() const
-{
-  return {_decision, _decision.size()};
-}
+multi_slot_response_detailed::const_iterator_t multi_slot_response_detailed::end() const { return {_decision, _size}; }
 
-multi_slot_response_detailed::iterator_t multi_slot_response_detailed::end() { return {_decision, _decision.size()}; }
+multi_slot_response_detailed::iterator_t multi_slot_response_detailed::end() { return {_decision, _size}; }
 
-void multi_slot_response_detailed::resize(size_t new_size) { _decision.resize(new_size); }
+void multi_slot_response_detailed::resize(size_t new_size)
+{
+  // Slots going out of use are cleared rather than destroyed, so that growing again reuses their memory
+  for (size_t i = new_size; i < _size; ++i) { _decision[i].clear(); }
+  if (new_size > _decision.size()) { _decision.resize(new_size); }
+  _size = new_size;
+}
 }  // namespace reinforcement_learning
@@ -94,13 +94,11 @@ decision_ranking_event decision_ranking_event::request_decision(const std::vecto
 }
 
 multi_slot_decision_event::multi_slot_decision_event(const std::string& event_id, bool deferred_action, float pass_prob,
-    string_view context, std::vector<std::vector<uint32_t>> action_ids, std::vector<std::vector<float>> pdfs,
-    std::string model_version, const timestamp& ts)
+    string_view context, const multi_slot_ranking& ranking, std::string model_version, const timestamp& ts)
     : event(event_id.c_str(), ts, pass_prob)
     , _event_id(event_id)
     , _deferred_action(deferred_action)
-    , _action_ids_vector(std::move(action_ids))
-    , _probilities_vector(std::move(pdfs))
+    , _ranking(ranking)
     , _model_id(std::move(model_version))
 {
   string context_str(context);
@@ -108,24 +106,17 @@ multi_slot_decision_event::multi_slot_decision_event(const std::string& event_id
 }
 
 const std::vector<unsigned char>& multi_slot_decision_event::get_context() const { return _context; }
-const std::vector<std::vector<uint32_t>>& multi_slot_decision_event::get_actions_ids() const
-{
-  return _action_ids_vector;
-}
-const std::vector<std::vector<float>>& multi_slot_decision_event::get_probabilities() const
-{
-  return _probilities_vector;
-}
+const multi_slot_ranking& multi_slot_decision_event::get_ranking() const { return _ranking; }
 const std::string& multi_slot_decision_event::get_model_id() const { return _model_id; }
 bool multi_slot_decision_event::get_defered_action() const { return _deferred_action; }
 const std::string& multi_slot_decision_event::get_event_id() const { return _event_id; }
 
 multi_slot_decision_event multi_slot_decision_event::request_decision(const std::string& event_id, string_view context,
-    unsigned int flags, const std::vector<std::vector<uint32_t>>& action_ids,
-    const std::vector<std::vector<float>>& pdfs, const std::string& model_version, const timestamp& ts, float pass_prob)
+    unsigned int flags, const multi_slot_ranking& ranking, const std::string& model_version, const timestamp& ts,
+    float pass_prob)
 {
   return multi_slot_decision_event(
-      event_id, (flags & action_flags::DEFERRED) != 0u, pass_prob, context, action_ids, pdfs, model_version, ts);
+      event_id, (flags & action_flags::DEFERRED) != 0u, pass_prob, context, ranking, model_version, ts);
 }
 
 outcome_event::outcome_event(
@@ -1,6 +1,7 @@
 #pragma once
 #include "decision_response.h"
 #include "learning_mode.h"
+#include "multi_slot_ranking.h"
 #include "multi_slot_response.h"
 #include "ranking_response.h"
 #include "rl_string_view.h"
@@ -131,26 +132,22 @@ public:
   multi_slot_decision_event& operator=(multi_slot_decision_event&& other) = default;
 
   const std::vector<unsigned char>& get_context() const;
-  const std::vector<std::vector<uint32_t>>& get_actions_ids() const;
-  const std::vector<std::vector<float>>& get_probabilities() const;
+  const multi_slot_ranking& get_ranking() const;
   const std::string& get_model_id() const;
   bool get_defered_action() const;
   const std::string& get_event_id() const;
 
 public:
   static multi_slot_decision_event request_decision(const std::string& event_id, string_view context,
-      unsigned int flags, const std::vector<std::vector<uint32_t>>& action_ids,
-      const std::vector<std::vector<float>>& pdfs, const std::string& model_version, const timestamp& ts,
+      unsigned int flags, const multi_slot_ranking& ranking, const std::string& model_version, const timestamp& ts,
       float pass_prob = 1.f);
 
 private:
   multi_slot_decision_event(const std::string& event_id, bool deferred_action, float pass_prob, string_view context,
-      std::vector<std::vector<uint32_t>> action_ids, std::vector<std::vector<float>> pdfs, std::string model_version,
-      const timestamp& ts);
+      const multi_slot_ranking& ranking, std::string model_version, const timestamp& ts);
 
   std::vector<unsigned char> _context;
-  std::vector<std::vector<uint32_t>> _action_ids_vector;
-  std::vector<std::vector<float>> _probilities_vector;
+  multi_slot_ranking _ranking;
   std::string _event_id;
 
   std::string _model_id;
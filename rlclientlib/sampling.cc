@@ -3,43 +3,83 @@
 #include "api_status.h"
 #include "err_constants.h"
 #include "trace_logger.h"
+#include "utility/metrics_registry.h"
 #include "vw/explore/explore.h"
+#include "vw_model/ranking_kernels.h"
 
 #include <iostream>
+#include <vector>
 
 namespace e = exploration;
 namespace reinforcement_learning
 {
+namespace
+{
+// exploration::sample_after_normalizing, with its loops run by ranking kernels: the same draw, choice and normalized
+// pdf, bit for bit. Its two loops sum the pdf in the same order, so the running sums of the first one are kept as a
+// cdf and searched rather than computed again.
+int sample_after_normalizing(uint64_t rnd_seed, std::vector<float>& pdf, uint32_t& chosen_index)
+{
+  if (pdf.empty()) { return E_EXPLORATION_BAD_RANGE; }
+
+  const auto isa = ranking_kernels::supported_isa();
+  // reused by the requests of each thread
+  thread_local std::vector<float> cdf;
+  cdf.resize(pdf.size());
+
+  const float total = ranking_kernels::build_cdf(isa, pdf.data(), pdf.size(), cdf.data());
+  if (total == 0)
+  {
+    // the first action is assumed to be the best, and always drawn
+    pdf[0] = 1;
+    chosen_index = 0;
+    return S_EXPLORATION_OK;
+  }
+
+  float draw = total * VW::details::merand48_noadvance(rnd_seed);
+  // make sure we don't go out of bounds
+  if (draw > total) { draw = total; }
+
+  const size_t found = ranking_kernels::search_cdf(isa, cdf.data(), pdf.size(), draw);
+  chosen_index = static_cast<uint32_t>(found < pdf.size() ? found : pdf.size() - 1);
+  ranking_kernels::normalize_pdf(isa, pdf.data(), pdf.size(), total);
+  return S_EXPLORATION_OK;
+}
+}  // namespace
+
 int populate_response(size_t chosen_action_index, std::vector<int>& action_ids, std::vector<float>& pdf,
-    std::string&& model_id, ranking_response& response, i_trace* trace_logger, api_status* status)
+    const std::string& model_id, ranking_response& response, i_trace* trace_logger, api_status* status)
 {
+  response.reserve(pdf.size());
   for (size_t idx = 0; idx < pdf.size(); ++idx) { response.push_back(action_ids[idx], pdf[idx]); }
 
   RETURN_IF_FAIL(response.set_chosen_action_id(action_ids[chosen_action_index]));
-  response.set_model_id(std::move(model_id));
+  response.set_model_id(model_id.c_str());
   return error_code::success;
 }
 
-int populate_response(float action, float pdf_value, std::string&& event_id, std::string&& model_id,
+int populate_response(float action, float pdf_value, const char* event_id, const std::string& model_id,
     continuous_action_response& response, i_trace* trace_logger, api_status* status)
 {
+  utility::stage_timer timer(api_stage::sampling);
   response.set_chosen_action(action);
   response.set_chosen_action_pdf_value(pdf_value);
-  response.set_event_id(std::move(event_id));
-  response.set_model_id(std::move(model_id));
+  response.set_event_id(event_id);
+  response.set_model_id(model_id.c_str());
   return error_code::success;
 }
 
 int populate_response(const std::vector<std::vector<uint32_t>>& action_ids, const std::vector<std::vector<float>>& pdfs,
-    const std::vector<const char*>& event_ids, std::string&& model_id, decision_response& response,
+    const std::vector<const char*>& event_ids, const std::string& model_id, decision_response& response,
     i_trace* trace_logger, api_status* status)
 {
+  utility::stage_timer timer(api_stage::sampling);
   if (action_ids.size() != pdfs.size())
   {
     RETURN_ERROR_LS(trace_logger, status, invalid_argument) << "action_ids and pdfs must be the same size";
   }
 
-  response.set_model_id(std::move(model_id));
+  response.set_model_id(model_id.c_str());
   for (size_t i = 0; i < action_ids.size(); i++)
   {
     if (action_ids[i].size() != pdfs[i].size())
@@ -53,86 +93,83 @@ int populate_response(const std::vector<std::vector<uint32_t>>& action_ids, cons
   return error_code::success;
 }
 
-int populate_slot(const std::vector<uint32_t>& action_ids, const std::vector<float>& pdf, slot_ranking& response,
+int populate_slot(const uint32_t* action_ids, const float* pdf, size_t count, slot_ranking& response,
     const std::string& slot_id, i_trace* trace_logger, api_status* status)
 {
-  for (size_t idx = 0; idx < pdf.size(); ++idx) { response.push_back(action_ids[idx], pdf[idx]); }
+  response.reserve(count);
+  for (size_t idx = 0; idx < count; ++idx) { response.push_back(action_ids[idx], pdf[idx]); }
   response.set_id(slot_id.c_str());
   RETURN_IF_FAIL(response.set_chosen_action_id(action_ids[reinforcement_learning::default_chosen_action_index]));
   return error_code::success;
 }
 
-int populate_multi_slot_response(const std::vector<std::vector<uint32_t>>& action_ids,
-    const std::vector<std::vector<float>>& pdfs, std::string&& event_id, std::string&& model_id,
+int populate_multi_slot_response(const multi_slot_ranking& ranking, const char* event_id, const std::string& model_id,
     const std::vector<std::string>& slot_ids, multi_slot_response& response, i_trace* trace_logger, api_status* status)
 {
-  if (action_ids.size() != pdfs.size())
-  {
-    RETURN_ERROR_LS(trace_logger, status, invalid_argument) << "action_ids and pdfs must be the same size";
-  }
-
-  if (action_ids.size() != slot_ids.size())
+  utility::stage_timer timer(api_stage::sampling);
+  if (ranking.slot_count() != slot_ids.size())
   {
-    RETURN_ERROR_LS(trace_logger, status, invalid_argument) << "action_ids and slot_ids must be the same size";
+    RETURN_ERROR_LS(trace_logger, status, invalid_argument) << "ranking and slot_ids must be the same size";
   }
 
-  response.set_event_id(std::move(event_id));
-  response.set_model_id(std::move(model_id));
+  response.set_event_id(event_id);
+  response.set_model_id(model_id.c_str());
 
-  for (size_t i = 0; i < action_ids.size(); i++)
+  for (size_t i = 0; i < ranking.slot_count(); i++)
   {
-    if (action_ids[i].size() != pdfs[i].size())
+    if (ranking.slot_size(i) == 0)
     {
-      RETURN_ERROR_LS(trace_logger, status, invalid_argument) << "action_ids[i] and pdfs[i] must be the same size";
+      RETURN_ERROR_LS(trace_logger, status, invalid_argument) << "the slots of ranking must be non empty";
     }
 
-    response.push_back(slot_ids[i], action_ids[i][0], pdfs[i][0]);
+    response.push_back(slot_ids[i], ranking.slot_action_ids(i)[0], ranking.slot_probabilities(i)[0]);
   }
 
   return error_code::success;
 }
 
-int populate_multi_slot_response_detailed(const std::vector<std::vector<uint32_t>>& action_ids,
-    const std::vector<std::vector<float>>& pdfs, std::string&& event_id, std::string&& model_id,
-    const std::vector<std::string>& slot_ids, multi_slot_response_detailed& response, i_trace* trace_logger,
-    api_status* status)
+int populate_multi_slot_response_detailed(const multi_slot_ranking& ranking, const char* event_id,
+    const std::string& model_id, const std::vector<std::string>& slot_ids, multi_slot_response_detailed& response,
+    i_trace* trace_logger, api_status* status)
 {
-  if (!(action_ids.size() == pdfs.size() && pdfs.size() == response.size() && response.size() == slot_ids.size()))
+  utility::stage_timer timer(api_stage::sampling);
+  if (!(ranking.slot_count() == response.size() && response.size() == slot_ids.size()))
   {
     RETURN_ERROR_LS(trace_logger, status, invalid_argument)
-        << "action_ids, pdfs, slot_ids, and number of slots must be the same size";
+        << "ranking, slot_ids, and number of slots must be the same size";
   }
 
-  response.set_event_id(std::move(event_id));
-  response.set_model_id(std::move(model_id));
+  response.set_event_id(event_id);
+  response.set_model_id(model_id.c_str());
 
   auto r = response.begin();
-  for (size_t i = 0; i < action_ids.size() && r != response.end(); i++, ++r)
+  for (size_t i = 0; i < ranking.slot_count() && r != response.end(); i++, ++r)
   {
-    if (action_ids[i].size() != pdfs[i].size() || action_ids[i].empty())
+    if (ranking.slot_size(i) == 0)
     {
-      RETURN_ERROR_LS(trace_logger, status, invalid_argument)
-          << "action_ids[i] and pdfs[i] must be the same size and non empty";
+      RETURN_ERROR_LS(trace_logger, status, invalid_argument) << "the slots of ranking must be non empty";
     }
-    populate_slot(action_ids[i], pdfs[i], *r, slot_ids[i], trace_logger, status);
+    populate_slot(ranking.slot_action_ids(i), ranking.slot_probabilities(i), ranking.slot_size(i), *r, slot_ids[i],
+        trace_logger, status);
   }
 
   return error_code::success;
 }
 
 int sample_and_populate_response(uint64_t rnd_seed, std::vector<int>& action_ids, std::vector<float>& pdf,
-    std::string&& model_id, ranking_response& response, i_trace* trace_logger, api_status* status)
+    const std::string& model_id, ranking_response& response, i_trace* trace_logger, api_status* status)
 {
+  utility::stage_timer timer(api_stage::sampling);
   try
   {
     // Pick a slot using the pdf. NOTE: sample_after_normalizing() can change the pdf
     uint32_t chosen_index = 0;
-    auto scode = e::sample_after_normalizing(rnd_seed, std::begin(pdf), std::end(pdf), chosen_index);
+    auto scode = sample_after_normalizing(rnd_seed, pdf, chosen_index);
 
     if (S_EXPLORATION_OK != scode) { RETURN_ERROR_LS(trace_logger, status, exploration_error) << scode; }
 
     RETURN_IF_FAIL(
-        populate_response(chosen_index, action_ids, pdf, std::move(model_id), response, trace_logger, status));
+        populate_response(chosen_index, action_ids, pdf, model_id, response, trace_logger, status));
 
     // Swap values in first position with values in chosen index
     scode = e::swap_chosen(std::begin(response), std::end(response), chosen_index);
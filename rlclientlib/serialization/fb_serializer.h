@@ -89,9 +89,9 @@ struct fb_event_serializer<decision_ranking_event>
   static size_t size_estimate(const decision_ranking_event& evt)
   {
     size_t estimate = 0;
-    auto action_ids = evt.get_actions_ids();
-    auto probs = evt.get_probabilities();
-    auto evt_ids = evt.get_event_ids();
+    const auto& action_ids = evt.get_actions_ids();
+    const auto& probs = evt.get_probabilities();
+    const auto& evt_ids = evt.get_event_ids();
 
     for (size_t i = 0; i < evt_ids.size(); i++)
     {
@@ -111,10 +111,11 @@ struct fb_event_serializer<decision_ranking_event>
     const auto context_offset = builder.CreateVector(evt.get_context());
     const auto model_id_offset = builder.CreateString(evt.get_model_id());
 
-    auto action_ids = evt.get_actions_ids();
-    const auto probabilities = evt.get_probabilities();
-    const auto decision_slot_ids = evt.get_event_ids();
+    const auto& action_ids = evt.get_actions_ids();
+    const auto& probabilities = evt.get_probabilities();
+    const auto& decision_slot_ids = evt.get_event_ids();
     std::vector<flatbuffers::Offset<SlotEvent>> slots;
+    slots.reserve(decision_slot_ids.size());
     for (size_t i = 0; i < decision_slot_ids.size(); i++)
     {
       slots.push_back(CreateSlotEvent(builder, builder.CreateString(decision_slot_ids[i]),
@@ -141,16 +142,8 @@ struct fb_event_serializer<multi_slot_decision_event>
 
   static size_t size_estimate(const multi_slot_decision_event& evt)
   {
-    size_t estimate = 0;
-    auto action_ids = evt.get_actions_ids();
-    auto probs = evt.get_probabilities();
-
-    for (size_t i = 0; i < action_ids.size(); i++)
-    {
-      estimate += action_ids[i].size() * sizeof(action_ids[0][0]);
-      estimate += probs[i].size() * sizeof(probs[0][0]);
-    }
-
+    const auto& ranking = evt.get_ranking();
+    size_t estimate = ranking.size() * (sizeof(uint32_t) + sizeof(float));
     estimate += evt.get_context().size() + evt.get_model_id().size() + sizeof(evt.get_defered_action()) +
         sizeof(evt.get_pass_prob());
     estimate += evt.get_event_id().size();
@@ -165,13 +158,14 @@ struct fb_event_serializer<multi_slot_decision_event>
     const auto context_offset = builder.CreateVector(evt.get_context());
     const auto model_id_offset = builder.CreateString(evt.get_model_id());
 
-    auto action_ids = evt.get_actions_ids();
-    const auto probabilities = evt.get_probabilities();
+    const auto& ranking = evt.get_ranking();
     std::vector<flatbuffers::Offset<SlatesSlotEvent>> slots;
-    for (size_t i = 0; i < action_ids.size(); i++)
+    slots.reserve(ranking.slot_count());
+    for (size_t i = 0; i < ranking.slot_count(); i++)
     {
-      slots.push_back(
-          CreateSlatesSlotEvent(builder, builder.CreateVector(action_ids[i]), builder.CreateVector(probabilities[i])));
+      const auto size = ranking.slot_size(i);
+      slots.push_back(CreateSlatesSlotEvent(builder, builder.CreateVector(ranking.slot_action_ids(i), size),
+          builder.CreateVector(ranking.slot_probabilities(i), size)));
     }
     const auto slots_offset = builder.CreateVector(slots);
 
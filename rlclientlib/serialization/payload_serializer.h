@@ -41,15 +41,16 @@ struct cb_serializer : payload_serializer<generic_event::payload_type_t::Payload
 {
   static generic_event::payload_buffer_t event(const std::string& context_str, unsigned int flags,
       v2::LearningModeType learning_mode, const std::vector<uint64_t>& action_ids,
-      const std::vector<float>& probabilities, const std::string& model_id)
+      const std::vector<float>& probabilities, const std::string& model_id,
+      v2::ContextFormat context_format = v2::ContextFormat_Json, const std::vector<uint64_t>& shortlist = {})
   {
     flatbuffers::FlatBufferBuilder fbb;
 
     std::vector<unsigned char> _context;
     copy(context_str.begin(), context_str.end(), std::back_inserter(_context));
 
-    auto fb = v2::CreateCbEventDirect(
-        fbb, flags & action_flags::DEFERRED, &action_ids, &_context, &probabilities, model_id.c_str(), learning_mode);
+    auto fb = v2::CreateCbEventDirect(fbb, flags & action_flags::DEFERRED, &action_ids, &_context, &probabilities,
+        model_id.c_str(), learning_mode, context_format, shortlist.empty() ? nullptr : &shortlist);
     fbb.Finish(fb);
     return fbb.Release();
   }
@@ -58,15 +59,16 @@ struct cb_serializer : payload_serializer<generic_event::payload_type_t::Payload
 struct ca_serializer : payload_serializer<generic_event::payload_type_t::PayloadType_CA>
 {
   static generic_event::payload_buffer_t event(const std::string& context_str, unsigned int flags, float chosen_action,
-      float chosen_action_pdf_value, const std::string& model_id)
+      float chosen_action_pdf_value, const std::string& model_id,
+      v2::ContextFormat context_format = v2::ContextFormat_Json)
   {
     flatbuffers::FlatBufferBuilder fbb;
 
     std::vector<unsigned char> _context;
     copy(context_str.begin(), context_str.end(), std::back_inserter(_context));
 
-    auto fb = v2::CreateCaEventDirect(
-        fbb, flags & action_flags::DEFERRED, chosen_action, &_context, chosen_action_pdf_value, model_id.c_str());
+    auto fb = v2::CreateCaEventDirect(fbb, flags & action_flags::DEFERRED, chosen_action, &_context,
+        chosen_action_pdf_value, model_id.c_str(), v2::LearningModeType_Online, context_format);
     fbb.Finish(fb);
     return fbb.Release();
   }
@@ -75,19 +77,22 @@ struct ca_serializer : payload_serializer<generic_event::payload_type_t::Payload
 struct multi_slot_serializer : payload_serializer<generic_event::payload_type_t::PayloadType_Slates>
 {
   static generic_event::payload_buffer_t event(const std::string& context_str, unsigned int flags,
-      const std::vector<std::vector<uint32_t>>& action_ids, const std::vector<std::vector<float>>& pdfs,
-      const std::string& model_version, const std::vector<std::string>& slot_ids,
+      const multi_slot_ranking& ranking, const std::string& model_version, const std::vector<std::string>& slot_ids,
       const std::vector<int>& baseline_actions, v2::LearningModeType learning_mode)
   {
     flatbuffers::FlatBufferBuilder fbb;
     std::vector<flatbuffers::Offset<v2::SlotEvent>> slots;
+    slots.reserve(ranking.slot_count());
 
     std::vector<unsigned char> _context;
     copy(context_str.begin(), context_str.end(), std::back_inserter(_context));
 
-    for (size_t i = 0; i < action_ids.size(); i++)
+    for (size_t i = 0; i < ranking.slot_count(); i++)
     {
-      slots.push_back(v2::CreateSlotEventDirect(fbb, &action_ids[i], &pdfs[i], slot_ids[i].c_str()));
+      const auto size = ranking.slot_size(i);
+      const auto action_ids_offset = fbb.CreateVector(ranking.slot_action_ids(i), size);
+      const auto pdf_offset = fbb.CreateVector(ranking.slot_probabilities(i), size);
+      slots.push_back(v2::CreateSlotEvent(fbb, action_ids_offset, pdf_offset, fbb.CreateString(slot_ids[i])));
     }
     auto fb = v2::CreateMultiSlotEventDirect(fbb, &_context, &slots, model_version.c_str(),
         flags & action_flags::DEFERRED, &baseline_actions, learning_mode);
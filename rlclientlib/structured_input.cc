@@ -0,0 +1,105 @@
+#include "structured_input.h"
+
+#include "api_status.h"
+#include "err_constants.h"
+
+#include <cstring>
+#include <limits>
+
+namespace reinforcement_learning
+{
+namespace
+{
+const size_t TENSOR_HEADER_SIZE = 2 * sizeof(uint32_t);
+
+void write_u32(char* target, uint32_t value) { std::memcpy(target, &value, sizeof(value)); }
+}  // namespace
+
+const uint32_t structured_input::MAGIC;
+const size_t structured_input::ALIGNMENT;
+
+structured_input::structured_input() { clear(); }
+
+int structured_input::add_tensor(
+    const char* name, const int64_t* dimensions, size_t rank, const float* values, api_status* status)
+{
+  if (name == nullptr) { RETURN_ERROR_LS(nullptr, status, invalid_argument) << "Tensor name is null."; }
+
+  const size_t name_length = std::strlen(name);
+  if (name_length > std::numeric_limits<uint32_t>::max() || rank > std::numeric_limits<uint32_t>::max())
+  {
+    RETURN_ERROR_LS(nullptr, status, invalid_argument) << "Tensor name or rank is too large.";
+  }
+
+  size_t value_count = rank == 0 ? 0 : 1;
+  for (size_t d = 0; d < rank; d++)
+  {
+    if (dimensions[d] < 0 ||
+        (dimensions[d] > 0 &&
+            value_count > std::numeric_limits<size_t>::max() / sizeof(float) / static_cast<size_t>(dimensions[d])))
+    {
+      RETURN_ERROR_LS(nullptr, status, invalid_argument)
+          << "Invalid dimension " << dimensions[d] << " for tensor '" << name << "'.";
+    }
+    value_count *= static_cast<size_t>(dimensions[d]);
+  }
+
+  if (value_count > 0 && values == nullptr)
+  {
+    RETURN_ERROR_LS(nullptr, status, invalid_argument) << "Values of tensor '" << name << "' are null.";
+  }
+
+  const size_t name_size = padded_size(name_length + 1);
+  const size_t dimensions_size = rank * sizeof(int64_t);
+  const size_t values_size = padded_size(value_count * sizeof(float));
+
+  size_t offset = _size;
+  grow(TENSOR_HEADER_SIZE + name_size + dimensions_size + values_size);
+
+  write_u32(bytes() + offset, static_cast<uint32_t>(name_length));
+  write_u32(bytes() + offset + sizeof(uint32_t), static_cast<uint32_t>(rank));
+  offset += TENSOR_HEADER_SIZE;
+
+  std::memcpy(bytes() + offset, name, name_length);
+  offset += name_size;
+
+  if (dimensions_size > 0) { std::memcpy(bytes() + offset, dimensions, dimensions_size); }
+  offset += dimensions_size;
+
+  if (value_count > 0) { std::memcpy(bytes() + offset, values, value_count * sizeof(float)); }
+
+  write_u32(bytes() + sizeof(uint32_t), ++_tensor_count);
+  return error_code::success;
+}
+
+int structured_input::add_tensor(
+    const std::string& name, const std::vector<int64_t>& dimensions, const float* values, api_status* status)
+{
+  return add_tensor(name.c_str(), dimensions.data(), dimensions.size(), values, status);
+}
+
+void structured_input::clear()
+{
+  _buffer.clear();
+  _size = 0;
+  _tensor_count = 0;
+  grow(TENSOR_HEADER_SIZE);
+  write_u32(bytes(), MAGIC);
+  write_u32(bytes() + sizeof(uint32_t), 0);
+}
+
+size_t structured_input::tensor_count() const { return _tensor_count; }
+
+const char* structured_input::data() const { return reinterpret_cast<const char*>(_buffer.data()); }
+
+size_t structured_input::size() const { return _size; }
+
+char* structured_input::bytes() { return reinterpret_cast<char*>(_buffer.data()); }
+
+// sizes are always multiples of 8, new space is zero filled
+void structured_input::grow(size_t size)
+{
+  _size += size;
+  _buffer.resize(_size / sizeof(uint64_t), 0);
+}
+}  // namespace reinforcement_learning
@@ -1,6 +1,7 @@
 #include "trace_logger.h"
 
 #include <algorithm>
+#include <cstdio>
 
 const char* reinforcement_learning::details::get_log_level_string(int log_level)
 {
@@ -59,4 +60,38 @@ int reinforcement_learning::details::get_log_level_from_string(
       RETURN_ERROR_ARG(nullptr, status, invalid_argument, "Provided log level is an invalid string.");
     }
   }
-}
\ No newline at end of file
+}
+
+void reinforcement_learning::trace_field::format(std::string& out) const
+{
+  out.push_back(' ');
+  out.append(name);
+  out.push_back('=');
+  switch (type)
+  {
+    case type_t::int64:
+      out.append(std::to_string(int_value));
+      break;
+    case type_t::uint64:
+      out.append(std::to_string(uint_value));
+      break;
+    case type_t::float64:
+    {
+      char buffer[32];
+      const int length = std::snprintf(buffer, sizeof(buffer), "%.9g", float_value);
+      if (length > 0) { out.append(buffer, (std::min)(static_cast<size_t>(length), sizeof(buffer) - 1)); }
+      break;
+    }
+    case type_t::string:
+      out.append(string_value);
+      break;
+  }
+}
+
+void reinforcement_learning::i_trace::log_event(
+    int log_level, const char* event, std::initializer_list<trace_field> fields)
+{
+  std::string msg(event);
+  for (const auto& field : fields) { field.format(msg); }
+  log(log_level, msg);
+}
@@ -88,6 +88,7 @@ struct MessageHandler : public rj::BaseReaderHandler<rj::UTF8<>, MessageHandler>
   int _array_level = 0;
   bool _is_multi = false;
   bool _is_slots = false;
+  bool _is_slot_id = false;
   size_t _item_start = 0;
 
   MessageHandler(rj::InsituStringStream& is, ContextInfo& info) : _is(is), _info(info) {}
@@ -99,11 +100,27 @@ struct MessageHandler : public rj::BaseReaderHandler<rj::UTF8<>, MessageHandler>
       _is_multi = (strcmp(str, multi) == 0);
       _is_slots = (strcmp(str, slots) == 0);
     }
+    _is_slot_id = _is_slots && _level == 2 && _array_level == 1 && strcmp(str, slot_id) == 0;
+    return true;
+  }
+
+  bool String(const char* str, rj::SizeType length, bool copy)
+  {
+    if (_is_slot_id) { _info.slot_ids.emplace(_info.slots.size(), std::string(str, length)); }
+    _is_slot_id = false;
+    return true;
+  }
+
+  // any other value
+  bool Default()
+  {
+    _is_slot_id = false;
     return true;
   }
 
   bool StartObject()
   {
+    _is_slot_id = false;
     if (((static_cast<int>(_is_multi) | static_cast<int>(_is_slots)) != 0) && _level == 1 && _array_level == 1)
     {
       _item_start = _is.Tell() - 1;
@@ -128,6 +145,7 @@ struct MessageHandler : public rj::BaseReaderHandler<rj::UTF8<>, MessageHandler>
 
   bool StartArray()
   {
+    _is_slot_id = false;
     ++_array_level;
     return true;
   }
@@ -144,6 +162,7 @@ int get_context_info(string_view context, ContextInfo& info, i_trace* trace, api
   std::string copy(context);
   info.actions.clear();
   info.slots.clear();
+  info.slot_ids.clear();
 
   rj::InsituStringStream iss((char*)copy.c_str());
   MessageHandler mh(iss, info);
@@ -3,6 +3,7 @@
 #include "rl_string_view.h"
 
 #include <map>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -11,7 +12,8 @@ namespace reinforcement_learning
 class i_trace;
 namespace utility
 {
-//! This struct collects all sort of relevant data we need about a context json.
+//! This struct collects all sort of relevant data we need about a context json. It is filled by a single pass over
+//! the context and then shared by everything handling the request, so that the context is not parsed again.
 struct ContextInfo
 {
   //! Each pair is the start offset and length of a JSON object. IE, the range covers '{' to '}'
@@ -21,6 +23,8 @@ struct ContextInfo
   index_vector_t actions;
   //! The index to each element in the _slots array
   index_vector_t slots;
+  //! The _id of the elements of the _slots array that have one, by index
+  std::map<size_t, std::string> slot_ids;
 };
 
 int get_event_ids(string_view context, std::map<size_t, std::string>& event_ids, i_trace* trace, api_status* status);
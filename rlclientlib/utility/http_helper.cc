@@ -1,8 +1,14 @@
 #include "http_helper.h"
 
+#include "api_status.h"
 #include "constants.h"
+#include "err_constants.h"
+#include "trace_logger.h"
+
+#include <openssl/evp.h>
 
 #include <chrono>
+#include <vector>
 
 namespace reinforcement_learning
 {
@@ -20,5 +26,26 @@ web::http::client::http_client_config get_http_config(const utility::configurati
   config.set_timeout(std::chrono::seconds(timeout));
   return config;
 }
+
+int check_content_md5(
+    const char* data, size_t len, const ::utility::string_t& content_md5, i_trace* trace, api_status* status)
+{
+  if (content_md5.empty()) { return error_code::success; }
+
+  std::vector<unsigned char> digest(EVP_MAX_MD_SIZE);
+  unsigned int digest_size = 0;
+  if (EVP_Digest(data, len, digest.data(), &digest_size, EVP_md5(), nullptr) != 1)
+  {
+    RETURN_ERROR_LS(trace, status, model_checksum_mismatch) << "Failed to compute the MD5 of the model";
+  }
+  digest.resize(digest_size);
+
+  if (::utility::conversions::to_base64(digest) != content_md5)
+  {
+    RETURN_ERROR_LS(trace, status, model_checksum_mismatch)
+        << "Content-MD5 = " + ::utility::conversions::to_utf8string(content_md5);
+  }
+  return error_code::success;
+}
 }  // namespace utility
 }  // namespace reinforcement_learning
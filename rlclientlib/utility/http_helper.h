@@ -3,11 +3,19 @@
 
 #include <cpprest/http_client.h>
 
+#include <cstddef>
+
 namespace reinforcement_learning
 {
+class api_status;
+class i_trace;
 namespace utility
 {
 web::http::client::http_client_config get_http_config(const utility::configuration& cfg);
 
+// Compares the MD5 of data with the base64 encoded value of a Content-MD5 header. An empty header matches anything.
+int check_content_md5(
+    const char* data, size_t len, const ::utility::string_t& content_md5, i_trace* trace, api_status* status);
+
 }
 }  // namespace reinforcement_learning
\ No newline at end of file
@@ -0,0 +1,185 @@
+#include "metrics_registry.h"
+
+#ifndef RL_DISABLE_METRICS
+
+#  include <algorithm>
+#  include <atomic>
+#  include <memory>
+#  include <mutex>
+#  include <vector>
+
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#  endif
+
+namespace reinforcement_learning
+{
+namespace utility
+{
+namespace
+{
+// Values below 2^SUB_BUCKET_BITS have a bucket each. Above, every power of two is split into 2^SUB_BUCKET_BITS linear
+// buckets, so that a bucket is at most 1/8 of its values wide. 38 powers of two reach past 4 minutes in nanoseconds,
+// larger values go to the last bucket.
+const int SUB_BUCKET_BITS = 3;
+const size_t SUB_BUCKETS = size_t{1} << SUB_BUCKET_BITS;
+const size_t BUCKET_COUNT = 38 * SUB_BUCKETS;
+const size_t STAGE_COUNT = static_cast<size_t>(api_stage::count);
+const size_t COUNTER_COUNT = static_cast<size_t>(api_counter::count);
+
+int most_significant_bit(uint64_t value)
+{
+#  if defined(_MSC_VER)
+  unsigned long index = 0;
+  _BitScanReverse64(&index, value);
+  return static_cast<int>(index);
+#  else
+  return 63 - __builtin_clzll(value);
+#  endif
+}
+
+size_t bucket_index(uint64_t value)
+{
+  if (value < SUB_BUCKETS) { return static_cast<size_t>(value); }
+  const int msb = most_significant_bit(value);
+  const int shift = msb - SUB_BUCKET_BITS;
+  const size_t index = static_cast<size_t>(shift + 1) * SUB_BUCKETS + ((value >> shift) & (SUB_BUCKETS - 1));
+  return (std::min)(index, BUCKET_COUNT - 1);
+}
+
+uint64_t bucket_upper_bound(size_t index)
+{
+  if (index < SUB_BUCKETS) { return index; }
+  const int shift = static_cast<int>(index / SUB_BUCKETS) - 1;
+  const uint64_t lower = static_cast<uint64_t>(SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+  return lower + (uint64_t{1} << shift) - 1;
+}
+
+// Only its thread writes to a shard, so a relaxed load and store is enough and cheaper than an atomic increment
+void add(std::atomic<uint64_t>& target, uint64_t value)
+{
+  target.store(target.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+struct shard
+{
+  std::atomic<uint64_t> buckets[STAGE_COUNT][BUCKET_COUNT];
+  std::atomic<uint64_t> sums[STAGE_COUNT];
+  std::atomic<uint64_t> counters[COUNTER_COUNT];
+  bool in_use = true;
+
+  shard()
+  {
+    for (auto& stage : buckets)
+    {
+      for (auto& bucket : stage) { bucket.store(0, std::memory_order_relaxed); }
+    }
+    for (auto& sum : sums) { sum.store(0, std::memory_order_relaxed); }
+    for (auto& counter : counters) { counter.store(0, std::memory_order_relaxed); }
+  }
+};
+
+class shard_list
+{
+public:
+  shard* acquire()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& s : _shards)
+    {
+      if (!s->in_use)
+      {
+        s->in_use = true;
+        return s.get();
+      }
+    }
+    _shards.emplace_back(new shard());
+    return _shards.back().get();
+  }
+
+  void release(shard* s)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    s->in_use = false;
+  }
+
+  void snapshot(metrics_snapshot& snapshot)
+  {
+    std::vector<uint64_t> buckets(BUCKET_COUNT);
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (size_t stage = 0; stage < STAGE_COUNT; ++stage)
+    {
+      std::fill(buckets.begin(), buckets.end(), 0);
+      auto& histogram = snapshot.get(static_cast<api_stage>(stage));
+      histogram = latency_histogram();
+      for (const auto& s : _shards)
+      {
+        const auto& shard_buckets = s->buckets[stage];
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) { buckets[i] += shard_buckets[i].load(std::memory_order_relaxed); }
+        histogram.sum += s->sums[stage].load(std::memory_order_relaxed);
+      }
+      for (size_t i = 0; i < BUCKET_COUNT; ++i)
+      {
+        if (buckets[i] == 0) { continue; }
+        histogram.buckets.emplace_back(bucket_upper_bound(i), buckets[i]);
+        histogram.count += buckets[i];
+      }
+    }
+
+    for (size_t counter = 0; counter < COUNTER_COUNT; ++counter)
+    {
+      auto& value = snapshot.get(static_cast<api_counter>(counter));
+      value = 0;
+      for (const auto& s : _shards) { value += s->counters[counter].load(std::memory_order_relaxed); }
+    }
+  }
+
+private:
+  std::mutex _mutex;
+  std::vector<std::unique_ptr<shard>> _shards;
+};
+
+// Never destroyed, threads that outlive static destruction still return their shard
+shard_list& shards()
+{
+  static auto* list = new shard_list();
+  return *list;
+}
+
+// Acquires the shard of the thread on first use and releases it when the thread exits
+class thread_shard
+{
+public:
+  thread_shard() : _shard(shards().acquire()) {}
+  ~thread_shard() { shards().release(_shard); }
+  shard& get() { return *_shard; }
+
+private:
+  shard* _shard;
+};
+
+shard& current_shard()
+{
+  thread_local thread_shard instance;
+  return instance.get();
+}
+}  // namespace
+
+void metrics_registry::record(api_stage stage, uint64_t nanoseconds)
+{
+  auto& s = current_shard();
+  const auto index = static_cast<size_t>(stage);
+  add(s.buckets[index][bucket_index(nanoseconds)], 1);
+  add(s.sums[index], nanoseconds);
+}
+
+void metrics_registry::increment(api_counter counter, uint64_t value)
+{
+  add(current_shard().counters[static_cast<size_t>(counter)], value);
+}
+
+void metrics_registry::snapshot(metrics_snapshot& snapshot) { shards().snapshot(snapshot); }
+}  // namespace utility
+}  // namespace reinforcement_learning
+
+#endif
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "metrics_snapshot.h"
+
+#include <chrono>
+#include <cstdint>
+
+namespace reinforcement_learning
+{
+namespace utility
+{
+/*
+Process wide registry of the latency histograms and counters of metrics_snapshot.
+
+Every thread records into its own shard of atomics with plain loads and
+stores, so recording takes no lock and never contends. snapshot() sums the
+shards. The shard of an exited thread is kept, with its values, and handed
+to the next new thread.
+
+Building with RL_DISABLE_METRICS turns every function into an empty inline
+one and stage_timer into an empty object.
+*/
+class metrics_registry
+{
+public:
+  static void record(api_stage stage, uint64_t nanoseconds);
+  static void increment(api_counter counter, uint64_t value = 1);
+  static void snapshot(metrics_snapshot& snapshot);
+
+  // Tick count of a monotonic clock, for the values passed to record_since()
+  static uint64_t now();
+  static void record_since(api_stage stage, uint64_t start) { record(stage, now() - start); }
+};
+
+// Records the time between its construction and its destruction
+class stage_timer
+{
+public:
+  explicit stage_timer(api_stage stage);
+  ~stage_timer();
+
+  stage_timer(const stage_timer&) = delete;
+  stage_timer& operator=(const stage_timer&) = delete;
+
+private:
+#ifndef RL_DISABLE_METRICS
+  api_stage _stage;
+  uint64_t _start;
+#endif
+};
+
+#ifdef RL_DISABLE_METRICS
+inline void metrics_registry::record(api_stage, uint64_t) {}
+inline void metrics_registry::increment(api_counter, uint64_t) {}
+inline void metrics_registry::snapshot(metrics_snapshot&) {}
+inline uint64_t metrics_registry::now() { return 0; }
+inline stage_timer::stage_timer(api_stage) {}
+inline stage_timer::~stage_timer() {}
+#else
+inline uint64_t metrics_registry::now()
+{
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+inline stage_timer::stage_timer(api_stage stage) : _stage(stage), _start(metrics_registry::now()) {}
+inline stage_timer::~stage_timer() { metrics_registry::record_since(_stage, _start); }
+#endif
+}  // namespace utility
+}  // namespace reinforcement_learning
@@ -1,4 +1,5 @@
 #pragma once
+#include "metrics_registry.h"
 #include "str_util.h"
 #include "trace_logger.h"
 
@@ -16,6 +17,7 @@ template <typename TObject>
 class versioned_object_pool_unsafe
 {
   using TFactory = std::function<TObject*(void)>;
+  using TWarmUp = std::function<void(TObject&)>;
 
   int _version;
   TFactory _factory;
@@ -24,12 +26,17 @@ class versioned_object_pool_unsafe
 
 public:
   // Construct object pool given a factory function that allocates new objects when called
-  // Optionally, pre-populate the pool with a given count of objects
-  versioned_object_pool_unsafe(TFactory factory, int objects_count = 0, int version = 0)
+  // Optionally, pre-populate the pool with a given count of objects, passing each of them to warm_up
+  versioned_object_pool_unsafe(
+      TFactory factory, int objects_count = 0, int version = 0, const TWarmUp& warm_up = nullptr)
       : _version(version), _factory(std::move(factory)), _objects_count(objects_count)
   {
     _pool.reserve(_objects_count);
-    for (int i = 0; i < _objects_count; ++i) { _pool.emplace_back(_factory()); }
+    for (int i = 0; i < _objects_count; ++i)
+    {
+      _pool.emplace_back(_factory());
+      if (warm_up) { warm_up(*_pool.back()); }
+    }
   }
 
   ~versioned_object_pool_unsafe() = default;
@@ -78,8 +85,11 @@ class versioned_object_pool
 {
   using TFactory = std::function<TObject*(void)>;
   using TObjectDeleter = std::function<void(TObject*)>;
+  using TWarmUp = std::function<void(TObject&)>;
   using impl_type = versioned_object_pool_unsafe<TObject>;
   std::mutex _mutex;
+  // serializes update_factory(), which builds the new pool without holding _mutex
+  std::mutex _update_mutex;
   std::unique_ptr<impl_type> _impl;
   i_trace* _trace_logger = nullptr;
 
@@ -105,6 +115,8 @@ public:
   // The object is returned to pool when its std::unique_ptr is destroyed
   std::unique_ptr<TObject, TObjectDeleter> get_or_create()
   {
+    // Wait for the lock and creation of an object included
+    stage_timer timer(api_stage::pool_checkout);
     std::lock_guard<std::mutex> lock(_mutex);
     // in the deleter function, capture a copy of the version at time of object creation
     int current_version = _impl->version();
@@ -138,25 +150,41 @@ public:
   }
 
   // Update the pool's factory function and increment version number
-  void update_factory(TFactory new_factory)
+  // The objects of the new pool are created, and passed to warm_up if given, before the new pool replaces the current
+  // one, so requests are neither blocked meanwhile nor served by cold objects afterwards. With warm_up at least one
+  // object is created. Exceptions thrown by the factory or by warm_up leave the current pool in place.
+  void update_factory(TFactory new_factory, const TWarmUp& warm_up = nullptr)
   {
+    std::lock_guard<std::mutex> update_lock(_update_mutex);
+
     int objects_count = 0;
     int new_version = 0;
-
-    std::lock_guard<std::mutex> lock(_mutex);
-    objects_count = _impl->size();
-    new_version = _impl->version() + 1;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      objects_count = _impl->size();
+      new_version = _impl->version() + 1;
+    }
 
     TRACE_DEBUG(
         _trace_logger, utility::concat("versioned_object_pool::update_factory() called: pool size is ", objects_count));
 
-    std::unique_ptr<impl_type> new_impl(new impl_type(std::move(new_factory), objects_count, new_version));
+    if (warm_up && objects_count == 0) { objects_count = 1; }
+    std::unique_ptr<impl_type> new_impl(new impl_type(std::move(new_factory), objects_count, new_version, warm_up));
+
+    std::lock_guard<std::mutex> lock(_mutex);
     _impl.swap(new_impl);
   }
 
   // Get a reference to the internal factory std::function
   const TFactory& get_factory_function() const { return _impl->get_factory_function(); }
 
+  // Incremented by every update_factory()
+  int version()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _impl->version();
+  }
+
 private:
   void return_to_pool(TObject* obj, int obj_version)
   {
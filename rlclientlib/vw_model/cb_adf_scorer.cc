@@ -0,0 +1,234 @@
+#include "cb_adf_scorer.h"
+
+#include "vw/config/options.h"
+#include "vw/core/example.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace reinforcement_learning
+{
+namespace
+{
+// Same values as in VW
+const uint64_t FNV_PRIME = 16777619;
+const unsigned char CONSTANT_NAMESPACE = 128;
+const unsigned char WILDCARD_NAMESPACE = ':';
+
+// Options that make a --cb_explore_adf model predict other than by a linear score and epsilon-greedy exploration
+const char* const UNSUPPORTED_OPTIONS[] = {"ccb_explore_adf", "slates", "softmax", "bag", "cover", "squarecb", "regcb",
+    "regcbopt", "rnd", "synthcover", "first", "large_action_space", "graph_feedback", "epsilon_decay", "ignore_linear",
+    "permutations", "experimental_full_name_interactions", "lrq", "lrqfa", "stage_poly", "nn", "boosting", "baseline",
+    "automl", "marginal", "explore_eval", "audit"};
+
+// The JSON parser labels the shared example of a multi-line example like this
+bool is_shared(const VW::example& ex)
+{
+  const auto& costs = ex.l.cb.costs;
+  return costs.size() == 1 && costs[0].probability == -1.f;
+}
+
+// Features of one namespace of the action followed by those of the shared example, as VW merges them
+class merged_features
+{
+public:
+  merged_features(const VW::features* first, const VW::features* second)
+      : _first(first), _second(second), _first_size(first == nullptr ? 0 : first->size())
+  {
+  }
+
+  size_t size() const { return _first_size + (_second == nullptr ? 0 : _second->size()); }
+  uint64_t index(size_t i) const { return i < _first_size ? _first->indices[i] : _second->indices[i - _first_size]; }
+  float value(size_t i) const { return i < _first_size ? _first->values[i] : _second->values[i - _first_size]; }
+
+private:
+  const VW::features* _first;
+  const VW::features* _second;
+  size_t _first_size;
+};
+}  // namespace
+
+std::unique_ptr<cb_adf_scorer> cb_adf_scorer::create(VW::workspace& vw)
+{
+  auto& options = *vw.options;
+  if (!options.was_supplied("cb_explore_adf") || vw.weights.sparse || vw.output_config.audit) { return nullptr; }
+  for (const auto* option : UNSUPPORTED_OPTIONS)
+  {
+    if (options.was_supplied(option)) { return nullptr; }
+  }
+
+  try
+  {
+    const float epsilon = options.get_typed_option<float>("epsilon").value();
+    const bool first_only = options.was_supplied("first_only");
+    return std::unique_ptr<cb_adf_scorer>(new cb_adf_scorer(vw, epsilon, first_only));
+  }
+  catch (const std::exception&)
+  {
+    return nullptr;
+  }
+}
+
+cb_adf_scorer::cb_adf_scorer(VW::workspace& vw, float epsilon, bool first_only)
+    : _mask(vw.weights.mask())
+    , _stride_shift(vw.weights.stride_shift())
+    , _epsilon(epsilon)
+    , _first_only(first_only)
+    , _isa(ranking_kernels::supported_isa())
+{
+  // Only the first slot of each stride is used for prediction, the others hold learning state
+  _weights.resize(static_cast<size_t>(_mask >> _stride_shift) + 1);
+  for (size_t i = 0; i < _weights.size(); ++i) { _weights[i] = vw.weights.dense_weights[i << _stride_shift]; }
+}
+
+bool cb_adf_scorer::predict(const VW::multi_ex& examples, std::vector<int>& actions, std::vector<float>& pdf)
+{
+  if (examples.empty()) { return false; }
+
+  const VW::example* shared = is_shared(*examples[0]) ? examples[0] : nullptr;
+  const size_t first_action = shared == nullptr ? 0 : 1;
+  const size_t action_count = examples.size() - first_action;
+  if (action_count == 0) { return false; }
+
+  const auto* interactions = examples[first_action]->interactions;
+  if (interactions != nullptr)
+  {
+    for (const auto& term : *interactions)
+    {
+      // wildcards are expanded by a reduction at prediction time
+      if (std::find(term.begin(), term.end(), WILDCARD_NAMESPACE) != term.end()) { return false; }
+    }
+  }
+
+  _scores.resize(action_count);
+  for (size_t i = 0; i < action_count; ++i) { _scores[i] = score(shared, *examples[first_action + i]); }
+  _ranking_keys.resize(action_count);
+  ranking_kernels::make_keys(_isa, _scores.data(), action_count, _ranking_keys.data());
+
+  // lowest cost first, ties broken by action like VW does
+  std::sort(_ranking_keys.begin(), _ranking_keys.end());
+
+  const size_t tied = _first_only ? 1 : ranking_kernels::count_best(_isa, _ranking_keys.data(), action_count);
+
+  actions.resize(action_count);
+  ranking_kernels::unpack_actions(_isa, _ranking_keys.data(), action_count, actions.data());
+  pdf.resize(action_count);
+  ranking_kernels::epsilon_greedy_pdf(_isa, _epsilon, tied, action_count, pdf.data());
+  return true;
+}
+
+bool cb_adf_scorer::predict(const VW::multi_ex& examples, size_t shortlist_size, std::vector<int>& shortlist,
+    std::vector<int>& actions, std::vector<float>& pdf)
+{
+  shortlist.clear();
+  if (examples.empty()) { return false; }
+
+  const VW::example* shared = is_shared(*examples[0]) ? examples[0] : nullptr;
+  const size_t first_action = shared == nullptr ? 0 : 1;
+  const size_t action_count = examples.size() - first_action;
+  if (shortlist_size == 0 || action_count <= shortlist_size) { return predict(examples, actions, pdf); }
+
+  // The linear terms of the shared features add the same to every action, so only the action features tell them apart
+  _scores.resize(action_count);
+  for (size_t i = 0; i < action_count; ++i) { _scores[i] = linear_score(*examples[first_action + i]); }
+  _ranking_keys.resize(action_count);
+  ranking_kernels::make_keys(_isa, _scores.data(), action_count, _ranking_keys.data());
+  ranking_kernels::smallest_keys(_isa, _ranking_keys.data(), action_count, shortlist_size);
+
+  shortlist.resize(shortlist_size);
+  ranking_kernels::unpack_actions(_isa, _ranking_keys.data(), shortlist_size, shortlist.data());
+  std::sort(shortlist.begin(), shortlist.end());
+
+  _shortlisted_examples.clear();
+  if (shared != nullptr) { _shortlisted_examples.push_back(examples[0]); }
+  for (const auto action : shortlist) { _shortlisted_examples.push_back(examples[first_action + action]); }
+
+  if (!predict(_shortlisted_examples, actions, pdf))
+  {
+    shortlist.clear();
+    return false;
+  }
+  for (auto& action : actions) { action = shortlist[action]; }
+  return true;
+}
+
+float cb_adf_scorer::score(const VW::example* shared, const VW::example& action)
+{
+  const uint64_t offset = action.ft_offset;
+
+  float sum = 0.f;
+  for (const auto ns : action.indices) { sum += linear(action.feature_space[ns], offset); }
+  if (shared != nullptr)
+  {
+    for (const auto ns : shared->indices)
+    {
+      if (ns != CONSTANT_NAMESPACE) { sum += linear(shared->feature_space[ns], offset); }
+    }
+  }
+
+  if (action.interactions == nullptr) { return sum; }
+  for (const auto& term : *action.interactions)
+  {
+    _interaction_features.clear();
+    for (const auto ns : term)
+    {
+      const auto* action_features = &action.feature_space[ns];
+      const auto* shared_features =
+          shared != nullptr && ns != CONSTANT_NAMESPACE ? &shared->feature_space[ns] : nullptr;
+      _interaction_features.emplace_back(action_features, shared_features);
+    }
+    sum += interaction(0, term, 0, 0, 1.f, offset);
+  }
+  return sum;
+}
+
+float cb_adf_scorer::linear_score(const VW::example& action) const
+{
+  float sum = 0.f;
+  for (const auto ns : action.indices) { sum += linear(action.feature_space[ns], action.ft_offset); }
+  return sum;
+}
+
+// Gathers with independent accumulators, so that the loop is not bound by the latency of the additions
+float cb_adf_scorer::linear(const VW::features& features, uint64_t offset) const
+{
+  const size_t size = features.size();
+  const auto& indices = features.indices;
+  const auto& values = features.values;
+
+  float sum0 = 0.f;
+  float sum1 = 0.f;
+  float sum2 = 0.f;
+  float sum3 = 0.f;
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4)
+  {
+    sum0 += values[i] * weight(indices[i] + offset);
+    sum1 += values[i + 1] * weight(indices[i + 1] + offset);
+    sum2 += values[i + 2] * weight(indices[i + 2] + offset);
+    sum3 += values[i + 3] * weight(indices[i + 3] + offset);
+  }
+  for (; i < size; ++i) { sum0 += values[i] * weight(indices[i] + offset); }
+  return (sum0 + sum1) + (sum2 + sum3);
+}
+
+// The hash of the features f0..fn of an interaction is FNV*(...(FNV*(FNV*f0 ^ f1) ^ f2)...) ^ fn. A namespace that
+// follows itself only pairs each feature with itself and the features after it.
+float cb_adf_scorer::interaction(size_t position, const std::vector<unsigned char>& namespaces, size_t start,
+    uint64_t hash, float value, uint64_t offset) const
+{
+  const merged_features features(_interaction_features[position].first, _interaction_features[position].second);
+  const bool is_last = position + 1 == namespaces.size();
+  const size_t begin = position > 0 && namespaces[position] == namespaces[position - 1] ? start : 0;
+
+  float sum = 0.f;
+  for (size_t i = begin; i < features.size(); ++i)
+  {
+    const uint64_t feature_hash = position == 0 ? features.index(i) : (FNV_PRIME * hash) ^ features.index(i);
+    const float feature_value = value * features.value(i);
+    if (is_last) { sum += feature_value * weight(feature_hash + offset); }
+    else { sum += interaction(position + 1, namespaces, i, feature_hash, feature_value, offset); }
+  }
+  return sum;
+}
+}  // namespace reinforcement_learning
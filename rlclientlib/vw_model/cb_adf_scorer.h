@@ -0,0 +1,69 @@
+#pragma once
+
+#include "ranking_kernels.h"
+#include "vw/core/vw.h"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace reinforcement_learning
+{
+/*
+Prediction-only replacement for the learner stack of linear --cb_explore_adf
+models with epsilon-greedy exploration.
+
+The features are still parsed and hashed by VW, so they are exactly the ones
+VW would score. Scoring and exploration then run on a compact copy of the
+weights, holding only the weight of each feature and none of the learning
+state, instead of going through cb_explore_adf, cb_adf, csoaa_ldf and gd.
+
+create() returns nullptr for models it can not score like VW does, e.g. with
+other exploration algorithms, sparse weights or wildcard interactions.
+*/
+class cb_adf_scorer
+{
+public:
+  static std::unique_ptr<cb_adf_scorer> create(VW::workspace& vw);
+
+  // examples as produced by the JSON parser after VW::setup_examples, the shared example first if any. Returns false
+  // if the examples use a feature the scorer does not support, VW has to predict them instead.
+  bool predict(const VW::multi_ex& examples, std::vector<int>& actions, std::vector<float>& pdf);
+  // Two-stage predict() for large action sets. The actions are first ranked by their linear terms alone, then only the
+  // best shortlist_size of them are scored in full and explored over. shortlist receives the indices of those actions
+  // in increasing order, actions holds the same indices. shortlist is left empty if every action was scored.
+  bool predict(const VW::multi_ex& examples, size_t shortlist_size, std::vector<int>& shortlist,
+      std::vector<int>& actions, std::vector<float>& pdf);
+
+  // Scores (costs, lower is better) of the actions of the last predict() of all the actions, in the order of the
+  // examples. These are the partial predictions VW computes for the action examples.
+  const std::vector<float>& scores() const { return _scores; }
+
+private:
+  cb_adf_scorer(VW::workspace& vw, float epsilon, bool first_only);
+
+  float score(const VW::example* shared, const VW::example& action);
+  float linear_score(const VW::example& action) const;
+  float linear(const VW::features& features, uint64_t offset) const;
+  float interaction(size_t position, const std::vector<unsigned char>& namespaces, size_t start, uint64_t hash,
+      float value, uint64_t offset) const;
+  float weight(uint64_t index) const { return _weights[(index & _mask) >> _stride_shift]; }
+
+  std::vector<float> _weights;
+  uint64_t _mask;
+  uint32_t _stride_shift;
+  const float _epsilon;
+  const bool _first_only;
+  const ranking_kernels::kernel_isa _isa;
+
+  // reused between calls
+  std::vector<float> _scores;
+  // score and action of each action packed by ranking_kernels::make_keys(), sorted into the ranking
+  std::vector<uint64_t> _ranking_keys;
+  // shared example, if any, followed by the shortlisted actions
+  VW::multi_ex _shortlisted_examples;
+  // features of the namespaces of the interaction being scored, action features first, then shared features
+  std::vector<std::pair<const VW::features*, const VW::features*>> _interaction_features;
+};
+}  // namespace reinforcement_learning
@@ -60,8 +60,7 @@ int pdf_model::request_decision(const std::vector<const char*>& event_ids, strin
 }
 
 int pdf_model::request_multi_slot_decision(const char* event_id, const std::vector<std::string>& slot_ids,
-    string_view features, std::vector<std::vector<uint32_t>>& actions_ids, std::vector<std::vector<float>>& action_pdfs,
-    std::string& model_version, api_status* status)
+    string_view features, multi_slot_ranking& ranking, std::string& model_version, api_status* status)
 {
   return error_code::not_supported;
 }
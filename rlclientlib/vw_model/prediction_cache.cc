@@ -0,0 +1,99 @@
+#include "prediction_cache.h"
+
+#include "vw/common/hash.h"
+
+#include <iterator>
+
+namespace reinforcement_learning
+{
+namespace model_management
+{
+prediction_cache::prediction_cache(size_t capacity, hash_fn hash)
+    : _capacity(capacity), _index(0, context_hash{hash})
+{
+}
+
+bool prediction_cache::get(int version, string_view context, std::vector<int>& action_ids,
+    std::vector<float>& action_pdf, std::string& model_version)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (update_version(version))
+  {
+    const auto it = _index.find(context);
+    if (it != _index.end())
+    {
+      _entries.splice(_entries.begin(), _entries, it->second);
+      const auto& cached = _entries.front();
+      action_ids = cached.action_ids;
+      action_pdf = cached.action_pdf;
+      model_version = cached.model_version;
+      ++_hits;
+      return true;
+    }
+  }
+  ++_misses;
+  return false;
+}
+
+void prediction_cache::put(int version, string_view context, const std::vector<int>& action_ids,
+    const std::vector<float>& action_pdf, const std::string& model_version)
+{
+  if (_capacity == 0) { return; }
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!update_version(version)) { return; }
+
+  const auto it = _index.find(context);
+  if (it != _index.end())
+  {
+    _entries.splice(_entries.begin(), _entries, it->second);
+    auto& cached = _entries.front();
+    cached.action_ids = action_ids;
+    cached.action_pdf = action_pdf;
+    cached.model_version = model_version;
+    return;
+  }
+
+  if (_entries.size() >= _capacity)
+  {
+    // reuse the least recently used entry, and its memory
+    _index.erase(string_view(_entries.back().context));
+    _entries.splice(_entries.begin(), _entries, std::prev(_entries.end()));
+  }
+  else { _entries.emplace_front(); }
+
+  auto& cached = _entries.front();
+  cached.context.assign(context.data(), context.size());
+  cached.action_ids = action_ids;
+  cached.action_pdf = action_pdf;
+  cached.model_version = model_version;
+  _index.emplace(string_view(cached.context), _entries.begin());
+}
+
+size_t prediction_cache::size() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _entries.size();
+}
+
+uint64_t prediction_cache::hits() const { return _hits; }
+uint64_t prediction_cache::misses() const { return _misses; }
+
+size_t prediction_cache::hash(string_view context)
+{
+  return static_cast<size_t>(VW::uniform_hash(context.data(), context.size(), 0));
+}
+
+bool prediction_cache::update_version(int version)
+{
+  if (version < _version) { return false; }
+  if (version > _version)
+  {
+    _entries.clear();
+    _index.clear();
+    _version = version;
+  }
+  return true;
+}
+}  // namespace model_management
+}  // namespace reinforcement_learning
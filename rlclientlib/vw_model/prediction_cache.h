@@ -0,0 +1,81 @@
+#pragma once
+
+#include "rl_string_view.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace reinforcement_learning
+{
+namespace model_management
+{
+/*
+Bounded cache of the rankings of contexts, least recently used entries are
+evicted first. Entries are keyed by the context itself, a lookup only hits
+an entry of the very same context, and belong to a version of the model
+pool: the first lookup or insertion with a newer
+version drops all entries, lookups and insertions with an older version are
+ignored.
+
+Only the ranking is cached, callers still sample from it with the seed of
+each event.
+*/
+class prediction_cache
+{
+public:
+  using hash_fn = size_t (*)(string_view context);
+
+  // The hash of the contexts only picks their bucket, it is replaced by tests to force collisions
+  explicit prediction_cache(size_t capacity, hash_fn hash = &prediction_cache::hash);
+
+  prediction_cache(const prediction_cache&) = delete;
+  prediction_cache& operator=(const prediction_cache&) = delete;
+
+  bool get(int version, string_view context, std::vector<int>& action_ids, std::vector<float>& action_pdf,
+      std::string& model_version);
+  void put(int version, string_view context, const std::vector<int>& action_ids, const std::vector<float>& action_pdf,
+      const std::string& model_version);
+
+  size_t size() const;
+  uint64_t hits() const;
+  uint64_t misses() const;
+
+  static size_t hash(string_view context);
+
+private:
+  struct entry
+  {
+    std::string context;
+    std::vector<int> action_ids;
+    std::vector<float> action_pdf;
+    std::string model_version;
+  };
+  using entry_list = std::list<entry>;
+
+  struct context_hash
+  {
+    hash_fn fn;
+    size_t operator()(string_view context) const { return fn(context); }
+  };
+
+  // Returns false for an outdated version. Must be called with _mutex held.
+  bool update_version(int version);
+
+  const size_t _capacity;
+  mutable std::mutex _mutex;
+  int _version = 0;
+  // most recently used first
+  entry_list _entries;
+  // keys are views of the context of their entry
+  std::unordered_map<string_view, entry_list::iterator, context_hash> _index;
+  std::atomic<uint64_t> _hits{0};
+  std::atomic<uint64_t> _misses{0};
+};
+}  // namespace model_management
+}  // namespace reinforcement_learning
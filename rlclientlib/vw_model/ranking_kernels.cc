@@ -0,0 +1,380 @@
+#include "ranking_kernels.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#  define RL_RANKING_X86
+#  include <immintrin.h>
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>
+#    define RL_RANKING_TARGET(isa)
+#  else
+#    define RL_RANKING_TARGET(isa) __attribute__((target(isa)))
+#  endif
+#endif
+
+namespace reinforcement_learning
+{
+namespace ranking_kernels
+{
+namespace
+{
+// The bits of a float, flipped so that they compare as unsigned integers like the floats do, above the action. -0 is
+// folded into +0 as they compare equal.
+uint64_t ranking_key(float score, uint32_t action)
+{
+  const float normalized = score + 0.f;
+  uint32_t bits = 0;
+  std::memcpy(&bits, &normalized, sizeof(bits));
+  bits ^= (bits & 0x80000000) != 0 ? 0xFFFFFFFF : 0x80000000;
+  return (static_cast<uint64_t>(bits) << 32) | action;
+}
+
+// The scalar kernels start at i, so that they also finish what the vector kernels leave
+void make_keys_scalar(const float* scores, size_t i, size_t count, uint64_t* keys)
+{
+  for (; i < count; ++i) { keys[i] = ranking_key(scores[i], static_cast<uint32_t>(i)); }
+}
+
+size_t count_best_scalar(const uint64_t* keys, size_t i, size_t count)
+{
+  const uint64_t best_score = keys[0] >> 32;
+  while (i < count && (keys[i] >> 32) == best_score) { ++i; }
+  return i;
+}
+
+void unpack_actions_scalar(const uint64_t* keys, size_t i, size_t count, int* actions)
+{
+  for (; i < count; ++i) { actions[i] = static_cast<int>(keys[i] & 0xFFFFFFFF); }
+}
+
+void fill_scalar(float* pdf, size_t i, size_t end, float value)
+{
+  for (; i < end; ++i) { pdf[i] = value; }
+}
+
+// keys[0, k) is a max-heap of the k smallest keys seen so far. A smaller key at position i takes the place of the
+// largest one, which moves to i.
+void replace_largest(uint64_t* keys, size_t k, size_t i)
+{
+  std::pop_heap(keys, keys + k);
+  std::swap(keys[k - 1], keys[i]);
+  std::push_heap(keys, keys + k);
+}
+
+void smallest_keys_scalar(uint64_t* keys, size_t i, size_t count, size_t k)
+{
+  for (; i < count; ++i)
+  {
+    if (keys[i] < keys[0]) { replace_largest(keys, k, i); }
+  }
+}
+
+float build_cdf_scalar(float* pdf, size_t i, size_t count, float* cdf, float sum)
+{
+  for (; i < count; ++i)
+  {
+    if (pdf[i] < 0) { pdf[i] = 0; }
+    sum += pdf[i];
+    cdf[i] = sum;
+  }
+  return sum;
+}
+
+size_t search_cdf_scalar(const float* cdf, size_t i, size_t count, float draw)
+{
+  while (i < count && !(draw <= cdf[i])) { ++i; }
+  return i;
+}
+
+void normalize_pdf_scalar(float* pdf, size_t i, size_t count, float total)
+{
+  for (; i < count; ++i) { pdf[i] /= total; }
+}
+
+#ifdef RL_RANKING_X86
+// Keys are built 8 at a time. The unpacks interleave actions and scores within each 128 bit lane, the keys of
+// actions 0, 1, 4 and 5 in one register and 2, 3, 6 and 7 in the other, the lane permutes put them back in order.
+RL_RANKING_TARGET("avx2")
+size_t make_keys_avx2(const float* scores, size_t count, uint64_t* keys)
+{
+  const __m256i sign_bit = _mm256_set1_epi32(static_cast<int>(0x80000000));
+  const __m256i step = _mm256_set1_epi32(8);
+  __m256i actions = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256 normalized = _mm256_add_ps(_mm256_loadu_ps(scores + i), _mm256_setzero_ps());
+    const __m256i bits = _mm256_castps_si256(normalized);
+    // all ones for negative scores, the sign bit alone otherwise
+    const __m256i flip = _mm256_or_si256(_mm256_srai_epi32(bits, 31), sign_bit);
+    const __m256i flipped = _mm256_xor_si256(bits, flip);
+
+    const __m256i low = _mm256_unpacklo_epi32(actions, flipped);
+    const __m256i high = _mm256_unpackhi_epi32(actions, flipped);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(keys + i), _mm256_permute2x128_si256(low, high, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(keys + i + 4), _mm256_permute2x128_si256(low, high, 0x31));
+    actions = _mm256_add_epi32(actions, step);
+  }
+  return i;
+}
+
+// Compares the scores of 4 keys at a time, stops at the first key with a different score
+RL_RANKING_TARGET("avx2")
+size_t count_best_avx2(const uint64_t* keys, size_t count)
+{
+  const __m256i best_score = _mm256_set1_epi64x(static_cast<long long>(keys[0] >> 32));
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m256i scores = _mm256_srli_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i)), 32);
+    int equal = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(scores, best_score)));
+    if (equal != 0xF)
+    {
+      while ((equal & 1) != 0)
+      {
+        ++i;
+        equal >>= 1;
+      }
+      return i;
+    }
+  }
+  return i;
+}
+
+// Gathers the low halves of 8 keys into one register
+RL_RANKING_TARGET("avx2")
+size_t unpack_actions_avx2(const uint64_t* keys, size_t count, int* actions)
+{
+  const __m256i low_halves_first = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256i first =
+        _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i)), low_halves_first);
+    const __m256i second = _mm256_permutevar8x32_epi32(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i + 4)), low_halves_first);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(actions + i), _mm256_permute2x128_si256(first, second, 0x20));
+  }
+  return i;
+}
+
+RL_RANKING_TARGET("avx2")
+size_t fill_avx2(float* pdf, size_t i, size_t end, float value)
+{
+  const __m256 values = _mm256_set1_ps(value);
+  for (; i + 8 <= end; i += 8) { _mm256_storeu_ps(pdf + i, values); }
+  return i;
+}
+
+// Compares 4 keys at a time with the largest of the smallest keys, only keys below it go through the heap. The sign
+// bits are flipped so that the signed comparison orders the keys as unsigned integers.
+RL_RANKING_TARGET("avx2")
+size_t smallest_keys_avx2(uint64_t* keys, size_t i, size_t count, size_t k)
+{
+  const __m256i sign_bit = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ULL));
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m256i largest = _mm256_set1_epi64x(static_cast<long long>(keys[0] ^ 0x8000000000000000ULL));
+    const __m256i block =
+        _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i)), sign_bit);
+    const int smaller = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(largest, block)));
+    if (smaller != 0) { smallest_keys_scalar(keys, i, i + 4, k); }
+  }
+  return i;
+}
+
+// The clamping is vectorized, the sums are accumulated one after the other like VW does
+RL_RANKING_TARGET("avx2")
+size_t build_cdf_avx2(float* pdf, size_t count, float* cdf, float& sum)
+{
+  const __m256 zero = _mm256_setzero_ps();
+  alignas(32) float clamped[8];
+
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256 values = _mm256_loadu_ps(pdf + i);
+    // NaN and -0 are kept, as the scalar comparison does
+    _mm256_store_ps(clamped, _mm256_blendv_ps(values, zero, _mm256_cmp_ps(values, zero, _CMP_LT_OQ)));
+    _mm256_storeu_ps(pdf + i, _mm256_load_ps(clamped));
+    for (size_t j = 0; j < 8; ++j)
+    {
+      sum += clamped[j];
+      cdf[i + j] = sum;
+    }
+  }
+  return i;
+}
+
+// Stops at the first block with an entry that draw does not exceed, the scalar loop finds it
+RL_RANKING_TARGET("avx2")
+size_t search_cdf_avx2(const float* cdf, size_t count, float draw)
+{
+  const __m256 draws = _mm256_set1_ps(draw);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    if (_mm256_movemask_ps(_mm256_cmp_ps(draws, _mm256_loadu_ps(cdf + i), _CMP_LE_OQ)) != 0) { return i; }
+  }
+  return i;
+}
+
+RL_RANKING_TARGET("avx2")
+size_t normalize_pdf_avx2(float* pdf, size_t count, float total)
+{
+  const __m256 totals = _mm256_set1_ps(total);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) { _mm256_storeu_ps(pdf + i, _mm256_div_ps(_mm256_loadu_ps(pdf + i), totals)); }
+  return i;
+}
+
+kernel_isa detect_isa()
+{
+#  if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  const int max_leaf = info[0];
+
+  __cpuid(info, 1);
+  const bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+
+  bool avx2 = false;
+  if (max_leaf >= 7 && os_saves_ymm)
+  {
+    __cpuidex(info, 7, 0);
+    avx2 = (info[1] & (1 << 5)) != 0;
+  }
+#  else
+  __builtin_cpu_init();
+  const bool avx2 = __builtin_cpu_supports("avx2") != 0;
+#  endif
+
+  return avx2 ? kernel_isa::avx2 : kernel_isa::scalar;
+}
+#else
+kernel_isa detect_isa() { return kernel_isa::scalar; }
+#endif
+
+// Requesting an instruction set the CPU does not support falls back to the best supported one
+bool use_avx2(kernel_isa isa) { return isa == kernel_isa::avx2 && supported_isa() == kernel_isa::avx2; }
+}  // namespace
+
+kernel_isa supported_isa()
+{
+  static const kernel_isa isa = detect_isa();
+  return isa;
+}
+
+void make_keys(kernel_isa isa, const float* scores, size_t count, uint64_t* keys)
+{
+  size_t i = 0;
+#ifdef RL_RANKING_X86
+  if (use_avx2(isa)) { i = make_keys_avx2(scores, count, keys); }
+#else
+  static_cast<void>(isa);
+#endif
+  make_keys_scalar(scores, i, count, keys);
+}
+
+size_t count_best(kernel_isa isa, const uint64_t* keys, size_t count)
+{
+  size_t i = 0;
+#ifdef RL_RANKING_X86
+  // stops at the first key with another score, if any, which the scalar loop checks again
+  if (use_avx2(isa)) { i = count_best_avx2(keys, count); }
+#else
+  static_cast<void>(isa);
+#endif
+  return count_best_scalar(keys, i, count);
+}
+
+void unpack_actions(kernel_isa isa, const uint64_t* keys, size_t count, int* actions)
+{
+  size_t i = 0;
+#ifdef RL_RANKING_X86
+  if (use_avx2(isa)) { i = unpack_actions_avx2(keys, count, actions); }
+#else
+  static_cast<void>(isa);
+#endif
+  unpack_actions_scalar(keys, i, count, actions);
+}
+
+void epsilon_greedy_pdf(kernel_isa isa, float epsilon, size_t tied, size_t count, float* pdf)
+{
+  const float explore_probability = epsilon / static_cast<float>(count);
+  const float best_probability = explore_probability + (1.f - epsilon) / static_cast<float>(tied);
+
+  size_t best_end = 0;
+  size_t end = tied;
+#ifdef RL_RANKING_X86
+  if (use_avx2(isa))
+  {
+    best_end = fill_avx2(pdf, 0, tied, best_probability);
+    end = fill_avx2(pdf, tied, count, explore_probability);
+  }
+#else
+  static_cast<void>(isa);
+#endif
+  fill_scalar(pdf, best_end, tied, best_probability);
+  fill_scalar(pdf, end, count, explore_probability);
+}
+void smallest_keys(kernel_isa isa, uint64_t* keys, size_t count, size_t k)
+{
+  if (k >= count)
+  {
+    std::sort(keys, keys + count);
+    return;
+  }
+  if (k == 0) { return; }
+
+  std::make_heap(keys, keys + k);
+  size_t i = k;
+#ifdef RL_RANKING_X86
+  if (use_avx2(isa)) { i = smallest_keys_avx2(keys, i, count, k); }
+#else
+  static_cast<void>(isa);
+#endif
+  smallest_keys_scalar(keys, i, count, k);
+  std::sort_heap(keys, keys + k);
+}
+
+float build_cdf(kernel_isa isa, float* pdf, size_t count, float* cdf)
+{
+  float sum = 0.f;
+  size_t i = 0;
+#ifdef RL_RANKING_X86
+  if (use_avx2(isa)) { i = build_cdf_avx2(pdf, count, cdf, sum); }
+#else
+  static_cast<void>(isa);
+#endif
+  return build_cdf_scalar(pdf, i, count, cdf, sum);
+}
+
+size_t search_cdf(kernel_isa isa, const float* cdf, size_t count, float draw)
+{
+  size_t i = 0;
+#ifdef RL_RANKING_X86
+  if (use_avx2(isa)) { i = search_cdf_avx2(cdf, count, draw); }
+#else
+  static_cast<void>(isa);
+#endif
+  return search_cdf_scalar(cdf, i, count, draw);
+}
+
+void normalize_pdf(kernel_isa isa, float* pdf, size_t count, float total)
+{
+  size_t i = 0;
+#ifdef RL_RANKING_X86
+  if (use_avx2(isa)) { i = normalize_pdf_avx2(pdf, count, total); }
+#else
+  static_cast<void>(isa);
+#endif
+  normalize_pdf_scalar(pdf, i, count, total);
+}
+}  // namespace ranking_kernels
+}  // namespace reinforcement_learning
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace reinforcement_learning
+{
+// Loops of cb_adf_scorer and of sampling over the actions of a decision, which can number in the thousands.
+//
+// Each kernel has a scalar implementation and an AVX2 one, used when the CPU
+// supports it (detected once at runtime). Both only use exact operations
+// (bit manipulation, comparisons, copies and the same single float
+// operations), so they produce the same bits for any input. Sums are the
+// exception to vectorization: they are accumulated in order, as VW does.
+// Ranking keys pack the score of an action and its index so that sorting them
+// as integers orders the actions by score, then by index.
+namespace ranking_kernels
+{
+enum class kernel_isa
+{
+  scalar,
+  avx2
+};
+
+// keys[i] is the ranking key of scores[i] and action i
+void make_keys(kernel_isa isa, const float* scores, size_t count, uint64_t* keys);
+
+// Number of keys at the start of the sorted keys that have the same score as the first one. count must not be 0.
+size_t count_best(kernel_isa isa, const uint64_t* keys, size_t count);
+
+// actions[i] is the action of keys[i]
+void unpack_actions(kernel_isa isa, const uint64_t* keys, size_t count, int* actions);
+
+// Epsilon-greedy pdf of count actions, the best tied ones first: each action gets epsilon / count and the best ones
+// share the rest
+void epsilon_greedy_pdf(kernel_isa isa, float epsilon, size_t tied, size_t count, float* pdf);
+
+// Moves the k smallest keys to the front of keys, in increasing order. The other keys follow in an unspecified order.
+void smallest_keys(kernel_isa isa, uint64_t* keys, size_t count, size_t k);
+
+// Clamps the negative entries of pdf to 0 and writes their running sums to cdf, returns the total. This is the first
+// loop of VW's exploration::sample_after_normalizing, whose second loop sums the same values again.
+float build_cdf(kernel_isa isa, float* pdf, size_t count, float* cdf);
+
+// Index of the first entry of cdf that draw does not exceed, count if there is none
+size_t search_cdf(kernel_isa isa, const float* cdf, size_t count, float draw);
+
+// Divides the entries of pdf by total
+void normalize_pdf(kernel_isa isa, float* pdf, size_t count, float total);
+
+// Best instruction set supported by this CPU and build
+kernel_isa supported_isa();
+}  // namespace ranking_kernels
+}  // namespace reinforcement_learning
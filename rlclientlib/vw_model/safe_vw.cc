@@ -1,5 +1,7 @@
 #include "safe_vw.h"
 
+#include "utility/metrics_registry.h"
+
 // VW headers
 #include "vw/config/options.h"
 #include "vw/core/debug_print.h"
@@ -90,6 +92,7 @@ void safe_vw::parse_context_with_pdf(string_view context, std::vector<int>& acti
   VW::multi_ex examples;
   examples.push_back(get_or_create_example());
 
+  const auto parse_start = utility::metrics_registry::now();
   // copy due to destructive parsing by rapidjson
   std::string line_vec(context);
   VW::example_factory_t ex_fac = [this]() -> VW::example& { return get_or_create_example_f(this); };
@@ -105,6 +108,7 @@ void safe_vw::parse_context_with_pdf(string_view context, std::vector<int>& acti
     VW::read_line_decision_service_json<false>(
         *_vw, examples, &line_vec[0], line_vec.size(), false, ex_fac, &interaction);
   }
+  utility::metrics_registry::record_since(api_stage::context_parse, parse_start);
 
   // finalize example
   VW::setup_examples(*_vw, examples);
@@ -121,11 +125,11 @@ void safe_vw::parse_context_with_pdf(string_view context, std::vector<int>& acti
   for (auto&& ex : examples) { _example_pool.emplace_back(ex); }
 }
 
-void safe_vw::rank(string_view context, std::vector<int>& actions, std::vector<float>& scores)
+void safe_vw::parse_json(string_view context, VW::multi_ex& examples)
 {
-  VW::multi_ex examples;
   examples.push_back(get_or_create_example());
 
+  const auto parse_start = utility::metrics_registry::now();
   // copy due to destructive parsing by rapidjson
   std::string line_vec(context);
   VW::example_factory_t ex_fac = [this]() -> VW::example& { return get_or_create_example_f(this); };
@@ -136,10 +140,45 @@ void safe_vw::rank(string_view context, std::vector<int>& actions, std::vector<f
     VW::parsers::json::read_line_json<true>(*_vw, examples, &line_vec[0], line_vec.size(), ex_fac);
   }
   else { VW::parsers::json::read_line_json<false>(*_vw, examples, &line_vec[0], line_vec.size(), ex_fac); }
+  utility::metrics_registry::record_since(api_stage::context_parse, parse_start);
 
   // finalize example
   VW::setup_examples(*_vw, examples);
+}
+
+void safe_vw::rank(string_view context, std::vector<int>& actions, std::vector<float>& scores)
+{
+  VW::multi_ex examples;
+  parse_json(context, examples);
+
+  if (_scorer != nullptr && _scorer->predict(examples, actions, scores))
+  {
+    for (auto&& ex : examples) { _example_pool.emplace_back(ex); }
+    return;
+  }
 
+  predict(examples, actions, scores);
+}
+
+void safe_vw::rank(string_view context, size_t shortlist_size, std::vector<int>& actions, std::vector<float>& scores,
+    std::vector<int>& shortlist)
+{
+  VW::multi_ex examples;
+  parse_json(context, examples);
+
+  if (_scorer != nullptr && _scorer->predict(examples, shortlist_size, shortlist, actions, scores))
+  {
+    for (auto&& ex : examples) { _example_pool.emplace_back(ex); }
+    return;
+  }
+
+  // Without the scorer there is no cheap first stage, VW ranks all the actions
+  shortlist.clear();
+  predict(examples, actions, scores);
+}
+
+void safe_vw::predict(VW::multi_ex& examples, std::vector<int>& actions, std::vector<float>& scores)
+{
   // TODO: refactor setup_examples to take in multi_ex
   VW::multi_ex examples2(examples.begin(), examples.end());
 
@@ -168,6 +207,7 @@ void safe_vw::choose_continuous_action(string_view context, float& action, float
   VW::multi_ex examples;
   examples.push_back(get_or_create_example());
 
+  const auto parse_start = utility::metrics_registry::now();
   // copy due to destructive parsing by rapidjson
   std::string line_vec(context);
   VW::example_factory_t ex_fac = [this]() -> VW::example& { return get_or_create_example_f(this); };
@@ -178,6 +218,7 @@ void safe_vw::choose_continuous_action(string_view context, float& action, float
     VW::parsers::json::read_line_json<true>(*_vw, examples, &line_vec[0], line_vec.size(), ex_fac);
   }
   else { VW::parsers::json::read_line_json<false>(*_vw, examples, &line_vec[0], line_vec.size(), ex_fac); }
+  utility::metrics_registry::record_since(api_stage::context_parse, parse_start);
 
   // finalize example
   VW::setup_examples(*_vw, examples);
@@ -200,6 +241,7 @@ void safe_vw::rank_decisions(const std::vector<const char*>& event_ids, string_v
   VW::multi_ex examples;
   examples.push_back(get_or_create_example());
 
+  const auto parse_start = utility::metrics_registry::now();
   // copy due to destructive parsing by rapidjson
   std::string line_vec(context);
   VW::example_factory_t ex_fac = [this]() -> VW::example& { return get_or_create_example_f(this); };
@@ -210,6 +252,7 @@ void safe_vw::rank_decisions(const std::vector<const char*>& event_ids, string_v
     VW::parsers::json::read_line_json<true>(*_vw, examples, &line_vec[0], line_vec.size(), ex_fac);
   }
   else { VW::parsers::json::read_line_json<false>(*_vw, examples, &line_vec[0], line_vec.size(), ex_fac); }
+  utility::metrics_registry::record_since(api_stage::context_parse, parse_start);
 
   // In order to control the seed for the sampling of each slot the event id + app id is passed in as the seed using the
   // example tag.
@@ -249,12 +292,13 @@ void safe_vw::rank_decisions(const std::vector<const char*>& event_ids, string_v
   for (auto&& ex : examples) { _example_pool.emplace_back(ex); }
 }
 
-void safe_vw::rank_multi_slot_decisions(const char* event_id, const std::vector<std::string>& slot_ids,
-    string_view context, std::vector<std::vector<uint32_t>>& actions, std::vector<std::vector<float>>& scores)
+void safe_vw::rank_multi_slot_decisions(
+    const char* event_id, const std::vector<std::string>& slot_ids, string_view context, multi_slot_ranking& ranking)
 {
   VW::multi_ex examples;
   examples.push_back(get_or_create_example());
 
+  const auto parse_start = utility::metrics_registry::now();
   // copy due to destructive parsing by rapidjson
   std::string line_vec(context);
   VW::example_factory_t ex_fac = [this]() -> VW::example& { return get_or_create_example_f(this); };
@@ -265,6 +309,7 @@ void safe_vw::rank_multi_slot_decisions(const char* event_id, const std::vector<
     VW::parsers::json::read_line_json<true>(*_vw, examples, &line_vec[0], line_vec.size(), ex_fac);
   }
   else { VW::parsers::json::read_line_json<false>(*_vw, examples, &line_vec[0], line_vec.size(), ex_fac); }
+  utility::metrics_registry::record_since(api_stage::context_parse, parse_start);
 
   // In order to control the seed for the sampling of each slot the event id + app id is passed in as the seed using the
   // example tag.
@@ -287,17 +332,14 @@ void safe_vw::rank_multi_slot_decisions(const char* event_id, const std::vector<
 
   // prediction are in the first-example
   auto& predictions = examples2[0]->pred.decision_scores;
-  actions.resize(predictions.size());
-  scores.resize(predictions.size());
-  for (size_t i = 0; i < predictions.size(); ++i)
+  size_t entry_count = 0;
+  for (const auto& slot : predictions) { entry_count += slot.size(); }
+  ranking.clear();
+  ranking.reserve(predictions.size(), entry_count);
+  for (const auto& slot : predictions)
   {
-    actions[i].reserve(predictions[i].size());
-    scores[i].reserve(predictions[i].size());
-    for (size_t j = 0; j < predictions[i].size(); ++j)
-    {
-      actions[i].push_back(predictions[i][j].action);
-      scores[i].push_back(predictions[i][j].score);
-    }
+    ranking.add_slot();
+    for (const auto& action_score : slot) { ranking.push_back(action_score.action, action_score.score); }
   }
 
   // clean up examples and push examples back into pool for re-use
@@ -307,6 +349,24 @@ void safe_vw::rank_multi_slot_decisions(const char* event_id, const std::vector<
 
 const char* safe_vw::id() const { return _vw->id.c_str(); }
 
+void safe_vw::apply_delta(const model_management::model_delta& delta)
+{
+  // The weight array masks the index, so out of range entries can not write outside of it
+  for (const auto& weight : delta.weights()) { _vw->weights[static_cast<size_t>(weight.first)] = weight.second; }
+  _vw->id = delta.model_id();
+
+  // the scorer holds a copy of the weights
+  if (_scorer != nullptr) { enable_cb_adf_scorer(); }
+}
+
+bool safe_vw::enable_cb_adf_scorer()
+{
+  _scorer = cb_adf_scorer::create(*_vw);
+  return _scorer != nullptr;
+}
+
+bool safe_vw::has_cb_adf_scorer() const { return _scorer != nullptr; }
+
 mm::model_type_t safe_vw::get_model_type(const std::string& args)
 {
   // slates == slates
@@ -396,18 +456,32 @@ safe_vw_factory::safe_vw_factory(const model_management::model_data&& master_dat
 {
 }
 
+safe_vw_factory::safe_vw_factory(const model_management::model_data& master_data, std::string command_line,
+    std::shared_ptr<const model_management::model_delta> delta)
+    : _master_data(master_data), _command_line(std::move(command_line)), _delta(std::move(delta))
+{
+}
+
 safe_vw* safe_vw_factory::operator()()
 {
+  std::unique_ptr<safe_vw> vw;
   if ((_master_data.data() != nullptr) && !_command_line.empty())
   {
     // Construct new vw object from raw model data and command line argument
-    return new safe_vw(_master_data.data(), _master_data.data_sz(), _command_line);
+    vw.reset(new safe_vw(_master_data.data(), _master_data.data_sz(), _command_line));
   }
-  if (_master_data.data() != nullptr)
+  else if (_master_data.data() != nullptr)
   {
     // Construct new vw object from raw model data.
-    return new safe_vw(_master_data.data(), _master_data.data_sz());
+    vw.reset(new safe_vw(_master_data.data(), _master_data.data_sz()));
   }
-  return new safe_vw(_command_line);
+  else { return new safe_vw(_command_line); }
+
+  // Every object owns its weights, objects of earlier factories keep the weights they were built with
+  if (_delta) { vw->apply_delta(*_delta); }
+  if (_use_cb_adf_scorer) { vw->enable_cb_adf_scorer(); }
+  return vw.release();
 }
+
+void safe_vw_factory::use_cb_adf_scorer(bool enabled) { _use_cb_adf_scorer = enabled; }
 }  // namespace reinforcement_learning
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "cb_adf_scorer.h"
 #include "model_mgmt.h"
+#include "model_mgmt/model_delta.h"
 #include "vw/core/vw.h"
 
 #include <memory>
@@ -14,9 +16,14 @@ class safe_vw
   std::shared_ptr<safe_vw> _master;
   VW::workspace* _vw;
   std::vector<VW::example*> _example_pool;
+  // replaces VW prediction in rank() when set
+  std::unique_ptr<cb_adf_scorer> _scorer;
 
   VW::example* get_or_create_example();
   static VW::example& get_or_create_example_f(void* vw);
+  void parse_json(string_view context, VW::multi_ex& examples);
+  // Predicts the parsed examples of rank() with VW and returns them to the pool
+  void predict(VW::multi_ex& examples, std::vector<int>& actions, std::vector<float>& scores);
 
 public:
   safe_vw(std::shared_ptr<safe_vw> master);
@@ -28,16 +35,27 @@ public:
 
   void parse_context_with_pdf(string_view context, std::vector<int>& actions, std::vector<float>& scores);
   void rank(string_view context, std::vector<int>& actions, std::vector<float>& scores);
+  // Ranks only a shortlist of at most shortlist_size actions when cb_adf_scorer is enabled, see cb_adf_scorer.
+  // shortlist is left empty when all the actions were ranked.
+  void rank(string_view context, size_t shortlist_size, std::vector<int>& actions, std::vector<float>& scores,
+      std::vector<int>& shortlist);
   void choose_continuous_action(string_view context, float& action, float& pdf_value);
   // Used for CCB
   void rank_decisions(const std::vector<const char*>& event_ids, string_view context,
       std::vector<std::vector<uint32_t>>& actions, std::vector<std::vector<float>>& scores);
   // Used for slates
-  void rank_multi_slot_decisions(const char* event_id, const std::vector<std::string>& slot_ids, string_view context,
-      std::vector<std::vector<uint32_t>>& actions, std::vector<std::vector<float>>& scores);
+  void rank_multi_slot_decisions(
+      const char* event_id, const std::vector<std::string>& slot_ids, string_view context, multi_slot_ranking& ranking);
 
   const char* id() const;
 
+  // Overwrites the weights listed in delta and takes over its model id
+  void apply_delta(const model_management::model_delta& delta);
+
+  // Scores rank() requests with cb_adf_scorer if it supports the model. Returns whether it does.
+  bool enable_cb_adf_scorer();
+  bool has_cb_adf_scorer() const;
+
   bool is_compatible(const std::string& args) const;
   bool is_CB_to_CCB_model_upgrade(const std::string& args) const;
 
@@ -57,6 +75,8 @@ class safe_vw_factory
 {
   model_management::model_data _master_data;
   std::string _command_line;
+  std::shared_ptr<const model_management::model_delta> _delta;
+  bool _use_cb_adf_scorer = false;
 
 public:
   // model_data is copied and stored in the factory object.
@@ -65,6 +85,12 @@ public:
   safe_vw_factory(const model_management::model_data&& master_data);
   safe_vw_factory(const model_management::model_data& master_data, std::string command_line);
   safe_vw_factory(const model_management::model_data&& master_data, std::string command_line);
+  // Objects are constructed from master_data, then delta is applied to them. The delta is shared, not copied.
+  safe_vw_factory(const model_management::model_data& master_data, std::string command_line,
+      std::shared_ptr<const model_management::model_delta> delta);
+
+  // Objects use cb_adf_scorer when the model allows it
+  void use_cb_adf_scorer(bool enabled);
 
   safe_vw* operator()();
 };
@@ -5,8 +5,15 @@
 #include "object_factory.h"
 #include "ranking_response.h"
 #include "str_util.h"
+#include "utility/context_helper.h"
 
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
 #include <fstream>
+#include <memory>
+#include <stdexcept>
 
 namespace reinforcement_learning
 {
@@ -21,8 +28,54 @@ vw_model::vw_model(i_trace* trace_logger, const utility::configuration& config)
     , _vw_pool(safe_vw_factory(_initial_command_line),
           config.get_int(name::VW_POOL_INIT_SIZE, value::DEFAULT_VW_POOL_INIT_SIZE), trace_logger)
     , _trace_logger(trace_logger)
+    , _use_cb_adf_scorer(config.get_bool(name::MODEL_VW_LIGHTWEIGHT_CB_ADF, false))
 {
+  const auto cache_size = config.get_int(name::MODEL_VW_PREDICTION_CACHE_SIZE, 0);
+  if (cache_size > 0 && !_audit) { _prediction_cache.reset(new prediction_cache(static_cast<size_t>(cache_size))); }
+
+  const auto* const warmup_file = config.get(name::MODEL_WARMUP_CONTEXTS_FILE, nullptr);
+  if (warmup_file != nullptr && warmup_file[0] != '\0') { load_warmup_contexts(warmup_file); }
+}
+
+namespace
+{
+// Copies of the returned object share its memory, so the model is held once however often it is copied
+model_data make_shared_copy(const model_data& data)
+{
+  if (data.is_shared()) { return data; }
+
+  std::shared_ptr<char> copy(new char[data.data_sz()], std::default_delete<char[]>());
+  std::memcpy(copy.get(), data.data(), data.data_sz());
+  model_data shared;
+  shared.set_shared_data(std::move(copy), data.data_sz());
+  return shared;
+}
+
+// A VW model starts with the length of the version string, including its terminating '\0', and the version string
+bool has_vw_model_header(const model_data& data)
+{
+  const size_t max_version_length = 32;
+
+  uint32_t version_length = 0;
+  if (data.data_sz() < sizeof(version_length)) { return false; }
+  std::memcpy(&version_length, data.data(), sizeof(version_length));
+  if (version_length < 2 || version_length > max_version_length ||
+      version_length > data.data_sz() - sizeof(version_length))
+  {
+    return false;
+  }
+
+  const char* const version = data.data() + sizeof(version_length);
+  if (version[version_length - 1] != '\0') { return false; }
+  return std::all_of(version, version + version_length - 1,
+      [](char c) { return isdigit(static_cast<unsigned char>(c)) != 0 || c == '.'; });
+}
+
+std::chrono::microseconds elapsed_since(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
 }
+}  // namespace
 
 int vw_model::update(const model_data& data, bool& model_ready, api_status* status)
 {
@@ -30,8 +83,16 @@ int vw_model::update(const model_data& data, bool& model_ready, api_status* stat
   {
     TRACE_INFO(_trace_logger, utility::concat("Received new model data. With size ", data.data_sz()));
 
+    if (model_delta::is_delta(data)) { return update_from_delta(data, model_ready, status); }
+
     if (data.data_sz() > 0)
     {
+      if (!has_vw_model_header(data))
+      {
+        RETURN_ERROR_LS(_trace_logger, status, model_update_error) << "Received data does not start with a VW header";
+      }
+
+      auto start = std::chrono::steady_clock::now();
       std::string cmd_line = add_optional_audit_flag(_quiet_commandline_options);
 
       std::unique_ptr<safe_vw> init_vw(new safe_vw(data.data(), data.data_sz(), cmd_line));
@@ -40,12 +101,30 @@ int vw_model::update(const model_data& data, bool& model_ready, api_status* stat
         cmd_line = add_optional_audit_flag(_upgrade_to_CCB_vw_commandline_options);
       }
 
-      safe_vw_factory factory(data, cmd_line);
+      // The factory and the pool keep copies of the model data, these share a single copy of the model
+      const model_data base_data = make_shared_copy(data);
+      safe_vw_factory factory(base_data, cmd_line);
+      factory.use_cb_adf_scorer(_use_cb_adf_scorer);
       std::unique_ptr<safe_vw> test_vw(factory());
       if (test_vw->is_compatible(_initial_command_line))
       {
-        // safe_vw_factory will create a copy of the model data to use for vw object construction.
-        _vw_pool.update_factory(factory);
+        if (_use_cb_adf_scorer && !test_vw->has_cb_adf_scorer())
+        {
+          TRACE_INFO(_trace_logger, "The model is not supported by the lightweight CB ADF scorer, VW will predict");
+        }
+
+        const auto parse_time = elapsed_since(start);
+        start = std::chrono::steady_clock::now();
+        publish(factory);
+        TRACE_INFO(_trace_logger,
+            utility::concat("Published model ", test_vw->id(), ". Parse: ", parse_time.count(),
+                "us, warm-up and publish: ", elapsed_since(start).count(), "us"));
+
+        // Later deltas apply to this model
+        _base_data = base_data;
+        _base_command_line = cmd_line;
+        _base_model_id = test_vw->id();
+        _delta.reset();
         model_ready = true;
       }
       else
@@ -67,11 +146,60 @@ int vw_model::update(const model_data& data, bool& model_ready, api_status* stat
   return error_code::success;
 }
 
+int vw_model::update_from_delta(const model_data& data, bool& model_ready, api_status* status)
+{
+  if (_base_data.data_sz() == 0)
+  {
+    RETURN_ERROR_LS(_trace_logger, status, model_update_error) << "Received a model delta before a full model.";
+  }
+
+  std::shared_ptr<model_delta> delta(new model_delta());
+  RETURN_IF_FAIL(delta->parse(data.data(), data.data_sz(), status));
+
+  // A delta either holds all changes since the full model, or the changes since the previous delta
+  if (_delta && delta->base_id() == _delta->model_id())
+  {
+    std::shared_ptr<model_delta> merged(new model_delta(*_delta));
+    merged->merge(*delta);
+    delta = std::move(merged);
+  }
+  else if (delta->base_id() != _base_model_id)
+  {
+    RETURN_ERROR_LS(_trace_logger, status, model_update_error)
+        << "Model delta does not apply to the current model: base_id = " << delta->base_id()
+        << ", current model = " << (_delta ? _delta->model_id() : _base_model_id);
+  }
+
+  TRACE_INFO(_trace_logger,
+      utility::concat("Applying model delta with ", delta->weights().size(), " weights, new model ",
+          delta->model_id()));
+
+  // Objects parse the full base model and apply the delta, a delta costs as much as a full update apart from the
+  // transfer
+  const auto start = std::chrono::steady_clock::now();
+  safe_vw_factory factory(_base_data, _base_command_line, delta);
+  factory.use_cb_adf_scorer(_use_cb_adf_scorer);
+  publish(std::move(factory));
+  TRACE_INFO(_trace_logger,
+      utility::concat("Published model ", delta->model_id(), ". Parse of the base model, warm-up and publish: ",
+          elapsed_since(start).count(), "us"));
+  _delta = std::move(delta);
+  model_ready = true;
+  return error_code::success;
+}
+
 int vw_model::choose_rank(const char* event_id, uint64_t rnd_seed, string_view features, std::vector<int>& action_ids,
     std::vector<float>& action_pdf, std::string& model_version, api_status* status)
 {
   try
   {
+    // Read before ranking: if the pool is updated meanwhile, the result is filed under the older version and dropped
+    const int pool_version = _prediction_cache ? _vw_pool.version() : 0;
+    if (_prediction_cache && _prediction_cache->get(pool_version, features, action_ids, action_pdf, model_version))
+    {
+      return error_code::success;
+    }
+
     auto vw = _vw_pool.get_or_create();
 
     // Get a ranked list of action_ids and corresponding pdf
@@ -81,6 +209,35 @@ int vw_model::choose_rank(const char* event_id, uint64_t rnd_seed, string_view f
 
     model_version = vw->id();
 
+    if (_prediction_cache) { _prediction_cache->put(pool_version, features, action_ids, action_pdf, model_version); }
+
+    return error_code::success;
+  }
+  catch (const std::exception& e)
+  {
+    RETURN_ERROR_LS(_trace_logger, status, model_rank_error) << e.what();
+  }
+  catch (...)
+  {
+    RETURN_ERROR_LS(_trace_logger, status, model_rank_error) << "Unknown error";
+  }
+}
+
+int vw_model::choose_rank_shortlist(const char* event_id, uint64_t rnd_seed, string_view features,
+    size_t shortlist_size, std::vector<int>& action_ids, std::vector<float>& action_pdf, std::vector<int>& shortlist,
+    std::string& model_version, api_status* status)
+{
+  // Rankings of a shortlist are not cached: they are only made for action sets too large to be worth keeping
+  try
+  {
+    auto vw = _vw_pool.get_or_create();
+
+    vw->rank(features, shortlist_size, action_ids, action_pdf, shortlist);
+
+    if (_audit) { write_audit_log(event_id, vw->get_audit_data()); }
+
+    model_version = vw->id();
+
     return error_code::success;
   }
   catch (const std::exception& e)
@@ -149,15 +306,14 @@ int vw_model::request_decision(const std::vector<const char*>& event_ids, string
 }
 
 int vw_model::request_multi_slot_decision(const char* event_id, const std::vector<std::string>& slot_ids,
-    string_view features, std::vector<std::vector<uint32_t>>& actions_ids, std::vector<std::vector<float>>& action_pdfs,
-    std::string& model_version, api_status* status)
+    string_view features, multi_slot_ranking& ranking, std::string& model_version, api_status* status)
 {
   try
   {
     auto vw = _vw_pool.get_or_create();
 
     // Get a ranked list of action_ids and corresponding pdf
-    vw->rank_multi_slot_decisions(event_id, slot_ids, features, actions_ids, action_pdfs);
+    vw->rank_multi_slot_decisions(event_id, slot_ids, features, ranking);
 
     if (_audit) { write_audit_log(event_id, vw->get_audit_data()); }
 
@@ -201,6 +357,78 @@ void vw_model::write_audit_log(const char* event_id, string_view audit_buffer) c
   }
 }
 
+void vw_model::load_warmup_contexts(const char* file_name)
+{
+  std::ifstream file(file_name);
+  if (!file.is_open())
+  {
+    TRACE_ERROR(_trace_logger, utility::concat("Unable to open the model warm-up contexts ", file_name));
+    return;
+  }
+
+  std::string line;
+  while (std::getline(file, line))
+  {
+    if (!line.empty()) { _warmup_contexts.push_back(line); }
+  }
+}
+
+void vw_model::publish(safe_vw_factory factory)
+{
+  if (_warmup_contexts.empty())
+  {
+    _vw_pool.update_factory(std::move(factory));
+    return;
+  }
+
+  // Runs the prediction paths that serve requests for the type of the model once, before any request reaches the
+  // object: CCB models serve request_decision and request_multi_slot_decision, slates models only the latter
+  const auto type = model_type();
+  const auto warm_up = [this, type](safe_vw& vw)
+  {
+    std::vector<int> action_ids;
+    std::vector<float> action_pdf;
+    std::vector<std::vector<uint32_t>> decision_ids;
+    std::vector<std::vector<float>> decision_pdfs;
+    multi_slot_ranking ranking;
+    std::vector<std::string> slot_ids;
+    utility::ContextInfo context_info;
+    float action = 0.f;
+    float pdf_value = 0.f;
+    for (const auto& context : _warmup_contexts)
+    {
+      switch (type)
+      {
+        case model_type_t::CA:
+          vw.choose_continuous_action(context, action, pdf_value);
+          break;
+        case model_type_t::CCB:
+          vw.rank_decisions({}, context, decision_ids, decision_pdfs);
+          // CCB models serve multi slot decisions too
+          // fall through
+        case model_type_t::SLATES:
+          // one id per slot, as request_multi_slot_decision passes them
+          if (utility::get_context_info(context, context_info) != error_code::success)
+          {
+            throw std::runtime_error("Unable to parse the warm-up context");
+          }
+          slot_ids.resize(context_info.slots.size());
+          for (size_t i = 0; i < slot_ids.size(); ++i)
+          {
+            const auto id = context_info.slot_ids.find(i);
+            slot_ids[i] = id != context_info.slot_ids.end() ? id->second : std::to_string(i);
+          }
+          vw.rank_multi_slot_decisions("warm-up", slot_ids, context, ranking);
+          break;
+        default:
+          vw.rank(context, action_ids, action_pdf);
+          break;
+      }
+    }
+  };
+  _vw_pool.update_factory(std::move(factory), warm_up);
+}
+
 model_type_t vw_model::model_type() const { return safe_vw::get_model_type(_initial_command_line); }
 
 }  // namespace model_management
@@ -2,6 +2,7 @@
 #include "../utility/versioned_object_pool.h"
 #include "model_mgmt.h"
 #include "multistep.h"
+#include "prediction_cache.h"
 #include "safe_vw.h"
 #include "trace_logger.h"
 
@@ -21,6 +22,10 @@ class vw_model : public i_model
 {
   std::string add_optional_audit_flag(const std::string& command_line) const;
   void write_audit_log(const char* event_id, string_view audit_buffer) const;
+  int update_from_delta(const model_data& data, bool& model_ready, api_status* status);
+  void load_warmup_contexts(const char* file_name);
+  // Builds and warms up the objects of the pool from factory, then swaps them in
+  void publish(safe_vw_factory factory);
 
 public:
   vw_model(i_trace* trace_logger, const utility::configuration& config);
@@ -28,14 +33,16 @@ public:
   int update(const model_data& data, bool& model_ready, api_status* status = nullptr) override;
   int choose_rank(const char* event_id, uint64_t rnd_seed, string_view features, std::vector<int>& action_ids,
       std::vector<float>& action_pdf, std::string& model_version, api_status* status = nullptr) override;
+  int choose_rank_shortlist(const char* event_id, uint64_t rnd_seed, string_view features, size_t shortlist_size,
+      std::vector<int>& action_ids, std::vector<float>& action_pdf, std::vector<int>& shortlist,
+      std::string& model_version, api_status* status = nullptr) override;
   int choose_continuous_action(string_view features, float& action, float& pdf_value, std::string& model_version,
       api_status* status = nullptr) override;
   int request_decision(const std::vector<const char*>& event_ids, string_view features,
       std::vector<std::vector<uint32_t>>& actions_ids, std::vector<std::vector<float>>& action_pdfs,
       std::string& model_version, api_status* status = nullptr) override;
   int request_multi_slot_decision(const char* event_id, const std::vector<std::string>& slot_ids, string_view features,
-      std::vector<std::vector<uint32_t>>& actions_ids, std::vector<std::vector<float>>& action_pdfs,
-      std::string& model_version, api_status* status = nullptr) override;
+      multi_slot_ranking& ranking, std::string& model_version, api_status* status = nullptr) override;
   int choose_rank_multistep(const char* event_id, uint64_t rnd_seed, string_view features,
       const episode_history& history, std::vector<int>& action_ids, std::vector<float>& action_pdf,
       std::string& model_version, api_status* status = nullptr) override;
@@ -49,6 +56,18 @@ private:
   const std::string _upgrade_to_CCB_vw_commandline_options{"--ccb_explore_adf --json --quiet"};
   utility::versioned_object_pool<safe_vw> _vw_pool;
   i_trace* _trace_logger;
+  const bool _use_cb_adf_scorer;
+  // only set if enabled
+  std::unique_ptr<prediction_cache> _prediction_cache;
+  std::vector<std::string> _warmup_contexts;
+
+  // Last full model, deltas are applied on top of it. Only used by update(). Every object built for a delta parses
+  // this full model again, see model_delta.
+  model_data _base_data;
+  std::string _base_command_line;
+  std::string _base_model_id;
+  // All deltas received since the last full model, merged
+  std::shared_ptr<const model_delta> _delta;
 };
 }  // namespace model_management
 }  // namespace reinforcement_learning
@@ -0,0 +1,393 @@
+#include "load_generator.h"
+
+#include "benchmark_common.h"
+#include "config_utility.h"
+#include "constants.h"
+#include "err_constants.h"
+#include "logger_statistics.h"
+#include "multi_slot_response.h"
+#include "ranking_response.h"
+#include "sender.h"
+
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace r = reinforcement_learning;
+namespace u = r::utility;
+namespace cfg = u::config;
+namespace err = r::error_code;
+namespace po = boost::program_options;
+namespace chrono = std::chrono;
+
+namespace
+{
+const char* const HTTP_SIM_SENDER = "LOAD_GENERATOR_HTTP_SIM_SENDER";
+
+// Stands for the HTTP sender: a request completes after a fixed latency and at most tasks_limit requests are in
+// flight, send() blocks until one completes when the limit is reached. Nothing leaves the machine.
+class http_sim_sender : public r::i_sender
+{
+public:
+  http_sim_sender(chrono::microseconds latency, size_t tasks_limit) : _latency(latency), _tasks_limit(tasks_limit) {}
+
+  int init(const u::configuration& /*config*/, r::api_status* /*status*/) override { return err::success; }
+
+  void get_statistics(r::logger_statistics& stats) const override
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto now = chrono::steady_clock::now();
+    const auto in_flight = std::count_if(
+        _completions.begin(), _completions.end(), [now](const chrono::steady_clock::time_point& t) { return t > now; });
+    stats.requests_in_flight = static_cast<uint64_t>(in_flight);
+  }
+
+protected:
+  int v_send(const buffer& /*data*/, r::api_status* /*status*/) override
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto now = chrono::steady_clock::now();
+    while (!_completions.empty() && _completions.front() <= now) { _completions.pop_front(); }
+    if (_completions.size() >= _tasks_limit)
+    {
+      const auto first_completion = _completions.front();
+      _completions.pop_front();
+      lock.unlock();
+      std::this_thread::sleep_until(first_completion);
+      lock.lock();
+      now = chrono::steady_clock::now();
+    }
+    _completions.push_back(now + _latency);
+    return err::success;
+  }
+
+private:
+  const chrono::microseconds _latency;
+  const size_t _tasks_limit;
+  mutable std::mutex _mutex;
+  std::deque<chrono::steady_clock::time_point> _completions;
+};
+
+struct pending_outcome
+{
+  chrono::steady_clock::time_point due;
+  std::string event_id;
+
+  bool operator>(const pending_outcome& other) const { return due > other.due; }
+};
+
+uint64_t elapsed_ns(chrono::steady_clock::time_point from, chrono::steady_clock::time_point to)
+{
+  return static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(to - from).count());
+}
+
+void print_percentiles(const std::string& name, std::vector<uint64_t>& samples_ns)
+{
+  std::cout << std::setw(24) << std::left << name << std::right;
+  if (samples_ns.empty())
+  {
+    std::cout << " no samples" << std::endl;
+    return;
+  }
+  std::sort(samples_ns.begin(), samples_ns.end());
+  std::cout << " count " << std::setw(9) << samples_ns.size();
+  const std::vector<std::pair<const char*, double>> percentiles = {
+      {"p50", 0.5}, {"p90", 0.9}, {"p99", 0.99}, {"p99.9", 0.999}, {"p99.99", 0.9999}, {"max", 1.}};
+  for (const auto& p : percentiles)
+  {
+    const auto index = static_cast<size_t>(p.second * static_cast<double>(samples_ns.size() - 1));
+    std::cout << " " << p.first << " " << std::setw(9) << std::fixed << std::setprecision(1)
+              << static_cast<double>(samples_ns[index]) / 1000. << "us";
+  }
+  std::cout << std::endl;
+}
+
+void print_logger_statistics(const std::string& name, const r::logger_statistics& stats)
+{
+  std::cout << std::setw(24) << std::left << name << std::right << " queue high water mark "
+            << stats.queue_count_high_water_mark << " events / " << stats.queue_bytes_high_water_mark << " bytes, "
+            << "dropped " << stats.events_dropped_queue_full << ", blocked " << stats.blocked_count << " times for "
+            << stats.blocked_time_ns / 1000000 << "ms, " << stats.batches_sent << " batches of "
+            << stats.batch_bytes_sent << " bytes sent, " << stats.send_failures << " failed" << std::endl;
+}
+
+void _on_error(const r::api_status& status, load_generator* generator) { generator->on_error(status); }
+}  // namespace
+
+load_generator::load_generator(const po::variables_map& vm)
+    : _options(vm)
+    , _ccb(vm["ccb"].as<bool>())
+    , _qps(vm["qps"].as<double>())
+    , _threads(vm["threads"].as<size_t>())
+    , _duration(vm["duration"].as<int>())
+    , _outcome_delay_ms(vm["outcome_delay_ms"].as<double>())
+    , _outcome_probability(vm["outcome_probability"].as<double>())
+    , _seed(vm["random_seed"].as<uint64_t>())
+{
+}
+
+bool load_generator::init()
+{
+  if (_qps <= 0 || _threads == 0)
+  {
+    std::cout << "qps and threads must be positive" << std::endl;
+    return false;
+  }
+
+  r::api_status status;
+  u::configuration config;
+  const auto json_config = _options["json_config"].as<std::string>();
+  if (!json_config.empty())
+  {
+    if (load_config_from_json(json_config, config, &status) != err::success)
+    {
+      std::cout << "Unable to load " << json_config << " " << status.get_error_msg() << std::endl;
+      return false;
+    }
+  }
+  else
+  {
+    // A local loop without a model source, the model is created from the command line
+    config.set(r::name::APP_ID, "load_generator");
+    config.set(r::name::PROTOCOL_VERSION, "2");
+    config.set(r::name::MODEL_SRC, r::value::NO_MODEL_DATA);
+    config.set(r::name::MODEL_BACKGROUND_REFRESH, "false");
+    config.set(r::name::MODEL_VW_INITIAL_COMMAND_LINE,
+        _ccb ? "--ccb_explore_adf --json --quiet --epsilon 0.2 --id N/A"
+             : "--cb_explore_adf --json --quiet --epsilon 0.2 --id N/A");
+  }
+  config.set(r::name::TIME_PROVIDER_IMPLEMENTATION, r::value::CLOCK_TIME_PROVIDER);
+
+  r::sender_factory_t* sender_factory = &r::sender_factory;
+  const auto sender = _options["sender"].as<std::string>();
+  if (sender == "file")
+  {
+    config.set(r::name::INTERACTION_SENDER_IMPLEMENTATION, r::value::INTERACTION_FILE_SENDER);
+    config.set(r::name::OBSERVATION_SENDER_IMPLEMENTATION, r::value::OBSERVATION_FILE_SENDER);
+    config.set(r::name::INTERACTION_FILE_NAME, _options["interaction_file"].as<std::string>().c_str());
+    config.set(r::name::OBSERVATION_FILE_NAME, _options["observation_file"].as<std::string>().c_str());
+  }
+  else if (sender == "http_sim")
+  {
+    const chrono::microseconds latency(static_cast<int64_t>(_options["http_latency_ms"].as<double>() * 1000));
+    const auto tasks_limit = _options["http_tasks_limit"].as<size_t>();
+    _http_sim_factory.register_type(HTTP_SIM_SENDER,
+        [latency, tasks_limit](std::unique_ptr<r::i_sender>& retval, const u::configuration& /*cfg*/,
+            r::error_callback_fn* /*error_cb*/, r::i_trace* /*trace_logger*/, r::api_status* /*status*/) -> int
+        {
+          retval.reset(new http_sim_sender(latency, tasks_limit));
+          return err::success;
+        });
+    config.set(r::name::INTERACTION_SENDER_IMPLEMENTATION, HTTP_SIM_SENDER);
+    config.set(r::name::OBSERVATION_SENDER_IMPLEMENTATION, HTTP_SIM_SENDER);
+    sender_factory = &_http_sim_factory;
+  }
+  else
+  {
+    std::cout << "Unknown sender " << sender << ", expected file or http_sim" << std::endl;
+    return false;
+  }
+
+  if (_ccb)
+  {
+    _ccb_loop.reset(new r::ccb_loop(config, _on_error, this, &r::trace_logger_factory, &r::data_transport_factory,
+        &r::model_factory, sender_factory));
+    _loop = _ccb_loop.get();
+  }
+  else
+  {
+    _cb.reset(new r::cb_loop(config, _on_error, this, &r::trace_logger_factory, &r::data_transport_factory,
+        &r::model_factory, sender_factory));
+    _loop = _cb.get();
+  }
+  if (_loop->init(&status) != err::success)
+  {
+    std::cout << status.get_error_msg() << std::endl;
+    return false;
+  }
+
+  init_examples();
+  return true;
+}
+
+void load_generator::on_error(const r::api_status& status)
+{
+  // Only the first background errors are printed, a failing sender reports one per batch
+  if (_background_errors.fetch_add(1) < 10)
+  {
+    std::lock_guard<std::mutex> lock(_error_mutex);
+    std::cerr << "Background error: " << status.get_error_msg() << std::endl;
+  }
+}
+
+void load_generator::init_examples()
+{
+  const auto shared_features = _options["shared_features"].as<int>();
+  const auto action_features = _options["action_features"].as<int>();
+  const auto actions = _options["actions"].as<int>();
+  const auto total_actions = _options["total_actions"].as<int>();
+  const auto count = _options["examples"].as<size_t>();
+  const auto seed = static_cast<int>(_seed);
+
+  if (_ccb)
+  {
+    ccb_decision_gen gen(shared_features * 3, shared_features, action_features * 3, action_features, actions,
+        _options["slots"].as<int>(), total_actions, seed);
+    std::generate_n(std::back_inserter(_examples), count, [&gen] { return gen.gen_example(); });
+  }
+  else
+  {
+    cb_decision_gen gen(shared_features, action_features, actions, total_actions, seed, false);
+    std::generate_n(std::back_inserter(_examples), count, [&gen] { return gen.gen_example(); });
+  }
+}
+
+void load_generator::run()
+{
+  std::cout << "Running " << _qps << " decisions/s on " << _threads << " threads for " << _duration.count() << "s"
+            << std::endl;
+
+  std::vector<thread_result> results(_threads);
+  std::vector<std::thread> threads;
+  // Leave time to start the threads before the first decision is due
+  const auto start = clock::now() + chrono::milliseconds(100);
+  for (size_t i = 0; i < _threads; ++i)
+  {
+    threads.emplace_back(&load_generator::run_thread, this, i, start, std::ref(results[i]));
+  }
+  for (auto& thread : threads) { thread.join(); }
+  const auto elapsed = chrono::duration<double>(clock::now() - start).count();
+
+  thread_result total;
+  for (auto& result : results)
+  {
+    total.service_ns.insert(total.service_ns.end(), result.service_ns.begin(), result.service_ns.end());
+    total.response_ns.insert(total.response_ns.end(), result.response_ns.begin(), result.response_ns.end());
+    total.outcome_ns.insert(total.outcome_ns.end(), result.outcome_ns.begin(), result.outcome_ns.end());
+    total.errors += result.errors;
+    if (!result.last_error.empty()) { total.last_error = result.last_error; }
+  }
+
+  std::cout << "Achieved " << std::fixed << std::setprecision(1)
+            << static_cast<double>(total.service_ns.size()) / elapsed << " decisions/s, "
+            << static_cast<double>(total.outcome_ns.size()) / elapsed << " outcomes/s, " << total.errors
+            << " errors, " << _background_errors.load() << " background errors" << std::endl;
+  if (!total.last_error.empty()) { std::cout << "Last error: " << total.last_error << std::endl; }
+
+  print_percentiles("decision service time", total.service_ns);
+  print_percentiles("decision response time", total.response_ns);
+  print_percentiles("outcome service time", total.outcome_ns);
+  print_statistics();
+}
+
+void load_generator::run_thread(size_t index, clock::time_point start, thread_result& result)
+{
+  // Each thread offers its share of the rate, the threads are staggered over one interval
+  const chrono::nanoseconds interval(static_cast<int64_t>(1e9 * static_cast<double>(_threads) / _qps));
+  auto scheduled = start + interval * index / _threads;
+  const auto end = start + _duration;
+
+  std::mt19937_64 rand(_seed + index);
+  std::exponential_distribution<double> outcome_delay_ms(1. / (std::max)(_outcome_delay_ms, 1e-3));
+  std::bernoulli_distribution has_outcome(_outcome_probability);
+  std::priority_queue<pending_outcome, std::vector<pending_outcome>, std::greater<pending_outcome>> outcomes;
+
+  const auto expected = static_cast<size_t>(_qps / static_cast<double>(_threads) * _duration.count()) + 1;
+  result.service_ns.reserve(expected);
+  result.response_ns.reserve(expected);
+
+  const auto prefix = "t" + std::to_string(index) + "-";
+  r::api_status status;
+  const auto report = [&](const pending_outcome& outcome)
+  {
+    const auto begin = clock::now();
+    if (report_outcome(outcome.event_id, &status) != err::success)
+    {
+      ++result.errors;
+      result.last_error = status.get_error_msg();
+    }
+    result.outcome_ns.push_back(elapsed_ns(begin, clock::now()));
+  };
+
+  for (size_t i = 0; scheduled < end; ++i, scheduled += interval)
+  {
+    // Outcomes due before the next decision
+    while (!outcomes.empty() && outcomes.top().due <= scheduled)
+    {
+      std::this_thread::sleep_until(outcomes.top().due);
+      report(outcomes.top());
+      outcomes.pop();
+    }
+
+    std::this_thread::sleep_until(scheduled);
+    auto event_id = prefix + std::to_string(i);
+    const auto begin = clock::now();
+    if (decide(event_id, _examples[(index + i * _threads) % _examples.size()], &status) != err::success)
+    {
+      ++result.errors;
+      result.last_error = status.get_error_msg();
+    }
+    const auto done = clock::now();
+    result.service_ns.push_back(elapsed_ns(begin, done));
+    result.response_ns.push_back(elapsed_ns(scheduled, done));
+
+    if (has_outcome(rand))
+    {
+      const chrono::nanoseconds delay(static_cast<int64_t>(outcome_delay_ms(rand) * 1e6));
+      outcomes.push({done + delay, std::move(event_id)});
+    }
+  }
+
+  // The outcomes still pending are reported without waiting, so that the run ends on time
+  while (!outcomes.empty())
+  {
+    report(outcomes.top());
+    outcomes.pop();
+  }
+}
+
+int load_generator::decide(const std::string& event_id, const std::string& context, r::api_status* status)
+{
+  if (_ccb)
+  {
+    r::multi_slot_response response;
+    return _ccb_loop->request_multi_slot_decision(event_id.c_str(), context.c_str(), response, status);
+  }
+  r::ranking_response response;
+  return _cb->choose_rank(event_id.c_str(), context.c_str(), response, status);
+}
+
+int load_generator::report_outcome(const std::string& event_id, r::api_status* status)
+{
+  if (_ccb) { return _ccb_loop->report_outcome(event_id.c_str(), 0, 1.f, status); }
+  return _cb->report_outcome(event_id.c_str(), 1.f, status);
+}
+
+void load_generator::print_statistics() const
+{
+  r::api_status status;
+  r::logging_statistics stats;
+  if (_loop->get_logging_statistics(stats, &status) != err::success)
+  {
+    std::cout << status.get_error_msg() << std::endl;
+    return;
+  }
+  print_logger_statistics("interactions", stats.interactions);
+  print_logger_statistics("observations", stats.observations);
+}
+
+int load_generator::load_config_from_json(const std::string& file_name, u::configuration& config, r::api_status* status)
+{
+  std::ifstream fs(file_name);
+  if (!fs.good()) { RETURN_ERROR_LS(nullptr, status, file_open_error) << " File:" << file_name; }
+  std::stringstream buffer;
+  buffer << fs.rdbuf();
+  return cfg::create_from_json(buffer.str(), config, nullptr, status);
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include "api_status.h"
+#include "cb_loop.h"
+#include "ccb_loop.h"
+#include "configuration.h"
+#include "factory_resolver.h"
+
+#include <boost/program_options.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+Open loop load generator.
+
+Every thread issues decisions on a fixed schedule, at its share of the
+target rate, whether or not the previous decisions were fast: a slow call
+delays the next ones but does not lower the offered load. The outcome of a
+decision is reported after an exponentially distributed delay, from the
+same thread.
+
+Two latencies are recorded per decision: the service time, from the call
+to its return, and the response time, from the time the decision was
+scheduled to its return. The response time includes the time spent behind
+schedule, so its tail is not hidden by coordinated omission.
+*/
+class load_generator
+{
+public:
+  load_generator(const boost::program_options::variables_map& vm);
+  bool init();
+  void run();
+
+  void on_error(const reinforcement_learning::api_status& status);
+
+private:
+  using clock = std::chrono::steady_clock;
+
+  struct thread_result
+  {
+    std::vector<uint64_t> service_ns;
+    std::vector<uint64_t> response_ns;
+    std::vector<uint64_t> outcome_ns;
+    size_t errors = 0;
+    std::string last_error;
+  };
+
+  static int load_config_from_json(const std::string& file_name, reinforcement_learning::utility::configuration& config,
+      reinforcement_learning::api_status* status);
+  void init_examples();
+  void run_thread(size_t index, clock::time_point start, thread_result& result);
+  int decide(const std::string& event_id, const std::string& context, reinforcement_learning::api_status* status);
+  int report_outcome(const std::string& event_id, reinforcement_learning::api_status* status);
+  void print_statistics() const;
+
+private:
+  const boost::program_options::variables_map& _options;
+  const bool _ccb;
+  const double _qps;
+  const size_t _threads;
+  const std::chrono::seconds _duration;
+  const double _outcome_delay_ms;
+  const double _outcome_probability;
+  const uint64_t _seed;
+
+  std::vector<std::string> _examples;
+  reinforcement_learning::sender_factory_t _http_sim_factory;
+  std::unique_ptr<reinforcement_learning::cb_loop> _cb;
+  std::unique_ptr<reinforcement_learning::ccb_loop> _ccb_loop;
+  reinforcement_learning::base_loop* _loop = nullptr;
+
+  std::atomic<size_t> _background_errors{0};
+  std::mutex _error_mutex;
+};
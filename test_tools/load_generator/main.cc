@@ -0,0 +1,66 @@
+#include "constants.h"
+#include "load_generator.h"
+
+#include <iostream>
+
+namespace po = boost::program_options;
+
+bool is_help(const po::variables_map& vm) { return vm.count("help") > 0; }
+
+po::variables_map process_cmd_line(const int argc, char** argv)
+{
+  po::options_description desc("Options");
+  desc.add_options()("help", "produce help message")("json_config,j", po::value<std::string>()->default_value(""),
+      "JSON file with config information for the RL loop. Default is a local loop without model source")(
+      "ccb", po::bool_switch(), "Make CCB decisions instead of CB decisions")(
+      "qps,q", po::value<double>()->default_value(1000), "Decisions per second, over all the threads")(
+      "threads,t", po::value<size_t>()->default_value(4), "Threads making decisions")(
+      "duration,d", po::value<int>()->default_value(10), "Duration of the run in seconds")(
+      "outcome_delay_ms", po::value<double>()->default_value(1000),
+      "Mean delay between a decision and its outcome, exponentially distributed")(
+      "outcome_probability", po::value<double>()->default_value(1.), "Probability that a decision has an outcome")(
+      "sender", po::value<std::string>()->default_value("file"),
+      "file: log to interaction_file and observation_file. http_sim: simulate an HTTP sender")(
+      "interaction_file", po::value<std::string>()->default_value(reinforcement_learning::DEV_NULL),
+      "Interactions file of the file sender")(
+      "observation_file", po::value<std::string>()->default_value(reinforcement_learning::DEV_NULL),
+      "Observations file of the file sender")(
+      "http_latency_ms", po::value<double>()->default_value(50), "Latency of a request of the simulated HTTP sender")(
+      "http_tasks_limit", po::value<size_t>()->default_value(16), "Requests in flight of the simulated HTTP sender")(
+      "shared_features", po::value<int>()->default_value(20), "Shared features per decision")(
+      "action_features", po::value<int>()->default_value(10), "Features per action")(
+      "actions", po::value<int>()->default_value(50), "Actions per decision")(
+      "total_actions", po::value<int>()->default_value(2000), "Actions the decisions pick from")(
+      "slots", po::value<int>()->default_value(5), "Slots per CCB decision")(
+      "examples", po::value<size_t>()->default_value(1000), "Distinct contexts, generated before the run")(
+      "random_seed", po::value<uint64_t>()->default_value(0), "Random seed of the contexts and outcome delays");
+
+  po::variables_map vm;
+  store(parse_command_line(argc, argv, desc), vm);
+
+  if (is_help(vm)) { std::cout << desc << std::endl; }
+
+  return vm;
+}
+
+int main(int argc, char** argv)
+{
+  try
+  {
+    const auto vm = process_cmd_line(argc, argv);
+    if (is_help(vm)) { return 0; }
+
+    load_generator generator(vm);
+    if (!generator.init())
+    {
+      std::cerr << "Load generator haven't initialized properly." << std::endl;
+      return -1;
+    }
+    generator.run();
+  }
+  catch (const std::exception& e)
+  {
+    std::cout << "Error: " << e.what() << std::endl;
+    return -1;
+  }
+}
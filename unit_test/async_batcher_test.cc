@@ -388,6 +388,53 @@ BOOST_AUTO_TEST_CASE(queue_config_drop_rate_test)
   BOOST_CHECK_EQUAL(items[0], "0.00\n0.69\n0.70\n");
 }
 
+BOOST_AUTO_TEST_CASE(batcher_statistics_test)
+{
+  std::vector<std::string> items;
+  std::unique_ptr<logger::i_message_sender> s(new message_sender(items));
+  error_callback_fn error_fn(expect_no_error, nullptr);
+  utility::watchdog watchdog(nullptr);
+  utility::async_batcher_config config;
+  config.send_high_water_mark = 262143;
+  config.send_batch_interval_ms = static_cast<int>(100000);
+  config.send_queue_max_capacity = 10;
+  config.subsample_rate = 0.7f;
+  int dummy = 0;
+
+  logger::async_batcher<config_drop_event> batcher(std::move(s), watchdog, dummy, &error_fn, config);
+  batcher.init(nullptr);
+
+  std::vector<std::string> vs = {"0.00", "1.00", "0.69", "0.70", "0.71"};
+  for (const auto& v : vs)
+  {
+    auto evt_sp = std::make_shared<config_drop_event>(v);
+    auto evt_fn = [evt_sp](config_drop_event& out_evt, api_status* status) -> int
+    {
+      out_evt = std::move(*evt_sp);
+      return error_code::success;
+    };
+    batcher.append(std::move(evt_fn), evt_sp.get(), nullptr);
+  }
+
+  logger_statistics stats;
+  batcher.get_statistics(stats);
+  BOOST_CHECK_EQUAL(stats.queue_count, 3);
+  BOOST_CHECK_EQUAL(stats.queue_bytes, 3);
+  BOOST_CHECK_EQUAL(stats.events_dropped_subsampling, 2);
+  BOOST_CHECK_EQUAL(stats.batches_sent, 0);
+
+  batcher.run_iteration(nullptr);
+  batcher.get_statistics(stats);
+  BOOST_REQUIRE_EQUAL(items.size(), 1);
+  BOOST_CHECK_EQUAL(stats.queue_count, 0);
+  BOOST_CHECK_EQUAL(stats.queue_count_high_water_mark, 3);
+  BOOST_CHECK_EQUAL(stats.batches_sent, 1);
+  BOOST_CHECK_EQUAL(stats.batch_bytes_sent, items[0].size());
+  BOOST_CHECK_EQUAL(stats.send_failures, 0);
+  BOOST_CHECK_EQUAL(stats.blocked_count, 0);
+  BOOST_CHECK_EQUAL(stats.requests_in_flight, 0);
+}
+
 BOOST_AUTO_TEST_CASE(get_batcher_config_counter_status_test)
 {
   utility::configuration config;
@@ -118,6 +118,28 @@ BOOST_AUTO_TEST_CASE(dedup_simple_json)
   BOOST_CHECK_EQUAL(false, dict.remove_object(178626470));
 }
 
+BOOST_AUTO_TEST_CASE(dedup_json_with_context_info)
+{
+  std::string payload = R"({"s_": "1", "_multi": [{ "b_": "1" }, { "b_": "2" }], "_slots": [{ "a": 10 }]})";
+
+  r::dedup_dict parsing_dict;
+  std::string expected_payload;
+  r::generic_event::object_list_t expected_objects;
+  BOOST_CHECK_EQUAL(err::success,
+      parsing_dict.transform_payload_and_add_objects(payload.c_str(), expected_payload, expected_objects, nullptr));
+
+  // the spans found while serving the request are used as is
+  r::utility::ContextInfo info;
+  BOOST_CHECK_EQUAL(err::success, r::utility::get_context_info(payload.c_str(), info));
+  r::dedup_dict dict;
+  std::string p_out;
+  r::generic_event::object_list_t a_out;
+  BOOST_CHECK_EQUAL(err::success, dict.transform_payload_and_add_objects(payload.c_str(), info, p_out, a_out, nullptr));
+  BOOST_CHECK_EQUAL(expected_payload, p_out);
+  BOOST_CHECK(expected_objects == a_out);
+  BOOST_CHECK_EQUAL(2, dict.size());
+}
+
 BOOST_AUTO_TEST_CASE(compression_transformer)
 {
   r::zstd_compressor compressor(1);
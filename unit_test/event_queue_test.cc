@@ -300,4 +300,31 @@ BOOST_AUTO_TEST_CASE(queue_capacity_test)
   Func f;
   queue.pop(&f);
   BOOST_CHECK_EQUAL(queue.capacity(), 0);
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(queue_statistics)
+{
+  event_queue<test_event> queue(30, events_counter_status::DISABLE, 0.5);
+  const std::vector<std::string> ids = {"no_drop_1", "drop_1", "no_drop_2", "no_drop_3", "drop_2", "no_drop_4"};
+  for (const auto& id : ids)
+  {
+    auto evt_sp = std::make_shared<test_event>(id);
+    queue.push(std::bind(passthru, _1, _2, evt_sp), 10, evt_sp.get());
+  }
+
+  logger_statistics stats;
+  queue.get_statistics(stats);
+  BOOST_CHECK_EQUAL(stats.queue_count, 4);
+  BOOST_CHECK_EQUAL(stats.queue_bytes, 40);
+  BOOST_CHECK_EQUAL(stats.events_dropped_subsampling, 2);
+  BOOST_CHECK_EQUAL(stats.events_dropped_queue_full, 0);
+
+  Func f;
+  queue.pop(&f);
+  queue.pop(&f);
+  queue.get_statistics(stats);
+  BOOST_CHECK_EQUAL(stats.queue_count, 2);
+  BOOST_CHECK_EQUAL(stats.queue_bytes, 20);
+  BOOST_CHECK_EQUAL(stats.queue_count_high_water_mark, 4);
+  BOOST_CHECK_EQUAL(stats.queue_bytes_high_water_mark, 40);
+}
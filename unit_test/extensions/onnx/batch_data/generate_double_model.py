@@ -0,0 +1,18 @@
+# Generates double_model.onnx: a model with a dynamic batch dimension
+# computing Output = 2 * Input for Input of shape [batch, 4]
+import onnx
+from onnx import TensorProto, helper
+
+two = helper.make_tensor("Two", TensorProto.FLOAT, [], [2.0])
+node = helper.make_node("Mul", ["Input", "Two"], ["Output"])
+graph = helper.make_graph(
+    [node],
+    "double",
+    [helper.make_tensor_value_info("Input", TensorProto.FLOAT, ["batch", 4])],
+    [helper.make_tensor_value_info("Output", TensorProto.FLOAT, ["batch", 4])],
+    [two],
+)
+model = helper.make_model(graph, opset_imports=[helper.make_opsetid("", 13)])
+model.ir_version = 7
+onnx.checker.check_model(model)
+onnx.save(model, "double_model.onnx")
@@ -0,0 +1,145 @@
+#ifdef STAND_ALONE
+#  define BOOST_TEST_MODULE Main
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include "batch_scheduler.h"
+#include "test_helpers.h"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Output = 2 * Input, for Input of shape [batch, 4]. See batch_data/generate_double_model.py
+const char* const DOUBLE_MODEL_PATH = "./batch_data/double_model.onnx";
+const size_t DOUBLE_MODEL_WIDTH = 4;
+
+std::shared_ptr<Ort::Session> load_double_model()
+{
+  static Ort::Env env(ORT_LOGGING_LEVEL_WARNING, "batch_scheduler_test");
+#ifdef WIN32
+  const std::wstring path = s2ws(DOUBLE_MODEL_PATH);
+#else
+  const std::string path = DOUBLE_MODEL_PATH;
+#endif
+  return std::make_shared<Ort::Session>(env, path.c_str(), Ort::SessionOptions{});
+}
+
+struct double_request
+{
+  double_request(size_t rows, float first_value)
+      : values(rows * DOUBLE_MODEL_WIDTH), shape{static_cast<int64_t>(rows), static_cast<int64_t>(DOUBLE_MODEL_WIDTH)}
+  {
+    for (size_t i = 0; i < values.size(); i++) { values[i] = first_value + static_cast<float>(i); }
+    inputs.push_back(Ort::Value::CreateTensor<float>(
+        GlobalConfig::instance()->get_memory_info(), values.data(), values.size(), shape.data(), shape.size()));
+  }
+
+  int run(o::batch_scheduler& scheduler, const std::shared_ptr<Ort::Session>& session)
+  {
+    return scheduler.run(session, input_names, inputs, "Output", output, &status);
+  }
+
+  void validate() const
+  {
+    require_success(status);
+    BOOST_REQUIRE_EQUAL(output.size(), values.size());
+    for (size_t i = 0; i < values.size(); i++) { BOOST_REQUIRE_EQUAL(output[i], 2 * values[i]); }
+  }
+
+  tensor_raw values;
+  dimensions shape;
+  std::vector<const char*> input_names{"Input"};
+  std::vector<Ort::Value> inputs;
+  std::vector<float> output;
+  r::api_status status;
+};
+
+void run_concurrently(o::batch_scheduler& scheduler, const std::shared_ptr<Ort::Session>& session,
+    std::vector<std::unique_ptr<double_request>>& requests)
+{
+  std::vector<std::thread> threads;
+  for (auto& request : requests)
+  {
+    double_request* r = request.get();
+    threads.emplace_back([&scheduler, &session, r] { r->run(scheduler, session); });
+  }
+  for (auto& thread : threads) { thread.join(); }
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(batch_scheduler_splits_output_per_request)
+{
+  // Arrange
+  auto session = load_double_model();
+
+  o::batching_options options;
+  options.max_size = 8;
+  options.max_delay = std::chrono::milliseconds(20);
+  o::batch_scheduler scheduler(options, nullptr);
+
+  std::vector<std::unique_ptr<double_request>> requests;
+  for (size_t i = 0; i < 16; i++) { requests.emplace_back(new double_request(1 + i % 3, 100.f * i)); }
+
+  // Act
+  run_concurrently(scheduler, session, requests);
+
+  // Assert
+  for (const auto& request : requests) { request->validate(); }
+}
+
+BOOST_AUTO_TEST_CASE(batch_scheduler_runs_full_batch_without_waiting)
+{
+  // Arrange
+  auto session = load_double_model();
+
+  // A full batch is run right away, the delay would make the test time out otherwise
+  o::batching_options options;
+  options.max_size = 4;
+  options.max_delay = std::chrono::seconds(30);
+  o::batch_scheduler scheduler(options, nullptr);
+
+  std::vector<std::unique_ptr<double_request>> requests;
+  requests.emplace_back(new double_request(2, 1.f));
+  requests.emplace_back(new double_request(1, 10.f));
+  requests.emplace_back(new double_request(1, 20.f));
+
+  // Act
+  const auto start = std::chrono::steady_clock::now();
+  run_concurrently(scheduler, session, requests);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  // Assert
+  BOOST_REQUIRE(elapsed < std::chrono::seconds(10));
+  for (const auto& request : requests) { request->validate(); }
+}
+
+BOOST_AUTO_TEST_CASE(batch_scheduler_reports_run_errors)
+{
+  // Arrange
+  auto session = load_double_model();
+
+  o::batching_options options;
+  options.max_size = 4;
+  options.max_delay = std::chrono::microseconds(100);
+  o::batch_scheduler scheduler(options, nullptr);
+
+  // The model expects rows of 4 values
+  tensor_raw values{1.f, 2.f, 3.f};
+  dimensions shape{1, 3};
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(Ort::Value::CreateTensor<float>(
+      GlobalConfig::instance()->get_memory_info(), values.data(), values.size(), shape.data(), shape.size()));
+
+  // Act
+  r::api_status status;
+  std::vector<float> output;
+  scheduler.run(session, {"Input"}, inputs, "Output", output, &status);
+
+  // Assert
+  require_status(status, r::error_code::extension_error);
+}
@@ -0,0 +1,133 @@
+#ifdef STAND_ALONE
+#  define BOOST_TEST_MODULE Main
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include "binary_tensor_reader.h"
+#include "onnx_binary_tensor.h"
+#include "test_helpers.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace b = reinforcement_learning::onnx::binary_tensor;
+
+namespace
+{
+int read_binary(const char* data, size_t size, std::vector<const char*>& names, std::vector<Ort::Value>& inputs,
+    std::vector<uint64_t>& aligned_storage)
+{
+  r::api_status status;
+  o::read_binary_tensors(r::string_view(data, size), GlobalConfig::instance()->get_memory_info(), names, inputs,
+      aligned_storage, nullptr, &status);
+  return status.get_error_code();
+}
+
+void validate_tensor(Ort::Value& tensor, const dimensions& expected_dimensions, const tensor_raw& expected_values)
+{
+  auto shape = tensor.GetTensorTypeAndShapeInfo().GetShape();
+  BOOST_REQUIRE_EQUAL_COLLECTIONS(
+      shape.cbegin(), shape.cend(), expected_dimensions.cbegin(), expected_dimensions.cend());
+
+  const float* values = tensor.GetTensorMutableData<float>();
+  BOOST_REQUIRE_EQUAL_COLLECTIONS(
+      values, values + expected_values.size(), expected_values.cbegin(), expected_values.cend());
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(binary_tensor_in_place)
+{
+  // Arrange
+  const dimensions vector_dimensions{4};
+  const tensor_raw vector_values{1.0f, 2.1f, 4.2f, -9.1f};
+  const dimensions matrix_dimensions{1, 3};
+  const tensor_raw matrix_values{0.5f, 0.25f, 0.125f};
+
+  b::writer writer;
+  writer.add_tensor("abc", vector_dimensions, vector_values.data());
+  writer.add_tensor("longer_input_name", matrix_dimensions, matrix_values.data());
+
+  // Act
+  std::vector<const char*> names;
+  std::vector<Ort::Value> inputs;
+  std::vector<uint64_t> aligned_storage;
+  BOOST_REQUIRE_EQUAL(read_binary(writer.data(), writer.size(), names, inputs, aligned_storage), r::error_code::success);
+
+  // Assert
+  BOOST_REQUIRE_EQUAL(names.size(), 2);
+  BOOST_REQUIRE_EQUAL(std::string(names[0]), "abc");
+  BOOST_REQUIRE_EQUAL(std::string(names[1]), "longer_input_name");
+
+  BOOST_REQUIRE_EQUAL(inputs.size(), 2);
+  validate_tensor(inputs[0], vector_dimensions, vector_values);
+  validate_tensor(inputs[1], matrix_dimensions, matrix_values);
+
+  // The tensors point into the caller's buffer
+  BOOST_REQUIRE(aligned_storage.empty());
+  const char* tensor_data = reinterpret_cast<const char*>(inputs[0].GetTensorMutableData<float>());
+  BOOST_REQUIRE(tensor_data > writer.data() && tensor_data < writer.data() + writer.size());
+}
+
+BOOST_AUTO_TEST_CASE(binary_tensor_unaligned)
+{
+  // Arrange
+  const dimensions dims{2, 2};
+  const tensor_raw values{1.0f, 2.0f, 3.0f, 4.0f};
+
+  b::writer writer;
+  writer.add_tensor("abc", dims, values.data());
+
+  std::vector<char> unaligned(writer.size() + 1);
+  std::memcpy(unaligned.data() + 1, writer.data(), writer.size());
+
+  // Act
+  std::vector<const char*> names;
+  std::vector<Ort::Value> inputs;
+  std::vector<uint64_t> aligned_storage;
+  BOOST_REQUIRE_EQUAL(
+      read_binary(unaligned.data() + 1, writer.size(), names, inputs, aligned_storage), r::error_code::success);
+
+  // Assert
+  BOOST_REQUIRE(!aligned_storage.empty());
+  BOOST_REQUIRE_EQUAL(std::string(names[0]), "abc");
+  validate_tensor(inputs[0], dims, values);
+}
+
+BOOST_AUTO_TEST_CASE(binary_tensor_invalid)
+{
+  const dimensions dims{4};
+  const tensor_raw values{1.0f, 2.1f, 4.2f, -9.1f};
+
+  b::writer writer;
+  writer.add_tensor("abc", dims, values.data());
+
+  std::vector<const char*> names;
+  std::vector<Ort::Value> inputs;
+  std::vector<uint64_t> aligned_storage;
+
+  // Tensor notation is not accepted
+  const std::string notation = R"({"abc":"BAAAAAAAAAA=;AACAP2ZmBkBmZoZAmpkRwQ=="})";
+  BOOST_REQUIRE_EQUAL(read_binary(notation.data(), notation.size(), names, inputs, aligned_storage),
+      r::error_code::extension_error);
+
+  // Truncated values
+  BOOST_REQUIRE_EQUAL(
+      read_binary(writer.data(), writer.size() - 8, names, inputs, aligned_storage), r::error_code::extension_error);
+
+  // Trailing bytes
+  std::vector<uint64_t> trailing(writer.size() / sizeof(uint64_t) + 1, 0);
+  std::memcpy(trailing.data(), writer.data(), writer.size());
+  BOOST_REQUIRE_EQUAL(read_binary(reinterpret_cast<const char*>(trailing.data()), writer.size() + 8, names, inputs,
+                          aligned_storage),
+      r::error_code::extension_error);
+
+  // Negative dimension, located after the 8 byte header, the 8 byte tensor header and the padded name
+  std::vector<uint64_t> negative(writer.size() / sizeof(uint64_t));
+  std::memcpy(negative.data(), writer.data(), writer.size());
+  negative[3] = static_cast<uint64_t>(-4);
+  BOOST_REQUIRE_EQUAL(read_binary(reinterpret_cast<const char*>(negative.data()), writer.size(), names, inputs,
+                          aligned_storage),
+      r::error_code::extension_error);
+}
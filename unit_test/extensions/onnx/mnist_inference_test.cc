@@ -4,22 +4,53 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include "cb_loop.h"
 #include "config_utility.h"
 #include "configuration.h"
 #include "factory_resolver.h"
 #include "live_model.h"
 #include "mock_helpers.h"
+#include "onnx_binary_tensor.h"
 #include "onnx_extension.h"
 #include "test_helpers.h"
 
+#include <cstring>
 #include <iostream>
+#include <string>
 
 namespace r = reinforcement_learning;
 namespace u = reinforcement_learning::utility;
 
 void logging_error_fn(const r::api_status& status, void*) { std::cerr << status.get_error_msg() << std::endl; }
 
-BOOST_AUTO_TEST_CASE(mnist_inference_smoke_test)
+// Converts tensor notation with a single tensor to the binary tensor framing
+o::binary_tensor::writer to_binary_tensors(const std::string& tensor_notation)
+{
+  const size_t name_end = tensor_notation.find('"', 2);
+  const size_t separator = tensor_notation.find(';', name_end);
+  const size_t value_start = name_end + 3;
+
+  const std::string name = tensor_notation.substr(2, name_end - 2);
+  const o::bytes_t dimension_bytes = from_base64(tensor_notation.substr(value_start, separator - value_start));
+  const o::bytes_t value_bytes =
+      from_base64(tensor_notation.substr(separator + 1, tensor_notation.size() - separator - 3));
+
+  dimensions dims(dimension_bytes.size() / sizeof(int64_t));
+  std::memcpy(dims.data(), dimension_bytes.data(), dimension_bytes.size());
+
+  o::binary_tensor::writer writer;
+  writer.add_tensor(name, dims, reinterpret_cast<const float*>(value_bytes.data()));
+  return writer;
+}
+
+enum class mnist_input
+{
+  tensor_notation,
+  binary,
+  structured
+};
+
+void run_mnist_inference_test(mnist_input input, bool use_io_binding = false)
 {
   // Assume that the onnx factory is already registered via the GlobalConfig fixture in main.cc
   const char* EVENT_ID = "f43dc884-abab-48ac-bc1a-aadb51fd15d4";
@@ -59,17 +90,43 @@ BOOST_AUTO_TEST_CASE(mnist_inference_smoke_test)
 
   // TODO: This should be a CMake-configure set value
   config.set("model_file_loader.file_name", "./mnist_data/mnist_model.onnx");
+  if (input == mnist_input::binary) { config.set(r::name::ONNX_INPUT_FORMAT, r::value::ONNX_INPUT_FORMAT_BINARY); }
+  if (input == mnist_input::structured) { config.set(r::name::ONNX_USE_UNSTRUCTURED_INPUT, "false"); }
+  if (use_io_binding)
+  {
+    config.set(r::name::ONNX_USE_IO_BINDING, "true");
+    config.set(r::name::ONNX_INTRA_OP_THREADS, "1");
+    config.set(r::name::ONNX_GRAPH_OPTIMIZATION_LEVEL, r::value::ONNX_GRAPH_OPTIMIZATION_ALL);
+  }
 
   require_success(status);
 
-  r::live_model model(config, logging_error_fn, nullptr, &r::trace_logger_factory, &r::data_transport_factory,
-      &r::model_factory, mock_sender_factory.get());
-  model.init(&status);
+  r::ranking_response response;
+  if (input == mnist_input::structured)
+  {
+    r::cb_loop loop(config, logging_error_fn, nullptr, &r::trace_logger_factory, &r::data_transport_factory,
+        &r::model_factory, mock_sender_factory.get());
+    loop.init(&status);
 
-  require_success(status);
+    require_success(status);
 
-  r::ranking_response response;
-  model.choose_rank(EVENT_ID, TENSOR_NOTATION_CONTEXT, response, &status);
+    loop.choose_rank(EVENT_ID, to_binary_tensors(TENSOR_NOTATION_CONTEXT), response, &status);
+  }
+  else
+  {
+    r::live_model model(config, logging_error_fn, nullptr, &r::trace_logger_factory, &r::data_transport_factory,
+        &r::model_factory, mock_sender_factory.get());
+    model.init(&status);
+
+    require_success(status);
+
+    if (input == mnist_input::binary)
+    {
+      const auto binary_context = to_binary_tensors(TENSOR_NOTATION_CONTEXT);
+      model.choose_rank(EVENT_ID, r::string_view(binary_context.data(), binary_context.size()), response, &status);
+    }
+    else { model.choose_rank(EVENT_ID, TENSOR_NOTATION_CONTEXT, response, &status); }
+  }
 
   require_success(status);
 
@@ -79,4 +136,12 @@ BOOST_AUTO_TEST_CASE(mnist_inference_smoke_test)
   require_success(status);
 
   BOOST_REQUIRE_EQUAL(chosen_action_id, correct_label);
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(mnist_inference_smoke_test) { run_mnist_inference_test(mnist_input::tensor_notation); }
+
+BOOST_AUTO_TEST_CASE(mnist_inference_binary_input) { run_mnist_inference_test(mnist_input::binary); }
+
+BOOST_AUTO_TEST_CASE(mnist_inference_structured_input) { run_mnist_inference_test(mnist_input::structured); }
+
+BOOST_AUTO_TEST_CASE(mnist_inference_io_binding) { run_mnist_inference_test(mnist_input::tensor_notation, true); }
@@ -0,0 +1,99 @@
+#include "api_status.h"
+#include "base64_decoder.h"
+#include "onnx_input.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace r = reinforcement_learning;
+namespace o = reinforcement_learning::onnx;
+
+namespace
+{
+std::string encode_base64(const unsigned char* bytes, size_t size)
+{
+  static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+  std::string result;
+  result.reserve((size + 2) / 3 * 4);
+  for (size_t i = 0; i < size; i += 3)
+  {
+    const uint32_t b0 = bytes[i];
+    const uint32_t b1 = i + 1 < size ? bytes[i + 1] : 0;
+    const uint32_t b2 = i + 2 < size ? bytes[i + 2] : 0;
+    const uint32_t bits = (b0 << 16) | (b1 << 8) | b2;
+
+    result.push_back(alphabet[(bits >> 18) & 0x3F]);
+    result.push_back(alphabet[(bits >> 12) & 0x3F]);
+    result.push_back(i + 1 < size ? alphabet[(bits >> 6) & 0x3F] : '=');
+    result.push_back(i + 2 < size ? alphabet[bits & 0x3F] : '=');
+  }
+  return result;
+}
+
+// A single float tensor of the given number of values, e.g. 28 * 28 for an MNIST image
+std::string create_tensor_notation(int64_t value_count)
+{
+  const std::vector<int64_t> dimensions{1, value_count};
+  std::vector<float> values(static_cast<size_t>(value_count));
+  for (size_t i = 0; i < values.size(); i++) { values[i] = static_cast<float>(i) / static_cast<float>(value_count); }
+
+  return R"({"Input3":")" +
+      encode_base64(reinterpret_cast<const unsigned char*>(dimensions.data()), dimensions.size() * sizeof(int64_t)) +
+      ";" + encode_base64(reinterpret_cast<const unsigned char*>(values.data()), values.size() * sizeof(float)) +
+      R"("})";
+}
+}  // namespace
+
+static void bench_read_tensor_notation(benchmark::State& state)
+{
+  const std::string notation = create_tensor_notation(state.range(0));
+
+  for (auto _ : state)
+  {
+    o::onnx_input_builder input_builder{nullptr};
+    r::api_status status;
+    o::read_tensor_notation(notation, input_builder, &status);
+    benchmark::DoNotOptimize(input_builder);
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * notation.size()));
+}
+
+static void bench_base64_decode(benchmark::State& state)
+{
+  const auto isa = static_cast<o::base64::decoder_isa>(state.range(0));
+  if (static_cast<int>(isa) > static_cast<int>(o::base64::supported_isa()))
+  {
+    state.SkipWithError("instruction set not supported on this CPU");
+    return;
+  }
+
+  std::vector<float> values(static_cast<size_t>(state.range(1)), 0.5f);
+  const std::string encoded =
+      encode_base64(reinterpret_cast<const unsigned char*>(values.data()), values.size() * sizeof(float));
+
+  o::bytes_t decoded(o::base64::decoded_size(encoded.data(), encoded.size()));
+  for (auto _ : state)
+  {
+    o::base64::decode_error error;
+    benchmark::DoNotOptimize(o::base64::decode(isa, encoded.data(), encoded.size(), decoded.data(), error));
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * encoded.size()));
+}
+
+BENCHMARK(bench_read_tensor_notation)->Arg(28 * 28)->Arg(64 * 1024)->Arg(1024 * 1024);
+
+BENCHMARK(bench_base64_decode)
+    ->ArgNames({"isa", "values"})
+    ->ArgsProduct({{static_cast<int64_t>(o::base64::decoder_isa::scalar),
+                       static_cast<int64_t>(o::base64::decoder_isa::sse41),
+                       static_cast<int64_t>(o::base64::decoder_isa::avx2)},
+        {28 * 28, 64 * 1024, 1024 * 1024}});
+
+BENCHMARK_MAIN();
@@ -4,9 +4,12 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include "base64_decoder.h"
 #include "onnx_input.h"
 #include "test_helpers.h"
 
+#include <string>
+
 BOOST_AUTO_TEST_CASE(null_pointer)
 {
   // Arrange
@@ -78,6 +81,34 @@ BOOST_AUTO_TEST_CASE(simple_vector)
   BOOST_REQUIRE_EQUAL(parsed_inputs.size(), 1);
 }
 
+BOOST_AUTO_TEST_CASE(reused_input_builder)
+{
+  // Arrange
+  o::onnx_input_builder ic{nullptr};
+
+  const auto two_inputs = R"({"abc":"BAAAAAAAAAA=;AACAP2ZmBkBmZoZAmpkRwQ==","def":"AQAAAAAAAAA=;AACAPw=="})";
+
+  r::api_status status;
+  o::read_tensor_notation(two_inputs, ic, &status);
+  require_success(status);
+  validate_input_context(ic, 2, std::vector<std::string>({"abc", "def"}));
+
+  // Act
+  ic.clear();
+  o::read_tensor_notation(SimpleVectorNotation, ic, &status);
+
+  // Assert
+  require_success(status);
+  validate_input_context(ic, 1, std::vector<std::string>({"abc"}));
+
+  std::vector<Ort::Value> parsed_inputs;
+  ic.allocate_inputs(parsed_inputs, GlobalConfig::instance()->get_memory_info(), &status);
+  require_success(status);
+
+  BOOST_REQUIRE_EQUAL(parsed_inputs.size(), 1);
+  validate_tensor(parsed_inputs[0], {4}, {1.0f, 2.1f, 4.2f, -9.1f});
+}
+
 BOOST_AUTO_TEST_CASE(roundtrip_tensor_data)
 {
   // The goal of this test is to ensure that the assumptions we make about roundtripping the underlying
@@ -192,4 +223,101 @@ BOOST_AUTO_TEST_CASE(bad_tensor_data)
 
   // Assert
   require_status(status, reinforcement_learning::error_code::extension_error);
-}
\ No newline at end of file
+}
+
+const std::vector<o::base64::decoder_isa> AllDecoderIsas{
+    o::base64::decoder_isa::scalar, o::base64::decoder_isa::sse41, o::base64::decoder_isa::avx2};
+
+BOOST_AUTO_TEST_CASE(base64_decoder_matches_across_isas)
+{
+  // Cover every tail length around the 16 and 32 character vector blocks
+  for (size_t size = 0; size < 200; size++)
+  {
+    o::bytes_t bytes(size);
+    for (size_t i = 0; i < size; i++) { bytes[i] = static_cast<o::byte_t>((i * 151 + size * 7) & 0xFF); }
+    const std::string encoded = to_base64(bytes);
+
+    for (auto isa : AllDecoderIsas)
+    {
+      o::bytes_t decoded(o::base64::decoded_size(encoded.data(), encoded.size()));
+      o::base64::decode_error error;
+
+      BOOST_REQUIRE(o::base64::decode(isa, encoded.data(), encoded.size(), decoded.data(), error));
+      BOOST_REQUIRE_EQUAL_COLLECTIONS(bytes.cbegin(), bytes.cend(), decoded.cbegin(), decoded.cend());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(base64_decoder_errors)
+{
+  o::bytes_t bytes(96, 0x5A);
+  const std::string encoded = to_base64(bytes);
+
+  for (auto isa : AllDecoderIsas)
+  {
+    // An invalid character inside a vector block has to be reported at its exact position
+    std::string bad_character = encoded;
+    bad_character[37] = '!';
+
+    o::bytes_t decoded(o::base64::decoded_size(bad_character.data(), bad_character.size()));
+    o::base64::decode_error error;
+    BOOST_REQUIRE(!o::base64::decode(isa, bad_character.data(), bad_character.size(), decoded.data(), error));
+    BOOST_REQUIRE(error.error == o::base64::decode_error::kind::invalid_character);
+    BOOST_REQUIRE_EQUAL(error.position, 37);
+    BOOST_REQUIRE_EQUAL(error.character, '!');
+
+    const std::string bad_length = encoded.substr(0, encoded.size() - 1);
+    decoded.resize(o::base64::decoded_size(bad_length.data(), bad_length.size()));
+    BOOST_REQUIRE(!o::base64::decode(isa, bad_length.data(), bad_length.size(), decoded.data(), error));
+    BOOST_REQUIRE(error.error == o::base64::decode_error::kind::invalid_length);
+    BOOST_REQUIRE_EQUAL(error.count, bad_length.size());
+
+    const std::string bad_padding = encoded.substr(0, encoded.size() - 3) + "===";
+    decoded.resize(o::base64::decoded_size(bad_padding.data(), bad_padding.size()));
+    BOOST_REQUIRE(!o::base64::decode(isa, bad_padding.data(), bad_padding.size(), decoded.data(), error));
+    BOOST_REQUIRE(error.error == o::base64::decode_error::kind::invalid_padding);
+    BOOST_REQUIRE_EQUAL(error.count, 3);
+  }
+}
+
+const auto BadTensorBase64Character = R"({"abc":"BAAAAAAAAAA=;AACAP2ZmBkBm!oZAmpkRwQ=="})";
+
+BOOST_AUTO_TEST_CASE(bad_tensor_base64_character)
+{
+  // Arrange
+  r::api_status status;
+  o::onnx_input_builder ic{nullptr};
+
+  // Act
+  o::read_tensor_notation(BadTensorBase64Character, ic, &status);
+
+  // Assert
+  require_status(status, reinforcement_learning::error_code::extension_error);
+
+  const std::string message = status.get_error_msg();
+  BOOST_REQUIRE_MESSAGE(
+      message.find("Parse failure at position 33 while parsing tensor value: Invalid base64 character: '!'.") !=
+          std::string::npos,
+      message);
+}
+
+// 5 bytes of values, which do not fit in a whole number of floats
+const auto BadTensorValuePacking = R"({"abc":"AQAAAAAAAAA=;AACAP2Y="})";
+
+BOOST_AUTO_TEST_CASE(bad_tensor_value_packing)
+{
+  // Arrange
+  r::api_status status;
+  o::onnx_input_builder ic{nullptr};
+
+  // Act
+  o::read_tensor_notation(BadTensorValuePacking, ic, &status);
+
+  // Assert
+  require_status(status, reinforcement_learning::error_code::extension_error);
+
+  const std::string message = status.get_error_msg();
+  BOOST_REQUIRE_MESSAGE(message.find("Parse failure at position 30 while parsing tensor value: Invalid number of "
+                                     "bytes: '5'. Expecting a multiple of 4.") != std::string::npos,
+      message);
+}
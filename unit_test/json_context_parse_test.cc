@@ -277,3 +277,32 @@ BOOST_AUTO_TEST_CASE(get_slot_ids_some_slots_missing)
   BOOST_CHECK_EQUAL(slot_ids[1], "");
   BOOST_CHECK_EQUAL(slot_ids[2], "provided_id_2");
 }
+
+BOOST_AUTO_TEST_CASE(get_context_info_slot_ids)
+{
+  auto const context = R"({
+    "_id":"not_a_slot",
+    "_multi":[
+      {"_id":"not_a_slot_either", "a":1}
+    ],
+    "_slots": [
+      {"a":4, "_id":"provided_id_0"},
+      {"b":{"_id":"nested"}},
+      {"_id":3},
+      {"c":["x"], "_id":"provided_id_3"}
+    ]
+  })";
+  rlutil::ContextInfo info;
+  auto scode = rlutil::get_context_info(context, info);
+  BOOST_CHECK_EQUAL(scode, error_code::success);
+
+  // the same ids get_slot_ids finds
+  std::map<size_t, std::string> slot_ids;
+  scode = rlutil::get_slot_ids(context, info.slots, slot_ids);
+  BOOST_CHECK_EQUAL(scode, error_code::success);
+  BOOST_CHECK(info.slot_ids == slot_ids);
+
+  BOOST_CHECK_EQUAL(info.slot_ids.size(), 2);
+  BOOST_CHECK_EQUAL(info.slot_ids[0], "provided_id_0");
+  BOOST_CHECK_EQUAL(info.slot_ids[3], "provided_id_3");
+}
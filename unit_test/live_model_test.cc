@@ -13,6 +13,8 @@
 #include "constants.h"
 #include "err_constants.h"
 #include "factory_resolver.h"
+#include "generated/v2/CbEvent_generated.h"
+#include "generated/v2/Event_generated.h"
 #include "live_model.h"
 #include "mock_util.h"
 #include "model_mgmt.h"
@@ -21,6 +23,7 @@
 #include "sender.h"
 #include "slates_loop.h"
 #include "str_util.h"
+#include "structured_input.h"
 
 #include <fstream>
 #include <thread>
@@ -42,6 +45,7 @@ namespace u = reinforcement_learning::utility;
 namespace m = reinforcement_learning::model_management;
 namespace err = reinforcement_learning::error_code;
 namespace cfg = reinforcement_learning::utility::config;
+namespace v2 = reinforcement_learning::messages::flatbuff::v2;
 
 using namespace fakeit;
 
@@ -109,6 +113,22 @@ MODEL_TYPE create_mock_live_model(const u::configuration& config,
       config, nullptr, nullptr, &r::trace_logger_factory, data_transport_factory, model_factory, sender_factory);
   return model;
 }
+
+// CB events of the batches recorded by a sender, logged with protocol version 2 and without compression or dedup
+std::vector<const v2::CbEvent*> get_cb_events(std::vector<buffer_data_t>& recorded)
+{
+  std::vector<const v2::CbEvent*> events;
+  for (auto& buffer : recorded)
+  {
+    const auto* batch = v2::GetEventBatch(buffer.body_begin());
+    for (const auto* serialized : *batch->events())
+    {
+      const auto* event = v2::GetEvent(serialized->payload()->data());
+      events.push_back(v2::GetCbEvent(event->payload()->data()));
+    }
+  }
+  return events;
+}
 }  // namespace
 
 BOOST_AUTO_TEST_CASE(schema_v1_with_bad_use_dedup)
@@ -215,6 +235,204 @@ BOOST_AUTO_TEST_CASE(live_model_ranking_request)
   BOOST_CHECK_EQUAL(status.get_error_msg(), "");
 }
 
+BOOST_AUTO_TEST_CASE(live_model_ranking_request_structured_input)
+{
+  u::configuration config;
+  cfg::create_from_json(JSON_CFG, config);
+  config.set(r::name::EH_TEST, "true");
+  config.set(r::name::PROTOCOL_VERSION, "2");
+
+  r::api_status status;
+
+  r::cb_loop ds = create_mock_live_model<r::cb_loop>(config, nullptr, nullptr, nullptr);
+  BOOST_CHECK_EQUAL(ds.init(&status), err::success);
+
+  const std::vector<int64_t> dimensions{1, 3};
+  const std::vector<float> values{0.5f, 1.5f, 2.5f};
+  r::structured_input input;
+  BOOST_CHECK_EQUAL(input.add_tensor("features", dimensions, values.data()), err::success);
+
+  r::ranking_response response;
+  BOOST_CHECK_EQUAL(ds.choose_rank("event_id", input, response, &status), err::success);
+  BOOST_CHECK_EQUAL(response.size(), 2);
+  BOOST_CHECK_EQUAL(response.get_event_id(), "event_id");
+
+  // event_id is auto-generated
+  BOOST_CHECK_EQUAL(ds.choose_rank(input, response, &status), err::success);
+  BOOST_CHECK(strlen(response.get_event_id()) > 0);
+
+  // no tensors
+  r::structured_input empty;
+  BOOST_CHECK_EQUAL(ds.choose_rank("event_id", empty, response, &status), err::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(live_model_ranking_request_structured_input_with_dedup)
+{
+  u::configuration config;
+  cfg::create_from_json(JSON_CFG, config);
+  config.set(r::name::EH_TEST, "true");
+  config.set(r::name::PROTOCOL_VERSION, "2");
+  config.set(r::name::INTERACTION_USE_DEDUP, "true");
+
+  r::api_status status;
+
+  r::cb_loop ds = create_mock_live_model<r::cb_loop>(config, nullptr, nullptr, nullptr);
+  BOOST_CHECK_EQUAL(ds.init(&status), err::success);
+
+  const std::vector<float> values{0.5f, 1.5f};
+  r::structured_input input;
+  input.add_tensor("features", std::vector<int64_t>{2}, values.data());
+
+  // The binary context can not be deduplicated
+  r::ranking_response response;
+  BOOST_CHECK_EQUAL(ds.choose_rank("event_id", input, response, &status), err::content_encoding_error);
+}
+
+BOOST_AUTO_TEST_CASE(live_model_ranking_request_structured_input_logged_as_binary_tensors)
+{
+  std::vector<buffer_data_t> recorded_interactions;
+  auto mock_interaction_sender = get_mock_sender(recorded_interactions);
+  auto mock_observation_sender = get_mock_sender(r::error_code::success);
+  auto sender_factory = get_mock_sender_factory(mock_observation_sender.get(), mock_interaction_sender.get());
+
+  u::configuration config;
+  cfg::create_from_json(JSON_CFG, config);
+  config.set(r::name::EH_TEST, "true");
+  config.set(r::name::PROTOCOL_VERSION, "2");
+
+  const std::vector<float> values{0.5f, 1.5f};
+  r::structured_input input;
+  input.add_tensor("features", std::vector<int64_t>{2}, values.data());
+  {
+    r::cb_loop ds = create_mock_live_model<r::cb_loop>(config, nullptr, nullptr, sender_factory.get());
+    r::api_status status;
+    BOOST_CHECK_EQUAL(ds.init(&status), err::success);
+
+    r::ranking_response response;
+    BOOST_CHECK_EQUAL(ds.choose_rank("event_id", input, response, &status), err::success);
+  }
+
+  // The context is logged as given and tagged, so that the trainer does not read it as json
+  const auto events = get_cb_events(recorded_interactions);
+  BOOST_REQUIRE_EQUAL(events.size(), 1);
+  BOOST_CHECK(events[0]->context_format() == v2::ContextFormat_BinaryTensors);
+  const std::string context(
+      reinterpret_cast<const char*>(events[0]->context()->data()), events[0]->context()->size());
+  BOOST_CHECK(context == std::string(input.data(), input.size()));
+}
+
+BOOST_AUTO_TEST_CASE(live_model_ranking_request_structured_input_unsupported_configurations)
+{
+  const std::vector<float> values{0.5f, 1.5f};
+  r::structured_input input;
+  input.add_tensor("features", std::vector<int64_t>{2}, values.data());
+  r::ranking_response response;
+  r::api_status status;
+
+  // v1 events can not tell a binary context from a json one
+  u::configuration config_v1;
+  cfg::create_from_json(JSON_CFG, config_v1);
+  config_v1.set(r::name::EH_TEST, "true");
+  r::cb_loop ds_v1 = create_mock_live_model<r::cb_loop>(config_v1, nullptr, nullptr, nullptr);
+  BOOST_CHECK_EQUAL(ds_v1.init(&status), err::success);
+  BOOST_CHECK_EQUAL(ds_v1.choose_rank("event_id", input, response, &status), err::protocol_not_supported);
+
+  // The shortlist is made of the actions of a json context
+  u::configuration config_shortlist;
+  cfg::create_from_json(JSON_CFG, config_shortlist);
+  config_shortlist.set(r::name::EH_TEST, "true");
+  config_shortlist.set(r::name::PROTOCOL_VERSION, "2");
+  config_shortlist.set(r::name::RANK_SHORTLIST_SIZE, "1");
+  r::cb_loop ds_shortlist = create_mock_live_model<r::cb_loop>(config_shortlist, nullptr, nullptr, nullptr);
+  BOOST_CHECK_EQUAL(ds_shortlist.init(&status), err::success);
+  BOOST_CHECK_EQUAL(ds_shortlist.choose_rank("event_id", input, response, &status), err::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(live_model_ranking_request_logs_shortlisted_decision)
+{
+  std::vector<buffer_data_t> recorded_interactions;
+  auto mock_interaction_sender = get_mock_sender(recorded_interactions);
+  auto mock_observation_sender = get_mock_sender(r::error_code::success);
+  auto sender_factory = get_mock_sender_factory(mock_observation_sender.get(), mock_interaction_sender.get());
+
+  // The model ranks actions 3 and 1 out of 4, always choosing action 3
+  auto mock_model = get_mock_model(r::model_management::model_type_t::CB);
+  When(Method((*mock_model), choose_rank_shortlist))
+      .AlwaysDo(
+          [](const char*, uint64_t, r::string_view, size_t, std::vector<int>& action_ids,
+              std::vector<float>& action_pdf, std::vector<int>& shortlist, std::string& model_version, r::api_status*)
+          {
+            shortlist = {1, 3};
+            action_ids = {3, 1};
+            action_pdf = {1.f, 0.f};
+            model_version = "model_id";
+            return r::error_code::success;
+          });
+  auto model_factory = get_mock_model_factory(mock_model.get());
+
+  u::configuration config;
+  cfg::create_from_json(JSON_CFG, config);
+  config.set(r::name::EH_TEST, "true");
+  config.set(r::name::PROTOCOL_VERSION, "2");
+  config.set(r::name::RANK_SHORTLIST_SIZE, "2");
+
+  const auto context =
+      R"({"GUser":{"id":"a"},"_multi":[{"TAction":{"a":0}},{"TAction":{"a":1}},{"TAction":{"a":2}},{"TAction":{"a":3}}]})";
+  {
+    r::cb_loop ds = create_mock_live_model<r::cb_loop>(config, nullptr, model_factory.get(), sender_factory.get());
+    r::api_status status;
+    BOOST_REQUIRE_EQUAL(ds.init(&status), err::success);
+
+    r::ranking_response response;
+    BOOST_REQUIRE_EQUAL(ds.choose_rank("event_id", context, response, &status), err::success);
+
+    // The caller gets the ids of the full context
+    size_t chosen_action_id = 0;
+    BOOST_CHECK_EQUAL(response.get_chosen_action_id(chosen_action_id), err::success);
+    BOOST_CHECK_EQUAL(chosen_action_id, 3);
+    BOOST_REQUIRE_EQUAL(response.size(), 2);
+    auto it = response.begin();
+    BOOST_CHECK_EQUAL((*it).action_id, 3);
+    BOOST_CHECK_EQUAL((*it).probability, 1.f);
+    ++it;
+    BOOST_CHECK_EQUAL((*it).action_id, 1);
+    BOOST_CHECK_EQUAL((*it).probability, 0.f);
+  }
+
+  // The log holds the full context, the ids of the full context (from 1) and the shortlist in its own field
+  const auto events = get_cb_events(recorded_interactions);
+  BOOST_REQUIRE_EQUAL(events.size(), 1);
+  const std::string logged_context(
+      reinterpret_cast<const char*>(events[0]->context()->data()), events[0]->context()->size());
+  BOOST_CHECK_EQUAL(logged_context, context);
+
+  const std::vector<uint64_t> expected_ids{4, 2};
+  const auto& action_ids = *events[0]->action_ids();
+  BOOST_CHECK_EQUAL_COLLECTIONS(action_ids.begin(), action_ids.end(), expected_ids.begin(), expected_ids.end());
+  const std::vector<float> expected_pdf{1.f, 0.f};
+  const auto& probabilities = *events[0]->probabilities();
+  BOOST_CHECK_EQUAL_COLLECTIONS(
+      probabilities.begin(), probabilities.end(), expected_pdf.begin(), expected_pdf.end());
+  const std::vector<uint64_t> expected_shortlist{2, 4};
+  BOOST_REQUIRE(events[0]->shortlist() != nullptr);
+  const auto& shortlist = *events[0]->shortlist();
+  BOOST_CHECK_EQUAL_COLLECTIONS(
+      shortlist.begin(), shortlist.end(), expected_shortlist.begin(), expected_shortlist.end());
+}
+
+BOOST_AUTO_TEST_CASE(live_model_ranking_request_shortlist_requires_protocol_v2)
+{
+  // v1 events have no field for the shortlist
+  u::configuration config;
+  cfg::create_from_json(JSON_CFG, config);
+  config.set(r::name::EH_TEST, "true");
+  config.set(r::name::RANK_SHORTLIST_SIZE, "2");
+
+  r::cb_loop ds = create_mock_live_model<r::cb_loop>(config, nullptr, nullptr, nullptr);
+  r::api_status status;
+  BOOST_CHECK_EQUAL(ds.init(&status), err::protocol_not_supported);
+}
+
 BOOST_AUTO_TEST_CASE(live_model_ranking_request_online_mode)
 {
   // create a simple ds configuration
@@ -934,7 +1152,7 @@ BOOST_AUTO_TEST_CASE(populate_response_same_size_test)
   r::decision_response resp;
 
   BOOST_CHECK_EQUAL(
-      populate_response(action_ids, pdfs, event_ids, std::move(model_id), resp, nullptr, &status), err::success);
+      populate_response(action_ids, pdfs, event_ids, model_id, resp, nullptr, &status), err::success);
 
   BOOST_CHECK(strcmp(resp.get_model_id(), "id") == 0);
   BOOST_CHECK_EQUAL(resp.size(), 3);
@@ -969,15 +1187,49 @@ BOOST_AUTO_TEST_CASE(populate_response_different_size_test)
 
   r::decision_response resp;
 
-  BOOST_CHECK_EQUAL(populate_response(action_ids, pdfs, event_ids, std::move(model_id), resp, nullptr, &status),
+  BOOST_CHECK_EQUAL(populate_response(action_ids, pdfs, event_ids, model_id, resp, nullptr, &status),
       err::invalid_argument);
 
   action_ids = {{0, 1}, {1, 2}, {1}};
   pdfs = {{0.8667f, 0.0667f, 0.0667f}, {0.9f, 0.1f}, {1.0f}};
-  BOOST_CHECK_EQUAL(populate_response(action_ids, pdfs, event_ids, std::move(model_id), resp, nullptr, &status),
+  BOOST_CHECK_EQUAL(populate_response(action_ids, pdfs, event_ids, model_id, resp, nullptr, &status),
       err::invalid_argument);
 }
 
+BOOST_AUTO_TEST_CASE(populate_response_reuse_test)
+{
+  r::api_status status;
+  std::vector<const char*> event_ids = {"a", "b", "c"};
+  const std::string model_id = "id";
+
+  r::decision_response resp;
+  BOOST_CHECK_EQUAL(populate_response({{0, 1}, {1}, {2}}, {{0.9f, 0.1f}, {1.0f}, {1.0f}}, event_ids, model_id, resp,
+                        nullptr, &status),
+      err::success);
+  const auto* first_slot = &(*resp.begin());
+
+  resp.clear();
+  BOOST_CHECK_EQUAL(resp.size(), 0);
+  BOOST_CHECK(resp.begin() == resp.end());
+
+  event_ids = {"d", "e"};
+  BOOST_CHECK_EQUAL(
+      populate_response({{1, 0}, {0}}, {{0.7f, 0.3f}, {1.0f}}, event_ids, model_id, resp, nullptr, &status),
+      err::success);
+  BOOST_CHECK_EQUAL(resp.size(), 2);
+  // the slots of the previous request are reused
+  BOOST_CHECK_EQUAL(&(*resp.begin()), first_slot);
+
+  auto it = resp.begin();
+  BOOST_CHECK(strcmp((*it).get_slot_id(), "d") == 0);
+  BOOST_CHECK_EQUAL((*it).get_action_id(), 1);
+  ++it;
+  BOOST_CHECK(strcmp((*it).get_slot_id(), "e") == 0);
+  BOOST_CHECK_EQUAL((*it).get_action_id(), 0);
+  ++it;
+  BOOST_CHECK(it == resp.end());
+}
+
 BOOST_AUTO_TEST_CASE(populate_slot_test)
 {
   r::api_status status;
@@ -987,7 +1239,8 @@ BOOST_AUTO_TEST_CASE(populate_slot_test)
 
   r::slot_ranking slot;
 
-  BOOST_CHECK_EQUAL(populate_slot(action_ids, pdfs, slot, slot_id, nullptr, &status), err::success);
+  BOOST_CHECK_EQUAL(
+      populate_slot(action_ids.data(), pdfs.data(), action_ids.size(), slot, slot_id, nullptr, &status), err::success);
 
   BOOST_CHECK_EQUAL(slot.size(), 3);
 
@@ -1003,29 +1256,42 @@ BOOST_AUTO_TEST_CASE(populate_slot_test)
   }
 }
 
+r::multi_slot_ranking make_multi_slot_ranking(
+    const std::vector<std::vector<uint32_t>>& action_ids, const std::vector<std::vector<float>>& pdfs)
+{
+  r::multi_slot_ranking ranking;
+  for (size_t i = 0; i < action_ids.size(); i++)
+  {
+    ranking.add_slot();
+    for (size_t j = 0; j < action_ids[i].size(); j++) { ranking.push_back(action_ids[i][j], pdfs[i][j]); }
+  }
+  return ranking;
+}
+
 BOOST_AUTO_TEST_CASE(populate_multi_slot_response_same_size_test)
 {
   r::api_status status;
   std::vector<std::vector<uint32_t>> action_ids = {{0, 1, 2}, {1, 2}, {2}};
   std::vector<std::vector<float>> pdfs = {{0.8667f, 0.0667f, 0.0667f}, {0.9f, 0.1f}, {1.0f}};
+  const auto ranking = make_multi_slot_ranking(action_ids, pdfs);
   std::vector<std::string> slot_ids = {"slot0", "slot1", "slot2"};
   std::string event_id = "a";
   std::string model_id = "id";
 
+  BOOST_CHECK_EQUAL(ranking.slot_count(), 3);
+  BOOST_CHECK_EQUAL(ranking.size(), 6);
+  BOOST_CHECK_EQUAL(ranking.slot_size(1), 2);
+
   r::multi_slot_response_detailed resp;
   resp.resize(3);
 
   BOOST_CHECK_EQUAL(populate_multi_slot_response_detailed(
-                        action_ids, pdfs, std::move(event_id), std::move(model_id), slot_ids, resp, nullptr, &status),
+                        ranking, event_id.c_str(), model_id, slot_ids, resp, nullptr, &status),
       err::success);
 
   BOOST_CHECK(strcmp(resp.get_model_id(), "id") == 0);
   BOOST_CHECK_EQUAL(resp.size(), 3);
 
-  auto it = resp.begin();
-  size_t action_id = 0;
-  auto& rank_resp = *it;
-
   int i = 0;
   for (const auto& s : resp)
   {
@@ -1035,6 +1301,7 @@ BOOST_AUTO_TEST_CASE(populate_multi_slot_response_same_size_test)
       BOOST_CHECK_EQUAL(d.action_id, action_ids[i][j]);
       BOOST_CHECK_EQUAL(d.probability, pdfs[i][j++]);
     }
+    BOOST_CHECK_EQUAL(j, action_ids[i].size());
     ++i;
   }
 }
@@ -1042,25 +1309,72 @@ BOOST_AUTO_TEST_CASE(populate_multi_slot_response_same_size_test)
 BOOST_AUTO_TEST_CASE(populate_multi_slot_response_different_size_test)
 {
   r::api_status status;
-  std::vector<std::vector<uint32_t>> action_ids = {{0, 1, 2}, {1, 2}};
-  std::vector<std::vector<float>> pdfs = {{0.8667f, 0.0667f, 0.0667f}, {0.9f, 0.1f}, {1.0f}};
   std::vector<std::string> slot_ids = {"slot0", "slot1", "slot2"};
   std::string event_id = "a";
   std::string model_id = "id";
 
   r::multi_slot_response_detailed resp;
+  resp.resize(3);
 
+  auto ranking = make_multi_slot_ranking({{0, 1, 2}, {1, 2}}, {{0.8667f, 0.0667f, 0.0667f}, {0.9f, 0.1f}});
   BOOST_CHECK_EQUAL(populate_multi_slot_response_detailed(
-                        action_ids, pdfs, std::move(event_id), std::move(model_id), slot_ids, resp, nullptr, &status),
+                        ranking, event_id.c_str(), model_id, slot_ids, resp, nullptr, &status),
       err::invalid_argument);
 
-  action_ids = {{0, 1}, {1, 2}, {1}};
-  pdfs = {{0.8667f, 0.0667f, 0.0667f}, {0.9f, 0.1f}, {1.0f}};
+  // empty slot
+  ranking = make_multi_slot_ranking({{0, 1}, {}, {1}}, {{0.9f, 0.1f}, {}, {1.0f}});
   BOOST_CHECK_EQUAL(populate_multi_slot_response_detailed(
-                        action_ids, pdfs, std::move(event_id), std::move(model_id), slot_ids, resp, nullptr, &status),
+                        ranking, event_id.c_str(), model_id, slot_ids, resp, nullptr, &status),
       err::invalid_argument);
 }
 
+BOOST_AUTO_TEST_CASE(populate_multi_slot_response_reuse_test)
+{
+  r::api_status status;
+  std::vector<std::string> slot_ids = {"slot0", "slot1", "slot2"};
+  const std::string model_id = "id";
+
+  r::multi_slot_response resp;
+  auto ranking = make_multi_slot_ranking({{0, 1}, {1}, {2}}, {{0.9f, 0.1f}, {1.0f}, {1.0f}});
+  BOOST_CHECK_EQUAL(
+      populate_multi_slot_response(ranking, "a", model_id, slot_ids, resp, nullptr, &status), err::success);
+  const auto* first_entry = &(*resp.begin());
+
+  resp.clear();
+  BOOST_CHECK_EQUAL(resp.size(), 0);
+  BOOST_CHECK(strcmp(resp.get_event_id(), "") == 0);
+
+  slot_ids = {"slot3"};
+  ranking = make_multi_slot_ranking({{1, 0}}, {{0.6f, 0.4f}});
+  BOOST_CHECK_EQUAL(
+      populate_multi_slot_response(ranking, "b", model_id, slot_ids, resp, nullptr, &status), err::success);
+  BOOST_CHECK_EQUAL(resp.size(), 1);
+  BOOST_CHECK(strcmp(resp.get_event_id(), "b") == 0);
+  // the entries of the previous request are reused
+  BOOST_CHECK_EQUAL(&(*resp.begin()), first_entry);
+  BOOST_CHECK(strcmp((*resp.begin()).get_id(), "slot3") == 0);
+  BOOST_CHECK_EQUAL((*resp.begin()).get_action_id(), 1);
+  BOOST_CHECK_CLOSE((*resp.begin()).get_probability(), 0.6f, FLOAT_TOL);
+}
+
+BOOST_AUTO_TEST_CASE(multi_slot_ranking_reuse)
+{
+  auto ranking = make_multi_slot_ranking({{0, 1, 2}, {1, 2}}, {{0.8f, 0.1f, 0.1f}, {0.9f, 0.1f}});
+  const auto* ids = ranking.action_ids().data();
+
+  ranking.clear();
+  BOOST_CHECK_EQUAL(ranking.slot_count(), 0);
+  BOOST_CHECK_EQUAL(ranking.size(), 0);
+
+  ranking.add_slot();
+  ranking.push_back(2, 1.f);
+  BOOST_CHECK_EQUAL(ranking.slot_count(), 1);
+  BOOST_CHECK_EQUAL(ranking.slot_action_ids(0)[0], 2);
+  BOOST_CHECK_EQUAL(ranking.slot_probabilities(0)[0], 1.f);
+  // the memory is kept
+  BOOST_CHECK_EQUAL(ranking.action_ids().data(), ids);
+}
+
 const auto JSON_CCB_CONTEXT =
     R"({"GUser":{"id":"a","major":"eng","hobby":"hiking"},"_multi":[ { "TAction":{"a1":"f1"} },{"TAction":{"a2":"f2"}}],"_slots":[{"Slot":{"a1":"f1"}},{"Slot":{"a1":"f1"}}]})";
 
@@ -0,0 +1,141 @@
+#ifdef STAND_ALONE
+#  define BOOST_TEST_MODULE Main
+#endif
+
+#include "metrics_snapshot.h"
+#include "utility/metrics_registry.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace reinforcement_learning;
+using namespace reinforcement_learning::utility;
+
+namespace
+{
+// Metrics are process wide, other tests record into them too: only the differences between snapshots are checked
+uint64_t count_up_to(const latency_histogram& histogram, uint64_t bound)
+{
+  uint64_t count = 0;
+  for (const auto& bucket : histogram.buckets)
+  {
+    if (bucket.first <= bound) { count += bucket.second; }
+  }
+  return count;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(latency_histogram_quantile)
+{
+  latency_histogram histogram;
+  BOOST_CHECK_EQUAL(histogram.quantile(0.5), 0);
+
+  histogram.buckets = {{10, 50}, {100, 40}, {1000, 10}};
+  histogram.count = 100;
+  BOOST_CHECK_EQUAL(histogram.quantile(0.), 10);
+  BOOST_CHECK_EQUAL(histogram.quantile(0.49), 10);
+  BOOST_CHECK_EQUAL(histogram.quantile(0.5), 100);
+  BOOST_CHECK_EQUAL(histogram.quantile(0.95), 1000);
+  BOOST_CHECK_EQUAL(histogram.quantile(1.), 1000);
+}
+
+BOOST_AUTO_TEST_CASE(metrics_snapshot_to_prometheus)
+{
+  metrics_snapshot snapshot;
+  auto& histogram = snapshot.get(api_stage::send);
+  histogram.buckets = {{800, 2}, {3000000, 1}};
+  histogram.count = 3;
+  histogram.sum = 3001600;
+  snapshot.get(api_counter::batches_sent) = 7;
+
+  const auto text = snapshot.to_prometheus();
+  BOOST_CHECK(text.find("rl_stage_latency_seconds_bucket{stage=\"send\",le=\"1e-06\"} 2\n") != std::string::npos);
+  BOOST_CHECK(text.find("rl_stage_latency_seconds_bucket{stage=\"send\",le=\"0.0025\"} 2\n") != std::string::npos);
+  BOOST_CHECK(text.find("rl_stage_latency_seconds_bucket{stage=\"send\",le=\"0.005\"} 3\n") != std::string::npos);
+  BOOST_CHECK(text.find("rl_stage_latency_seconds_bucket{stage=\"send\",le=\"+Inf\"} 3\n") != std::string::npos);
+  BOOST_CHECK(text.find("rl_stage_latency_seconds_count{stage=\"send\"} 3\n") != std::string::npos);
+  BOOST_CHECK(text.find("rl_stage_latency_seconds_count{stage=\"context_parse\"} 0\n") != std::string::npos);
+  BOOST_CHECK(text.find("rl_batches_sent_total 7\n") != std::string::npos);
+  BOOST_CHECK(text.find("rl_send_retries_total 0\n") != std::string::npos);
+}
+
+#ifndef RL_DISABLE_METRICS
+BOOST_AUTO_TEST_CASE(metrics_registry_buckets)
+{
+  metrics_snapshot before;
+  metrics_registry::snapshot(before);
+
+  const std::vector<uint64_t> values = {0, 5, 7, 8, 1000, 1100, 1000000};
+  for (const auto value : values) { metrics_registry::record(api_stage::compression, value); }
+  metrics_registry::increment(api_counter::send_retries, 3);
+
+  metrics_snapshot after;
+  metrics_registry::snapshot(after);
+
+  const auto& old_histogram = before.get(api_stage::compression);
+  const auto& histogram = after.get(api_stage::compression);
+  BOOST_CHECK_EQUAL(histogram.count - old_histogram.count, values.size());
+  BOOST_CHECK_EQUAL(histogram.sum - old_histogram.sum, 1002120);
+  BOOST_CHECK_EQUAL(after.get(api_counter::send_retries) - before.get(api_counter::send_retries), 3);
+
+  // Small values are exact, larger ones within 1/8
+  BOOST_CHECK_EQUAL(count_up_to(histogram, 7) - count_up_to(old_histogram, 7), 3);
+  BOOST_CHECK_EQUAL(count_up_to(histogram, 8) - count_up_to(old_histogram, 8), 4);
+  BOOST_CHECK_EQUAL(count_up_to(histogram, 1100 * 9 / 8) - count_up_to(old_histogram, 1100 * 9 / 8), 6);
+  BOOST_CHECK_EQUAL(count_up_to(histogram, 1000000 * 9 / 8) - count_up_to(old_histogram, 1000000 * 9 / 8), 7);
+
+  for (size_t i = 1; i < histogram.buckets.size(); ++i)
+  {
+    BOOST_CHECK_LT(histogram.buckets[i - 1].first, histogram.buckets[i].first);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(metrics_registry_threads)
+{
+  metrics_snapshot before;
+  metrics_registry::snapshot(before);
+
+  const int thread_count = 4;
+  const int record_count = 10000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thread_count; ++t)
+  {
+    threads.emplace_back(
+        []
+        {
+          for (int i = 0; i < record_count; ++i)
+          {
+            metrics_registry::record(api_stage::batch_fill, i);
+            metrics_registry::increment(api_counter::events_dropped);
+          }
+        });
+  }
+  for (auto& thread : threads) { thread.join(); }
+
+  // The shards of the exited threads keep their values
+  metrics_snapshot after;
+  metrics_registry::snapshot(after);
+  BOOST_CHECK_EQUAL(after.get(api_stage::batch_fill).count - before.get(api_stage::batch_fill).count,
+      thread_count * record_count);
+  BOOST_CHECK_EQUAL(after.get(api_counter::events_dropped) - before.get(api_counter::events_dropped),
+      thread_count * record_count);
+}
+
+BOOST_AUTO_TEST_CASE(metrics_stage_timer)
+{
+  metrics_snapshot before;
+  metrics_registry::snapshot(before);
+  {
+    stage_timer timer(api_stage::pool_checkout);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  metrics_snapshot after;
+  metrics_registry::snapshot(after);
+
+  BOOST_CHECK_EQUAL(after.get(api_stage::pool_checkout).count - before.get(api_stage::pool_checkout).count, 1);
+  BOOST_CHECK_GE(after.get(api_stage::pool_checkout).sum - before.get(api_stage::pool_checkout).sum, 2000000);
+}
+#endif
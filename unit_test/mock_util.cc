@@ -98,8 +98,7 @@ std::unique_ptr<fakeit::Mock<m::i_model>> get_mock_model(m::model_type_t model_t
   };
 
   const auto request_multi_slot_decision_fn = [](const char*, const std::vector<std::string>&, r::string_view,
-                                                  std::vector<std::vector<uint32_t>>&, std::vector<std::vector<float>>&,
-                                                  std::string& model_version, r::api_status*)
+                                                  r::multi_slot_ranking&, std::string& model_version, r::api_status*)
   {
     model_version = "model_id";
     return r::error_code::success;
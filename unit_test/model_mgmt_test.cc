@@ -11,12 +11,19 @@
 #include "constants.h"
 #include "err_constants.h"
 #include "factory_resolver.h"
+#include "metrics_snapshot.h"
 #include "model_mgmt/data_callback_fn.h"
+#include "model_mgmt/file_model_loader.h"
+#include "model_mgmt/model_delta.h"
 #include "model_mgmt/model_downloader.h"
 #include "object_factory.h"
+#include "utility/metrics_registry.h"
 #include "utility/periodic_background_proc.h"
 #include "utility/watchdog.h"
 
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <regex>
 #include <unordered_map>
 
@@ -243,3 +250,241 @@ BOOST_AUTO_TEST_CASE(vw_model_type)
   BOOST_CHECK_EQUAL(r::error_code::success, r::model_factory.create(vw, r::value::VW, model_cc));
   BOOST_CHECK_EQUAL((int)m::model_type_t::SLATES, (int)vw->model_type());
 }
+
+namespace
+{
+void write_model_file(const std::string& file_name, const std::string& content)
+{
+  // Write and rename, as a model publisher should when the file is mapped
+  const std::string temp_name = file_name + ".tmp";
+  {
+    std::ofstream out(temp_name, std::ios::binary | std::ios::trunc);
+    out << content;
+  }
+  std::remove(file_name.c_str());
+  std::rename(temp_name.c_str(), file_name.c_str());
+}
+
+std::string to_string(const m::model_data& data) { return std::string(data.data(), data.data_sz()); }
+
+void run_file_model_loader_test(bool use_mmap, bool use_inotify)
+{
+  const std::string file_name("file_model_loader_test.model");
+  write_model_file(file_name, "first model");
+
+  m::file_model_loader loader(file_name, true, nullptr, use_mmap, use_inotify);
+  r::api_status status;
+  BOOST_CHECK_EQUAL(loader.init(&status), r::error_code::success);
+
+  m::model_data first;
+  BOOST_CHECK_EQUAL(loader.get_data(first, &status), r::error_code::success);
+  BOOST_CHECK_EQUAL(to_string(first), "first model");
+  BOOST_CHECK_EQUAL(first.refresh_count(), 1);
+  BOOST_CHECK_EQUAL(first.is_shared(), use_mmap);
+
+  // Unchanged file is not loaded again
+  m::model_data unchanged;
+  BOOST_CHECK_EQUAL(loader.get_data(unchanged, &status), r::error_code::success);
+  BOOST_CHECK_EQUAL(unchanged.refresh_count(), 0);
+
+  write_model_file(file_name, "second, longer model");
+
+  m::model_data second;
+  BOOST_CHECK_EQUAL(loader.get_data(second, &status), r::error_code::success);
+  BOOST_CHECK_EQUAL(to_string(second), "second, longer model");
+  BOOST_CHECK_EQUAL(second.refresh_count(), 1);
+
+  // Copies share mapped data, and earlier data stays valid
+  const m::model_data copy(second);
+  BOOST_CHECK_EQUAL(copy.data() == second.data(), use_mmap);
+  BOOST_CHECK_EQUAL(to_string(first), "first model");
+
+  // Same size, and most likely the same second as the last load: only the content tells the change
+  write_model_file(file_name, "second, other  model");
+
+  m::model_data third;
+  BOOST_CHECK_EQUAL(loader.get_data(third, &status), r::error_code::success);
+  BOOST_CHECK_EQUAL(to_string(third), "second, other  model");
+  BOOST_CHECK_EQUAL(third.refresh_count(), 1);
+
+  m::model_data unchanged_again;
+  BOOST_CHECK_EQUAL(loader.get_data(unchanged_again, &status), r::error_code::success);
+  BOOST_CHECK_EQUAL(unchanged_again.refresh_count(), 0);
+
+  std::remove(file_name.c_str());
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(file_model_loader_read) { run_file_model_loader_test(false, false); }
+
+BOOST_AUTO_TEST_CASE(file_model_loader_read_inotify) { run_file_model_loader_test(false, true); }
+
+BOOST_AUTO_TEST_CASE(file_model_loader_mmap) { run_file_model_loader_test(true, true); }
+
+BOOST_AUTO_TEST_CASE(file_model_loader_mmap_in_place_rewrite)
+{
+  const std::string file_name("file_model_loader_in_place.model");
+  write_model_file(file_name, "first model");
+
+  m::file_model_loader loader(file_name, true, nullptr, true, true);
+  r::api_status status;
+  BOOST_CHECK_EQUAL(loader.init(&status), r::error_code::success);
+
+  m::model_data first;
+  BOOST_CHECK_EQUAL(loader.get_data(first, &status), r::error_code::success);
+  BOOST_CHECK(first.is_shared());
+
+  // Rewritten in place while first still maps it, not grown smaller so that the mapping stays readable
+  {
+    std::ofstream out(file_name, std::ios::binary | std::ios::trunc);
+    out << "second, longer model";
+  }
+
+  m::model_data second;
+  BOOST_CHECK_EQUAL(loader.get_data(second, &status), r::error_code::success);
+  BOOST_CHECK_EQUAL(to_string(second), "second, longer model");
+  BOOST_CHECK(!second.is_shared());
+
+  // Once the mapping is released, a replaced file is mapped again
+  first = m::model_data();
+  write_model_file(file_name, "third model");
+
+  m::model_data third;
+  BOOST_CHECK_EQUAL(loader.get_data(third, &status), r::error_code::success);
+  BOOST_CHECK_EQUAL(to_string(third), "third model");
+  BOOST_CHECK(third.is_shared());
+
+  std::remove(file_name.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(model_data_shared)
+{
+  const std::string content("shared model");
+  std::shared_ptr<char> buffer(new char[content.size()], std::default_delete<char[]>());
+  std::memcpy(buffer.get(), content.data(), content.size());
+
+  m::model_data data;
+  data.set_shared_data(buffer, content.size());
+  BOOST_CHECK(data.is_shared());
+  BOOST_CHECK_EQUAL(to_string(data), content);
+
+  // Copies keep the memory alive
+  m::model_data copy(data);
+  data.free();
+  buffer.reset();
+  BOOST_CHECK(!data.is_shared());
+  BOOST_CHECK_EQUAL(data.data_sz(), 0);
+  BOOST_CHECK_EQUAL(to_string(copy), content);
+
+  // Resizing takes a copy
+  copy.data_sz(6);
+  BOOST_CHECK(!copy.is_shared());
+  BOOST_CHECK_EQUAL(to_string(copy), "shared");
+}
+
+BOOST_AUTO_TEST_CASE(model_delta_round_trip)
+{
+  m::model_delta delta;
+  delta.set_ids("base", "next");
+  delta.set_weight(10, 1.f);
+  delta.set_weight(2, 2.f);
+  delta.set_weight(10, 3.f);
+
+  m::model_data md;
+  delta.serialize(md);
+  BOOST_CHECK(m::model_delta::is_delta(md));
+
+  m::model_delta parsed;
+  BOOST_CHECK_EQUAL(parsed.parse(md.data(), md.data_sz()), e::success);
+  BOOST_CHECK_EQUAL(parsed.base_id(), "base");
+  BOOST_CHECK_EQUAL(parsed.model_id(), "next");
+  BOOST_REQUIRE_EQUAL(parsed.weights().size(), 2);
+  BOOST_CHECK_EQUAL(parsed.weights()[0].first, 2);
+  BOOST_CHECK_EQUAL(parsed.weights()[1].first, 10);
+  BOOST_CHECK_EQUAL(parsed.weights()[1].second, 3.f);
+
+  r::api_status status;
+  BOOST_CHECK_EQUAL(parsed.parse(md.data(), md.data_sz() - 1, &status), e::model_update_error);
+
+  m::model_data not_a_delta;
+  not_a_delta.set_data("model", 5);
+  BOOST_CHECK(!m::model_delta::is_delta(not_a_delta));
+}
+
+BOOST_AUTO_TEST_CASE(model_delta_merge)
+{
+  m::model_delta delta;
+  delta.set_ids("base", "first");
+  delta.set_weight(1, 1.f);
+  delta.set_weight(5, 5.f);
+
+  m::model_delta newer;
+  newer.set_ids("first", "second");
+  newer.set_weight(3, 3.f);
+  newer.set_weight(5, 50.f);
+
+  delta.merge(newer);
+  BOOST_CHECK_EQUAL(delta.base_id(), "base");
+  BOOST_CHECK_EQUAL(delta.model_id(), "second");
+
+  const std::vector<m::model_delta::entry> expected{{1, 1.f}, {3, 3.f}, {5, 50.f}};
+  BOOST_CHECK(delta.weights() == expected);
+}
+
+namespace
+{
+class verified_data_transport : public m::i_data_transport
+{
+public:
+  explicit verified_data_transport(bool valid) : _valid(valid) {}
+
+  int get_data(m::model_data& data, r::api_status* status) override
+  {
+    data.set_data("model", 5);
+    data.increment_refresh_count();
+    return e::success;
+  }
+
+  int verify_data(const m::model_data& data, r::api_status* status) override
+  {
+    if (!_valid) { RETURN_ERROR_LS(nullptr, status, model_checksum_mismatch); }
+    return e::success;
+  }
+
+private:
+  bool _valid;
+};
+
+void count_data_fn(const m::model_data& data, int* count) { ++*count; }
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(model_downloader_verifies_data)
+{
+  int count = 0;
+  m::data_callback_fn dfn(count_data_fn, &count);
+
+  r::metrics_snapshot before;
+  u::metrics_registry::snapshot(before);
+
+  verified_data_transport valid_transport(true);
+  m::model_downloader valid_downloader(&valid_transport, &dfn, nullptr);
+  BOOST_CHECK_EQUAL(valid_downloader.run_iteration(nullptr), e::success);
+  BOOST_CHECK_EQUAL(count, 1);
+
+  // data that fails verification is not handed to the model
+  verified_data_transport invalid_transport(false);
+  m::model_downloader invalid_downloader(&invalid_transport, &dfn, nullptr);
+  r::api_status status;
+  BOOST_CHECK_EQUAL(invalid_downloader.run_iteration(&status), e::model_checksum_mismatch);
+  BOOST_CHECK_EQUAL(count, 1);
+
+#ifndef RL_DISABLE_METRICS
+  // Only the refresh that loaded a model is timed
+  r::metrics_snapshot after;
+  u::metrics_registry::snapshot(after);
+  for (const auto stage : {r::api_stage::model_fetch, r::api_stage::model_verify, r::api_stage::model_load})
+  {
+    BOOST_CHECK_EQUAL(after.get(stage).count - before.get(stage).count, 1u);
+  }
+#endif
+}
@@ -6,6 +6,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include "api_status.h"
+#include "err_constants.h"
 #include "slot_ranking.h"
 
 #include <string>
@@ -74,3 +75,59 @@ BOOST_AUTO_TEST_CASE(multi_slot_response_detailed_write_read_iterator)
     }
   }
 }
+
+BOOST_AUTO_TEST_CASE(multi_slot_response_detailed_reuse)
+{
+  multi_slot_response_detailed multi;
+  multi.resize(3);
+  for (auto& s : multi)
+  {
+    for (auto& p : get_slot_ranking_test_data1()) { s.push_back(p.first, p.second); }
+  }
+  const auto* first_slot = &(*multi.begin());
+
+  multi.clear();
+  BOOST_CHECK_EQUAL(multi.size(), 0);
+  BOOST_CHECK(multi.begin() == multi.end());
+
+  // the slots are kept and come back empty
+  multi.resize(2);
+  BOOST_CHECK_EQUAL(multi.size(), 2);
+  BOOST_CHECK_EQUAL(&(*multi.begin()), first_slot);
+  for (const auto& s : multi) { BOOST_CHECK_EQUAL(s.size(), 0); }
+
+  int count = 0;
+  for (auto r = begin(multi); r != end(multi); ++r) { ++count; }
+  BOOST_CHECK_EQUAL(count, 2);
+
+  api_status status;
+  BOOST_CHECK_NE(multi.set_slot_at_index(2, slot_ranking(), &status), error_code::success);
+}
+
+BOOST_AUTO_TEST_CASE(multi_slot_response_detailed_set_slot_keeps_buffers)
+{
+  multi_slot_response_detailed multi;
+  multi.resize(1);
+
+  slot_ranking large("large");
+  for (size_t i = 0; i < 8; ++i) { large.push_back(i, 0.125f); }
+  large.set_chosen_action_id(3);
+  BOOST_CHECK_EQUAL(multi.set_slot_at_index(0, std::move(large)), error_code::success);
+  const auto* first_action = &(*(*multi.begin()).begin());
+
+  // a smaller slot is copied into the same buffers
+  slot_ranking small("small");
+  small.push_back(5, 0.6f);
+  small.push_back(2, 0.4f);
+  small.set_chosen_action_id(1);
+  BOOST_CHECK_EQUAL(multi.set_slot_at_index(0, std::move(small)), error_code::success);
+
+  const auto& slot = *multi.begin();
+  BOOST_CHECK_EQUAL(&(*slot.begin()), first_action);
+  BOOST_CHECK_EQUAL(slot.get_id(), "small");
+  BOOST_CHECK_EQUAL(slot.size(), 2);
+  BOOST_CHECK_EQUAL((*slot.begin()).action_id, 5);
+  size_t chosen_action_id = 0;
+  BOOST_CHECK_EQUAL(slot.get_chosen_action_id(chosen_action_id), error_code::success);
+  BOOST_CHECK_EQUAL(chosen_action_id, 1);
+}
@@ -7,7 +7,9 @@
 #include "trace_logger.h"
 #include "utility/versioned_object_pool.h"
 
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 using namespace reinforcement_learning;
 using namespace reinforcement_learning::utility;
@@ -190,4 +192,31 @@ BOOST_AUTO_TEST_CASE(object_pool_logging)
   pool.update_factory(new_factory);
   BOOST_TEST(logger.get_message().find("2") != std::string::npos);
   logger.reset();
-}
\ No newline at end of file
+}
+BOOST_AUTO_TEST_CASE(object_pool_update_factory_warm_up)
+{
+  my_object_factory factory;
+  versioned_object_pool<my_object> pool(factory);
+
+  std::vector<int> warmed_up;
+  const auto warm_up = [&warmed_up](my_object& obj) { warmed_up.push_back(obj._id); };
+
+  // an empty pool gets one warm object
+  pool.update_factory(my_object_factory(), warm_up);
+  BOOST_CHECK_EQUAL(warmed_up.size(), 1);
+  {
+    auto obj = pool.get_or_create();
+    BOOST_CHECK_EQUAL(obj->_id, 0);
+    auto pool_factory = pool.get_factory_function().target<my_object_factory>();
+    BOOST_CHECK_EQUAL(pool_factory->_count, 1);
+  }
+
+  // a failed warm-up keeps the current pool
+  const auto failing_warm_up = [](my_object&) { throw std::runtime_error("warm-up failed"); };
+  my_object_factory other_factory;
+  other_factory._count = 10;
+  BOOST_CHECK_THROW(pool.update_factory(other_factory, failing_warm_up), std::runtime_error);
+
+  auto obj = pool.get_or_create();
+  BOOST_CHECK_EQUAL(obj->_id, 0);
+}
@@ -58,6 +58,35 @@ BOOST_AUTO_TEST_CASE(cb_payload_serializer_test)
   BOOST_CHECK_CLOSE(0.8, probabilities[1], tolerance);
 
   BOOST_CHECK_EQUAL(true, event->deferred_action());
+  BOOST_CHECK(event->context_format() == v2::ContextFormat_Json);
+}
+
+BOOST_AUTO_TEST_CASE(payload_serializer_context_format_test)
+{
+  const std::vector<uint64_t> action_ids{1};
+  const std::vector<float> probs{1.f};
+  const auto cb_buffer = cb_serializer::event("binary", 0, v2::LearningModeType_Online, action_ids, probs, "model_id",
+      v2::ContextFormat_BinaryTensors);
+  BOOST_CHECK(v2::GetCbEvent(cb_buffer.data())->context_format() == v2::ContextFormat_BinaryTensors);
+
+  const auto ca_buffer = ca_serializer::event("binary", 0, 1.f, 0.5f, "model_id", v2::ContextFormat_BinaryTensors);
+  BOOST_CHECK(v2::GetCaEvent(ca_buffer.data())->context_format() == v2::ContextFormat_BinaryTensors);
+}
+
+BOOST_AUTO_TEST_CASE(payload_serializer_shortlist_test)
+{
+  const std::vector<uint64_t> action_ids{3, 1};
+  const std::vector<float> probs{0.9f, 0.1f};
+  const auto full_buffer =
+      cb_serializer::event("context", 0, v2::LearningModeType_Online, action_ids, probs, "model_id");
+  BOOST_CHECK(v2::GetCbEvent(full_buffer.data())->shortlist() == nullptr);
+
+  const std::vector<uint64_t> shortlist{1, 3};
+  const auto shortlisted_buffer = cb_serializer::event(
+      "context", 0, v2::LearningModeType_Online, action_ids, probs, "model_id", v2::ContextFormat_Json, shortlist);
+  const auto* logged = v2::GetCbEvent(shortlisted_buffer.data())->shortlist();
+  BOOST_REQUIRE(logged != nullptr);
+  BOOST_CHECK_EQUAL_COLLECTIONS(logged->begin(), logged->end(), shortlist.begin(), shortlist.end());
 }
 
 BOOST_AUTO_TEST_CASE(ca_payload_serializer_test)
@@ -93,7 +122,13 @@ BOOST_AUTO_TEST_CASE(multi_slot_payload_serializer_test)
   vector<vector<float>> probs{{0.5f, 0.3f, 0.2f}, {0.8f, 0.2f}};
   vector<std::string> slot_ids = {"0", "1"};
   vector<int> baseline_actions = {1, 0};
-  const auto buffer = serializer.event("my_context", action_flags::DEFAULT, actions, probs, "model_id", slot_ids,
+  multi_slot_ranking ranking;
+  for (size_t i = 0; i < actions.size(); ++i)
+  {
+    ranking.add_slot();
+    for (size_t j = 0; j < actions[i].size(); ++j) { ranking.push_back(actions[i][j], probs[i][j]); }
+  }
+  const auto buffer = serializer.event("my_context", action_flags::DEFAULT, ranking, "model_id", slot_ids,
       baseline_actions, v2::LearningModeType_Apprentice);
 
   const auto event = v2::GetMultiSlotEvent(buffer.data());
@@ -105,6 +140,7 @@ BOOST_AUTO_TEST_CASE(multi_slot_payload_serializer_test)
   BOOST_CHECK_EQUAL("model_id", event->model_id()->c_str());
 
   const auto& slots = *event->slots();
+  BOOST_CHECK_EQUAL(actions.size(), slots.size());
   for (flatbuffers::uoffset_t i = 0; i < slots.size(); ++i)
   {
     BOOST_CHECK_EQUAL(slot_ids[i], slots[i]->id()->str());
@@ -0,0 +1,112 @@
+#ifdef STAND_ALONE
+#  define BOOST_TEST_MODULE Main
+#endif
+
+#include "vw_model/prediction_cache.h"
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace reinforcement_learning;
+using namespace reinforcement_learning::model_management;
+
+namespace
+{
+void put(prediction_cache& cache, int version, const std::string& context, int action)
+{
+  cache.put(version, context, std::vector<int>{action, 1 - action}, std::vector<float>{0.9f, 0.1f}, "model");
+}
+
+bool get(prediction_cache& cache, int version, const std::string& context, int& action)
+{
+  std::vector<int> action_ids;
+  std::vector<float> action_pdf;
+  std::string model_version;
+  if (!cache.get(version, context, action_ids, action_pdf, model_version)) { return false; }
+  BOOST_CHECK_EQUAL(action_pdf.size(), 2);
+  BOOST_CHECK_EQUAL(model_version, "model");
+  action = action_ids[0];
+  return true;
+}
+
+size_t same_bucket(string_view) { return 42; }
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(prediction_cache_hit_and_miss)
+{
+  prediction_cache cache(10);
+  int action = -1;
+  BOOST_CHECK(!get(cache, 0, "a", action));
+
+  put(cache, 0, "a", 1);
+  BOOST_CHECK(get(cache, 0, "a", action));
+  BOOST_CHECK_EQUAL(action, 1);
+  BOOST_CHECK(!get(cache, 0, "b", action));
+
+  BOOST_CHECK_EQUAL(cache.hits(), 1);
+  BOOST_CHECK_EQUAL(cache.misses(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(prediction_cache_evicts_least_recently_used)
+{
+  prediction_cache cache(2);
+  int action = -1;
+  put(cache, 0, "a", 0);
+  put(cache, 0, "b", 0);
+  BOOST_CHECK(get(cache, 0, "a", action));
+
+  // "b" is the least recently used
+  put(cache, 0, "c", 0);
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+  BOOST_CHECK(get(cache, 0, "a", action));
+  BOOST_CHECK(!get(cache, 0, "b", action));
+  BOOST_CHECK(get(cache, 0, "c", action));
+}
+
+BOOST_AUTO_TEST_CASE(prediction_cache_invalidated_by_new_version)
+{
+  prediction_cache cache(10);
+  int action = -1;
+  put(cache, 0, "a", 0);
+
+  // a new version drops all entries
+  BOOST_CHECK(!get(cache, 1, "a", action));
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+
+  // rankings of an older version are not stored
+  put(cache, 0, "a", 0);
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+
+  put(cache, 1, "a", 1);
+  BOOST_CHECK(get(cache, 1, "a", action));
+  BOOST_CHECK_EQUAL(action, 1);
+  BOOST_CHECK(!get(cache, 0, "a", action));
+}
+
+BOOST_AUTO_TEST_CASE(prediction_cache_colliding_contexts)
+{
+  // all the contexts have the same hash, only their content tells them apart
+  prediction_cache cache(2, &same_bucket);
+  int action = -1;
+  put(cache, 0, "a", 0);
+  BOOST_CHECK(!get(cache, 0, "b", action));
+
+  put(cache, 0, "b", 1);
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+  BOOST_CHECK(get(cache, 0, "a", action));
+  BOOST_CHECK_EQUAL(action, 0);
+  BOOST_CHECK(get(cache, 0, "b", action));
+  BOOST_CHECK_EQUAL(action, 1);
+
+  // same size and same hash as the cached contexts
+  BOOST_CHECK(!get(cache, 0, "c", action));
+
+  // "a" is the least recently used
+  put(cache, 0, "c", 0);
+  BOOST_CHECK(!get(cache, 0, "a", action));
+  BOOST_CHECK(get(cache, 0, "b", action));
+  BOOST_CHECK_EQUAL(action, 1);
+  BOOST_CHECK(get(cache, 0, "c", action));
+  BOOST_CHECK_EQUAL(action, 0);
+}
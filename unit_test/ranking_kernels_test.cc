@@ -0,0 +1,223 @@
+#ifdef STAND_ALONE
+#  define BOOST_TEST_MODULE Main
+#endif
+
+#include "vw_model/ranking_kernels.h"
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace k = reinforcement_learning::ranking_kernels;
+
+namespace
+{
+const std::vector<k::kernel_isa> ALL_ISAS{k::kernel_isa::scalar, k::kernel_isa::avx2};
+
+// Scores with ties, both zeros and infinities, in a pattern that does not repeat with the vector width
+std::vector<float> make_scores(size_t count)
+{
+  const float values[] = {0.5f, -0.f, 0.f, -1.25f, std::numeric_limits<float>::infinity(), 3.f, -0.5f,
+      -std::numeric_limits<float>::infinity(), 1e-40f, -1e-40f, 0.5f};
+  std::vector<float> scores(count);
+  for (size_t i = 0; i < count; ++i) { scores[i] = values[(i * 7 + count) % (sizeof(values) / sizeof(values[0]))]; }
+  return scores;
+}
+
+bool same_bits(const std::vector<float>& left, const std::vector<float>& right)
+{
+  return left.size() == right.size() && std::memcmp(left.data(), right.data(), left.size() * sizeof(float)) == 0;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(ranking_kernels_rank_like_the_scores)
+{
+  // Cover every tail length around the 4 and 8 element vector blocks
+  for (size_t count = 1; count < 40; ++count)
+  {
+    const auto scores = make_scores(count);
+
+    // lowest score first, ties broken by action
+    std::vector<int> expected(count);
+    for (size_t i = 0; i < count; ++i) { expected[i] = static_cast<int>(i); }
+    std::stable_sort(
+        expected.begin(), expected.end(), [&scores](int left, int right) { return scores[left] < scores[right]; });
+    size_t expected_tied = 1;
+    while (expected_tied < count && scores[expected[expected_tied]] == scores[expected[0]]) { ++expected_tied; }
+
+    for (auto isa : ALL_ISAS)
+    {
+      std::vector<uint64_t> keys(count);
+      k::make_keys(isa, scores.data(), count, keys.data());
+      std::sort(keys.begin(), keys.end());
+
+      std::vector<int> actions(count);
+      k::unpack_actions(isa, keys.data(), count, actions.data());
+      BOOST_CHECK_EQUAL_COLLECTIONS(actions.begin(), actions.end(), expected.begin(), expected.end());
+      BOOST_CHECK_EQUAL(k::count_best(isa, keys.data(), count), expected_tied);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ranking_kernels_count_best_across_blocks)
+{
+  for (size_t count = 1; count < 40; ++count)
+  {
+    for (size_t tied = 1; tied <= count; ++tied)
+    {
+      std::vector<float> scores(count, 1.f);
+      std::fill(scores.begin(), scores.begin() + tied, -2.f);
+
+      for (auto isa : ALL_ISAS)
+      {
+        std::vector<uint64_t> keys(count);
+        k::make_keys(isa, scores.data(), count, keys.data());
+        BOOST_CHECK_EQUAL(k::count_best(isa, keys.data(), count), tied);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ranking_kernels_match_across_isas)
+{
+  for (size_t count = 1; count < 40; ++count)
+  {
+    const auto scores = make_scores(count);
+
+    std::vector<uint64_t> scalar_keys(count);
+    k::make_keys(k::kernel_isa::scalar, scores.data(), count, scalar_keys.data());
+    std::vector<int> scalar_actions(count);
+    k::unpack_actions(k::kernel_isa::scalar, scalar_keys.data(), count, scalar_actions.data());
+
+    for (auto isa : ALL_ISAS)
+    {
+      std::vector<uint64_t> keys(count);
+      k::make_keys(isa, scores.data(), count, keys.data());
+      BOOST_CHECK_EQUAL_COLLECTIONS(keys.begin(), keys.end(), scalar_keys.begin(), scalar_keys.end());
+
+      std::vector<int> actions(count);
+      k::unpack_actions(isa, keys.data(), count, actions.data());
+      BOOST_CHECK_EQUAL_COLLECTIONS(actions.begin(), actions.end(), scalar_actions.begin(), scalar_actions.end());
+    }
+
+    for (size_t tied = 1; tied <= count; ++tied)
+    {
+      for (float epsilon : {0.f, 0.2f, 1.f})
+      {
+        // same operations as the exploration of VW: each action gets epsilon / count, the best add their share
+        std::vector<float> expected(count, epsilon / static_cast<float>(count));
+        for (size_t i = 0; i < tied; ++i) { expected[i] += (1.f - epsilon) / static_cast<float>(tied); }
+
+        for (auto isa : ALL_ISAS)
+        {
+          std::vector<float> pdf(count, -1.f);
+          k::epsilon_greedy_pdf(isa, epsilon, tied, count, pdf.data());
+          BOOST_CHECK(same_bits(pdf, expected));
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ranking_kernels_smallest_keys_match_sort)
+{
+  for (size_t count = 1; count < 40; ++count)
+  {
+    // unique keys of tied scores, and raw keys with duplicates
+    const auto scores = make_scores(count);
+    std::vector<uint64_t> score_keys(count);
+    k::make_keys(k::kernel_isa::scalar, scores.data(), count, score_keys.data());
+    std::vector<uint64_t> duplicate_keys(count);
+    for (size_t i = 0; i < count; ++i) { duplicate_keys[i] = (i * 5 + count) % 3; }
+
+    for (const auto& input : {score_keys, duplicate_keys})
+    {
+      std::vector<uint64_t> sorted = input;
+      std::sort(sorted.begin(), sorted.end());
+
+      for (size_t smallest = 0; smallest <= count; ++smallest)
+      {
+        for (auto isa : ALL_ISAS)
+        {
+          std::vector<uint64_t> keys = input;
+          k::smallest_keys(isa, keys.data(), count, smallest);
+          BOOST_CHECK_EQUAL_COLLECTIONS(
+              keys.begin(), keys.begin() + smallest, sorted.begin(), sorted.begin() + smallest);
+
+          // the other keys are all still there
+          std::sort(keys.begin() + smallest, keys.end());
+          BOOST_CHECK_EQUAL_COLLECTIONS(keys.begin(), keys.end(), sorted.begin(), sorted.end());
+        }
+      }
+    }
+  }
+}
+
+namespace
+{
+// The loops of exploration::sample_after_normalizing
+size_t sample_like_vw(std::vector<float>& pdf, float draw_fraction)
+{
+  float total = 0.f;
+  for (auto& p : pdf)
+  {
+    if (p < 0) { p = 0; }
+    total += p;
+  }
+  float draw = total * draw_fraction;
+  if (draw > total) { draw = total; }
+
+  float sum = 0.f;
+  size_t chosen = pdf.size();
+  for (size_t i = 0; i < pdf.size(); ++i)
+  {
+    sum += pdf[i];
+    if (chosen == pdf.size() && draw <= sum) { chosen = i; }
+    pdf[i] /= total;
+  }
+  return chosen;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(ranking_kernels_sample_like_vw)
+{
+  for (size_t count = 1; count < 40; ++count)
+  {
+    // negative, zero and tied probabilities, the zeros make runs of equal cdf entries
+    const auto scores = make_scores(count);
+    std::vector<float> input(count);
+    for (size_t i = 0; i < count; ++i) { input[i] = std::isinf(scores[i]) ? 0.f : scores[i]; }
+
+    for (float draw_fraction : {0.f, 1e-7f, 0.25f, 0.5f, 0.75f, 0.9999999f, 1.f})
+    {
+      std::vector<float> expected_pdf = input;
+      const size_t expected = sample_like_vw(expected_pdf, draw_fraction);
+
+      for (auto isa : ALL_ISAS)
+      {
+        std::vector<float> pdf = input;
+        std::vector<float> cdf(count);
+        const float total = k::build_cdf(isa, pdf.data(), count, cdf.data());
+
+        float draw = total * draw_fraction;
+        if (draw > total) { draw = total; }
+        BOOST_CHECK_EQUAL(k::search_cdf(isa, cdf.data(), count, draw), expected);
+
+        // every entry of a run of equal cdf entries is found at its start
+        for (size_t i = 0; i < count; ++i)
+        {
+          const size_t first = k::search_cdf(isa, cdf.data(), count, cdf[i]);
+          BOOST_CHECK_LE(first, i);
+          BOOST_CHECK(first == i || cdf[first] == cdf[i]);
+        }
+
+        k::normalize_pdf(isa, pdf.data(), count, total);
+        BOOST_CHECK(same_bits(pdf, expected_pdf));
+      }
+    }
+  }
+}
@@ -5,9 +5,23 @@
 #include "vw_model/safe_vw.h"
 #include <boost/test/unit_test.hpp>
 
+#include "api_status.h"
+#include "configuration.h"
+#include "constants.h"
 #include "data.h"
+#include "err_constants.h"
 #include "model_mgmt.h"
+#include "model_mgmt/model_delta.h"
 #include "utility/versioned_object_pool.h"
+#include "vw/core/example.h"
+#include "vw/core/parse_example_json.h"
+#include "vw_model/cb_adf_scorer.h"
+#include "vw_model/vw_model.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
 
 using namespace reinforcement_learning;
 using namespace reinforcement_learning::utility;
@@ -69,14 +83,14 @@ BOOST_AUTO_TEST_CASE(factory_with_cb_model_and_ccb_arguments)
     uint32_t slot_count = 3;
     const char* features = json;
 
-    std::vector<std::vector<uint32_t>> actions_ids;
-    std::vector<std::vector<float>> action_pdfs;
+    multi_slot_ranking ranking;
 
     std::vector<std::string> slot_ids = {"0", "1"};
 
-    vw->rank_multi_slot_decisions(event_id, slot_ids, features, actions_ids, action_pdfs);
-    BOOST_CHECK_EQUAL(actions_ids.size(), slot_count);
-    BOOST_CHECK_EQUAL(action_pdfs.size(), slot_count);
+    vw->rank_multi_slot_decisions(event_id, slot_ids, features, ranking);
+    BOOST_CHECK_EQUAL(ranking.slot_count(), slot_count);
+    BOOST_CHECK_EQUAL(ranking.offsets().size(), slot_count + 1);
+    BOOST_CHECK_EQUAL(ranking.action_ids().size(), ranking.probabilities().size());
     // todo: add more accurate assertions once vw is updated with cb and ccb single slot equivalence changes
   }
 }
@@ -158,3 +172,308 @@ BOOST_AUTO_TEST_CASE(factory_with_empty_model)
     BOOST_CHECK_EQUAL_COLLECTIONS(ranking.begin(), ranking.end(), ranking_expected.begin(), ranking_expected.end());
   }
 }
+
+BOOST_AUTO_TEST_CASE(factory_with_model_delta)
+{
+  const auto json = R"({"a":{"0":1,"5":2},"_multi":[{"b":{"0":1}},{"b":{"0":2}},{"b":{"0":3}}]})";
+
+  model_management::model_data model_data;
+  get_model_data_from_raw((const char*)cb_data_5_model, cb_data_5_model_len, &model_data);
+
+  versioned_object_pool<safe_vw> pool(safe_vw_factory(model_data, "--json --quiet"));
+  auto vw = pool.get_or_create();
+  const std::string base_id = vw->id();
+
+  std::shared_ptr<model_management::model_delta> delta(new model_management::model_delta());
+  delta->set_ids(base_id, "delta-1");
+  delta->set_weight(0, 1.f);
+  delta->set_weight(1 << 20, -1.f);
+  pool.update_factory(safe_vw_factory(model_data, "--json --quiet", delta));
+
+  // objects created before the update are not affected
+  BOOST_CHECK_EQUAL(vw->id(), base_id);
+
+  auto updated_vw = pool.get_or_create();
+  BOOST_CHECK_EQUAL(updated_vw->id(), "delta-1");
+
+  std::vector<int> actions;
+  std::vector<float> ranking;
+  updated_vw->rank(json, actions, ranking);
+  BOOST_CHECK_EQUAL(ranking.size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(vw_model_delta_update)
+{
+  const auto json = R"({"a":{"0":1,"5":2},"_multi":[{"b":{"0":1}},{"b":{"0":2}},{"b":{"0":3}}]})";
+  const utility::configuration config;
+  model_management::vw_model model(nullptr, config);
+
+  model_management::model_data model_data;
+  model_management::model_delta delta;
+  delta.set_ids("base", "delta-1");
+  delta.set_weight(0, 1.f);
+  delta.serialize(model_data);
+
+  // a delta needs a full model to apply to
+  bool model_ready = false;
+  BOOST_CHECK_EQUAL(model.update(model_data, model_ready), error_code::model_update_error);
+  BOOST_CHECK(!model_ready);
+
+  get_model_data_from_raw((const char*)cb_data_5_model, cb_data_5_model_len, &model_data);
+  BOOST_CHECK_EQUAL(model.update(model_data, model_ready), error_code::success);
+  BOOST_CHECK(model_ready);
+
+  std::vector<int> actions;
+  std::vector<float> ranking;
+  std::string base_id;
+  BOOST_CHECK_EQUAL(model.choose_rank("event", 0, json, actions, ranking, base_id), error_code::success);
+
+  // wrong base model
+  delta.serialize(model_data);
+  api_status status;
+  BOOST_CHECK_EQUAL(model.update(model_data, model_ready, &status), error_code::model_update_error);
+  const std::string expected_message = "base_id = base, current model = " + base_id;
+  BOOST_CHECK(std::string(status.get_error_msg()).find(expected_message) != std::string::npos);
+
+  std::string model_version;
+  delta.set_ids(base_id, "delta-1");
+  delta.serialize(model_data);
+  BOOST_CHECK_EQUAL(model.update(model_data, model_ready), error_code::success);
+  BOOST_CHECK_EQUAL(model.choose_rank("event", 0, json, actions, ranking, model_version), error_code::success);
+  BOOST_CHECK_EQUAL(model_version, "delta-1");
+
+  // deltas can be chained
+  delta.set_ids("delta-1", "delta-2");
+  delta.serialize(model_data);
+  BOOST_CHECK_EQUAL(model.update(model_data, model_ready), error_code::success);
+  BOOST_CHECK_EQUAL(model.choose_rank("event", 0, json, actions, ranking, model_version), error_code::success);
+  BOOST_CHECK_EQUAL(model_version, "delta-2");
+}
+
+BOOST_AUTO_TEST_CASE(vw_model_rejects_data_without_header)
+{
+  const utility::configuration config;
+  model_management::vw_model model(nullptr, config);
+
+  model_management::model_data model_data;
+  const std::string not_a_model = "<html>Not Found</html>";
+  model_data.set_data(not_a_model.c_str(), not_a_model.size());
+
+  bool model_ready = false;
+  BOOST_CHECK_EQUAL(model.update(model_data, model_ready), error_code::model_update_error);
+  BOOST_CHECK(!model_ready);
+}
+
+BOOST_AUTO_TEST_CASE(vw_model_warm_up)
+{
+  const auto json = R"({"a":{"0":1,"5":2},"_multi":[{"b":{"0":1}},{"b":{"0":2}},{"b":{"0":3}}]})";
+  const std::string file_name = "vw_model_warm_up_contexts.txt";
+  {
+    std::ofstream file(file_name, std::ios::trunc);
+    file << json << "\n" << json << "\n";
+  }
+
+  utility::configuration config;
+  config.set(name::MODEL_WARMUP_CONTEXTS_FILE, file_name.c_str());
+  model_management::vw_model model(nullptr, config);
+
+  model_management::model_data model_data;
+  get_model_data_from_raw((const char*)cb_data_5_model, cb_data_5_model_len, &model_data);
+  bool model_ready = false;
+  BOOST_CHECK_EQUAL(model.update(model_data, model_ready), error_code::success);
+  BOOST_CHECK(model_ready);
+
+  std::vector<int> actions;
+  std::vector<float> ranking;
+  std::string model_version;
+  BOOST_CHECK_EQUAL(model.choose_rank("event", 0, json, actions, ranking, model_version), error_code::success);
+  BOOST_CHECK_EQUAL(ranking.size(), 3);
+
+  // a model that fails to warm up is not published
+  {
+    std::ofstream file(file_name, std::ios::trunc);
+    file << "{not json\n";
+  }
+  model_management::vw_model failing_model(nullptr, config);
+  model_ready = false;
+  BOOST_CHECK_EQUAL(failing_model.update(model_data, model_ready), error_code::model_update_error);
+  BOOST_CHECK(!model_ready);
+
+  std::remove(file_name.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(vw_model_warm_up_slates)
+{
+  const auto command_line = "--slates --ccb_explore_adf --json --quiet --epsilon 0.0 --first_only --id N/A";
+  const auto json =
+      R"({"GUser":{"id":"a"},"_multi":[{"TAction":{"a1":"f1"},"_slot_id":0},{"TAction":{"a2":"f2"},"_slot_id":1},{"TAction":{"a3":"f3"},"_slot_id":1}],"_slots":[{"Slot":{"a1":"f1"}},{"_id":"second","Slot":{"a2":"f2"}}]})";
+  const std::string file_name = "vw_model_warm_up_slates_contexts.txt";
+  {
+    std::ofstream file(file_name, std::ios::trunc);
+    file << json << "\n";
+  }
+
+  // an untrained slates model
+  auto backing = std::make_shared<std::vector<char>>();
+  {
+    auto* vw = VW::initialize(command_line);
+    io_buf buf;
+    buf.add_file(VW::io::create_vector_writer(backing));
+    VW::save_predictor(*vw, buf);
+    buf.flush();
+    VW::finish(*vw);
+  }
+
+  utility::configuration config;
+  config.set(name::MODEL_WARMUP_CONTEXTS_FILE, file_name.c_str());
+  config.set(name::MODEL_VW_INITIAL_COMMAND_LINE, command_line);
+  model_management::vw_model model(nullptr, config);
+  BOOST_CHECK_EQUAL((int)model.model_type(), (int)model_management::model_type_t::SLATES);
+
+  // warmed up through the multi slot path that serves slates requests
+  model_management::model_data model_data;
+  get_model_data_from_raw(backing->data(), static_cast<unsigned int>(backing->size()), &model_data);
+  bool model_ready = false;
+  BOOST_CHECK_EQUAL(model.update(model_data, model_ready), error_code::success);
+  BOOST_CHECK(model_ready);
+
+  multi_slot_ranking ranking;
+  std::string model_version;
+  BOOST_CHECK_EQUAL(model.request_multi_slot_decision("event", {"first", "second"}, json, ranking, model_version),
+      error_code::success);
+  BOOST_CHECK_EQUAL(ranking.slot_count(), 2);
+
+  std::remove(file_name.c_str());
+}
+
+namespace
+{
+// Linear terms, quadratic a x b terms with several features on both sides, string features and actions without b
+const std::vector<std::string> CB_ADF_SCORER_CONTEXTS{
+    R"({"a":{"0":1,"5":2},"_multi":[{"b":{"0":1}},{"b":{"0":2}},{"b":{"0":3}}]})",
+    R"({"a":{"x":"y","1":0.5},"_multi":[{"b":{"0":1,"7":-1}},{"c":{"z":1}},{"b":{"3":2}},{"b":{"0":2}}]})",
+    R"({"_multi":[{"b":{"0":1}},{"b":{"1":1}}]})",
+    R"({"a":{"0":1,"5":2,"9":-0.5,"2":0.25},"_multi":[{"b":{"0":1,"3":0.5,"6":-2}},{"b":{"1":2,"2":-1,"4":0.75}},{"b":{"0":0.5,"7":1.5,"8":1}}]})",
+    R"({"a":{"city":"seattle","device":"phone","3":1},"_multi":[{"b":{"color":"red","size":"large"}},{"b":{"color":"blue","size":"small","0":1}},{"b":{"color":"red","5":-1}}]})",
+    R"({"a":{"user":"u1","1":1},"c":{"z":2},"_multi":[{"b":{"topic":"sports","1":0.5},"c":{"w":1}},{"b":{"topic":"news"}},{"d":{"e":1}}]})"};
+
+// Parses context like safe_vw does, into examples the caller deallocates
+VW::multi_ex parse_cb_context(VW::workspace& vw, const std::string& context)
+{
+  VW::example_factory_t new_example = [&vw]() -> VW::example&
+  {
+    auto* ex = VW::alloc_examples(1);
+    vw.parser_runtime.example_parser->lbl_parser.default_label(ex->l);
+    return *ex;
+  };
+
+  VW::multi_ex examples{&new_example()};
+  std::string line(context);
+  VW::parsers::json::read_line_json<false>(vw, examples, &line[0], line.size(), new_example);
+  VW::setup_examples(vw, examples);
+  return examples;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(cb_adf_scorer_matches_vw)
+{
+  safe_vw vw((const char*)cb_data_5_model, cb_data_5_model_len, "--json --quiet");
+  safe_vw scored_vw((const char*)cb_data_5_model, cb_data_5_model_len, "--json --quiet");
+  BOOST_REQUIRE(scored_vw.enable_cb_adf_scorer());
+
+  for (const auto& context : CB_ADF_SCORER_CONTEXTS)
+  {
+    std::vector<int> actions;
+    std::vector<float> ranking;
+    vw.rank(context, actions, ranking);
+
+    std::vector<int> scored_actions;
+    std::vector<float> scored_ranking;
+    scored_vw.rank(context, scored_actions, scored_ranking);
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(actions.begin(), actions.end(), scored_actions.begin(), scored_actions.end());
+    BOOST_REQUIRE_EQUAL(ranking.size(), scored_ranking.size());
+    for (size_t i = 0; i < ranking.size(); ++i) { BOOST_CHECK_CLOSE(ranking[i], scored_ranking[i], 1e-3); }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(cb_adf_scorer_scores_match_vw)
+{
+  io_buf buf;
+  buf.add_file(VW::io::create_buffer_view((const char*)cb_data_5_model, cb_data_5_model_len));
+  auto* vw = VW::initialize("--json --quiet", &buf, false, nullptr, nullptr);
+  auto scorer = cb_adf_scorer::create(*vw);
+  BOOST_REQUIRE(scorer != nullptr);
+
+  for (const auto& context : CB_ADF_SCORER_CONTEXTS)
+  {
+    VW::multi_ex examples = parse_cb_context(*vw, context);
+
+    std::vector<int> actions;
+    std::vector<float> pdf;
+    BOOST_REQUIRE(scorer->predict(examples, actions, pdf));
+    const std::vector<float> scores = scorer->scores();
+
+    // VW leaves the score of each action in its example, and the ranking in the first one
+    vw->predict(examples);
+    BOOST_REQUIRE_GE(examples.size(), scores.size());
+    const size_t first_action = examples.size() - scores.size();
+    for (size_t i = 0; i < scores.size(); ++i)
+    {
+      BOOST_CHECK_SMALL(examples[first_action + i]->partial_prediction - scores[i], 1e-5f);
+    }
+
+    const auto& predictions = examples[0]->pred.a_s;
+    BOOST_REQUIRE_EQUAL(predictions.size(), actions.size());
+    for (size_t i = 0; i < actions.size(); ++i)
+    {
+      BOOST_CHECK_EQUAL(predictions[i].action, actions[i]);
+      BOOST_CHECK_CLOSE(predictions[i].score, pdf[i], 1e-3);
+    }
+
+    for (auto* ex : examples) { VW::dealloc_examples(ex, 1); }
+  }
+
+  VW::finish(*vw);
+}
+
+BOOST_AUTO_TEST_CASE(cb_adf_scorer_shortlist)
+{
+  const std::string context =
+      R"({"a":{"x":"y","1":0.5},"_multi":[{"b":{"0":1,"7":-1}},{"c":{"z":1}},{"b":{"3":2}},{"b":{"0":2}}]})";
+
+  safe_vw scored_vw((const char*)cb_data_5_model, cb_data_5_model_len, "--json --quiet");
+  BOOST_REQUIRE(scored_vw.enable_cb_adf_scorer());
+
+  std::vector<int> actions;
+  std::vector<float> ranking;
+  std::vector<int> shortlist;
+  scored_vw.rank(context, 2, actions, ranking, shortlist);
+
+  BOOST_REQUIRE_EQUAL(shortlist.size(), 2);
+  BOOST_CHECK(shortlist[0] < shortlist[1]);
+  BOOST_CHECK(shortlist[1] < 4);
+  BOOST_REQUIRE_EQUAL(actions.size(), 2);
+  BOOST_CHECK(std::is_permutation(actions.begin(), actions.end(), shortlist.begin()));
+  BOOST_CHECK_CLOSE(ranking[0] + ranking[1], 1.f, 1e-3);
+
+  // a shortlist as large as the action set ranks everything
+  std::vector<int> all_actions;
+  std::vector<float> all_ranking;
+  scored_vw.rank(context, all_actions, all_ranking);
+  scored_vw.rank(context, 4, actions, ranking, shortlist);
+  BOOST_CHECK(shortlist.empty());
+  BOOST_CHECK_EQUAL_COLLECTIONS(actions.begin(), actions.end(), all_actions.begin(), all_actions.end());
+
+  // without the scorer VW ranks all the actions
+  safe_vw vw((const char*)cb_data_5_model, cb_data_5_model_len, "--json --quiet");
+  vw.rank(context, 2, actions, ranking, shortlist);
+  BOOST_CHECK(shortlist.empty());
+  BOOST_CHECK_EQUAL(actions.size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(cb_adf_scorer_not_used_for_ccb)
+{
+  safe_vw vw((const char*)cb_data_5_model, cb_data_5_model_len, "--ccb_explore_adf --json --quiet");
+  BOOST_CHECK(!vw.enable_cb_adf_scorer());
+}
@@ -0,0 +1,98 @@
+#ifdef STAND_ALONE
+#  define BOOST_TEST_MODULE Main
+#endif
+
+#include "structured_input.h"
+#include <boost/test/unit_test.hpp>
+
+#include "api_status.h"
+#include "err_constants.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace reinforcement_learning;
+
+namespace
+{
+uint32_t read_u32(const char* data)
+{
+  uint32_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(structured_input_empty)
+{
+  structured_input input;
+  BOOST_CHECK_EQUAL(input.tensor_count(), 0);
+  BOOST_CHECK_EQUAL(input.size(), 8);
+  BOOST_CHECK_EQUAL(read_u32(input.data()), structured_input::MAGIC);
+  BOOST_CHECK_EQUAL(read_u32(input.data() + 4), 0);
+}
+
+BOOST_AUTO_TEST_CASE(structured_input_layout)
+{
+  const std::vector<int64_t> dimensions{1, 3};
+  const std::vector<float> values{1.f, 2.f, 3.f};
+
+  structured_input input;
+  BOOST_CHECK_EQUAL(input.add_tensor("abc", dimensions, values.data()), error_code::success);
+
+  // header, tensor header, padded name, dimensions, padded values
+  BOOST_CHECK_EQUAL(input.size(), 8 + 8 + 8 + 16 + 16);
+  BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(input.data()) % structured_input::ALIGNMENT, 0);
+  BOOST_CHECK_EQUAL(input.tensor_count(), 1);
+  BOOST_CHECK_EQUAL(read_u32(input.data() + 4), 1);
+
+  const char* tensor = input.data() + 8;
+  BOOST_CHECK_EQUAL(read_u32(tensor), 3);
+  BOOST_CHECK_EQUAL(read_u32(tensor + 4), 2);
+  BOOST_CHECK_EQUAL(std::string(tensor + 8), "abc");
+
+  int64_t parsed_dimensions[2];
+  std::memcpy(parsed_dimensions, tensor + 16, sizeof(parsed_dimensions));
+  BOOST_CHECK_EQUAL_COLLECTIONS(parsed_dimensions, parsed_dimensions + 2, dimensions.cbegin(), dimensions.cend());
+
+  float parsed_values[3];
+  std::memcpy(parsed_values, tensor + 32, sizeof(parsed_values));
+  BOOST_CHECK_EQUAL_COLLECTIONS(parsed_values, parsed_values + 3, values.cbegin(), values.cend());
+}
+
+BOOST_AUTO_TEST_CASE(structured_input_clear_and_reuse)
+{
+  const std::vector<float> values{1.f, 2.f};
+
+  structured_input input;
+  input.add_tensor("a", std::vector<int64_t>{2}, values.data());
+  input.add_tensor("b", std::vector<int64_t>{2}, values.data());
+  BOOST_CHECK_EQUAL(input.tensor_count(), 2);
+
+  input.clear();
+  BOOST_CHECK_EQUAL(input.tensor_count(), 0);
+  BOOST_CHECK_EQUAL(input.size(), 8);
+
+  input.add_tensor("c", std::vector<int64_t>{2}, values.data());
+  BOOST_CHECK_EQUAL(input.tensor_count(), 1);
+  BOOST_CHECK_EQUAL(read_u32(input.data() + 4), 1);
+  BOOST_CHECK_EQUAL(std::string(input.data() + 16), "c");
+}
+
+BOOST_AUTO_TEST_CASE(structured_input_invalid_arguments)
+{
+  const float value = 1.f;
+  const int64_t negative[] = {-1};
+  const int64_t one[] = {1};
+
+  structured_input input;
+  api_status status;
+  BOOST_CHECK_EQUAL(input.add_tensor(nullptr, one, 1, &value, &status), error_code::invalid_argument);
+  BOOST_CHECK_EQUAL(input.add_tensor("a", negative, 1, &value, &status), error_code::invalid_argument);
+  BOOST_CHECK_EQUAL(input.add_tensor("a", one, 1, nullptr, &status), error_code::invalid_argument);
+
+  // failed calls leave the input untouched
+  BOOST_CHECK_EQUAL(input.tensor_count(), 0);
+  BOOST_CHECK_EQUAL(input.size(), 8);
+}
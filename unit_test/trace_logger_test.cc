@@ -9,11 +9,15 @@
 #include "console_tracer.h"
 #include "constants.h"
 #include "err_constants.h"
+#include "file_tracer.h"
 #include "live_model.h"
 #include "mock_util.h"
 #include "model_mgmt.h"
 
+#include <cstdio>
+#include <fstream>
 #include <mutex>
+#include <thread>
 
 #ifdef __GNUG__
 
@@ -96,3 +100,166 @@ BOOST_AUTO_TEST_CASE(test_console_logging)
   reinforcement_learning::console_tracer trace;
   trace.log(0, "Test message");
 }
+
+BOOST_AUTO_TEST_CASE(test_trace_level_checked_before_message)
+{
+  reinforcement_learning::console_tracer trace;
+  trace.set_level(r::LEVEL_WARN);
+  r::i_trace* logger = &trace;
+
+  int built = 0;
+  const auto message = [&built]() -> std::string
+  {
+    ++built;
+    return "Test message";
+  };
+  TRACE_INFO(logger, message());
+  BOOST_CHECK_EQUAL(built, 0);
+  TRACE_ERROR(logger, message());
+  BOOST_CHECK_EQUAL(built, 1);
+}
+
+namespace
+{
+std::vector<std::string> read_lines(const std::string& file_name)
+{
+  std::vector<std::string> lines;
+  std::ifstream file(file_name);
+  std::string line;
+  while (std::getline(file, line)) { lines.push_back(line); }
+  return lines;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(test_file_logging)
+{
+  const std::string file_name = "test_file_logging.log";
+  std::remove(file_name.c_str());
+  {
+    r::api_status status;
+    r::file_tracer trace(file_name, 16);
+    BOOST_CHECK_EQUAL(trace.init(&status), err::success);
+    trace.set_level(r::LEVEL_WARN);
+    BOOST_CHECK(!trace.is_enabled(r::LEVEL_INFO));
+    BOOST_CHECK(trace.is_enabled(r::LEVEL_ERROR));
+
+    trace.log(r::LEVEL_INFO, "filtered");
+    trace.log(r::LEVEL_WARN, "first");
+    trace.log(r::LEVEL_ERROR, "second");
+    trace.flush();
+
+    const auto lines = read_lines(file_name);
+    BOOST_REQUIRE_EQUAL(lines.size(), 2);
+    BOOST_CHECK(lines[0].find("WARN: first") != std::string::npos);
+    BOOST_CHECK(lines[1].find("ERROR: second") != std::string::npos);
+  }
+  std::remove(file_name.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(test_file_logging_threads)
+{
+  const std::string file_name = "test_file_logging_threads.log";
+  std::remove(file_name.c_str());
+  const int thread_count = 4;
+  const int record_count = 1000;
+  {
+    r::api_status status;
+    r::file_tracer trace(file_name, 8);
+    BOOST_CHECK_EQUAL(trace.init(&status), err::success);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t)
+    {
+      threads.emplace_back(
+          [&trace]
+          {
+            for (int i = 0; i < record_count; ++i) { trace.log(r::LEVEL_INFO, "message"); }
+          });
+    }
+    for (auto& thread : threads) { thread.join(); }
+  }
+
+  // Every record is either written or counted as dropped
+  size_t written = 0;
+  size_t dropped = 0;
+  for (const auto& line : read_lines(file_name))
+  {
+    if (line.find("INFO: message") != std::string::npos) { ++written; }
+    const auto warning = line.find("WARN: ");
+    if (warning != std::string::npos) { dropped += std::stoul(line.substr(warning + 6)); }
+  }
+  BOOST_CHECK_EQUAL(written + dropped, thread_count * record_count);
+  std::remove(file_name.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(test_trace_event_formatted_by_default)
+{
+  vector_tracer trace;
+  trace.data.clear();
+  r::i_trace* logger = &trace;
+  TRACE_EVENT(logger, r::LEVEL_INFO, "model_loaded", {"size", 42}, {"refresh", size_t{3}}, {"ratio", 0.5f},
+      {"id", "m1"}, {"path", std::string("a/b")});
+  BOOST_REQUIRE_EQUAL(trace.data.size(), 1);
+  BOOST_CHECK_EQUAL(trace.data[0], "model_loaded size=42 refresh=3 ratio=0.5 id=m1 path=a/b");
+  trace.data.clear();
+}
+
+BOOST_AUTO_TEST_CASE(test_file_logging_events)
+{
+  const std::string file_name = "test_file_logging_events.log";
+  std::remove(file_name.c_str());
+  {
+    r::api_status status;
+    r::file_tracer trace(file_name, 4);
+    BOOST_CHECK_EQUAL(trace.init(&status), err::success);
+    r::i_trace* logger = &trace;
+
+    // Records reuse the slots of the ring and the buffers of earlier ones, with more or fewer fields
+    for (int round = 0; round < 3; ++round)
+    {
+      TRACE_EVENT(logger, r::LEVEL_INFO, "request", {"round", round}, {"event_id", std::string(40, 'a' + round)});
+      TRACE_EVENT(logger, r::LEVEL_WARN, "slow", {"ms", -1.25});
+      trace.log(r::LEVEL_ERROR, "plain");
+      trace.flush();
+    }
+
+    const auto lines = read_lines(file_name);
+    BOOST_REQUIRE_EQUAL(lines.size(), 9);
+    for (int round = 0; round < 3; ++round)
+    {
+      const auto& request = lines[round * 3];
+      BOOST_CHECK(request.find("INFO: request round=" + std::to_string(round) + " event_id=" +
+                      std::string(40, 'a' + round)) != std::string::npos);
+      BOOST_CHECK(request.substr(request.size() - 40) == std::string(40, 'a' + round));
+      BOOST_CHECK(lines[round * 3 + 1].find("WARN: slow ms=-1.25") != std::string::npos);
+      BOOST_CHECK(lines[round * 3 + 2].find("ERROR: plain") != std::string::npos);
+    }
+  }
+  std::remove(file_name.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(test_file_logging_exited_threads)
+{
+  const std::string file_name = "test_file_logging_exited_threads.log";
+  std::remove(file_name.c_str());
+  {
+    r::api_status status;
+    r::file_tracer trace(file_name, 16);
+    BOOST_CHECK_EQUAL(trace.init(&status), err::success);
+
+    // Each thread exits right after logging, its ring is drained before it is dropped
+    for (int t = 0; t < 8; ++t)
+    {
+      std::thread([&trace] { trace.log(r::LEVEL_INFO, "exiting"); }).join();
+    }
+    trace.flush();
+    trace.log(r::LEVEL_INFO, "still logging");
+    trace.flush();
+
+    const auto lines = read_lines(file_name);
+    BOOST_REQUIRE_EQUAL(lines.size(), 9);
+    for (int t = 0; t < 8; ++t) { BOOST_CHECK(lines[t].find("INFO: exiting") != std::string::npos); }
+    BOOST_CHECK(lines[8].find("INFO: still logging") != std::string::npos);
+  }
+  std::remove(file_name.c_str());
+}